@@ -36,15 +36,22 @@
 #include "CROSS.h"
 #include "csprng_hash.h"
 #include "fp_arith.h"
+#include "hash_stats.h"
 #include "merkle_tree.h"
 #include "namespace.h"
 #include "pack_unpack.h"
+#include "pk_cache.h"
+#include "pk_expanded.h"
+#include "presig.h"
+#include "probes.h"
 #include "randombytes.h"
+#include "rng_pool.h"
 #include "seedtree.h"
+#include "verify_state.h"
 
 #if defined(RSDP)
 static
-void expand_pk(FP_ELEM V_tr[K][N-K],
+void expand_pk(V_TR_ELEM V_tr[K][V_TR_COLS],
                         const uint8_t seed_pk[KEYPAIR_SEED_LENGTH_BYTES]){
 
   /* Expansion of pk->seed, explicit domain separation for CSPRNG as in keygen */
@@ -52,13 +59,13 @@ void expand_pk(FP_ELEM V_tr[K][N-K],
 
   CSPRNG_STATE_T csprng_state_mat;
   csprng_initialize(&csprng_state_mat, seed_pk, KEYPAIR_SEED_LENGTH_BYTES, dsc_csprng_seed_pk);
-  csprng_fp_mat(V_tr,&csprng_state_mat);
+  csprng_fp_mat_lazy(V_tr,&csprng_state_mat);
   /* PQClean-edit: CSPRNG release context */
   csprng_release(&csprng_state_mat);
 }
 #elif defined(RSDPG)
 static
-void expand_pk(FP_ELEM V_tr[K][N-K],
+void expand_pk(V_TR_ELEM V_tr[K][V_TR_COLS],
                         FZ_ELEM W_mat[M][N-M],
                         const uint8_t seed_pk[KEYPAIR_SEED_LENGTH_BYTES]){
 
@@ -68,8 +75,8 @@ void expand_pk(FP_ELEM V_tr[K][N-K],
   CSPRNG_STATE_T csprng_state_mat;
   csprng_initialize(&csprng_state_mat, seed_pk, KEYPAIR_SEED_LENGTH_BYTES, dsc_csprng_seed_pk);
 
-  csprng_fz_mat(W_mat, &csprng_state_mat);
-  csprng_fp_mat(V_tr, &csprng_state_mat);
+  csprng_fz_mat_lazy(W_mat, &csprng_state_mat);
+  csprng_fp_mat_lazy(V_tr, &csprng_state_mat);
   /* PQClean-edit: CSPRNG release context */
   csprng_release(&csprng_state_mat);
 }
@@ -79,7 +86,7 @@ void expand_pk(FP_ELEM V_tr[K][N-K],
 #if defined(RSDP)
 static
 void expand_sk(FZ_ELEM e_bar[N],
-                         FP_ELEM V_tr[K][N-K],
+                         V_TR_ELEM V_tr[K][V_TR_COLS],
                          const uint8_t seed_sk[KEYPAIR_SEED_LENGTH_BYTES]){
   uint8_t seed_e_seed_pk[2][KEYPAIR_SEED_LENGTH_BYTES];
 
@@ -109,7 +116,7 @@ void expand_sk(FZ_ELEM e_bar[N],
 static
 void expand_sk(FZ_ELEM e_bar[N],
                          FZ_ELEM e_G_bar[M],
-                         FP_ELEM V_tr[K][N-K],
+                         V_TR_ELEM V_tr[K][V_TR_COLS],
                          FZ_ELEM W_mat[M][N-M],
                          const uint8_t seed_sk[KEYPAIR_SEED_LENGTH_BYTES]){
   uint8_t seed_e_seed_pk[2][KEYPAIR_SEED_LENGTH_BYTES];
@@ -151,10 +158,44 @@ void expand_sk(FZ_ELEM e_bar[N],
 #endif
 
 
+/* computes and packs the public syndrome of the secret e_bar, itself derived
+ * from e_G_bar and W_mat in RSDPG */
+#if defined(RSDP)
+static
+void keygen_syndrome(pk_t *PK,
+                     FZ_ELEM e_bar[N],
+                     V_TR_ELEM V_tr[K][V_TR_COLS]){
+#elif defined(RSDPG)
+static
+void keygen_syndrome(pk_t *PK,
+                     const FZ_ELEM e_G_bar[M],
+                     FZ_ELEM W_mat[M][N-M],
+                     V_TR_ELEM V_tr[K][V_TR_COLS]){
+  FZ_ELEM e_bar[N];
+#if defined(HIGH_PERFORMANCE_X86_64)
+    alignas(EPI8_PER_REG) uint16_t W_mat_avx[M][ROUND_UP(N-M,EPI16_PER_REG)] = {{0}};
+    for(int i = 0; i < M; i++){
+      for (int j = 0; j < N-M; j++){
+         W_mat_avx[i][j] = W_mat[i][j];
+      }
+    }
+  fz_inf_w_by_fz_matrix(e_bar,e_G_bar,W_mat_avx);
+#else
+  fz_inf_w_by_fz_matrix(e_bar,e_G_bar,W_mat);
+#endif
+  fz_dz_norm_n(e_bar);
+#endif
+  /* compute public syndrome */
+  FP_ELEM s[N-K];
+  restr_vec_by_fp_matrix(s, e_bar, V_tr);
+  pack_fp_syn(PK->s, s);
+}
+
 void CROSS_keygen(sk_t *SK,
                   pk_t *PK){
+  CROSS_PROBE_ENTRY(keygen);
   /* generation of random material for public and private key */
-  randombytes(SK->seed_sk,KEYPAIR_SEED_LENGTH_BYTES);
+  secret_randombytes(SK->seed_sk,KEYPAIR_SEED_LENGTH_BYTES);
 
   uint8_t seed_e_seed_pk[2][KEYPAIR_SEED_LENGTH_BYTES];
 
@@ -171,13 +212,15 @@ void CROSS_keygen(sk_t *SK,
   memcpy(PK->seed_pk, seed_e_seed_pk[1], KEYPAIR_SEED_LENGTH_BYTES);
 
   /* expansion of matrix/matrices */
-  FP_ELEM V_tr[K][N-K];
+  alignas(EPI8_PER_REG) V_TR_ELEM V_tr[K][V_TR_COLS];
+  CROSS_PROBE_PHASE_ENTRY("expand_key", 0);
 #if defined(RSDP)
   expand_pk(V_tr,PK->seed_pk);
 #elif defined(RSDPG)
   FZ_ELEM W_mat[M][N-M];
   expand_pk(V_tr,W_mat,PK->seed_pk);
 #endif
+  CROSS_PROBE_PHASE_RETURN("expand_key");
 
   /* expansion of secret key material */
   /* Expansion of seede, explicit domain separation for CSPRNG */
@@ -186,251 +229,460 @@ void CROSS_keygen(sk_t *SK,
   CSPRNG_STATE_T csprng_state_e_bar;
   csprng_initialize(&csprng_state_e_bar, seed_e_seed_pk[0], KEYPAIR_SEED_LENGTH_BYTES, dsc_csprng_seed_e);
 
-  FZ_ELEM e_bar[N];
 #if defined(RSDP)
+  FZ_ELEM e_bar[N];
   csprng_fz_vec(e_bar,&csprng_state_e_bar);
+  /* PQClean-edit: CSPRNG release context */
+  csprng_release(&csprng_state_e_bar);
+  keygen_syndrome(PK, e_bar, V_tr);
 #elif defined(RSDPG)
   FZ_ELEM e_G_bar[M];
   csprng_fz_inf_w(e_G_bar, &csprng_state_e_bar);
-#if (defined(HIGH_PERFORMANCE_X86_64) && defined(RSDPG) )
-    alignas(EPI8_PER_REG) uint16_t W_mat_avx[M][ROUND_UP(N-M,EPI16_PER_REG)] = {{0}};
-    for(int i = 0; i < M; i++){
-      for (int j = 0; j < N-M; j++){
-         W_mat_avx[i][j] = W_mat[i][j];
-      }
-    }
-  fz_inf_w_by_fz_matrix(e_bar,e_G_bar,W_mat_avx);
-#else
-  fz_inf_w_by_fz_matrix(e_bar,e_G_bar,W_mat);
-#endif
-  fz_dz_norm_n(e_bar);
-#endif
   /* PQClean-edit: CSPRNG release context */
   csprng_release(&csprng_state_e_bar);
-  /* compute public syndrome */
-  FP_ELEM s[N-K];
-  restr_vec_by_fp_matrix(s, e_bar, V_tr);
-  fp_dz_norm_synd(s);
-  pack_fp_syn(PK->s, s);
+  keygen_syndrome(PK, e_G_bar, W_mat, V_tr);
+#endif
+  CROSS_PROBE_RETURN(keygen);
 }
 
-/* sign cannot fail */
-void CROSS_sign(const sk_t *const SK,
-               const char *const m,
-               const uint64_t mlen,
-               CROSS_sig_t *const sig){
-    /* Wipe any residual information in the sig structure allocated by the 
-     * caller */
-    memset(sig,0,sizeof(CROSS_sig_t));
-    /* Key material expansion */
-    FP_ELEM V_tr[K][N-K];
-    FZ_ELEM e_bar[N];
-#if defined(RSDP)
-    expand_sk(e_bar, V_tr, SK->seed_sk);
-#elif defined(RSDPG)
-    FZ_ELEM e_G_bar[M];
-    FZ_ELEM W_mat[M][N-M];
-    expand_sk(e_bar, e_G_bar, V_tr, W_mat, SK->seed_sk);
-#endif
+/* Generates n keypairs, running the CSPRNG expansions of up to four keys in
+ * lockstep on the parallel SHAKE lanes. The seeds are drawn from randombytes
+ * in the same order as n calls to CROSS_keygen, which yield the same keys */
+void CROSS_keygen_batch(sk_t *SK,
+                        pk_t *PK,
+                        size_t n){
+  const uint16_t dsc_csprng_seed_sk = CSPRNG_DOMAIN_SEP_CONST + (3*T+1);
+  const uint16_t dsc_csprng_seed_pk = CSPRNG_DOMAIN_SEP_CONST + (3*T+2);
+  const uint16_t dsc_csprng_seed_e = CSPRNG_DOMAIN_SEP_CONST + (3*T+3);
 
-#if (defined(HIGH_PERFORMANCE_X86_64) && defined(RSDP) )
-    /* Expanded */
-    alignas(EPI8_PER_REG) uint16_t V_tr_avx[K][ROUND_UP(N-K,EPI16_PER_REG)] = {{0}};
-    for(int i = 0; i < K; i++){
-      for (int j = 0; j < N-K; j++){
-         V_tr_avx[i][j] = V_tr[i][j];
-      }
+  for(size_t base = 0; base < n; base += 4){
+    int par_level = (n-base < 4) ? (int)(n-base) : 4;
+    /* unused lanes alias the first one, the parallel CSPRNG ignores them */
+    int lane_idx[4] = {0};
+    for(int l = 0; l < par_level; l++){
+      lane_idx[l] = l;
+      secret_randombytes(SK[base+l].seed_sk,KEYPAIR_SEED_LENGTH_BYTES);
     }
-#elif (defined(HIGH_PERFORMANCE_X86_64) && defined(RSDPG) )
-    alignas(EPI8_PER_REG) FP_DOUBLEPREC V_tr_avx[K][ROUND_UP(N-K,EPI32_PER_REG)] = {{0}};
-    for(int i = 0; i < K; i++){
-      for (int j = 0; j < N-K; j++){
-         V_tr_avx[i][j] = V_tr[i][j];
-      }
+    sk_t *sk[4] = {&SK[base+lane_idx[0]], &SK[base+lane_idx[1]],
+                   &SK[base+lane_idx[2]], &SK[base+lane_idx[3]]};
+    pk_t *pk[4] = {&PK[base+lane_idx[0]], &PK[base+lane_idx[1]],
+                   &PK[base+lane_idx[2]], &PK[base+lane_idx[3]]};
+
+    PAR_CSPRNG_STATE_T csprng_state;
+    uint8_t seed_e_seed_pk[4][2][KEYPAIR_SEED_LENGTH_BYTES];
+    HASH_STATS_PAR(HASH_STATS_SITE_KEYGEN_SEED_SK, par_level);
+    csprng_initialize_par(par_level, &csprng_state,
+                          sk[0]->seed_sk, sk[1]->seed_sk, sk[2]->seed_sk, sk[3]->seed_sk,
+                          KEYPAIR_SEED_LENGTH_BYTES,
+                          dsc_csprng_seed_sk, dsc_csprng_seed_sk,
+                          dsc_csprng_seed_sk, dsc_csprng_seed_sk);
+    csprng_randombytes_par(par_level, &csprng_state,
+                           (uint8_t *)seed_e_seed_pk[0], (uint8_t *)seed_e_seed_pk[1],
+                           (uint8_t *)seed_e_seed_pk[2], (uint8_t *)seed_e_seed_pk[3],
+                           2*KEYPAIR_SEED_LENGTH_BYTES);
+    /* PQClean-edit: CSPRNG release context */
+    csprng_release_par(par_level, &csprng_state);
+    for(int l = 0; l < par_level; l++){
+      memcpy(pk[l]->seed_pk, seed_e_seed_pk[l][1], KEYPAIR_SEED_LENGTH_BYTES);
     }
+
+    /* squeeze the material for the matrices of all lanes, then of e_bar
+     * resp. e_G_bar */
+#if defined(RSDPG)
+    uint8_t W_mat_buf[4][CSPRNG_FZ_MAT_BYTES];
 #endif
-#if (defined(HIGH_PERFORMANCE_X86_64) && defined(RSDPG) )
-    alignas(EPI8_PER_REG) uint16_t W_mat_avx[M][ROUND_UP(N-M,EPI16_PER_REG)] = {{0}};
-    for(int i = 0; i < M; i++){
-      for (int j = 0; j < N-M; j++){
-         W_mat_avx[i][j] = W_mat[i][j];
-      }
-    }
+    uint8_t V_tr_buf[4][CSPRNG_FP_MAT_BYTES];
+    HASH_STATS_PAR(HASH_STATS_SITE_KEYGEN_SEED_PK, par_level);
+    csprng_initialize_par(par_level, &csprng_state,
+                          pk[0]->seed_pk, pk[1]->seed_pk, pk[2]->seed_pk, pk[3]->seed_pk,
+                          KEYPAIR_SEED_LENGTH_BYTES,
+                          dsc_csprng_seed_pk, dsc_csprng_seed_pk,
+                          dsc_csprng_seed_pk, dsc_csprng_seed_pk);
+#if defined(RSDPG)
+    csprng_randombytes_par(par_level, &csprng_state,
+                           W_mat_buf[0], W_mat_buf[1], W_mat_buf[2], W_mat_buf[3],
+                           CSPRNG_FZ_MAT_BYTES);
 #endif
+    csprng_randombytes_par(par_level, &csprng_state,
+                           V_tr_buf[0], V_tr_buf[1], V_tr_buf[2], V_tr_buf[3],
+                           CSPRNG_FP_MAT_BYTES);
+    /* PQClean-edit: CSPRNG release context */
+    csprng_release_par(par_level, &csprng_state);
 
-    uint8_t root_seed[SEED_LENGTH_BYTES];
-    randombytes(root_seed,SEED_LENGTH_BYTES);
-    randombytes(sig->salt,SALT_LENGTH_BYTES);
+#if defined(RSDP)
+    uint8_t e_buf[4][CSPRNG_FZ_VEC_BYTES];
+#elif defined(RSDPG)
+    uint8_t e_buf[4][CSPRNG_FZ_INF_W_BYTES];
+#endif
+    HASH_STATS_PAR(HASH_STATS_SITE_KEYGEN_SEED_E, par_level);
+    csprng_initialize_par(par_level, &csprng_state,
+                          seed_e_seed_pk[0][0], seed_e_seed_pk[1][0],
+                          seed_e_seed_pk[2][0], seed_e_seed_pk[3][0],
+                          KEYPAIR_SEED_LENGTH_BYTES,
+                          dsc_csprng_seed_e, dsc_csprng_seed_e,
+                          dsc_csprng_seed_e, dsc_csprng_seed_e);
+    csprng_randombytes_par(par_level, &csprng_state,
+                           e_buf[0], e_buf[1], e_buf[2], e_buf[3],
+                           sizeof(e_buf[0]));
+    /* PQClean-edit: CSPRNG release context */
+    csprng_release_par(par_level, &csprng_state);
 
+    /* rejection sampling and syndrome computation, one lane at a time */
+    for(int l = 0; l < par_level; l++){
+      alignas(EPI8_PER_REG) V_TR_ELEM V_tr[K][V_TR_COLS];
+      csprng_fp_mat_from_buffer(V_tr, V_tr_buf[l]);
+#if defined(RSDP)
+      FZ_ELEM e_bar[N];
+      csprng_fz_vec_from_buffer(e_bar, e_buf[l]);
+      keygen_syndrome(pk[l], e_bar, V_tr);
+#elif defined(RSDPG)
+      FZ_ELEM W_mat[M][N-M];
+      csprng_fz_mat_from_buffer(W_mat, W_mat_buf[l]);
+      FZ_ELEM e_G_bar[M];
+      csprng_fz_inf_w_from_buffer(e_G_bar, e_buf[l]);
+      keygen_syndrome(pk[l], e_G_bar, W_mat, V_tr);
+#endif
+    }
+  }
+}
+
+/* Per-signature round data, shared by the stages computing the rounds of
+ * CROSS_sign. Each stage works on a batch of four consecutive rounds, and
+ * writes only the entries of its rounds */
+typedef struct {
+    const uint8_t *round_seeds;
+    const uint8_t *salt;
+    const FZ_ELEM *e_bar;
+#if defined(RSDPG)
+    const FZ_ELEM *e_G_bar;
+#if defined(HIGH_PERFORMANCE_X86_64)
+    uint16_t (*W_mat)[ROUND_UP(N-M,EPI16_PER_REG)];
+#else
+    FZ_ELEM (*W_mat)[N-M];
+#endif
+    FZ_ELEM (*v_G_bar)[M];
+#endif
+    V_TR_ELEM (*V_tr)[V_TR_COLS];
+    const FP_ELEM *chall_1;
+    FZ_ELEM (*e_bar_prime)[N];
+    FZ_ELEM (*v_bar)[N];
+    FP_ELEM (*u_prime)[N];
 #if defined(NO_TREES)
-    unsigned char round_seeds[T*SEED_LENGTH_BYTES] = {0};
-    seed_leaves(round_seeds,root_seed,sig->salt);
+    uint8_t (*cmt_0)[HASH_DIGEST_LENGTH];
 #else
-    uint8_t seed_tree[SEED_LENGTH_BYTES*NUM_NODES_SEED_TREE] = {0};
-    gen_seed_tree(seed_tree,root_seed,sig->salt);
-    unsigned char round_seeds[T*SEED_LENGTH_BYTES] = {0};
-    seed_leaves(round_seeds, seed_tree);
+    /* cmt_0 is written straight into the leaves of the Merkle tree, which
+     * is built as the batches of rounds complete if cmt_0_tree is set */
+    uint8_t *merkle_tree;
+    tree_builder_t *cmt_0_tree;
 #endif
+    uint8_t *cmt_1;
+    /* packed y of all rounds, both hashed into digest_chall_2 and published */
+    uint8_t *y_packed;
+} sign_rounds_t;
 
-    FZ_ELEM e_bar_prime[T][N];
-    FZ_ELEM v_bar[T][N];
-    FP_ELEM u_prime[T][N];
-    FP_ELEM s_prime[N-K];
+#define NUM_ROUND_BATCHES ((T+3)/4)
+#define ROUND_BATCH_SIZE(batch) ((4*(batch)+4 <= T) ? 4 : T-4*(batch))
+
+/* first stage: seed expansion and commitments of the rounds in a batch */
+static
+void sign_commit_batch(const sign_rounds_t *const rounds, const int batch){
+    const int par_level = ROUND_BATCH_SIZE(batch);
 
 #if defined(RSDP)
     uint8_t cmt_0_i_input[4][DENSELY_PACKED_FP_SYN_SIZE+
                              DENSELY_PACKED_FZ_VEC_SIZE+
                              SALT_LENGTH_BYTES];
-    uint16_t cmt_0_i_input_dsc[4];
     const int offset_salt = DENSELY_PACKED_FP_SYN_SIZE+DENSELY_PACKED_FZ_VEC_SIZE;
 #elif defined(RSDPG)
-    FZ_ELEM e_G_bar_prime[M];
-    FZ_ELEM v_G_bar[T][M];
     uint8_t cmt_0_i_input[4][DENSELY_PACKED_FP_SYN_SIZE+
                              DENSELY_PACKED_FZ_RSDP_G_VEC_SIZE+
                              SALT_LENGTH_BYTES];
-    uint16_t cmt_0_i_input_dsc[4];
     const int offset_salt = DENSELY_PACKED_FP_SYN_SIZE+DENSELY_PACKED_FZ_RSDP_G_VEC_SIZE;
 #endif
-
+    uint16_t cmt_0_i_input_dsc[4];
     uint8_t cmt_1_i_input[4][SEED_LENGTH_BYTES+
                              SALT_LENGTH_BYTES];
     uint16_t cmt_1_i_input_dsc[4];
 
-    /* place the salt in the hash input for all parallel instances of keccak */
-    for(int instance=0; instance<4; instance++) {
-      /* cmt_0_i_input is syndrome|| v_bar resp. v_G_bar ||salt ; place salt at the end */
-      memcpy(cmt_0_i_input[instance]+offset_salt, sig->salt, SALT_LENGTH_BYTES);
-      /* cmt_1_i_input is concat(seed,salt,round index) */
-      memcpy(cmt_1_i_input[instance]+SEED_LENGTH_BYTES, sig->salt, SALT_LENGTH_BYTES);
+    /* CSPRNG is fed with concat(seed,salt,round index) represented
+     * as a 2 bytes little endian unsigned integer */
+    uint8_t csprng_input[4][CSPRNG_INPUT_LENGTH];
+    uint16_t domain_sep_csprng[4];
+    int round_idx[4];
+    for(int l = 0; l < 4; l++){
+        /* unused lanes alias the first one, they are ignored */
+        int i = 4*batch + ((l < par_level) ? l : 0);
+        round_idx[l] = i;
+        memcpy(csprng_input[l],rounds->round_seeds+SEED_LENGTH_BYTES*i,SEED_LENGTH_BYTES);
+        memcpy(csprng_input[l]+SEED_LENGTH_BYTES,rounds->salt,SALT_LENGTH_BYTES);
+        domain_sep_csprng[l] = CSPRNG_DOMAIN_SEP_CONST+i+(2*T-1);
+
+        /* cmt_0_i_input is syndrome|| v_bar resp. v_G_bar ||salt ; place salt at the end */
+        memcpy(cmt_0_i_input[l]+offset_salt, rounds->salt, SALT_LENGTH_BYTES);
+        /* cmt_1_i_input is concat(seed,salt,round index) */
+        memcpy(cmt_1_i_input[l], rounds->round_seeds+SEED_LENGTH_BYTES*i, SEED_LENGTH_BYTES);
+        memcpy(cmt_1_i_input[l]+SEED_LENGTH_BYTES, rounds->salt, SALT_LENGTH_BYTES);
+        /* Fixed endianness marshalling of round counter */
+        cmt_0_i_input_dsc[l] = HASH_DOMAIN_SEP_CONST+i+(2*T-1);
+        cmt_1_i_input_dsc[l] = HASH_DOMAIN_SEP_CONST+i+(2*T-1);
     }
 
-    uint8_t cmt_0[T][HASH_DIGEST_LENGTH] = {0};
-    uint8_t cmt_1[T*HASH_DIGEST_LENGTH] = {0};
-
-    /* enqueue the calls to hash */
-    int to_hash = 0;
-    int round_idx_queue[4] = {0};
-
-    CSPRNG_STATE_T csprng_state;
-    for(uint16_t i = 0; i<T; i++){
-        to_hash++;
-        round_idx_queue[to_hash-1] = i;
-        /* CSPRNG is fed with concat(seed,salt,round index) represented
-         * as a 2 bytes little endian unsigned integer */
-        uint8_t csprng_input[SEED_LENGTH_BYTES+SALT_LENGTH_BYTES];
-        memcpy(csprng_input,round_seeds+SEED_LENGTH_BYTES*i,SEED_LENGTH_BYTES);
-        memcpy(csprng_input+SEED_LENGTH_BYTES,sig->salt,SALT_LENGTH_BYTES);
-
-        uint16_t domain_sep_csprng = CSPRNG_DOMAIN_SEP_CONST+i+(2*T-1);
-
-        /* expand seed[i] into seed_e and seed_u */
-        csprng_initialize(&csprng_state,
-                          csprng_input,
-                          SEED_LENGTH_BYTES+SALT_LENGTH_BYTES,
-                          domain_sep_csprng);
-        /* expand e_bar_prime */
+    /* expand seed[i] into seed_e and seed_u, squeezing the material for
+     * e_bar_prime resp. e_G_bar_prime first, then the one for u_prime */
 #if defined(RSDP)
-        csprng_fz_vec(e_bar_prime[i], &csprng_state);
+    uint8_t e_buf[4][CSPRNG_FZ_VEC_BYTES];
 #elif defined(RSDPG)
-        csprng_fz_inf_w(e_G_bar_prime, &csprng_state);
-        fz_vec_sub_m(v_G_bar[i], e_G_bar, e_G_bar_prime);
-        fz_dz_norm_m(v_G_bar[i]);
-#if defined(HIGH_PERFORMANCE_X86_64)
-        fz_inf_w_by_fz_matrix(e_bar_prime[i], e_G_bar_prime,W_mat_avx);
-#else
-        fz_inf_w_by_fz_matrix(e_bar_prime[i], e_G_bar_prime, W_mat);
-#endif
-        fz_dz_norm_n(e_bar_prime[i]);
+    uint8_t e_buf[4][CSPRNG_FZ_INF_W_BYTES];
 #endif
-        fz_vec_sub_n(v_bar[i], e_bar, e_bar_prime[i]);
+    uint8_t u_buf[4][CSPRNG_FP_VEC_BYTES];
+    PAR_CSPRNG_STATE_T par_csprng_state;
+    HASH_STATS_PAR(HASH_STATS_SITE_SIGN_ROUND_SEEDS, par_level);
+    csprng_initialize_par(par_level, &par_csprng_state,
+                          csprng_input[0], csprng_input[1],
+                          csprng_input[2], csprng_input[3],
+                          CSPRNG_INPUT_LENGTH,
+                          domain_sep_csprng[0], domain_sep_csprng[1],
+                          domain_sep_csprng[2], domain_sep_csprng[3]);
+    csprng_randombytes_par(par_level, &par_csprng_state,
+                           e_buf[0], e_buf[1], e_buf[2], e_buf[3],
+                           sizeof(e_buf[0]));
+    csprng_randombytes_par(par_level, &par_csprng_state,
+                           u_buf[0], u_buf[1], u_buf[2], u_buf[3],
+                           sizeof(u_buf[0]));
+    /* PQClean-edit: CSPRNG release context */
+    csprng_release_par(par_level, &par_csprng_state);
 
-        FP_ELEM v[N];
-        convert_restr_vec_to_fp(v, v_bar[i]);
-        fz_dz_norm_n(v_bar[i]);
-        /* expand u_prime */
-        csprng_fp_vec(u_prime[i], &csprng_state);
-        /* PQClean-edit: CSPRNG release context */
-        csprng_release(&csprng_state);
+    for(int l = 0; l < par_level; l++){
+        int i = round_idx[l];
+#if defined(RSDP)
+        csprng_fz_vec_from_buffer(rounds->e_bar_prime[i], e_buf[l]);
+#elif defined(RSDPG)
+        FZ_ELEM e_G_bar_prime[M];
+        csprng_fz_inf_w_from_buffer(e_G_bar_prime, e_buf[l]);
+        fz_vec_sub_m(rounds->v_G_bar[i], rounds->e_G_bar, e_G_bar_prime);
+        fz_dz_norm_m(rounds->v_G_bar[i]);
+        fz_inf_w_by_fz_matrix(rounds->e_bar_prime[i], e_G_bar_prime, rounds->W_mat);
+        fz_dz_norm_n(rounds->e_bar_prime[i]);
+#endif
+        csprng_fp_vec_from_buffer(rounds->u_prime[i], u_buf[l]);
 
+        /* v_bar = e_bar - e_bar_prime and u = v * u_prime in a single pass */
         FP_ELEM u[N];
-        fp_vec_by_fp_vec_pointwise(u, v, u_prime[i]);
-#if (defined(HIGH_PERFORMANCE_X86_64))
-        fp_vec_by_fp_matrix(s_prime, u, V_tr_avx);
+        restr_vec_sub_by_fp_vec_pointwise(u, rounds->v_bar[i], rounds->e_bar,
+                                          rounds->e_bar_prime[i], rounds->u_prime[i]);
+        FP_ELEM s_prime[N-K];
+        fp_vec_by_fp_matrix(s_prime, u, rounds->V_tr);
+
+        /* cmt_0_i_input contains s_prime || v_bar resp. v_G_bar || salt */
+        pack_fp_syn(cmt_0_i_input[l],s_prime);
+#if defined(RSDP)
+        pack_fz_vec(cmt_0_i_input[l] + DENSELY_PACKED_FP_SYN_SIZE, rounds->v_bar[i]);
+#elif defined(RSDPG)
+        pack_fz_rsdp_g_vec(cmt_0_i_input[l] + DENSELY_PACKED_FP_SYN_SIZE, rounds->v_G_bar[i]);
+#endif
+    }
+
+    uint8_t *cmt_0_out[4];
+    for(int l = 0; l < 4; l++){
+#if defined(NO_TREES)
+        cmt_0_out[l] = rounds->cmt_0[round_idx[l]];
 #else
-        fp_vec_by_fp_matrix(s_prime, u, V_tr);
+        cmt_0_out[l] = tree_leaf(rounds->merkle_tree, round_idx[l]);
 #endif
-        fp_dz_norm_synd(s_prime);
+    }
+    HASH_STATS_PAR(HASH_STATS_SITE_SIGN_CMT_0, par_level);
+    hash_par(
+        par_level,
+        cmt_0_out[0],
+        cmt_0_out[1],
+        cmt_0_out[2],
+        cmt_0_out[3],
+        cmt_0_i_input[0],
+        cmt_0_i_input[1],
+        cmt_0_i_input[2],
+        cmt_0_i_input[3],
+        sizeof(cmt_0_i_input)/4,
+        cmt_0_i_input_dsc[0],
+        cmt_0_i_input_dsc[1],
+        cmt_0_i_input_dsc[2],
+        cmt_0_i_input_dsc[3]
+    );
+    HASH_STATS_PAR(HASH_STATS_SITE_SIGN_CMT_1, par_level);
+    hash_par(
+        par_level,
+        &rounds->cmt_1[round_idx[0]*HASH_DIGEST_LENGTH],
+        &rounds->cmt_1[round_idx[1]*HASH_DIGEST_LENGTH],
+        &rounds->cmt_1[round_idx[2]*HASH_DIGEST_LENGTH],
+        &rounds->cmt_1[round_idx[3]*HASH_DIGEST_LENGTH],
+        cmt_1_i_input[0],
+        cmt_1_i_input[1],
+        cmt_1_i_input[2],
+        cmt_1_i_input[3],
+        sizeof(cmt_1_i_input)/4,
+        cmt_1_i_input_dsc[0],
+        cmt_1_i_input_dsc[1],
+        cmt_1_i_input_dsc[2],
+        cmt_1_i_input_dsc[3]
+    );
+}
 
-        /* cmt_0_i_input contains s_prime || v_bar resp. v_G_bar || salt */
-        pack_fp_syn(cmt_0_i_input[to_hash-1],s_prime);
+/* second stage: first round of responses, y packed as it is published */
+static
+void sign_y_batch(const sign_rounds_t *const rounds, const int batch){
+    for(int i = 4*batch; i < 4*batch+ROUND_BATCH_SIZE(batch); i++){
+        FP_ELEM y[N];
+        fp_vec_by_restr_vec_scaled(y,
+                                   rounds->e_bar_prime[i],
+                                   rounds->chall_1[i],
+                                   rounds->u_prime[i]);
+        pack_fp_vec(rounds->y_packed+(i*DENSELY_PACKED_FP_VEC_SIZE),y);
+    }
+}
 
+typedef void (*sign_stage_t)(const sign_rounds_t *const rounds, const int batch);
+
+/* computes stage on all the batches of rounds, absorbing into hash_state
+ * the stream_bytes_per_round bytes that each round writes into stream, in
+ * round order, each batch as soon as it is computed */
+static
+void sign_run_stage(const sign_rounds_t *const rounds,
+                    const sign_stage_t stage,
+                    CSPRNG_STATE_T *const hash_state,
+                    const uint8_t *const stream,
+                    const size_t stream_bytes_per_round){
+    for(int batch = 0; batch < NUM_ROUND_BATCHES; batch++){
+        stage(rounds, batch);
+        hash_update(hash_state,
+                    stream+4*batch*stream_bytes_per_round,
+                    ROUND_BATCH_SIZE(batch)*stream_bytes_per_round);
+#if !defined(NO_TREES)
+        if(rounds->cmt_0_tree != NULL){
+            tree_builder_add(rounds->cmt_0_tree, rounds->merkle_tree, ROUND_BATCH_SIZE(batch));
+        }
+#endif
+    }
+}
+
+/* presign cannot fail */
+void CROSS_presign(const sk_t *const SK,
+                   CROSS_presig_t *const presig){
+    HASH_STATS_ENTER(HASH_STATS_SIGN);
+    /* Key material expansion */
+    alignas(EPI8_PER_REG) V_TR_ELEM V_tr[K][V_TR_COLS];
+    FZ_ELEM e_bar[N];
+    CROSS_PROBE_PHASE_ENTRY("expand_key", 0);
 #if defined(RSDP)
-        pack_fz_vec(cmt_0_i_input[to_hash-1] + DENSELY_PACKED_FP_SYN_SIZE, v_bar[i]);
+    expand_sk(e_bar, V_tr, SK->seed_sk);
 #elif defined(RSDPG)
-        pack_fz_rsdp_g_vec(cmt_0_i_input[to_hash-1] + DENSELY_PACKED_FP_SYN_SIZE, v_G_bar[i]);
+    FZ_ELEM e_G_bar[M];
+    FZ_ELEM W_mat[M][N-M];
+    expand_sk(e_bar, e_G_bar, V_tr, W_mat, SK->seed_sk);
 #endif
-        /* Fixed endianness marshalling of round counter */
-        uint16_t domain_sep_hash = HASH_DOMAIN_SEP_CONST+i+(2*T-1);
-        cmt_0_i_input_dsc[to_hash-1] = domain_sep_hash;
-
-        memcpy(cmt_1_i_input[to_hash-1], round_seeds+SEED_LENGTH_BYTES*i, SEED_LENGTH_BYTES);
-
-        cmt_1_i_input_dsc[to_hash-1] = domain_sep_hash;
-
-        if(to_hash == 4 || i == T-1){
-            hash_par(
-                to_hash,
-                cmt_0[round_idx_queue[0]],
-                cmt_0[round_idx_queue[1]],
-                cmt_0[round_idx_queue[2]],
-                cmt_0[round_idx_queue[3]],
-                cmt_0_i_input[0],
-                cmt_0_i_input[1],
-                cmt_0_i_input[2],
-                cmt_0_i_input[3],
-                sizeof(cmt_0_i_input)/4,
-                cmt_0_i_input_dsc[0],
-                cmt_0_i_input_dsc[1],
-                cmt_0_i_input_dsc[2],
-                cmt_0_i_input_dsc[3]
-            );
-            hash_par(
-                to_hash,
-                &cmt_1[round_idx_queue[0]*HASH_DIGEST_LENGTH],
-                &cmt_1[round_idx_queue[1]*HASH_DIGEST_LENGTH],
-                &cmt_1[round_idx_queue[2]*HASH_DIGEST_LENGTH],
-                &cmt_1[round_idx_queue[3]*HASH_DIGEST_LENGTH],
-                cmt_1_i_input[0],
-                cmt_1_i_input[1],
-                cmt_1_i_input[2],
-                cmt_1_i_input[3],
-                sizeof(cmt_1_i_input)/4,
-                cmt_1_i_input_dsc[0],
-                cmt_1_i_input_dsc[1],
-                cmt_1_i_input_dsc[2],
-                cmt_1_i_input_dsc[3]
-            );
-            to_hash = 0;
-        }
+    CROSS_PROBE_PHASE_RETURN("expand_key");
+
+#if (defined(HIGH_PERFORMANCE_X86_64) && defined(RSDPG) )
+    alignas(EPI8_PER_REG) uint16_t W_mat_avx[M][ROUND_UP(N-M,EPI16_PER_REG)] = {{0}};
+    for(int i = 0; i < M; i++){
+      for (int j = 0; j < N-M; j++){
+         W_mat_avx[i][j] = W_mat[i][j];
+      }
     }
+#endif
+
+    uint8_t root_seed[SEED_LENGTH_BYTES];
+    secret_randombytes(root_seed,SEED_LENGTH_BYTES);
+    secret_randombytes(presig->salt,SALT_LENGTH_BYTES);
+
+    CROSS_PROBE_PHASE_ENTRY("seed_tree", T);
+#if defined(NO_TREES)
+    unsigned char *round_seeds = presig->round_seeds;
+    memset(round_seeds, 0, sizeof(presig->round_seeds));
+    seed_leaves(round_seeds,root_seed,presig->salt);
+#else
+    /* every node of the tree is written, the leaves also as round seeds */
+    unsigned char round_seeds[T*SEED_LENGTH_BYTES];
+    gen_seed_tree_leaves(presig->seed_tree,round_seeds,root_seed,presig->salt);
+#endif
+    CROSS_PROBE_PHASE_RETURN("seed_tree");
+
+#if defined(NO_TREES)
+    uint8_t (*cmt_0)[HASH_DIGEST_LENGTH] = presig->cmt_0;
+    memset(cmt_0, 0, sizeof(presig->cmt_0));
+#else
+    tree_builder_t cmt_0_tree;
+    tree_builder_init(&cmt_0_tree);
+#endif
+    memset(presig->cmt_1, 0, sizeof(presig->cmt_1));
+
+    sign_rounds_t rounds = {0};
+    rounds.round_seeds = round_seeds;
+    rounds.salt = presig->salt;
+    rounds.e_bar = e_bar;
+#if defined(RSDPG)
+    rounds.e_G_bar = e_G_bar;
+#if defined(HIGH_PERFORMANCE_X86_64)
+    rounds.W_mat = W_mat_avx;
+#else
+    rounds.W_mat = W_mat;
+#endif
+    rounds.v_G_bar = presig->v_G_bar;
+#endif
+    rounds.V_tr = V_tr;
+    rounds.e_bar_prime = presig->e_bar_prime;
+    rounds.v_bar = presig->v_bar;
+    rounds.u_prime = presig->u_prime;
+#if defined(NO_TREES)
+    rounds.cmt_0 = cmt_0;
+#else
+    rounds.merkle_tree = presig->merkle_tree;
+    rounds.cmt_0_tree = &cmt_0_tree;
+#endif
+    rounds.cmt_1 = presig->cmt_1;
+
+    /* cmt_1 is absorbed into its digest, and cmt_0 into the Merkle tree, as
+     * each batch of rounds produces them */
+    CSPRNG_STATE_T cmt_1_state;
+    hash_init(&cmt_1_state);
+    CROSS_PROBE_PHASE_ENTRY("rounds", T);
+    sign_run_stage(&rounds, sign_commit_batch, &cmt_1_state, presig->cmt_1, HASH_DIGEST_LENGTH);
+    CROSS_PROBE_PHASE_RETURN("rounds");
 
     /* vector containing d_0 and d_1 from spec */
     uint8_t digest_cmt0_cmt1[2*HASH_DIGEST_LENGTH];
 
+    CROSS_PROBE_PHASE_ENTRY("merkle_root", T);
 #if defined(NO_TREES)
     tree_root(digest_cmt0_cmt1, cmt_0);
 #else
-    uint8_t merkle_tree[NUM_NODES_MERKLE_TREE * HASH_DIGEST_LENGTH];
-    tree_root(digest_cmt0_cmt1, merkle_tree, cmt_0);
+    tree_builder_root(&cmt_0_tree, digest_cmt0_cmt1, presig->merkle_tree);
 #endif
-    hash(digest_cmt0_cmt1 + HASH_DIGEST_LENGTH, cmt_1, sizeof(cmt_1), HASH_DOMAIN_SEP_CONST);
-    hash(sig->digest_cmt, digest_cmt0_cmt1, sizeof(digest_cmt0_cmt1), HASH_DOMAIN_SEP_CONST);
+    CROSS_PROBE_PHASE_RETURN("merkle_root");
+    hash_final(digest_cmt0_cmt1 + HASH_DIGEST_LENGTH, &cmt_1_state, HASH_DOMAIN_SEP_CONST);
+    hash(presig->digest_cmt, digest_cmt0_cmt1, sizeof(digest_cmt0_cmt1), HASH_DOMAIN_SEP_CONST);
+    presig->is_ready = 1;
+    /* the signature is counted as it is completed by CROSS_sign_online */
+    HASH_STATS_LEAVE(0);
+}
+
+int CROSS_sign_online(CROSS_presig_t *const presig,
+                      const char *const m,
+                      const uint64_t mlen,
+                      CROSS_sig_t *const sig){
+    if(!presig->is_ready){
+        return 0;
+    }
+    HASH_STATS_ENTER(HASH_STATS_SIGN);
+    /* Wipe any residual information in the sig structure allocated by the 
+     * caller */
+    memset(sig,0,sizeof(CROSS_sig_t));
+    memcpy(sig->salt, presig->salt, SALT_LENGTH_BYTES);
+    memcpy(sig->digest_cmt, presig->digest_cmt, HASH_DIGEST_LENGTH);
 
     /* first challenge extraction */
     /* Domain separation for hashing to digest_chall_1 */
     uint8_t digest_msg_cmt_salt[2*HASH_DIGEST_LENGTH+SALT_LENGTH_BYTES];
 
+    CROSS_PROBE_PHASE_ENTRY("chall_1", T);
     /* place d_m at the beginning of the input of the hash generating digest_chall_1 */ 
     hash(digest_msg_cmt_salt, (uint8_t*) m, mlen, HASH_DOMAIN_SEP_CONST);
     memcpy(digest_msg_cmt_salt+HASH_DIGEST_LENGTH, sig->digest_cmt, HASH_DIGEST_LENGTH);
@@ -443,133 +695,377 @@ void CROSS_sign(const sk_t *const SK,
     const uint16_t dsc_csprng_chall_1 = CSPRNG_DOMAIN_SEP_CONST + (3*T-1);
 
     FP_ELEM chall_1[T];
+    CSPRNG_STATE_T csprng_state;
     csprng_initialize(&csprng_state,digest_chall_1,sizeof(digest_chall_1), dsc_csprng_chall_1);
-    csprng_fp_vec_chall_1(chall_1, &csprng_state);
+    csprng_fp_vec_chall_1_lazy(chall_1, &csprng_state);
     /* PQClean-edit: CSPRNG release context */
     csprng_release(&csprng_state);
-
-    /* Computation of the first round of responses */
-    FP_ELEM y[T][N];
-    for(int i = 0; i < T; i++){
-        fp_vec_by_restr_vec_scaled(y[i],
-                                   e_bar_prime[i],
-                                   chall_1[i],
-                                   u_prime[i]);
-        fp_dz_norm(y[i]);
-    }
-    /* y vectors are packed before being hashed */
-    uint8_t y_digest_chall_1[T*DENSELY_PACKED_FP_VEC_SIZE+HASH_DIGEST_LENGTH];
-    for(int x = 0; x < T; x++){
-        pack_fp_vec(y_digest_chall_1+(x*DENSELY_PACKED_FP_VEC_SIZE),y[x]);
-    }
+    CROSS_PROBE_PHASE_RETURN("chall_1");
+
+    uint8_t y_packed[T*DENSELY_PACKED_FP_VEC_SIZE];
+
+    /* the second stage only reads the round material of presig */
+    sign_rounds_t rounds = {0};
+    rounds.chall_1 = chall_1;
+    rounds.e_bar_prime = presig->e_bar_prime;
+    rounds.u_prime = presig->u_prime;
+    rounds.y_packed = y_packed;
+
+    /* Computation of the first round of responses: each y[i] is packed,
+     * and absorbed into the hash input as soon as its batch of rounds is
+     * computed; the packed form is also the one published in resp_0 */
+    CROSS_PROBE_PHASE_ENTRY("responses_y", T);
+    CSPRNG_STATE_T y_state;
+    hash_init(&y_state);
+    sign_run_stage(&rounds, sign_y_batch, &y_state, y_packed, DENSELY_PACKED_FP_VEC_SIZE);
     /* Second challenge extraction */
-    memcpy(y_digest_chall_1+T*DENSELY_PACKED_FP_VEC_SIZE,digest_chall_1,HASH_DIGEST_LENGTH);
-
-    hash(sig->digest_chall_2, y_digest_chall_1, sizeof(y_digest_chall_1), HASH_DOMAIN_SEP_CONST);
+    hash_update(&y_state, digest_chall_1, HASH_DIGEST_LENGTH);
+    hash_final(sig->digest_chall_2, &y_state, HASH_DOMAIN_SEP_CONST);
+    CROSS_PROBE_PHASE_RETURN("responses_y");
 
-    uint8_t chall_2[T]={0};
-    expand_digest_to_fixed_weight(chall_2,sig->digest_chall_2);
+    CROSS_PROBE_PHASE_ENTRY("chall_2", T);
+    chall_2_t chall_2;
+    expand_digest_to_chall_2(&chall_2,sig->digest_chall_2);
+    CROSS_PROBE_PHASE_RETURN("chall_2");
 
     /* Computation of the second round of responses */
-
+    CROSS_PROBE_PHASE_ENTRY("merkle_proof", T);
 #if defined(NO_TREES)
-    tree_proof(sig->proof,cmt_0,chall_2);
-    seed_path(sig->path,round_seeds,chall_2);
+    tree_proof(sig->proof,presig->cmt_0,&chall_2);
 #else
-    tree_proof(sig->proof,merkle_tree,chall_2);
-    seed_path(sig->path,seed_tree,chall_2);
+    tree_proof(sig->proof,presig->merkle_tree,&chall_2);
 #endif
-
-    int published_rsps = 0;
-    for(int i = 0; i<T; i++){
-        if(chall_2[i] == 0){
-            assert(published_rsps < T-W);
-            pack_fp_vec(sig->resp_0[published_rsps].y, y[i]);
+    CROSS_PROBE_PHASE_RETURN("merkle_proof");
+    CROSS_PROBE_PHASE_ENTRY("seed_path", T);
+#if defined(NO_TREES)
+    seed_path(sig->path,presig->round_seeds,&chall_2);
+#else
+    seed_path(sig->path,presig->seed_tree,&chall_2);
+#endif
+    CROSS_PROBE_PHASE_RETURN("seed_path");
+
+    /* the responses of the rounds where chall_2 is 0, in round order */
+    CROSS_PROBE_PHASE_ENTRY("pack_responses", T-W);
+    for(int published_rsps = 0; published_rsps < T-W; published_rsps++){
+        const int i = chall_2.rounds_0[published_rsps];
+        memcpy(sig->resp_0[published_rsps].y,
+               y_packed+(i*DENSELY_PACKED_FP_VEC_SIZE),
+               DENSELY_PACKED_FP_VEC_SIZE);
 #if defined(RSDP)
-            pack_fz_vec(sig->resp_0[published_rsps].v_bar, v_bar[i]);
+        pack_fz_vec(sig->resp_0[published_rsps].v_bar, presig->v_bar[i]);
 #elif defined(RSDPG)
-            pack_fz_rsdp_g_vec(sig->resp_0[published_rsps].v_G_bar, v_G_bar[i]);
+        pack_fz_rsdp_g_vec(sig->resp_0[published_rsps].v_G_bar, presig->v_G_bar[i]);
 #endif
-            memcpy(sig->resp_1[published_rsps], &cmt_1[i*HASH_DIGEST_LENGTH], HASH_DIGEST_LENGTH);
-            published_rsps++;
-        }
+        memcpy(sig->resp_1[published_rsps], &presig->cmt_1[i*HASH_DIGEST_LENGTH], HASH_DIGEST_LENGTH);
     }
+    CROSS_PROBE_PHASE_RETURN("pack_responses");
+    /* a second challenge on the same commitments would reveal the secret
+     * key: the presignature does not survive its use */
+    presig_wipe(presig, sizeof(CROSS_presig_t));
+    HASH_STATS_LEAVE(1);
+    return 1;
 }
 
-/* verify returns 1 if signature is ok, 0 otherwise */
-int CROSS_verify(const pk_t *const PK,
-                 const char *const m,
-                 const uint64_t mlen,
-                 const CROSS_sig_t *const sig){
-    CSPRNG_STATE_T csprng_state;
+/* sign cannot fail */
+void CROSS_sign(const sk_t *const SK,
+               const char *const m,
+               const uint64_t mlen,
+               CROSS_sig_t *const sig){
+    CROSS_PROBE_ENTRY(sign);
+    HASH_STATS_ENTER(HASH_STATS_SIGN);
+    CROSS_presig_t presig;
+    CROSS_presign(SK, &presig);
+    CROSS_sign_online(&presig, m, mlen, sig);
+    HASH_STATS_LEAVE(1);
+    CROSS_PROBE_RETURN(sign);
+}
 
-    FP_ELEM V_tr[K][N-K];
+#if defined(VERIFY_EARLY_REJECT)
+/* checks everything in the signature which does not depend on the
+ * recomputed commitments: the zero padding of the seed path, of the Merkle
+ * proof and of the packed responses, and the membership of the responses to
+ * the restricted (sub)group. Returns 1 if all of them pass, 0 otherwise */
+static
+int is_sig_well_formed(const chall_2_t *chall_2,
+                       const CROSS_sig_t *const sig){
+    if(!is_seed_path_padding_ok(chall_2, sig->path) ||
+       !is_tree_proof_padding_ok(sig->proof, chall_2)){
+        return 0;
+    }
+    for(int i = 0; i < T-W; i++){
+        FP_ELEM y[N];
+        if(!unpack_fp_vec(y, sig->resp_0[i].y)){
+            return 0;
+        }
 #if defined(RSDP)
-    expand_pk(V_tr,PK->seed_pk);
+        FZ_ELEM v_bar[N];
+        if(!unpack_fz_vec(v_bar, sig->resp_0[i].v_bar) ||
+           !is_fz_vec_in_restr_group_n(v_bar)){
+            return 0;
+        }
 #elif defined(RSDPG)
-    FZ_ELEM W_mat[M][N-M];
-    expand_pk(V_tr,W_mat,PK->seed_pk);
-#endif
-#if (defined(HIGH_PERFORMANCE_X86_64) && defined(RSDP) )
-    /* Expanded */
-    alignas(EPI8_PER_REG) uint16_t V_tr_avx[K][ROUND_UP(N-K,EPI16_PER_REG)] = {{0}};
-    for(int i = 0; i < K; i++){
-      for (int j = 0; j < N-K; j++){
-         V_tr_avx[i][j] = V_tr[i][j];
-      }
+        FZ_ELEM v_G_bar[M];
+        if(!unpack_fz_rsdp_g_vec(v_G_bar, sig->resp_0[i].v_G_bar) ||
+           !is_fz_vec_in_restr_group_m(v_G_bar)){
+            return 0;
+        }
+#endif
     }
-#elif (defined(HIGH_PERFORMANCE_X86_64) && defined(RSDPG) )
-    alignas(EPI8_PER_REG) FP_DOUBLEPREC V_tr_avx[K][ROUND_UP(N-K,EPI32_PER_REG)] = {{0}};
-    for(int i = 0; i < K; i++){
-      for (int j = 0; j < N-K; j++){
-         V_tr_avx[i][j] = V_tr[i][j];
-      }
+    return 1;
+}
+#endif
+
+/* absorbs cmt_1 and the packed y of the rounds from absorb_pos[0] up to
+ * end_round excluded, in round order: the cmt_1 of rounds with chall_2 == 1
+ * are the recomputed ones, the others come from resp_1. absorb_pos[1] and
+ * absorb_pos[2] track the next cmt_1 of each kind */
+static
+void absorb_rounds(CROSS_verify_state_t *const state,
+                   const int end_round){
+    const uint8_t *const chall_2 = state->chall_2.value;
+    int *const pos = state->absorb_pos;
+    for(; pos[0] < end_round; pos[0]++){
+        const uint8_t *cmt_1_i = (chall_2[pos[0]] == 1) ? state->cmt_1_chall_2_1[pos[1]] :
+                                                          state->sig->resp_1[pos[2]];
+        hash_update(&state->cmt_1_state, cmt_1_i, HASH_DIGEST_LENGTH);
+        pos[1] += chall_2[pos[0]];
+        pos[2] += 1-chall_2[pos[0]];
+
+        uint8_t y_packed[DENSELY_PACKED_FP_VEC_SIZE];
+        pack_fp_vec(y_packed, state->y[pos[0]]);
+        hash_update(&state->y_state, y_packed, DENSELY_PACKED_FP_VEC_SIZE);
     }
+}
+
+/* generates the matrices of EPK from seed_pk */
+static
+void expand_pk_matrices(pk_expanded_t *const EPK,
+                        const uint8_t seed_pk[KEYPAIR_SEED_LENGTH_BYTES]){
+#if defined(RSDP)
+    expand_pk(EPK->V_tr,seed_pk);
+#elif defined(RSDPG)
+    expand_pk(EPK->V_tr,EPK->W_mat,seed_pk);
 #endif
 #if (defined(HIGH_PERFORMANCE_X86_64) && defined(RSDPG) )
-    alignas(EPI8_PER_REG) uint16_t W_mat_avx[M][ROUND_UP(N-M,EPI16_PER_REG)] = {{0}};
+    memset(EPK->W_mat_avx, 0, sizeof(EPK->W_mat_avx));
     for(int i = 0; i < M; i++){
       for (int j = 0; j < N-M; j++){
-         W_mat_avx[i][j] = W_mat[i][j];
+         EPK->W_mat_avx[i][j] = EPK->W_mat[i][j];
       }
     }
 #endif
+}
 
-    FP_ELEM s[N-K];
-    uint8_t is_padd_key_ok;
-    is_padd_key_ok = unpack_fp_syn(s,PK->s);
+int CROSS_pk_expand(pk_expanded_t *const EPK,
+                    const pk_t *const PK){
+    memcpy(&EPK->pk, PK, sizeof(pk_t));
+    expand_pk_matrices(EPK, PK->seed_pk);
+    return unpack_fp_syn(EPK->s, PK->s);
+}
 
+/* the phases of a step-wise verification: the seed tree is rebuilt, the
+ * rounds are verified, the Merkle root is recomputed, in this order */
+#define VERIFY_PHASE_SEED_TREE 0
+#define VERIFY_PHASE_ROUNDS 1
+#define VERIFY_PHASE_MERKLE_ROOT 2
+#define VERIFY_PHASE_DONE 3
+
+/* the nodes of the seed tree resp. of the Merkle tree which a step
+ * computes in place of a round */
+#define VERIFY_NODES_PER_ROUND 16
+
+/* the work preceding the rounds but for the seed tree: the first challenge
+ * is derived, state->EPK, sig, chall_2 and is_padd_key_ok are already set */
+static
+void verify_begin(CROSS_verify_state_t *const state,
+                  const char *const m,
+                  const uint64_t mlen){
+    const CROSS_sig_t *const sig = state->sig;
+    CSPRNG_STATE_T csprng_state;
+
+    CROSS_PROBE_PHASE_ENTRY("chall_1", T);
     uint8_t digest_msg_cmt_salt[2*HASH_DIGEST_LENGTH+SALT_LENGTH_BYTES];
     hash(digest_msg_cmt_salt, (uint8_t*) m, mlen, HASH_DOMAIN_SEP_CONST);
     memcpy(digest_msg_cmt_salt+HASH_DIGEST_LENGTH, sig->digest_cmt, HASH_DIGEST_LENGTH);
     memcpy(digest_msg_cmt_salt+2*HASH_DIGEST_LENGTH, sig->salt, SALT_LENGTH_BYTES);
 
-    uint8_t digest_chall_1[HASH_DIGEST_LENGTH];
-    hash(digest_chall_1,digest_msg_cmt_salt,sizeof(digest_msg_cmt_salt), HASH_DOMAIN_SEP_CONST);
+    hash(state->digest_chall_1,digest_msg_cmt_salt,sizeof(digest_msg_cmt_salt), HASH_DOMAIN_SEP_CONST);
 
     // Domain separation unique for expanding digest_chall_1
     const uint16_t dsc_csprng_chall_1 = CSPRNG_DOMAIN_SEP_CONST + (3*T-1);
-    csprng_initialize(&csprng_state,digest_chall_1,sizeof(digest_chall_1), dsc_csprng_chall_1);
+    csprng_initialize(&csprng_state,state->digest_chall_1,HASH_DIGEST_LENGTH, dsc_csprng_chall_1);
 
-    FP_ELEM chall_1[T];
-    csprng_fp_vec_chall_1(chall_1, &csprng_state);
+    csprng_fp_vec_chall_1_lazy(state->chall_1, &csprng_state);
     /* PQClean-edit: CSPRNG release context */
     csprng_release(&csprng_state);
+    CROSS_PROBE_PHASE_RETURN("chall_1");
 
-    uint8_t chall_2[T]={0};
-    expand_digest_to_fixed_weight(chall_2,sig->digest_chall_2);
-
-    uint8_t is_stree_padding_ok = 0;
+    memset(state->round_seeds, 0, sizeof(state->round_seeds));
 #if defined(NO_TREES)
-    uint8_t round_seeds[T*SEED_LENGTH_BYTES] = {0};
-    is_stree_padding_ok = rebuild_leaves(round_seeds,chall_2,sig->path);
+    CROSS_PROBE_PHASE_ENTRY("seed_tree", T);
+    state->is_stree_padding_ok = rebuild_leaves(state->round_seeds,&state->chall_2,sig->path);
+    CROSS_PROBE_PHASE_RETURN("seed_tree");
+    state->phase = VERIFY_PHASE_ROUNDS;
+#else
+    /* the seed tree is rebuilt by the steps */
+    memset(state->tree.seed, 0, sizeof(state->tree.seed));
+    rebuild_tree_init(&state->seed_tree_rebuild, &state->chall_2);
+    state->phase = VERIFY_PHASE_SEED_TREE;
+#endif
+
+    /* the rounds are processed split by challenge bit, following the
+     * lists in chall_2, so that each of the two passes runs the same
+     * computation on all four lanes */
+    state->next_chall_2_1 = 0;
+    state->next_chall_2_0 = 0;
+
+    memset(state->cmt_0, 0, sizeof(state->cmt_0));
+    hash_init(&state->cmt_1_state);
+    hash_init(&state->y_state);
+    memset(state->absorb_pos, 0, sizeof(state->absorb_pos));
+    state->is_signature_ok = 1;
+    state->is_packed_padd_ok = 1;
+}
+
+/* next batch of at most four, and at most max_rounds, rounds with
+ * chall_2 == 1: expand the revealed seeds, recompute y and cmt_1. Returns
+ * the number of rounds processed */
+static
+int verify_batch_chall_2_1(CROSS_verify_state_t *const state,
+                           const int max_rounds){
+    const CROSS_sig_t *const sig = state->sig;
+#if (defined(HIGH_PERFORMANCE_X86_64) && defined(RSDPG) )
+    uint16_t (*W_mat_avx)[ROUND_UP(N-M,EPI16_PER_REG)] = (uint16_t (*)[ROUND_UP(N-M,EPI16_PER_REG)]) state->EPK->W_mat_avx;
+#elif defined(RSDPG)
+    FZ_ELEM (*W_mat)[N-M] = (FZ_ELEM (*)[N-M]) state->EPK->W_mat;
+#endif
+    const int base = state->next_chall_2_1;
+    int par_level = W-base;
+    par_level = (par_level < 4) ? par_level : 4;
+    par_level = (par_level < max_rounds) ? par_level : max_rounds;
+
+    uint8_t cmt_1_i_input[4][SEED_LENGTH_BYTES+SALT_LENGTH_BYTES];
+    uint16_t cmt_1_i_input_dsc[4];
+
+    /* CSPRNG is fed with concat(seed,salt,round index) represented
+     * as a 2 bytes little endian unsigned integer */
+    uint8_t csprng_input[4][CSPRNG_INPUT_LENGTH];
+    uint16_t domain_sep_csprng[4];
+    int round_idx[4];
+    for(int l = 0; l < 4; l++){
+        /* unused lanes alias the first one, they are ignored */
+        uint16_t i = state->chall_2.rounds_1[base + ((l < par_level) ? l : 0)];
+        round_idx[l] = i;
+        memcpy(csprng_input[l],state->round_seeds+SEED_LENGTH_BYTES*i,SEED_LENGTH_BYTES);
+        memcpy(csprng_input[l]+SEED_LENGTH_BYTES,sig->salt,SALT_LENGTH_BYTES);
+        domain_sep_csprng[l] = CSPRNG_DOMAIN_SEP_CONST + i + (2*T-1);
+
+        /* cmt_1_i_input is concat(seed,salt,round index) */
+        memcpy(cmt_1_i_input[l],
+               state->round_seeds+SEED_LENGTH_BYTES*i,
+               SEED_LENGTH_BYTES);
+        memcpy(cmt_1_i_input[l]+SEED_LENGTH_BYTES, sig->salt, SALT_LENGTH_BYTES);
+        cmt_1_i_input_dsc[l] = HASH_DOMAIN_SEP_CONST + i + (2*T-1);
+    }
+
+    /* expand seed[i] into seed_e and seed_u, squeezing the material for
+     * e_bar_prime resp. e_G_bar_prime first, then the one for u_prime */
+#if defined(RSDP)
+    uint8_t e_buf[4][CSPRNG_FZ_VEC_BYTES];
+#elif defined(RSDPG)
+    uint8_t e_buf[4][CSPRNG_FZ_INF_W_BYTES];
+#endif
+    uint8_t u_buf[4][CSPRNG_FP_VEC_BYTES];
+    PAR_CSPRNG_STATE_T par_csprng_state;
+    HASH_STATS_PAR(HASH_STATS_SITE_VERIFY_ROUND_SEEDS, par_level);
+    csprng_initialize_par(par_level, &par_csprng_state,
+                          csprng_input[0], csprng_input[1],
+                          csprng_input[2], csprng_input[3],
+                          CSPRNG_INPUT_LENGTH,
+                          domain_sep_csprng[0], domain_sep_csprng[1],
+                          domain_sep_csprng[2], domain_sep_csprng[3]);
+    csprng_randombytes_par(par_level, &par_csprng_state,
+                           e_buf[0], e_buf[1], e_buf[2], e_buf[3],
+                           sizeof(e_buf[0]));
+    csprng_randombytes_par(par_level, &par_csprng_state,
+                           u_buf[0], u_buf[1], u_buf[2], u_buf[3],
+                           sizeof(u_buf[0]));
+    /* PQClean-edit: CSPRNG release context */
+    csprng_release_par(par_level, &par_csprng_state);
+
+    for(int l = 0; l < par_level; l++){
+        FZ_ELEM e_bar_prime[N];
+#if defined(RSDP)
+        csprng_fz_vec_from_buffer(e_bar_prime, e_buf[l]);
+#elif defined(RSDPG)
+        FZ_ELEM e_G_bar_prime[M];
+        csprng_fz_inf_w_from_buffer(e_G_bar_prime, e_buf[l]);
+#if defined(HIGH_PERFORMANCE_X86_64)
+        fz_inf_w_by_fz_matrix(e_bar_prime, e_G_bar_prime, W_mat_avx);
 #else
-    uint8_t seed_tree[SEED_LENGTH_BYTES*NUM_NODES_SEED_TREE] = {0};
-    is_stree_padding_ok = rebuild_tree(seed_tree, chall_2, sig->path, sig->salt);
+        fz_inf_w_by_fz_matrix(e_bar_prime, e_G_bar_prime, W_mat);
+#endif
+        fz_dz_norm_n(e_bar_prime);
+#endif
+        FP_ELEM u_prime[N];
+        csprng_fp_vec_from_buffer(u_prime, u_buf[l]);
+        fp_vec_by_restr_vec_scaled(state->y[round_idx[l]],
+                                   e_bar_prime,
+                                   state->chall_1[round_idx[l]],
+                                   u_prime);
+    }
 
-    unsigned char round_seeds[T*SEED_LENGTH_BYTES] = {0};
-    seed_leaves(round_seeds, seed_tree);
+    /* unused lanes alias the first one as well */
+    int out_idx[4];
+    for(int l = 0; l < 4; l++){
+        out_idx[l] = base + ((l < par_level) ? l : 0);
+    }
+    HASH_STATS_PAR(HASH_STATS_SITE_VERIFY_CMT_1, par_level);
+    hash_par(
+        par_level,
+        state->cmt_1_chall_2_1[out_idx[0]],
+        state->cmt_1_chall_2_1[out_idx[1]],
+        state->cmt_1_chall_2_1[out_idx[2]],
+        state->cmt_1_chall_2_1[out_idx[3]],
+        cmt_1_i_input[0],
+        cmt_1_i_input[1],
+        cmt_1_i_input[2],
+        cmt_1_i_input[3],
+        sizeof(cmt_1_i_input)/4,
+        cmt_1_i_input_dsc[0],
+        cmt_1_i_input_dsc[1],
+        cmt_1_i_input_dsc[2],
+        cmt_1_i_input_dsc[3]
+    );
+    state->next_chall_2_1 += par_level;
+    return par_level;
+}
+
+/* next batch of at most four, and at most max_rounds, rounds with
+ * chall_2 == 0: unpack the responses, recompute cmt_0. The responses are
+ * stored in round order, so the j-th of these rounds employs resp_0[j] and
+ * resp_1[j]. Along with each batch, cmt_1 and y are absorbed into their
+ * digests in round order, up to the last round of the batch, or of all the
+ * rounds after the last batch: all the rounds with chall_2 == 1 are
+ * processed before. Returns the number of rounds processed */
+static
+int verify_batch_chall_2_0(CROSS_verify_state_t *const state,
+                           const int max_rounds){
+    const CROSS_sig_t *const sig = state->sig;
+
+    /* the arithmetic takes the matrices as non-const, they are only read */
+    V_TR_ELEM (*V_tr)[V_TR_COLS] = (V_TR_ELEM (*)[V_TR_COLS]) state->EPK->V_tr;
+#if (defined(HIGH_PERFORMANCE_X86_64) && defined(RSDPG) )
+    uint16_t (*W_mat_avx)[ROUND_UP(N-M,EPI16_PER_REG)] = (uint16_t (*)[ROUND_UP(N-M,EPI16_PER_REG)]) state->EPK->W_mat_avx;
+#elif defined(RSDPG)
+    FZ_ELEM (*W_mat)[N-M] = (FZ_ELEM (*)[N-M]) state->EPK->W_mat;
 #endif
+    const FP_ELEM *s = state->EPK->s;
+
+    const int base = state->next_chall_2_0;
+    int par_level = (T-W)-base;
+    par_level = (par_level < 4) ? par_level : 4;
+    par_level = (par_level < max_rounds) ? par_level : max_rounds;
 
 #if defined(RSDP)
     uint8_t cmt_0_i_input[4][DENSELY_PACKED_FP_SYN_SIZE+
@@ -585,219 +1081,277 @@ int CROSS_verify(const pk_t *const PK,
     const int offset_salt = DENSELY_PACKED_FP_SYN_SIZE+DENSELY_PACKED_FZ_RSDP_G_VEC_SIZE;
 #endif
 
-    uint8_t cmt_1_i_input[4][SEED_LENGTH_BYTES+SALT_LENGTH_BYTES];
-    uint16_t cmt_1_i_input_dsc[4];
-
-    /* place the salt in the hash input for all parallel instances of keccak */
-    for(int instance=0; instance<4; instance++) {
-      /* cmt_0_i_input is syndrome|| v_bar resp. v_G_bar ||salt */
-      memcpy(cmt_0_i_input[instance]+offset_salt, sig->salt, SALT_LENGTH_BYTES);
-      /* cmt_1_i_input is concat(seed,salt,round index) */
-      memcpy(cmt_1_i_input[instance]+SEED_LENGTH_BYTES, sig->salt, SALT_LENGTH_BYTES);
-    }
-
-    uint8_t cmt_0[T][HASH_DIGEST_LENGTH] = {0};
-    uint8_t cmt_1[T*HASH_DIGEST_LENGTH] = {0};
-
-    FZ_ELEM e_bar_prime[N];
-    FP_ELEM u_prime[N];
-
     FP_ELEM y_prime[N] = {0};
     FP_ELEM y_prime_H[N-K] = {0};
     FP_ELEM s_prime[N-K] = {0};
 
-    FP_ELEM y[T][N];
-
-    /* enqueue the calls to hash */
-    int to_hash_cmt_1 = 0;
-    int to_hash_cmt_0 = 0;
-    int round_idx_queue_cmt_1[4] = {0};
-    int round_idx_queue_cmt_0[4] = {0};
-
-    int used_rsps = 0;
-    int is_signature_ok = 1;
-    uint8_t is_packed_padd_ok = 1;
-    for(uint16_t i = 0; i< T; i++){
-
-        uint16_t domain_sep_csprng = CSPRNG_DOMAIN_SEP_CONST + i + (2*T-1);
-        uint16_t domain_sep_hash = HASH_DOMAIN_SEP_CONST + i + (2*T-1);
-
-        if(chall_2[i] == 1){
-
-            /* save the index for the hash output */
-            to_hash_cmt_1++;
-            round_idx_queue_cmt_1[to_hash_cmt_1-1] = i;
-
-            memcpy(cmt_1_i_input[to_hash_cmt_1-1],
-                   round_seeds+SEED_LENGTH_BYTES*i,
-                   SEED_LENGTH_BYTES);
+    int round_idx[4];
+    for(int l = 0; l < 4; l++){
+        /* unused lanes alias the first one, they are ignored */
+        round_idx[l] = state->chall_2.rounds_0[base + ((l < par_level) ? l : 0)];
+        /* cmt_0_i_input is syndrome|| v_bar resp. v_G_bar ||salt */
+        memcpy(cmt_0_i_input[l]+offset_salt, sig->salt, SALT_LENGTH_BYTES);
+    }
 
-            cmt_1_i_input_dsc[to_hash_cmt_1-1] = domain_sep_hash;
+    for(int l = 0; l < par_level; l++){
+        int used_rsps = base + l;
+        uint16_t i = round_idx[l];
 
-            /* CSPRNG is fed with concat(seed,salt,round index) represented
-            * as a 2 bytes little endian unsigned integer */
-            uint8_t csprng_input[CSPRNG_INPUT_LENGTH];
-            memcpy(csprng_input+SEED_LENGTH_BYTES,sig->salt,SALT_LENGTH_BYTES);
-            memcpy(csprng_input,round_seeds+SEED_LENGTH_BYTES*i,SEED_LENGTH_BYTES);
+        /* liboqs-edit: separate && operands to avoid "garbage value" in clang static analyzer (scan-build) and valgrind */
+        uint8_t is_packed_padd_y_ok = unpack_fp_vec(state->y[i], sig->resp_0[used_rsps].y);
+        state->is_packed_padd_ok = state->is_packed_padd_ok && is_packed_padd_y_ok;
 
-            /* expand seed[i] into seed_e and seed_u */
-            csprng_initialize(&csprng_state, csprng_input,CSPRNG_INPUT_LENGTH, domain_sep_csprng);
-#if defined(RSDP)
-            /* expand e_bar_prime */
-            csprng_fz_vec(e_bar_prime, &csprng_state);
-#elif defined(RSDPG)
-            FZ_ELEM e_G_bar_prime[M];
-            csprng_fz_inf_w(e_G_bar_prime, &csprng_state);
-#if defined(HIGH_PERFORMANCE_X86_64)
-            fz_inf_w_by_fz_matrix(e_bar_prime, e_G_bar_prime, W_mat_avx);
-#else
-            fz_inf_w_by_fz_matrix(e_bar_prime, e_G_bar_prime, W_mat);
-#endif
-            fz_dz_norm_n(e_bar_prime);
-#endif
-            /* expand u_prime */
-            csprng_fp_vec(u_prime, &csprng_state);
-            /* PQClean-edit: CSPRNG release context */
-            csprng_release(&csprng_state);
-            fp_vec_by_restr_vec_scaled(y[i],
-                                       e_bar_prime,
-                                       chall_1[i],
-                                       u_prime);
-            fp_dz_norm(y[i]);
-        } else {
-
-            /* save the index for the hash output */
-            to_hash_cmt_0++;
-            round_idx_queue_cmt_0[to_hash_cmt_0-1] = i;
-
-            /* place y[i] in the buffer for later on hashing */
-            /* liboqs-edit: separate && operands to avoid "garbage value" in clang static analyzer (scan-build) and valgrind */
-            uint8_t is_packed_padd_y_ok = unpack_fp_vec(y[i], sig->resp_0[used_rsps].y);
-            is_packed_padd_ok = is_packed_padd_ok && is_packed_padd_y_ok;
-
-            FZ_ELEM v_bar[N];
+        FZ_ELEM v_bar[N];
 #if defined(RSDP)
-            /*v_bar is memcpy'ed directly into cmt_0 input buffer */
-            FZ_ELEM* v_bar_ptr = cmt_0_i_input[to_hash_cmt_0-1]+DENSELY_PACKED_FP_SYN_SIZE;
-            /* liboqs-edit: separate && operands to avoid "garbage value" in clang static analyzer (scan-build) and valgrind */
-            uint8_t is_packed_padd_v_bar_ok = unpack_fz_vec(v_bar, sig->resp_0[used_rsps].v_bar);
-            is_packed_padd_ok = is_packed_padd_ok && is_packed_padd_v_bar_ok;
-            memcpy(v_bar_ptr,
-                   &sig->resp_0[used_rsps].v_bar,
-                   DENSELY_PACKED_FZ_VEC_SIZE);
-            is_signature_ok = is_signature_ok &&
-                              is_fz_vec_in_restr_group_n(v_bar);
+        /*v_bar is memcpy'ed directly into cmt_0 input buffer */
+        FZ_ELEM* v_bar_ptr = cmt_0_i_input[l]+DENSELY_PACKED_FP_SYN_SIZE;
+        /* liboqs-edit: separate && operands to avoid "garbage value" in clang static analyzer (scan-build) and valgrind */
+        uint8_t is_packed_padd_v_bar_ok = unpack_fz_vec(v_bar, sig->resp_0[used_rsps].v_bar);
+        state->is_packed_padd_ok = state->is_packed_padd_ok && is_packed_padd_v_bar_ok;
+        memcpy(v_bar_ptr,
+               &sig->resp_0[used_rsps].v_bar,
+               DENSELY_PACKED_FZ_VEC_SIZE);
+        state->is_signature_ok = state->is_signature_ok &&
+                                 is_fz_vec_in_restr_group_n(v_bar);
 #elif defined(RSDPG)
-            /*v_G_bar is memcpy'ed directly into cmt_0 input buffer */
-            FZ_ELEM* v_G_bar_ptr = cmt_0_i_input[to_hash_cmt_0-1]+DENSELY_PACKED_FP_SYN_SIZE;
-            memcpy(v_G_bar_ptr,
-                   &sig->resp_0[used_rsps].v_G_bar,
-                   DENSELY_PACKED_FZ_RSDP_G_VEC_SIZE);
-            FZ_ELEM v_G_bar[M];
-            /* liboqs-edit: separate && operands to avoid "garbage value" in clang static analyzer (scan-build) and valgrind */
-            uint8_t is_packed_padd_v_G_bar_ok = unpack_fz_rsdp_g_vec(v_G_bar, sig->resp_0[used_rsps].v_G_bar);
-            is_packed_padd_ok = is_packed_padd_ok && is_packed_padd_v_G_bar_ok;
-            is_signature_ok = is_signature_ok &&
-                              is_fz_vec_in_restr_group_m(v_G_bar);
+        /*v_G_bar is memcpy'ed directly into cmt_0 input buffer */
+        FZ_ELEM* v_G_bar_ptr = cmt_0_i_input[l]+DENSELY_PACKED_FP_SYN_SIZE;
+        memcpy(v_G_bar_ptr,
+               &sig->resp_0[used_rsps].v_G_bar,
+               DENSELY_PACKED_FZ_RSDP_G_VEC_SIZE);
+        FZ_ELEM v_G_bar[M];
+        /* liboqs-edit: separate && operands to avoid "garbage value" in clang static analyzer (scan-build) and valgrind */
+        uint8_t is_packed_padd_v_G_bar_ok = unpack_fz_rsdp_g_vec(v_G_bar, sig->resp_0[used_rsps].v_G_bar);
+        state->is_packed_padd_ok = state->is_packed_padd_ok && is_packed_padd_v_G_bar_ok;
+        state->is_signature_ok = state->is_signature_ok &&
+                                 is_fz_vec_in_restr_group_m(v_G_bar);
 #if defined(HIGH_PERFORMANCE_X86_64)
-            fz_inf_w_by_fz_matrix(v_bar, v_G_bar, W_mat_avx);
+        fz_inf_w_by_fz_matrix(v_bar, v_G_bar, W_mat_avx);
 #else
-            fz_inf_w_by_fz_matrix(v_bar, v_G_bar, W_mat);
+        fz_inf_w_by_fz_matrix(v_bar, v_G_bar, W_mat);
 #endif
 
 #endif
-            memcpy(&cmt_1[i*HASH_DIGEST_LENGTH], sig->resp_1[used_rsps], HASH_DIGEST_LENGTH);
-            used_rsps++;
+        restr_by_fp_vec_pointwise(y_prime, v_bar, state->y[i]);
+        fp_vec_by_fp_matrix(y_prime_H, y_prime, V_tr);
+        fp_synd_minus_fp_vec_scaled(s_prime,
+                                    y_prime_H,
+                                    state->chall_1[i],
+                                    s);
+        pack_fp_syn(cmt_0_i_input[l],s_prime);
+        cmt_0_i_input_dsc[l] = HASH_DOMAIN_SEP_CONST + i + (2*T-1);
+    }
+
+    HASH_STATS_PAR(HASH_STATS_SITE_VERIFY_CMT_0, par_level);
+    hash_par(
+        par_level,
+        state->cmt_0[round_idx[0]],
+        state->cmt_0[round_idx[1]],
+        state->cmt_0[round_idx[2]],
+        state->cmt_0[round_idx[3]],
+        cmt_0_i_input[0],
+        cmt_0_i_input[1],
+        cmt_0_i_input[2],
+        cmt_0_i_input[3],
+        sizeof(cmt_0_i_input)/4,
+        cmt_0_i_input_dsc[0],
+        cmt_0_i_input_dsc[1],
+        cmt_0_i_input_dsc[2],
+        cmt_0_i_input_dsc[3]
+    );
+    state->next_chall_2_0 += par_level;
+    absorb_rounds(state, (state->next_chall_2_0 == T-W) ? T : round_idx[par_level-1]+1);
+    return par_level;
+}
 
-            FP_ELEM v[N];
-            convert_restr_vec_to_fp(v, v_bar);
-            fp_vec_by_fp_vec_pointwise(y_prime, v, y[i]);
-#if (defined(HIGH_PERFORMANCE_X86_64))
-            fp_vec_by_fp_matrix(y_prime_H, y_prime, V_tr_avx);
-            #else
-            fp_vec_by_fp_matrix(y_prime_H, y_prime ,V_tr);
+void CROSS_verify_start(CROSS_verify_state_t *const state,
+                        const pk_t *const PK,
+                        const char *const m,
+                        const uint64_t mlen,
+                        const CROSS_sig_t *const sig){
+    HASH_STATS_ENTER(HASH_STATS_VERIFY);
+    pk_expanded_t *const pk_expanded = &state->pk_expanded;
+    state->EPK = pk_expanded;
+    state->sig = sig;
+    state->is_ended = 0;
+    state->is_padd_key_ok = unpack_fp_syn(pk_expanded->s,PK->s);
+
+    CROSS_PROBE_PHASE_ENTRY("chall_2", T);
+    expand_digest_to_chall_2(&state->chall_2,sig->digest_chall_2);
+    CROSS_PROBE_PHASE_RETURN("chall_2");
+
+#if defined(VERIFY_EARLY_REJECT)
+    /* the public key and the signature are public: malformed ones are
+     * rejected before any of the expensive work is done */
+    if(!state->is_padd_key_ok || !is_sig_well_formed(&state->chall_2, sig)){
+        state->is_ended = 1;
+        HASH_STATS_LEAVE(0);
+        return;
+    }
 #endif
-            fp_dz_norm_synd(y_prime_H);
-            fp_synd_minus_fp_vec_scaled(s_prime,
-                                        y_prime_H,
-                                        chall_1[i],
-                                        s);
-            fp_dz_norm_synd(s_prime);
-            pack_fp_syn(cmt_0_i_input[to_hash_cmt_0-1],s_prime);
-            cmt_0_i_input_dsc[to_hash_cmt_0-1] = domain_sep_hash;
 
-        }
+    /* with PK_CACHE, the matrices of a recently seen seed_pk are copied out
+     * of the cache instead of being expanded again */
+    CROSS_PROBE_PHASE_ENTRY("expand_key", 0);
+    if(!pk_cache_lookup(PK->seed_pk, pk_expanded, PK_EXPANDED_MATRICES_BYTES)){
+        expand_pk_matrices(pk_expanded, PK->seed_pk);
+        pk_cache_insert(PK->seed_pk, pk_expanded, PK_EXPANDED_MATRICES_BYTES);
+    }
+    CROSS_PROBE_PHASE_RETURN("expand_key");
+    verify_begin(state, m, mlen);
+    HASH_STATS_LEAVE(0);
+}
 
-        /* hash commitment 1 in batches of 4 (or less on the last round) */
-        if(to_hash_cmt_1 == 4 || i == T-1){
-            hash_par(
-                to_hash_cmt_1,
-                &cmt_1[round_idx_queue_cmt_1[0]*HASH_DIGEST_LENGTH],
-                &cmt_1[round_idx_queue_cmt_1[1]*HASH_DIGEST_LENGTH],
-                &cmt_1[round_idx_queue_cmt_1[2]*HASH_DIGEST_LENGTH],
-                &cmt_1[round_idx_queue_cmt_1[3]*HASH_DIGEST_LENGTH],
-                cmt_1_i_input[0],
-                cmt_1_i_input[1],
-                cmt_1_i_input[2],
-                cmt_1_i_input[3],
-                sizeof(cmt_1_i_input)/4,
-                cmt_1_i_input_dsc[0],
-                cmt_1_i_input_dsc[1],
-                cmt_1_i_input_dsc[2],
-                cmt_1_i_input_dsc[3]
-            );
-            to_hash_cmt_1 = 0;
-        }
-        /* hash commitment 0 in batches of 4 (or less on the last round) */
-        if(to_hash_cmt_0 == 4 || i == T-1){
-            hash_par(
-                to_hash_cmt_0,
-                cmt_0[round_idx_queue_cmt_0[0]],
-                cmt_0[round_idx_queue_cmt_0[1]],
-                cmt_0[round_idx_queue_cmt_0[2]],
-                cmt_0[round_idx_queue_cmt_0[3]],
-                cmt_0_i_input[0],
-                cmt_0_i_input[1],
-                cmt_0_i_input[2],
-                cmt_0_i_input[3],
-                sizeof(cmt_0_i_input)/4,
-                cmt_0_i_input_dsc[0],
-                cmt_0_i_input_dsc[1],
-                cmt_0_i_input_dsc[2],
-                cmt_0_i_input_dsc[3]
-            );
-            to_hash_cmt_0 = 0;
+void CROSS_verify_start_expanded(CROSS_verify_state_t *const state,
+                                 const pk_expanded_t *const EPK,
+                                 const char *const m,
+                                 const uint64_t mlen,
+                                 const CROSS_sig_t *const sig){
+    HASH_STATS_ENTER(HASH_STATS_VERIFY);
+    state->EPK = EPK;
+    state->sig = sig;
+    state->is_ended = 0;
+    /* the padding of the key was checked by CROSS_pk_expand */
+    state->is_padd_key_ok = 1;
+
+    CROSS_PROBE_PHASE_ENTRY("chall_2", T);
+    expand_digest_to_chall_2(&state->chall_2,sig->digest_chall_2);
+    CROSS_PROBE_PHASE_RETURN("chall_2");
+
+#if defined(VERIFY_EARLY_REJECT)
+    if(!is_sig_well_formed(&state->chall_2, sig)){
+        state->is_ended = 1;
+        HASH_STATS_LEAVE(0);
+        return;
+    }
+#endif
+    verify_begin(state, m, mlen);
+    HASH_STATS_LEAVE(0);
+}
 
+/* a round, VERIFY_NODES_PER_ROUND nodes of the seed tree or of the Merkle
+ * tree take one unit of the budget each. The rounds are processed in
+ * batches of four, a batch is shrunk to fit a budget smaller than that */
+int CROSS_verify_step(CROSS_verify_state_t *const state,
+                      unsigned int budget_rounds){
+    if(state->is_ended){
+        return 1;
+    }
+    HASH_STATS_ENTER(HASH_STATS_VERIFY);
+    const CROSS_sig_t *const sig = state->sig;
+#if !defined(NO_TREES)
+    if(state->phase == VERIFY_PHASE_SEED_TREE && budget_rounds > 0){
+        CROSS_PROBE_PHASE_ENTRY("seed_tree", T);
+        int is_rebuilt = 0;
+        while(!is_rebuilt && budget_rounds > 0){
+            is_rebuilt = rebuild_tree_step(&state->seed_tree_rebuild,
+                                           state->tree.seed,
+                                           sig->path,
+                                           sig->salt,
+                                           VERIFY_NODES_PER_ROUND);
+            budget_rounds--;
+        }
+        if(is_rebuilt){
+            state->is_stree_padding_ok = rebuild_tree_finish(&state->seed_tree_rebuild, sig->path);
+            seed_leaves(state->round_seeds, state->tree.seed);
+            state->phase = VERIFY_PHASE_ROUNDS;
+        }
+        CROSS_PROBE_PHASE_RETURN("seed_tree");
+    }
+#endif
+    if(state->phase == VERIFY_PHASE_ROUNDS && budget_rounds > 0){
+        /* the rounds this step will verify */
+        CROSS_PROBE_PHASE_ENTRY("rounds",
+            ((unsigned int) (T-state->next_chall_2_1-state->next_chall_2_0) < budget_rounds) ?
+            (unsigned int) (T-state->next_chall_2_1-state->next_chall_2_0) : budget_rounds);
+        while(state->next_chall_2_1 < W && budget_rounds > 0){
+            int budget = (budget_rounds < 4) ? (int) budget_rounds : 4;
+            budget_rounds -= verify_batch_chall_2_1(state, budget);
         }
+        while(state->next_chall_2_0 < (T-W) && budget_rounds > 0){
+            int budget = (budget_rounds < 4) ? (int) budget_rounds : 4;
+            budget_rounds -= verify_batch_chall_2_0(state, budget);
+        }
+        CROSS_PROBE_PHASE_RETURN("rounds");
+        if(state->next_chall_2_0 == (T-W)){
+#if !defined(NO_TREES)
+            recompute_root_init(&state->merkle_recompute,
+                                state->tree.merkle,
+                                state->cmt_0,
+                                &state->chall_2);
+#endif
+            state->phase = VERIFY_PHASE_MERKLE_ROOT;
+        }
+    }
+    if(state->phase == VERIFY_PHASE_MERKLE_ROOT && budget_rounds > 0){
+        CROSS_PROBE_PHASE_ENTRY("merkle_root", T);
+#if defined(NO_TREES)
+        /* the root of the leaves alone is not worth splitting */
+        state->is_mtree_padding_ok = recompute_root(state->merkle_root,
+                                                    state->cmt_0,
+                                                    sig->proof,
+                                                    &state->chall_2);
+        state->phase = VERIFY_PHASE_DONE;
+#else
+        int is_recomputed = 0;
+        while(!is_recomputed && budget_rounds > 0){
+            is_recomputed = recompute_root_step(&state->merkle_recompute,
+                                                state->tree.merkle,
+                                                sig->proof,
+                                                VERIFY_NODES_PER_ROUND);
+            budget_rounds--;
+        }
+        if(is_recomputed){
+            state->is_mtree_padding_ok = recompute_root_finish(&state->merkle_recompute,
+                                                               state->merkle_root,
+                                                               state->tree.merkle,
+                                                               sig->proof);
+            state->phase = VERIFY_PHASE_DONE;
+        }
+#endif
+        CROSS_PROBE_PHASE_RETURN("merkle_root");
+    }
+    HASH_STATS_LEAVE(0);
+    return state->phase == VERIFY_PHASE_DONE;
+}
 
-    } /* end for iterating on ZKID iterations */
+void CROSS_verify_abort(CROSS_verify_state_t *const state){
+    if(state->is_ended){
+        return;
+    }
+    hash_release(&state->cmt_1_state);
+    hash_release(&state->y_state);
+    state->is_ended = 1;
+}
+
+int CROSS_verify_finish(CROSS_verify_state_t *const state){
+    HASH_STATS_ENTER(HASH_STATS_VERIFY);
+    /* the work left is never done here, the signature is rejected instead */
+    if(state->is_ended || state->phase != VERIFY_PHASE_DONE){
+        CROSS_verify_abort(state);
+        HASH_STATS_LEAVE(1);
+        return 0;
+    }
+
+    const CROSS_sig_t *const sig = state->sig;
+    int is_signature_ok = state->is_signature_ok;
 
     #ifndef SKIP_ASSERT
     assert(is_signature_ok);
     #endif
 
     uint8_t digest_cmt0_cmt1[2*HASH_DIGEST_LENGTH];
-
-    uint8_t is_mtree_padding_ok = recompute_root(digest_cmt0_cmt1,
-                                    cmt_0,
-                                    sig->proof,
-                                    chall_2);
-    hash(&digest_cmt0_cmt1[HASH_DIGEST_LENGTH], cmt_1, sizeof(cmt_1), HASH_DOMAIN_SEP_CONST);
+    memcpy(digest_cmt0_cmt1, state->merkle_root, HASH_DIGEST_LENGTH);
+    hash_final(&digest_cmt0_cmt1[HASH_DIGEST_LENGTH], &state->cmt_1_state, HASH_DOMAIN_SEP_CONST);
 
     uint8_t digest_cmt_prime[HASH_DIGEST_LENGTH];
     hash(digest_cmt_prime,digest_cmt0_cmt1,sizeof(digest_cmt0_cmt1), HASH_DOMAIN_SEP_CONST);
 
-
-    uint8_t y_digest_chall_1[T*DENSELY_PACKED_FP_VEC_SIZE+HASH_DIGEST_LENGTH];
-
-    for(int x = 0; x < T; x++){
-        pack_fp_vec(y_digest_chall_1+(x*DENSELY_PACKED_FP_VEC_SIZE),y[x]);
-    }
-    memcpy(y_digest_chall_1+T*DENSELY_PACKED_FP_VEC_SIZE,digest_chall_1,HASH_DIGEST_LENGTH);
-
+    /* the packed y of all the rounds are already absorbed */
     uint8_t digest_chall_2_prime[HASH_DIGEST_LENGTH];
-    hash(digest_chall_2_prime, y_digest_chall_1, sizeof(y_digest_chall_1), HASH_DOMAIN_SEP_CONST);
-
+    hash_update(&state->y_state, state->digest_chall_1, HASH_DIGEST_LENGTH);
+    hash_final(digest_chall_2_prime, &state->y_state, HASH_DOMAIN_SEP_CONST);
+    state->is_ended = 1;
 
     int does_digest_cmt_match = ( memcmp(digest_cmt_prime,
                                         sig->digest_cmt,
@@ -816,9 +1370,43 @@ int CROSS_verify(const pk_t *const PK,
     is_signature_ok = is_signature_ok &&
                       does_digest_cmt_match &&
                       does_digest_chall_2_match && 
-                      is_mtree_padding_ok &&
-                      is_stree_padding_ok &&
-                      is_padd_key_ok &&
-                      is_packed_padd_ok;
+                      state->is_mtree_padding_ok &&
+                      state->is_stree_padding_ok &&
+                      state->is_padd_key_ok &&
+                      state->is_packed_padd_ok;
+    HASH_STATS_LEAVE(1);
+    return is_signature_ok;
+}
+
+/* verify returns 1 if signature is ok, 0 otherwise */
+int CROSS_verify(const pk_t *const PK,
+                 const char *const m,
+                 const uint64_t mlen,
+                 const CROSS_sig_t *const sig){
+    CROSS_PROBE_ENTRY(verify);
+    HASH_STATS_ENTER(HASH_STATS_VERIFY);
+    CROSS_verify_state_t state;
+    CROSS_verify_start(&state, PK, m, mlen, sig);
+    while(!CROSS_verify_step(&state, T)){
+    }
+    int is_signature_ok = CROSS_verify_finish(&state);
+    HASH_STATS_LEAVE(1);
+    CROSS_PROBE_RETURN_VALUE(verify, is_signature_ok);
+    return is_signature_ok;
+}
+
+int CROSS_verify_expanded(const pk_expanded_t *const EPK,
+                          const char *const m,
+                          const uint64_t mlen,
+                          const CROSS_sig_t *const sig){
+    CROSS_PROBE_ENTRY(verify);
+    HASH_STATS_ENTER(HASH_STATS_VERIFY);
+    CROSS_verify_state_t state;
+    CROSS_verify_start_expanded(&state, EPK, m, mlen, sig);
+    while(!CROSS_verify_step(&state, T)){
+    }
+    int is_signature_ok = CROSS_verify_finish(&state);
+    HASH_STATS_LEAVE(1);
+    CROSS_PROBE_RETURN_VALUE(verify, is_signature_ok);
     return is_signature_ok;
 }
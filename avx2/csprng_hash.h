@@ -31,10 +31,25 @@
 
 #pragma once
 
+#include "architecture_detect.h"
 #include "namespace.h"
 #include "parameters.h"
 #include "sha3.h"
 
+/* The transposed matrix V_tr is expanded directly in the layout employed by
+ * fp_vec_by_fp_matrix: in the AVX2 implementation, rows are widened to the
+ * lane size and zero-padded to a whole number of registers */
+#if (defined(HIGH_PERFORMANCE_X86_64) && defined(RSDP) )
+#define V_TR_ELEM uint16_t
+#define V_TR_COLS ROUND_UP(N-K,EPI16_PER_REG)
+#elif (defined(HIGH_PERFORMANCE_X86_64) && defined(RSDPG) )
+#define V_TR_ELEM FP_DOUBLEPREC
+#define V_TR_COLS ROUND_UP(N-K,EPI32_PER_REG)
+#else
+#define V_TR_ELEM FP_ELEM
+#define V_TR_COLS (N-K)
+#endif
+
 /************************* CSPRNG ********************************/
 
 #define CSPRNG_STATE_T SHAKE_STATE_STRUCT
@@ -234,6 +249,42 @@ void hash(uint8_t digest[HASH_DIGEST_LENGTH],
    xof_shake_release(&csprng_state);
 }
 
+/* Incremental counterpart of hash(): the message is absorbed over any number
+ * of hash_update calls, hash_final appends the domain separation constant */
+static inline
+void hash_init(CSPRNG_STATE_T *const csprng_state){
+   /* SHAKE with a 2*lambda bit digest is employed also for hashing */
+   xof_shake_init(csprng_state, SEED_LENGTH_BYTES*8);
+}
+
+static inline
+void hash_update(CSPRNG_STATE_T *const csprng_state,
+                 const unsigned char *const m,
+                 const uint64_t mlen){
+   xof_shake_update(csprng_state,m,mlen);
+}
+
+static inline
+void hash_final(uint8_t digest[HASH_DIGEST_LENGTH],
+                CSPRNG_STATE_T *const csprng_state,
+                const uint16_t dsc){
+   uint8_t dsc_ordered[2];
+   dsc_ordered[0] = dsc & 0xff;
+   dsc_ordered[1] = (dsc >> 8) & 0xff;
+   xof_shake_update(csprng_state,dsc_ordered,2);
+   xof_shake_final(csprng_state);
+   xof_shake_extract(csprng_state,digest,HASH_DIGEST_LENGTH);
+   /* PQClean-edit: SHAKE release context */
+   xof_shake_release(csprng_state);
+}
+
+/* releases a state of hash_init which will not reach hash_final */
+static inline
+void hash_release(CSPRNG_STATE_T *const csprng_state){
+   /* PQClean-edit: SHAKE release context */
+   xof_shake_release(csprng_state);
+}
+
 #define par_xof_input csprng_initialize_par
 #define par_xof_output csprng_randombytes_par
 /* PQClean-edit: SHAKE release context */
@@ -270,17 +321,17 @@ void expand_digest_to_fixed_weight(uint8_t fixed_weight_string[T],
 #define BITS_FOR_P BITS_TO_REPRESENT(P-1) 
 #define BITS_FOR_Z BITS_TO_REPRESENT(Z-1) 
 
+#define CSPRNG_FP_VEC_BYTES (ROUND_UP(BITS_N_FP_CT_RNG,8)/8)
+/* samples u_prime out of CSPRNG_FP_VEC_BYTES bytes already extracted from a CSPRNG */
 static inline
-void csprng_fp_vec(FP_ELEM res[N],
-                   CSPRNG_STATE_T * const csprng_state){
+void csprng_fp_vec_from_buffer(FP_ELEM res[N],
+                               const uint8_t CSPRNG_buffer[CSPRNG_FP_VEC_BYTES]){
     const FP_ELEM mask = ( (FP_ELEM) 1 << BITS_FOR_P) - 1;
-    uint8_t CSPRNG_buffer[ROUND_UP(BITS_N_FP_CT_RNG,8)/8];
     /* To facilitate hardware implementations, the uint64_t 
      * sub-buffer is consumed starting from the least significant byte 
      * i.e., from the first being output by SHAKE. Bits in the byte are 
      * discarded shifting them out to the right, shifting fresh ones
      * in from the left end */
-    csprng_randombytes(CSPRNG_buffer,sizeof(CSPRNG_buffer),csprng_state);    
     int placed = 0;
     uint64_t sub_buffer = 0;
     for (int i=0; i<8; i++) {
@@ -289,7 +340,7 @@ void csprng_fp_vec(FP_ELEM res[N],
     /* position of the next fresh byte in CSPRNG_buffer*/
     int bits_in_sub_buf = 64;
     int pos_in_buf = 8;
-    int pos_remaining = sizeof(CSPRNG_buffer) - pos_in_buf;
+    int pos_remaining = CSPRNG_FP_VEC_BYTES - pos_in_buf;
     while(placed < N) {
         if (bits_in_sub_buf <= 32 && pos_remaining > 0) {
             /* get at most 4 bytes from buffer */
@@ -312,6 +363,14 @@ void csprng_fp_vec(FP_ELEM res[N],
     }
 }
 
+static inline
+void csprng_fp_vec(FP_ELEM res[N],
+                   CSPRNG_STATE_T * const csprng_state){
+    uint8_t CSPRNG_buffer[CSPRNG_FP_VEC_BYTES];
+    csprng_randombytes(CSPRNG_buffer,sizeof(CSPRNG_buffer),csprng_state);
+    csprng_fp_vec_from_buffer(res, CSPRNG_buffer);
+}
+
 #define BITS_FOR_P_M_ONE BITS_TO_REPRESENT(P-2) 
 
 static inline
@@ -357,17 +416,17 @@ void csprng_fp_vec_chall_1(FP_ELEM res[T],
     }
 }
 
+#define CSPRNG_FP_MAT_BYTES (ROUND_UP(BITS_V_CT_RNG,8)/8)
+/* samples V_tr out of CSPRNG_FP_MAT_BYTES bytes already extracted from a CSPRNG */
 static inline
-void csprng_fp_mat(FP_ELEM res[K][N-K],
-                   CSPRNG_STATE_T * const csprng_state){
+void csprng_fp_mat_from_buffer(V_TR_ELEM res[K][V_TR_COLS],
+                               const uint8_t CSPRNG_buffer[CSPRNG_FP_MAT_BYTES]){
     const FP_ELEM mask = ( (FP_ELEM) 1 << BITS_TO_REPRESENT(P-1)) - 1;
-    uint8_t CSPRNG_buffer[ROUND_UP(BITS_V_CT_RNG,8)/8];
     /* To facilitate hardware implementations, the uint64_t 
      * sub-buffer is consumed starting from the least significant byte 
      * i.e., from the first being output by SHAKE. Bits in the byte are 
      * discarded shifting them out to the right , shifting fresh ones
      * in from the left end */
-    csprng_randombytes(CSPRNG_buffer,sizeof(CSPRNG_buffer),csprng_state);    
     int placed = 0;
     uint64_t sub_buffer = 0;
     for (int i=0; i<8; i++) {
@@ -376,7 +435,13 @@ void csprng_fp_mat(FP_ELEM res[K][N-K],
 	/* position of the next fresh byte in CSPRNG_buffer*/
     int bits_in_sub_buf = 64;
     int pos_in_buf = 8;
-    int pos_remaining = sizeof(CSPRNG_buffer) - pos_in_buf;
+    int pos_remaining = CSPRNG_FP_MAT_BYTES - pos_in_buf;
+    for (int row = 0; row < K; row++) {
+        for (int col = N-K; col < V_TR_COLS; col++) {
+            res[row][col] = 0;
+        }
+    }
+    int row = 0, col = 0;
     while(placed < K*(N-K)) {
         if (bits_in_sub_buf <= 32 && pos_remaining > 0) {
             /* get at most 4 bytes from buffer */
@@ -390,27 +455,41 @@ void csprng_fp_mat(FP_ELEM res[K][N-K],
             bits_in_sub_buf += 8*refresh_amount; 
             pos_remaining -= refresh_amount;
         }
-        *((FP_ELEM*)res+placed) = sub_buffer & mask;
-        if (*((FP_ELEM*)res+placed) < P) {
+        FP_ELEM elem = sub_buffer & mask;
+        if (elem < P) {
+           res[row][col] = elem;
            placed++;
+           col++;
+           if (col == N-K) {
+              col = 0;
+              row++;
+           }
         }
         sub_buffer = sub_buffer >> BITS_FOR_P;
         bits_in_sub_buf -= BITS_FOR_P;
     }   
 }
 
-#if defined(RSDP)
 static inline
-void csprng_fz_vec(FZ_ELEM res[N],
+void csprng_fp_mat(V_TR_ELEM res[K][V_TR_COLS],
                    CSPRNG_STATE_T * const csprng_state){
+    uint8_t CSPRNG_buffer[CSPRNG_FP_MAT_BYTES];
+    csprng_randombytes(CSPRNG_buffer,sizeof(CSPRNG_buffer),csprng_state);
+    csprng_fp_mat_from_buffer(res, CSPRNG_buffer);
+}
+
+#if defined(RSDP)
+#define CSPRNG_FZ_VEC_BYTES (ROUND_UP(BITS_N_FZ_CT_RNG,8)/8)
+/* samples e_bar out of CSPRNG_FZ_VEC_BYTES bytes already extracted from a CSPRNG */
+static inline
+void csprng_fz_vec_from_buffer(FZ_ELEM res[N],
+                               const uint8_t CSPRNG_buffer[CSPRNG_FZ_VEC_BYTES]){
     const FZ_ELEM mask = ( (FZ_ELEM) 1 << BITS_TO_REPRESENT(Z-1)) - 1;
-    uint8_t CSPRNG_buffer[ROUND_UP(BITS_N_FZ_CT_RNG,8)/8];
     /* To facilitate hardware implementations, the uint64_t 
      * sub-buffer is consumed starting from the least significant byte 
      * i.e., from the first being output by SHAKE. Bits in the byte are 
      * discarded shifting them out to the right , shifting fresh ones
      * in from the left end */
-    csprng_randombytes(CSPRNG_buffer,sizeof(CSPRNG_buffer),csprng_state);    
     int placed = 0;
     uint64_t sub_buffer = 0;
     for (int i=0; i<8; i++) {
@@ -419,7 +498,7 @@ void csprng_fz_vec(FZ_ELEM res[N],
 	/* position of the next fresh byte in CSPRNG_buffer*/
     int bits_in_sub_buf = 64;
     int pos_in_buf = 8;
-    int pos_remaining = sizeof(CSPRNG_buffer) - pos_in_buf;
+    int pos_remaining = CSPRNG_FZ_VEC_BYTES - pos_in_buf;
     while(placed < N) {
         if (bits_in_sub_buf <= 32 && pos_remaining > 0) {
             /* get at most 4 bytes from buffer */
@@ -441,18 +520,26 @@ void csprng_fz_vec(FZ_ELEM res[N],
         bits_in_sub_buf -= BITS_FOR_Z;
     }
 }
-#elif defined(RSDPG)
+
 static inline
-void csprng_fz_inf_w(FZ_ELEM res[M],
+void csprng_fz_vec(FZ_ELEM res[N],
                    CSPRNG_STATE_T * const csprng_state){
+    uint8_t CSPRNG_buffer[CSPRNG_FZ_VEC_BYTES];
+    csprng_randombytes(CSPRNG_buffer,sizeof(CSPRNG_buffer),csprng_state);
+    csprng_fz_vec_from_buffer(res, CSPRNG_buffer);
+}
+#elif defined(RSDPG)
+#define CSPRNG_FZ_INF_W_BYTES (ROUND_UP(BITS_M_FZ_CT_RNG,8)/8)
+/* samples e_G_bar out of CSPRNG_FZ_INF_W_BYTES bytes already extracted from a CSPRNG */
+static inline
+void csprng_fz_inf_w_from_buffer(FZ_ELEM res[M],
+                                 const uint8_t CSPRNG_buffer[CSPRNG_FZ_INF_W_BYTES]){
     const FZ_ELEM mask = ( (FZ_ELEM) 1 << BITS_TO_REPRESENT(Z-1)) - 1;
-    uint8_t CSPRNG_buffer[ROUND_UP(BITS_M_FZ_CT_RNG,8)/8];
     /* To facilitate hardware implementations, the uint64_t 
      * sub-buffer is consumed starting from the least significant byte 
      * i.e., from the first being output by SHAKE. Bits in the byte are 
      * discarded shifting them out to the right , shifting fresh ones
      * in from the left end */
-    csprng_randombytes(CSPRNG_buffer,sizeof(CSPRNG_buffer),csprng_state);    
     int placed = 0;
     uint64_t sub_buffer = 0;
     for (int i=0; i<8; i++) {
@@ -461,7 +548,7 @@ void csprng_fz_inf_w(FZ_ELEM res[M],
 	/* position of the next fresh byte in CSPRNG_buffer*/
     int bits_in_sub_buf = 64;
     int pos_in_buf = 8;
-    int pos_remaining = sizeof(CSPRNG_buffer) - pos_in_buf;
+    int pos_remaining = CSPRNG_FZ_INF_W_BYTES - pos_in_buf;
     while(placed < M) {
         if (bits_in_sub_buf <= 32 && pos_remaining > 0) {
             /* get at most 4 bytes from buffer */
@@ -485,17 +572,24 @@ void csprng_fz_inf_w(FZ_ELEM res[M],
 }
 
 static inline
-void csprng_fz_mat(FZ_ELEM res[M][N-M],
-                   CSPRNG_STATE_T * const csprng_state){
+void csprng_fz_inf_w(FZ_ELEM res[M],
+                     CSPRNG_STATE_T * const csprng_state){
+    uint8_t CSPRNG_buffer[CSPRNG_FZ_INF_W_BYTES];
+    csprng_randombytes(CSPRNG_buffer,sizeof(CSPRNG_buffer),csprng_state);
+    csprng_fz_inf_w_from_buffer(res, CSPRNG_buffer);
+}
+
+#define CSPRNG_FZ_MAT_BYTES (ROUND_UP(BITS_W_CT_RNG,8)/8)
+/* samples W_mat out of CSPRNG_FZ_MAT_BYTES bytes already extracted from a CSPRNG */
+static inline
+void csprng_fz_mat_from_buffer(FZ_ELEM res[M][N-M],
+                               const uint8_t CSPRNG_buffer[CSPRNG_FZ_MAT_BYTES]){
     const FZ_ELEM mask = ( (FZ_ELEM) 1 << BITS_TO_REPRESENT(Z-1)) - 1;
-    uint8_t CSPRNG_buffer[ROUND_UP(BITS_W_CT_RNG,8)/8];
     /* To facilitate hardware implementations, the uint64_t 
      * sub-buffer is consumed starting from the least significant byte 
      * i.e., from the first being output by SHAKE. Bits in the byte are 
      * discarded shifting them out to the right , shifting fresh ones
      * in from the left end */
-    csprng_randombytes(CSPRNG_buffer,sizeof(CSPRNG_buffer),csprng_state);    
-
     int placed = 0;
     uint64_t sub_buffer = 0;
     for (int i=0; i<8; i++) {
@@ -504,7 +598,7 @@ void csprng_fz_mat(FZ_ELEM res[M][N-M],
 	/* position of the next fresh byte in CSPRNG_buffer*/
     int bits_in_sub_buf = 64;
     int pos_in_buf = 8;
-    int pos_remaining = sizeof(CSPRNG_buffer) - pos_in_buf;
+    int pos_remaining = CSPRNG_FZ_MAT_BYTES - pos_in_buf;
     while(placed < M*(N-M)) {
         if (bits_in_sub_buf <= 32 && pos_remaining > 0) {
             /* get at most 4 bytes from buffer */
@@ -526,4 +620,175 @@ void csprng_fz_mat(FZ_ELEM res[M][N-M],
         bits_in_sub_buf -= BITS_FOR_Z;
     }    
 }
+
+static inline
+void csprng_fz_mat(FZ_ELEM res[M][N-M],
+                   CSPRNG_STATE_T * const csprng_state){
+    uint8_t CSPRNG_buffer[CSPRNG_FZ_MAT_BYTES];
+    csprng_randombytes(CSPRNG_buffer,sizeof(CSPRNG_buffer),csprng_state);
+    csprng_fz_mat_from_buffer(res, CSPRNG_buffer);
+}
+#endif
+
+/************** Variable-time sampling, for public values only ***************/
+
+/* bytes extracted from the CSPRNG per Keccak permutation, the SHAKE rate */
+#if defined(CATEGORY_1)
+#define CSPRNG_BLOCK_BYTES 168
+#else
+#define CSPRNG_BLOCK_BYTES 136
+#endif
+
+/* The samplers above extract from the CSPRNG, up front, the amount of bytes
+ * (ct_bytes) which suffices to their rejection sampling in all but a
+ * negligible fraction of the cases, so that their timing does not depend on
+ * the values sampled. When the values are public, e.g., the matrices
+ * expanded from seed_pk and the first challenge, the bytes are rather
+ * extracted one block at a time, as long as more candidates are needed.
+ * The bits are consumed in the same order and out of the same ct_bytes,
+ * thus the values are the same as the ones of the constant-time samplers */
+typedef struct {
+    CSPRNG_STATE_T *csprng_state;
+    uint8_t block[CSPRNG_BLOCK_BYTES];
+    int pos_in_block;
+    int block_len;
+    /* bytes out of ct_bytes not yet extracted from the CSPRNG */
+    int to_extract;
+    uint64_t sub_buffer;
+    int bits_in_sub_buf;
+    /* bytes out of ct_bytes not yet moved into sub_buffer */
+    int pos_remaining;
+} csprng_lazy_t;
+
+static inline
+uint8_t csprng_lazy_byte(csprng_lazy_t *const lazy){
+    if (lazy->pos_in_block == lazy->block_len) {
+        lazy->block_len = (lazy->to_extract < CSPRNG_BLOCK_BYTES) ? lazy->to_extract : CSPRNG_BLOCK_BYTES;
+        csprng_randombytes(lazy->block, lazy->block_len, lazy->csprng_state);
+        lazy->to_extract -= lazy->block_len;
+        lazy->pos_in_block = 0;
+    }
+    return lazy->block[lazy->pos_in_block++];
+}
+
+static inline
+void csprng_lazy_init(csprng_lazy_t *const lazy,
+                      CSPRNG_STATE_T * const csprng_state,
+                      const int ct_bytes){
+    lazy->csprng_state = csprng_state;
+    lazy->pos_in_block = 0;
+    lazy->block_len = 0;
+    lazy->to_extract = ct_bytes;
+    lazy->sub_buffer = 0;
+    for (int i=0; i<8; i++) {
+        lazy->sub_buffer |= ((uint64_t) csprng_lazy_byte(lazy)) << 8*i;
+    }
+    lazy->bits_in_sub_buf = 64;
+    lazy->pos_remaining = ct_bytes - 8;
+}
+
+/* refills sub_buffer as the constant-time samplers do */
+static inline
+void csprng_lazy_refill(csprng_lazy_t *const lazy){
+    if (lazy->bits_in_sub_buf <= 32 && lazy->pos_remaining > 0) {
+        /* get at most 4 bytes from the CSPRNG */
+        int refresh_amount = (lazy->pos_remaining >= 4) ? 4 : lazy->pos_remaining;
+        uint32_t refresh_buf = 0;
+        for (int i=0; i<refresh_amount; i++) {
+            refresh_buf |= ((uint32_t)csprng_lazy_byte(lazy)) << 8*i;
+        }
+        lazy->sub_buffer |= ((uint64_t) refresh_buf) << lazy->bits_in_sub_buf;
+        lazy->bits_in_sub_buf += 8*refresh_amount;
+        lazy->pos_remaining -= refresh_amount;
+    }
+}
+
+static inline
+void csprng_lazy_drop(csprng_lazy_t *const lazy, const int bits){
+    lazy->sub_buffer = lazy->sub_buffer >> bits;
+    lazy->bits_in_sub_buf -= bits;
+}
+
+/* extracts the rest of ct_bytes, leaving the CSPRNG as the constant-time
+ * sampler does, for it to be employed further */
+static inline
+void csprng_lazy_complete(csprng_lazy_t *const lazy){
+    while (lazy->to_extract > 0) {
+        int len = (lazy->to_extract < CSPRNG_BLOCK_BYTES) ? lazy->to_extract : CSPRNG_BLOCK_BYTES;
+        csprng_randombytes(lazy->block, len, lazy->csprng_state);
+        lazy->to_extract -= len;
+    }
+}
+
+/* csprng_fp_vec_chall_1 for a public digest; the CSPRNG is left with less
+ * bytes extracted, it is only to be released afterwards */
+static inline
+void csprng_fp_vec_chall_1_lazy(FP_ELEM res[T],
+                                CSPRNG_STATE_T * const csprng_state){
+    const FP_ELEM mask = ( (FP_ELEM) 1 << BITS_FOR_P_M_ONE) - 1;
+    csprng_lazy_t lazy;
+    csprng_lazy_init(&lazy, csprng_state, ROUND_UP(BITS_CHALL_1_FPSTAR_CT_RNG,8)/8);
+    int placed = 0;
+    while(placed < T) {
+        csprng_lazy_refill(&lazy);
+        /* draw from 0 ... P-2, then add 1*/
+        res[placed] = (lazy.sub_buffer & mask)+1;
+        if (res[placed] < P) {
+           placed++;
+        }
+        csprng_lazy_drop(&lazy, BITS_FOR_P_M_ONE);
+    }
+}
+
+/* csprng_fp_mat for a public seed; the CSPRNG is left with less bytes
+ * extracted, it is only to be released afterwards */
+static inline
+void csprng_fp_mat_lazy(V_TR_ELEM res[K][V_TR_COLS],
+                        CSPRNG_STATE_T * const csprng_state){
+    const FP_ELEM mask = ( (FP_ELEM) 1 << BITS_TO_REPRESENT(P-1)) - 1;
+    csprng_lazy_t lazy;
+    csprng_lazy_init(&lazy, csprng_state, CSPRNG_FP_MAT_BYTES);
+    for (int row = 0; row < K; row++) {
+        for (int col = N-K; col < V_TR_COLS; col++) {
+            res[row][col] = 0;
+        }
+    }
+    int placed = 0;
+    int row = 0, col = 0;
+    while(placed < K*(N-K)) {
+        csprng_lazy_refill(&lazy);
+        FP_ELEM elem = lazy.sub_buffer & mask;
+        if (elem < P) {
+           res[row][col] = elem;
+           placed++;
+           col++;
+           if (col == N-K) {
+              col = 0;
+              row++;
+           }
+        }
+        csprng_lazy_drop(&lazy, BITS_FOR_P);
+    }
+}
+
+#if defined(RSDPG)
+/* csprng_fz_mat for a public seed, leaving the CSPRNG as csprng_fz_mat
+ * does: it saves the buffer, not the Keccak permutations */
+static inline
+void csprng_fz_mat_lazy(FZ_ELEM res[M][N-M],
+                        CSPRNG_STATE_T * const csprng_state){
+    const FZ_ELEM mask = ( (FZ_ELEM) 1 << BITS_TO_REPRESENT(Z-1)) - 1;
+    csprng_lazy_t lazy;
+    csprng_lazy_init(&lazy, csprng_state, CSPRNG_FZ_MAT_BYTES);
+    int placed = 0;
+    while(placed < M*(N-M)) {
+        csprng_lazy_refill(&lazy);
+        *((FZ_ELEM*)res+placed) = lazy.sub_buffer & mask;
+        if (*((FZ_ELEM*)res+placed) < Z) {
+           placed++;
+        }
+        csprng_lazy_drop(&lazy, BITS_FOR_Z);
+    }
+    csprng_lazy_complete(&lazy);
+}
 #endif
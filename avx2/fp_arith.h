@@ -96,57 +96,65 @@ FP_ELEM RESTR_TO_VAL(FP_ELEM x){
 #endif
 
 
+#if (defined(HIGH_PERFORMANCE_X86_64) && defined(RSDP) )
 /* in-place normalization of redundant zero representation for syndromes*/
 static inline
 void fp_dz_norm_synd(FP_ELEM v[N-K]){
-    for (int i = 0; i < N-K; i++){
+    int i;
+    for (i = 0; i+EPI8_PER_REG <= N-K; i += EPI8_PER_REG){
+        __m256i v_w = _mm256_lddqu_si256((__m256i const *) &v[i]);
+        v_w = mersenne_dz_norm_epi8(v_w, NUM_BITS_P);
+        _mm256_storeu_si256((__m256i *) &v[i], v_w);
+    }
+    for (; i < N-K; i++){
        v[i] = FP_DOUBLE_ZERO_NORM(v[i]);
     }
 }
 
 static inline
 void fp_dz_norm(FP_ELEM v[N]){
-    for (int i = 0; i < N; i++){
+    int i;
+    for (i = 0; i+EPI8_PER_REG <= N; i += EPI8_PER_REG){
+        __m256i v_w = _mm256_lddqu_si256((__m256i const *) &v[i]);
+        v_w = mersenne_dz_norm_epi8(v_w, NUM_BITS_P);
+        _mm256_storeu_si256((__m256i *) &v[i], v_w);
+    }
+    for (; i < N; i++){
        v[i] = FP_DOUBLE_ZERO_NORM(v[i]);
     }
 }
-
-/* Computes the product e*H of an n-element restricted vector by a (n-k)*n
- * FP H is in systematic form. Only the non systematic portion of H =[V I],
- * V, is provided, transposed, hence linearized by columns so that syndrome
- * computation is vectorizable. */
-
-static
-void restr_vec_by_fp_matrix(FP_ELEM res[N-K],
-                            FZ_ELEM e[N],
-                            FP_ELEM V_tr[K][N-K]){
-    FP_DOUBLEPREC res_dprec[N-K] = {0};
-    for(int i=0; i< N-K;i++) {
-        res_dprec[i]=RESTR_TO_VAL(e[K+i]);
-    }
-    for(int i = 0; i < K; i++){
-       for(int j = 0; j < N-K; j++){
-           res_dprec[j] += FPRED_SINGLE(
-                                  (FP_DOUBLEPREC) RESTR_TO_VAL(e[i]) *
-                                  (FP_DOUBLEPREC) V_tr[i][j]);
-           if(i == P-1) { res_dprec[j] = FPRED_SINGLE(res_dprec[j]); }
-       }
-    }
-    /* Save result trimming to regular precision */
-    for(int i=0; i< N-K;i++) {
-        res[i] = FPRED_SINGLE(res_dprec[i]);
+#else
+/* in-place normalization of redundant zero representation for syndromes*/
+static inline
+void fp_dz_norm_synd(FP_ELEM v[N-K]){
+    for (int i = 0; i < N-K; i++){
+       v[i] = FP_DOUBLE_ZERO_NORM(v[i]);
     }
 }
 
+static inline
+void fp_dz_norm(FP_ELEM v[N]){
+    for (int i = 0; i < N; i++){
+       v[i] = FP_DOUBLE_ZERO_NORM(v[i]);
+    }
+}
+#endif
 
+/* In both vector-matrix products below, the bounds of the column loop are
+ * constants of the set: the compiler unrolls it fully and keeps the column
+ * sums in registers across the rows, i.e., it emits the per-set register
+ * tiled kernel, so none is generated (see the fp_vec_by_fp_matrix and
+ * restr_vec_by_fp_matrix entries of bench/microbench.c) */
 #if defined(RSDP)
 #if defined(HIGH_PERFORMANCE_X86_64)
 /* Computes e * [I_k V]^T, V is already in transposed form
  * since  */
+/* The result is returned with the redundant zero already normalized, saving a
+ * further pass of fp_dz_norm_synd */
 static
 void fp_vec_by_fp_matrix(FP_ELEM res[N-K],
                          FP_ELEM e[N],
-                         FP_DOUBLEPREC V_tr[K][ROUND_UP(N-K,EPI16_PER_REG)]){
+                         V_TR_ELEM V_tr[K][V_TR_COLS]){
 
     alignas(EPI8_PER_REG) FP_DOUBLEPREC res_dprec[ROUND_UP(N-K,EPI16_PER_REG)] = {0};
     for(int i=0; i< N-K;i++) {
@@ -173,7 +181,7 @@ void fp_vec_by_fp_matrix(FP_ELEM res[N-K],
     }
     /* Save result trimming to regular precision */
     for(int i=0; i< N-K;i++) {
-        res[i] = FPRED_DOUBLE(res_dprec[i]);
+        res[i] = FP_DOUBLE_ZERO_NORM(FPRED_DOUBLE(res_dprec[i]));
     }
 }
 #else /* no AVX2, fallback to the reference implementation */
@@ -196,7 +204,8 @@ void fp_vec_by_fp_matrix(FP_ELEM res[N-K],
     }
     /* Save result trimming to regular precision */
     for(int i=0; i< N-K;i++) {
-        res[i] = FPRED_SINGLE(res_dprec[i]);
+        FP_ELEM tmp = FPRED_SINGLE(res_dprec[i]);
+        res[i] = FP_DOUBLE_ZERO_NORM(tmp);
     }
 }
 #endif /* defined(HIGH_PERFORMANCE_X86_64) */
@@ -223,8 +232,57 @@ __m256i reduce_avx2_32(__m256i a){
             r = _mm256_min_epu32(r, rs);
     return r;
 }
+
+/* lanes of x having the selected bit set to 1 are set to true_v, the others
+ * to 1, vector counterpart of FP_ELEM_CMOV */
+static inline
+__m256i fp_elem_cmov_epi32(__m256i x, int bit, int true_v){
+    __m256i one = _mm256_set1_epi32(1);
+    __m256i mask = _mm256_sub_epi32(_mm256_setzero_si256(),
+                                    _mm256_and_si256(_mm256_srli_epi32(x, bit), one));
+    return _mm256_blendv_epi8(one, _mm256_set1_epi32(true_v), mask);
+}
+
+/* RESTR_TO_VAL on eight exponents in [0,127] zero-extended to 32-bit lanes.
+ * The S&M products are reduced pairwise: each of them is below (P-1)^2, in
+ * the range of reduce_avx2_32 */
+static inline
+__m256i restr_to_val_epi32(__m256i x){
+    __m256i res1 = _mm256_mullo_epi32(fp_elem_cmov_epi32(x, 0, RESTR_G_GEN_1),
+                                      fp_elem_cmov_epi32(x, 1, RESTR_G_GEN_2));
+    __m256i res2 = _mm256_mullo_epi32(fp_elem_cmov_epi32(x, 2, RESTR_G_GEN_4),
+                                      fp_elem_cmov_epi32(x, 3, RESTR_G_GEN_8));
+    __m256i res3 = _mm256_mullo_epi32(fp_elem_cmov_epi32(x, 4, RESTR_G_GEN_16),
+                                      fp_elem_cmov_epi32(x, 5, RESTR_G_GEN_32));
+    __m256i res4 = fp_elem_cmov_epi32(x, 6, RESTR_G_GEN_64);
+    res1 = _mm256_mullo_epi32(reduce_avx2_32(res1), reduce_avx2_32(res2));
+    res3 = _mm256_mullo_epi32(reduce_avx2_32(res3), res4);
+    return reduce_avx2_32(_mm256_mullo_epi32(reduce_avx2_32(res1),
+                                             reduce_avx2_32(res3)));
+}
+
+/* zero-extending loads of eight FP resp. FZ elements into 32-bit lanes, and
+ * narrowing store of eight reduced 32-bit lanes as FP elements */
+static inline
+__m256i load_fp_epi32(const FP_ELEM *in){
+    return _mm256_cvtepu16_epi32(_mm_loadu_si128((__m128i const *) in));
+}
+
+static inline
+__m256i load_fz_epi32(const FZ_ELEM *in){
+    return _mm256_cvtepu8_epi32(_mm_loadl_epi64((__m128i const *) in));
+}
+
+static inline
+void store_fp_epi32(FP_ELEM *out, __m256i x){
+    /* packus interleaves the 128b lanes, pick back qwords 0 and 2 */
+    x = _mm256_packus_epi32(x, x);
+    x = _mm256_permute4x64_epi64(x, 0x08);
+    _mm_storeu_si128((__m128i *) out, _mm256_castsi256_si128(x));
+}
+/* no redundant zero in F_509: the result is already normalized */
 static inline 
-void fp_vec_by_fp_matrix(FP_ELEM res[N-K], FP_ELEM e[N], FP_DOUBLEPREC V_tr[K][ROUND_UP(N-K,EPI32_PER_REG)]){
+void fp_vec_by_fp_matrix(FP_ELEM res[N-K], FP_ELEM e[N], V_TR_ELEM V_tr[K][V_TR_COLS]){
 
     alignas(EPI8_PER_REG) FP_DOUBLEPREC res_dprec[ROUND_UP(N-K,EPI32_PER_REG)] = {0};
     for(int i=0; i< N-K;i++) {
@@ -279,6 +337,167 @@ void fp_vec_by_fp_matrix(FP_ELEM res[N-K],
 #endif /* defined(HIGH_PERFORMANCE_X86_64) */
 #endif /* defined(RSDPG) */
 
+#if (defined(HIGH_PERFORMANCE_X86_64) && defined(RSDP) )
+/* Vector Mersenne reduction of sixteen 16-bit lanes, i.e., FPRED_SINGLE */
+static inline
+__m256i fpred_single_epi16(__m256i x){
+    __m256i mred_mask = _mm256_set1_epi16(0x007f);
+    return _mm256_add_epi16(_mm256_and_si256(x, mred_mask),
+                            _mm256_srli_epi16(x, 7));
+}
+
+/* pointwise product of 32 packed FP elements in [0,127]: operands are zero
+ * extended to 16-bit lanes, products reduced and packed back into bytes.
+ * unpack{lo,hi} and packus act on the same 128b lanes, preserving the order */
+static inline
+__m256i fp_mul_epi8(__m256i a, __m256i b){
+    __m256i zero = _mm256_setzero_si256();
+    __m256i lo = _mm256_mullo_epi16(_mm256_unpacklo_epi8(a, zero),
+                                    _mm256_unpacklo_epi8(b, zero));
+    __m256i hi = _mm256_mullo_epi16(_mm256_unpackhi_epi8(a, zero),
+                                    _mm256_unpackhi_epi8(b, zero));
+    return _mm256_packus_epi16(fpred_single_epi16(lo), fpred_single_epi16(hi));
+}
+
+/* RESTR_TO_VAL on 32 packed exponents in [0,7]: RESTR_G_TABLE fits in 8
+ * bytes, thus a single in-lane shuffle performs the lookup */
+static inline
+__m256i restr_to_val_epi8(__m256i x){
+    __m256i lut = _mm256_set1_epi64x((long long) RESTR_G_TABLE);
+    return _mm256_shuffle_epi8(lut, x);
+}
+
+static inline
+void fp_vec_by_fp_vec_pointwise(FP_ELEM res[N],
+                                const FP_ELEM in1[N],
+                                const FP_ELEM in2[N]){
+    int i;
+    for(i = 0; i+EPI8_PER_REG <= N; i += EPI8_PER_REG){
+        __m256i a = _mm256_lddqu_si256((__m256i const *) &in1[i]);
+        __m256i b = _mm256_lddqu_si256((__m256i const *) &in2[i]);
+        _mm256_storeu_si256((__m256i *) &res[i], fp_mul_epi8(a, b));
+    }
+    for(; i < N; i++){
+        res[i] = FPRED_SINGLE( (FP_DOUBLEPREC) in1[i] *
+                               (FP_DOUBLEPREC) in2[i] );
+    }
+}
+
+static inline
+void restr_by_fp_vec_pointwise(FP_ELEM res[N],
+                                const FZ_ELEM in1[N],
+                                const FP_ELEM in2[N]){
+    int i;
+    for(i = 0; i+EPI8_PER_REG <= N; i += EPI8_PER_REG){
+        __m256i a = _mm256_lddqu_si256((__m256i const *) &in1[i]);
+        __m256i b = _mm256_lddqu_si256((__m256i const *) &in2[i]);
+        _mm256_storeu_si256((__m256i *) &res[i],
+                            fp_mul_epi8(restr_to_val_epi8(a), b));
+    }
+    for(; i < N; i++){
+        res[i] = FPRED_SINGLE( (FP_DOUBLEPREC) RESTR_TO_VAL(in1[i]) *
+                               (FP_DOUBLEPREC) in2[i]);
+    }
+}
+
+/* Fused a - b, conversion to FP and product by u_prime: computes
+ * v_bar = a - b, normalized, and res = RESTR_TO_VAL(a - b) * u_prime in a
+ * single pass, without storing the intermediate FP vector */
+static inline
+void restr_vec_sub_by_fp_vec_pointwise(FP_ELEM res[N],
+                                       FZ_ELEM v_bar[N],
+                                       const FZ_ELEM a[N],
+                                       const FZ_ELEM b[N],
+                                       const FP_ELEM u_prime[N]){
+    int i;
+    for(i = 0; i+EPI8_PER_REG <= N; i += EPI8_PER_REG){
+        __m256i a_w = _mm256_lddqu_si256((__m256i const *) &a[i]);
+        __m256i b_w = _mm256_lddqu_si256((__m256i const *) &b[i]);
+        __m256i u_prime_w = _mm256_lddqu_si256((__m256i const *) &u_prime[i]);
+        __m256i v_bar_w = fz_sub_epi8(a_w, b_w);
+        _mm256_storeu_si256((__m256i *) &res[i],
+                            fp_mul_epi8(restr_to_val_epi8(v_bar_w), u_prime_w));
+        v_bar_w = mersenne_dz_norm_epi8(v_bar_w, NUM_BITS_Z);
+        _mm256_storeu_si256((__m256i *) &v_bar[i], v_bar_w);
+    }
+    for(; i < N; i++){
+        FZ_ELEM v_bar_i = FZRED_SINGLE( a[i] + FZRED_OPPOSITE(b[i]) );
+        res[i] = FPRED_SINGLE( (FP_DOUBLEPREC) RESTR_TO_VAL(v_bar_i) *
+                               (FP_DOUBLEPREC) u_prime[i]);
+        v_bar[i] = FZ_DOUBLE_ZERO_NORM(v_bar_i);
+    }
+}
+#elif (defined(HIGH_PERFORMANCE_X86_64) && defined(RSDPG) )
+static inline
+void fp_vec_by_fp_vec_pointwise(FP_ELEM res[N],
+                                const FP_ELEM in1[N],
+                                const FP_ELEM in2[N]){
+    int i;
+    for(i = 0; i+EPI32_PER_REG <= N; i += EPI32_PER_REG){
+        __m256i a = load_fp_epi32(&in1[i]);
+        __m256i b = load_fp_epi32(&in2[i]);
+        store_fp_epi32(&res[i], reduce_avx2_32(_mm256_mullo_epi32(a, b)));
+    }
+    for(; i < N; i++){
+        res[i] = FPRED_SINGLE( (FP_DOUBLEPREC) in1[i] *
+                               (FP_DOUBLEPREC) in2[i] );
+    }
+}
+
+static inline
+void restr_by_fp_vec_pointwise(FP_ELEM res[N],
+                                const FZ_ELEM in1[N],
+                                const FP_ELEM in2[N]){
+    int i;
+    for(i = 0; i+EPI32_PER_REG <= N; i += EPI32_PER_REG){
+        __m256i a = restr_to_val_epi32(load_fz_epi32(&in1[i]));
+        __m256i b = load_fp_epi32(&in2[i]);
+        store_fp_epi32(&res[i], reduce_avx2_32(_mm256_mullo_epi32(a, b)));
+    }
+    for(; i < N; i++){
+        res[i] = FPRED_SINGLE( (FP_DOUBLEPREC) RESTR_TO_VAL(in1[i]) *
+                               (FP_DOUBLEPREC) in2[i]);
+    }
+}
+
+/* Fused a - b, conversion to FP and product by u_prime: computes
+ * v_bar = a - b, normalized, and res = RESTR_TO_VAL(a - b) * u_prime in a
+ * single pass. The restricted vector is processed 16 bytes at a time, i.e.,
+ * two batches of 32-bit lanes for the conversion */
+static inline
+void restr_vec_sub_by_fp_vec_pointwise(FP_ELEM res[N],
+                                       FZ_ELEM v_bar[N],
+                                       const FZ_ELEM a[N],
+                                       const FZ_ELEM b[N],
+                                       const FP_ELEM u_prime[N]){
+    int i;
+    for(i = 0; i+2*EPI32_PER_REG <= N; i += 2*EPI32_PER_REG){
+        __m256i a_w = _mm256_broadcastsi128_si256(
+                                 _mm_loadu_si128((__m128i const *) &a[i]));
+        __m256i b_w = _mm256_broadcastsi128_si256(
+                                 _mm_loadu_si128((__m128i const *) &b[i]));
+        __m128i v_bar_w = _mm256_castsi256_si128(fz_sub_epi8(a_w, b_w));
+
+        __m256i lo = restr_to_val_epi32(_mm256_cvtepu8_epi32(v_bar_w));
+        __m256i hi = restr_to_val_epi32(_mm256_cvtepu8_epi32(_mm_srli_si128(v_bar_w, 8)));
+        lo = _mm256_mullo_epi32(lo, load_fp_epi32(&u_prime[i]));
+        hi = _mm256_mullo_epi32(hi, load_fp_epi32(&u_prime[i+EPI32_PER_REG]));
+        store_fp_epi32(&res[i], reduce_avx2_32(lo));
+        store_fp_epi32(&res[i+EPI32_PER_REG], reduce_avx2_32(hi));
+
+        v_bar_w = _mm256_castsi256_si128(
+                      mersenne_dz_norm_epi8(_mm256_broadcastsi128_si256(v_bar_w),
+                                            NUM_BITS_Z));
+        _mm_storeu_si128((__m128i *) &v_bar[i], v_bar_w);
+    }
+    for(; i < N; i++){
+        FZ_ELEM v_bar_i = FZRED_SINGLE( a[i] + FZRED_OPPOSITE(b[i]) );
+        res[i] = FPRED_SINGLE( (FP_DOUBLEPREC) RESTR_TO_VAL(v_bar_i) *
+                               (FP_DOUBLEPREC) u_prime[i]);
+        v_bar[i] = FZ_DOUBLE_ZERO_NORM(v_bar_i);
+    }
+}
+#else /* no AVX2, fallback to the reference implementation */
 static inline
 void fp_vec_by_fp_vec_pointwise(FP_ELEM res[N],
                                 const FP_ELEM in1[N],
@@ -299,68 +518,81 @@ void restr_by_fp_vec_pointwise(FP_ELEM res[N],
     }
 }
 
-/* e*chall_1 + u_prime*/
+static inline
+void restr_vec_sub_by_fp_vec_pointwise(FP_ELEM res[N],
+                                       FZ_ELEM v_bar[N],
+                                       const FZ_ELEM a[N],
+                                       const FZ_ELEM b[N],
+                                       const FP_ELEM u_prime[N]){
+    for(int i = 0; i < N; i++){
+        FZ_ELEM v_bar_i = FZRED_SINGLE( a[i] + FZRED_OPPOSITE(b[i]) );
+        res[i] = FPRED_SINGLE( (FP_DOUBLEPREC) RESTR_TO_VAL(v_bar_i) *
+                               (FP_DOUBLEPREC) u_prime[i]);
+        v_bar[i] = FZ_DOUBLE_ZERO_NORM(v_bar_i);
+    }
+}
+#endif
+
+/* e*chall_1 + u_prime, with the redundant zero normalized, i.e., the
+ * response y as it is packed, without a further pass of fp_dz_norm */
 #if defined(RSDP)
 #if defined(HIGH_PERFORMANCE_X86_64)
+/* chall_1*RESTR_G_GEN^z for the Z = 7 values of z, i.e., the table of the
+ * values taken by y - u_prime in a round, built once per round. Since the
+ * single-cycle shuffle acts only on 128b lanes separately, the table is
+ * computed on two pairs of scattered 16-bit entries, reduced, and byte packed
+ * again into both lanes */
 static inline
-void fp_vec_by_restr_vec_scaled(FP_ELEM res[N],
-                                const FZ_ELEM e[N],
-                                const FP_ELEM chall_1,
-                                const FP_ELEM u_prime[N]){
-
-    alignas(EPI8_PER_REG) FZ_ELEM e_align[ROUND_UP(N,EPI8_PER_REG)];
-    alignas(EPI8_PER_REG) FP_ELEM u_prime_align[ROUND_UP(N,EPI8_PER_REG)];
-    alignas(EPI8_PER_REG) FP_ELEM res_align[ROUND_UP(N,EPI8_PER_REG)];
-    __m256i mred_mask = _mm256_set1_epi16 ((uint16_t)0x007f);
-    __m256i dense_mred_mask = _mm256_set1_epi8 ((uint8_t)0x7f);
-    __m256i dense_neg_mred_mask = _mm256_set1_epi8 ((uint8_t)0x80);
-    memcpy(e_align,e,N);
-    memcpy(u_prime_align,u_prime,N);
-
-    /* set a register with chall_1, EPI16_PER_REG times */
-    __m256i chall_1_comb = _mm256_set1_epi16 ((uint16_t) chall_1);
-
-    /* Since the single-cycle shuffle acts only on 128b lanes separately,
-     * prepare two pairs of tables, with alternating scattered elements, to be
-     * broadcast-multiplied. Results are then reduced, and byte packed again
-     * to allow the use of the shuffle instruction */
+__m256i restr_scaled_lut_epi8(const FP_ELEM chall_1){
     __m256i LUT_sparse = _mm256_set_epi16 (0x0001,0x0020,0x0008,0x0002,
                                            0x0040,0x0010,0x0004,0x0001,
                                            0x0001,0x0020,0x0008,0x0002,
                                            0x0040,0x0010,0x0004,0x0001);
-
-    /* comb-multiply the lookup table made of a single register obtaining
-     * pre-scaled values */
-    LUT_sparse = _mm256_mullo_epi16(LUT_sparse,chall_1_comb);
-    /* Vector Mersenne reduction */
-    __m256i tmp = _mm256_and_si256 (LUT_sparse, mred_mask);
-            LUT_sparse = _mm256_srli_epi16(LUT_sparse, 7);
-            LUT_sparse = _mm256_add_epi16(tmp,LUT_sparse);
+    /* comb-multiply the table by chall_1: RESTR_G_GEN^z is a power of two,
+     * thus a single Mersenne fold rotates chall_1 within 7 bits */
+    LUT_sparse = _mm256_mullo_epi16(LUT_sparse, _mm256_set1_epi16((uint16_t) chall_1));
+    LUT_sparse = fpred_single_epi16(LUT_sparse);
     /*semantics from the manual call for a *byte amount* in _mm256_srli_si256*/
-    tmp = _mm256_srli_si256(LUT_sparse, 7);
-    LUT_sparse = _mm256_or_si256(LUT_sparse,tmp);
-
-    /* Convert restricted to rescaled values by batch exponentiating them
-     * via shuffle: "shuffling" the table according to the restricted values
-     * yields chall_1-multiplied elements of FP*/
-    for(int i = 0; i < ROUND_UP(N,EPI8_PER_REG)/EPI8_PER_REG; i++ ){
-        __m256i e_word = _mm256_load_si256( (__m256i const *) &e_align[i*EPI8_PER_REG]);
-        e_word = _mm256_shuffle_epi8(LUT_sparse, e_word);
-        /* add to u_prime */
-        __m256i u_prime_word = _mm256_load_si256( (__m256i const *) &u_prime_align[i*EPI8_PER_REG]);
-        __m256i res_word =_mm256_add_epi8(e_word,u_prime_word);
-        /* reduce, knowing that a single out bit is the max overflow */
-        tmp = _mm256_and_si256 (res_word, dense_mred_mask);
-        /* no _mm256_srli_epi8 available, cope with the lack hand-clearing
-         * all other bits before shifting */
-        res_word = _mm256_srli_epi16(
-                               _mm256_and_si256(res_word,dense_neg_mred_mask),
-                               7);
-        res_word =_mm256_add_epi8(res_word,tmp);
-        _mm256_store_si256 ((__m256i *) &res_align[i*EPI8_PER_REG], res_word);
-
-    }
-    memcpy(res,res_align,N);
+    return _mm256_or_si256(LUT_sparse, _mm256_srli_si256(LUT_sparse, 7));
+}
+
+/* u_prime + lut[e] over 32 packed elements, the redundant zero normalized */
+static inline
+__m256i fp_restr_scaled_add_epi8(__m256i lut, __m256i e_w, __m256i u_prime_w){
+    __m256i dense_mred_mask = _mm256_set1_epi8 ((uint8_t)0x7f);
+    __m256i dense_neg_mred_mask = _mm256_set1_epi8 ((uint8_t)0x80);
+    __m256i res_w = _mm256_add_epi8(_mm256_shuffle_epi8(lut, e_w), u_prime_w);
+    /* reduce, knowing that a single out bit is the max overflow */
+    __m256i tmp = _mm256_and_si256 (res_w, dense_mred_mask);
+    /* no _mm256_srli_epi8 available, cope with the lack hand-clearing
+     * all other bits before shifting */
+    res_w = _mm256_srli_epi16(_mm256_and_si256(res_w, dense_neg_mred_mask), 7);
+    res_w = _mm256_add_epi8(res_w, tmp);
+    return mersenne_dz_norm_epi8(res_w, NUM_BITS_P);
+}
+
+/* res must not alias the inputs: the last, partial, block is computed on
+ * the final EPI8_PER_REG elements, overlapping the previous one */
+static inline
+void fp_vec_by_restr_vec_scaled(FP_ELEM res[N],
+                                const FZ_ELEM e[N],
+                                const FP_ELEM chall_1,
+                                const FP_ELEM u_prime[N]){
+    __m256i lut = restr_scaled_lut_epi8(chall_1);
+    int i;
+    for(i = 0; i+EPI8_PER_REG <= N; i += EPI8_PER_REG){
+        __m256i e_w = _mm256_lddqu_si256((__m256i const *) &e[i]);
+        __m256i u_prime_w = _mm256_lddqu_si256((__m256i const *) &u_prime[i]);
+        _mm256_storeu_si256((__m256i *) &res[i],
+                            fp_restr_scaled_add_epi8(lut, e_w, u_prime_w));
+    }
+    if(i < N){
+        i = N-EPI8_PER_REG;
+        __m256i e_w = _mm256_lddqu_si256((__m256i const *) &e[i]);
+        __m256i u_prime_w = _mm256_lddqu_si256((__m256i const *) &u_prime[i]);
+        _mm256_storeu_si256((__m256i *) &res[i],
+                            fp_restr_scaled_add_epi8(lut, e_w, u_prime_w));
+    }
 }
 #else
 static inline
@@ -369,14 +601,106 @@ void fp_vec_by_restr_vec_scaled(FP_ELEM res[N],
                                 const FP_ELEM chall_1,
                                 const FP_ELEM u_prime[N]){
     for(int i = 0; i < N; i++){
-        res[i] = FPRED_DOUBLE( (FP_DOUBLEPREC) u_prime[i] +
-                               (FP_DOUBLEPREC) RESTR_TO_VAL(e[i]) * (FP_DOUBLEPREC) chall_1) ;
+        FP_ELEM tmp = FPRED_DOUBLE( (FP_DOUBLEPREC) u_prime[i] +
+                                    (FP_DOUBLEPREC) RESTR_TO_VAL(e[i]) * (FP_DOUBLEPREC) chall_1);
+        res[i] = FP_DOUBLE_ZERO_NORM(tmp);
     }
 }
 #endif /* defined(HIGH_PERFORMANCE_X86_64) */
 #endif /* defined(RSDP) */
 
 #if defined(RSDPG)
+#if defined(HIGH_PERFORMANCE_X86_64)
+/* chall_1*RESTR_G_GEN^z for z in [0,127], i.e., the table of the values
+ * taken by y - u_prime in a round, built once per round and kept in
+ * registers. Row r holds the 16 entries having z >> 4 == r: its low bytes
+ * are broadcast to both 128b lanes of lut_lo[r], its high bytes to the ones
+ * of lut_hi[r], so that an in-lane shuffle on z & 0xf looks them up */
+static inline
+void restr_scaled_lut_epi8(__m256i lut_lo[8],
+                           __m256i lut_hi[8],
+                           const FP_ELEM chall_1){
+    uint32_t row[16];
+    row[0] = chall_1;
+    for(int j = 1; j < 16; j++){
+        row[j] = FPRED_SINGLE( (FP_DOUBLEPREC) row[j-1] * RESTR_G_GEN_1);
+    }
+    __m256i row_a = _mm256_loadu_si256((__m256i const *) &row[0]);
+    __m256i row_b = _mm256_loadu_si256((__m256i const *) &row[8]);
+    __m256i g_16 = _mm256_set1_epi32(RESTR_G_GEN_16);
+    /* gathers the low bytes of the 16-bit entries in the lower qword of each
+     * 128b lane, and the high bytes in the upper one */
+    __m256i split_bytes = _mm256_setr_epi8(0,2,4,6,8,10,12,14,1,3,5,7,9,11,13,15,
+                                           0,2,4,6,8,10,12,14,1,3,5,7,9,11,13,15);
+    for(int r = 0; r < 8; r++){
+        /* packus interleaves the 128b lanes, 0xD8 restores the qword order */
+        __m256i row_w = _mm256_packus_epi32(row_a, row_b);
+        row_w = _mm256_permute4x64_epi64(row_w, 0xD8);
+        row_w = _mm256_shuffle_epi8(row_w, split_bytes);
+        row_w = _mm256_permute4x64_epi64(row_w, 0xD8);
+        lut_lo[r] = _mm256_permute2x128_si256(row_w, row_w, 0x00);
+        lut_hi[r] = _mm256_permute2x128_si256(row_w, row_w, 0x11);
+        /* (P-1)*RESTR_G_GEN_16 is in range for reduce_avx2_32 */
+        row_a = reduce_avx2_32(_mm256_mullo_epi32(row_a, g_16));
+        row_b = reduce_avx2_32(_mm256_mullo_epi32(row_b, g_16));
+    }
+}
+
+/* u_prime + lut[e] over 32 elements: all the rows are looked up, the one
+ * matching e >> 4 is kept, so that no memory access depends on e */
+static inline
+void fp_restr_scaled_add_32(FP_ELEM res[EPI8_PER_REG],
+                            const __m256i lut_lo[8],
+                            const __m256i lut_hi[8],
+                            const FZ_ELEM e[EPI8_PER_REG],
+                            const FP_ELEM u_prime[EPI8_PER_REG]){
+    __m256i nibble_mask = _mm256_set1_epi8(0x0f);
+    __m256i p_16 = _mm256_set1_epi16(P);
+    __m256i e_w = _mm256_lddqu_si256((__m256i const *) e);
+    __m256i col = _mm256_and_si256(e_w, nibble_mask);
+    __m256i row = _mm256_and_si256(_mm256_srli_epi16(e_w, 4), nibble_mask);
+    __m256i val_lo = _mm256_setzero_si256();
+    __m256i val_hi = _mm256_setzero_si256();
+    for(int r = 0; r < 8; r++){
+        __m256i sel = _mm256_cmpeq_epi8(row, _mm256_set1_epi8((char) r));
+        val_lo = _mm256_or_si256(val_lo,
+                                 _mm256_and_si256(sel, _mm256_shuffle_epi8(lut_lo[r], col)));
+        val_hi = _mm256_or_si256(val_hi,
+                                 _mm256_and_si256(sel, _mm256_shuffle_epi8(lut_hi[r], col)));
+    }
+    /* back to 16-bit lanes, in element order */
+    __m256i val_a = _mm256_unpacklo_epi8(val_lo, val_hi);
+    __m256i val_b = _mm256_unpackhi_epi8(val_lo, val_hi);
+    __m256i res_0 = _mm256_permute2x128_si256(val_a, val_b, 0x20);
+    __m256i res_1 = _mm256_permute2x128_si256(val_a, val_b, 0x31);
+    /* both addends are reduced: a single conditional subtraction suffices */
+    res_0 = _mm256_add_epi16(res_0, _mm256_lddqu_si256((__m256i const *) &u_prime[0]));
+    res_1 = _mm256_add_epi16(res_1, _mm256_lddqu_si256((__m256i const *) &u_prime[EPI16_PER_REG]));
+    res_0 = _mm256_min_epu16(res_0, _mm256_sub_epi16(res_0, p_16));
+    res_1 = _mm256_min_epu16(res_1, _mm256_sub_epi16(res_1, p_16));
+    _mm256_storeu_si256((__m256i *) &res[0], res_0);
+    _mm256_storeu_si256((__m256i *) &res[EPI16_PER_REG], res_1);
+}
+
+/* res must not alias the inputs: the last, partial, block is computed on
+ * the final EPI8_PER_REG elements, overlapping the previous one */
+static inline
+void fp_vec_by_restr_vec_scaled(FP_ELEM res[N],
+                                const FZ_ELEM e[N],
+                                const FP_ELEM chall_1,
+                                const FP_ELEM u_prime[N]){
+    __m256i lut_lo[8], lut_hi[8];
+    restr_scaled_lut_epi8(lut_lo, lut_hi, chall_1);
+    int i;
+    for(i = 0; i+EPI8_PER_REG <= N; i += EPI8_PER_REG){
+        fp_restr_scaled_add_32(&res[i], lut_lo, lut_hi, &e[i], &u_prime[i]);
+    }
+    if(i < N){
+        i = N-EPI8_PER_REG;
+        fp_restr_scaled_add_32(&res[i], lut_lo, lut_hi, &e[i], &u_prime[i]);
+    }
+}
+#else
 static inline
 void fp_vec_by_restr_vec_scaled(FP_ELEM res[N],
                                 const FZ_ELEM e[N],
@@ -387,9 +711,103 @@ void fp_vec_by_restr_vec_scaled(FP_ELEM res[N],
                                (FP_DOUBLEPREC) RESTR_TO_VAL(e[i]) * (FP_DOUBLEPREC) chall_1) ;
     }
 }
-#endif
+#endif /* defined(HIGH_PERFORMANCE_X86_64) */
+#endif /* defined(RSDPG) */
+
+#if (defined(HIGH_PERFORMANCE_X86_64) && defined(RSDP) )
+/* synd - s*chall_1 is computed on 16-bit lanes, mirroring the scalar
+ * sequence of reductions. As for fp_vec_by_fp_matrix, the result has the
+ * redundant zero normalized */
+static inline
+__m256i fp_synd_minus_scaled_epi16(__m256i synd, __m256i s, __m256i chall_1_comb){
+    __m256i mred_mask = _mm256_set1_epi16(0x007f);
+    __m256i one = _mm256_set1_epi16(1);
+    __m256i tmp = fpred_single_epi16(_mm256_mullo_epi16(s, chall_1_comb));
+    /* FP_DOUBLE_ZERO_NORM, then FPRED_OPPOSITE */
+    tmp = _mm256_add_epi16(tmp, _mm256_srli_epi16(_mm256_add_epi16(tmp, one), 7));
+    tmp = _mm256_and_si256(tmp, mred_mask);
+    tmp = _mm256_xor_si256(tmp, mred_mask);
+    tmp = fpred_single_epi16(_mm256_add_epi16(synd, tmp));
+    /* FP_DOUBLE_ZERO_NORM of the result */
+    tmp = _mm256_add_epi16(tmp, _mm256_srli_epi16(_mm256_add_epi16(tmp, one), 7));
+    return _mm256_and_si256(tmp, mred_mask);
+}
+
+static inline
+void fp_synd_minus_fp_vec_scaled(FP_ELEM res[N-K],
+                                 const FP_ELEM synd[N-K],
+                                 const FP_ELEM chall_1,
+                                 const FP_ELEM s[N-K]){
+    __m256i zero = _mm256_setzero_si256();
+    __m256i chall_1_comb = _mm256_set1_epi16(chall_1);
+    int j;
+    for(j = 0; j+EPI8_PER_REG <= N-K; j += EPI8_PER_REG){
+        __m256i synd_w = _mm256_lddqu_si256((__m256i const *) &synd[j]);
+        __m256i s_w = _mm256_lddqu_si256((__m256i const *) &s[j]);
+        __m256i lo = fp_synd_minus_scaled_epi16(_mm256_unpacklo_epi8(synd_w, zero),
+                                                _mm256_unpacklo_epi8(s_w, zero),
+                                                chall_1_comb);
+        __m256i hi = fp_synd_minus_scaled_epi16(_mm256_unpackhi_epi8(synd_w, zero),
+                                                _mm256_unpackhi_epi8(s_w, zero),
+                                                chall_1_comb);
+        _mm256_storeu_si256((__m256i *) &res[j], _mm256_packus_epi16(lo, hi));
+    }
+    for(; j < N-K; j++){
+        FP_ELEM tmp = FPRED_SINGLE( (FP_DOUBLEPREC) s[j] * (FP_DOUBLEPREC) chall_1);
+        tmp = FP_DOUBLE_ZERO_NORM(tmp);
+        tmp = FPRED_SINGLE( (FP_DOUBLEPREC) synd[j] + FPRED_OPPOSITE(tmp) );
+        res[j] = FP_DOUBLE_ZERO_NORM(tmp);
+    }
+}
 
+static inline
+void convert_restr_vec_to_fp(FP_ELEM res[N],
+                            const FZ_ELEM in[N]){
+    int j;
+    for(j = 0; j+EPI8_PER_REG <= N; j += EPI8_PER_REG){
+        __m256i in_w = _mm256_lddqu_si256((__m256i const *) &in[j]);
+        _mm256_storeu_si256((__m256i *) &res[j], restr_to_val_epi8(in_w));
+    }
+    for(; j < N; j++){
+        res[j] = RESTR_TO_VAL(in[j]);
+    }
+}
+#elif (defined(HIGH_PERFORMANCE_X86_64) && defined(RSDPG) )
+static inline
+void fp_synd_minus_fp_vec_scaled(FP_ELEM res[N-K],
+                                 const FP_ELEM synd[N-K],
+                                 const FP_ELEM chall_1,
+                                 const FP_ELEM s[N-K]){
+    __m256i chall_1_comb = _mm256_set1_epi32(chall_1);
+    __m256i p_32 = _mm256_set1_epi32(P);
+    int j;
+    for(j = 0; j+EPI32_PER_REG <= N-K; j += EPI32_PER_REG){
+        __m256i tmp = reduce_avx2_32(_mm256_mullo_epi32(load_fp_epi32(&s[j]),
+                                                        chall_1_comb));
+        /* synd + (P - tmp) is at most 2P-1, no need to reduce the opposite */
+        tmp = _mm256_add_epi32(load_fp_epi32(&synd[j]), _mm256_sub_epi32(p_32, tmp));
+        store_fp_epi32(&res[j], reduce_avx2_32(tmp));
+    }
+    for(; j < N-K; j++){
+        FP_ELEM tmp = FPRED_SINGLE( (FP_DOUBLEPREC) s[j] * (FP_DOUBLEPREC) chall_1);
+        tmp = FP_DOUBLE_ZERO_NORM(tmp);
+        tmp = FPRED_SINGLE( (FP_DOUBLEPREC) synd[j] + FPRED_OPPOSITE(tmp) );
+        res[j] = FP_DOUBLE_ZERO_NORM(tmp);
+    }
+}
 
+static inline
+void convert_restr_vec_to_fp(FP_ELEM res[N],
+                            const FZ_ELEM in[N]){
+    int j;
+    for(j = 0; j+EPI32_PER_REG <= N; j += EPI32_PER_REG){
+        store_fp_epi32(&res[j], restr_to_val_epi32(load_fz_epi32(&in[j])));
+    }
+    for(; j < N; j++){
+        res[j] = RESTR_TO_VAL(in[j]);
+    }
+}
+#else /* no AVX2, fallback to the reference implementation */
 static inline
 void fp_synd_minus_fp_vec_scaled(FP_ELEM res[N-K],
                                  const FP_ELEM synd[N-K],
@@ -398,7 +816,8 @@ void fp_synd_minus_fp_vec_scaled(FP_ELEM res[N-K],
     for(int j = 0; j < N-K; j++){
         FP_ELEM tmp = FPRED_SINGLE( (FP_DOUBLEPREC) s[j] * (FP_DOUBLEPREC) chall_1);
         tmp = FP_DOUBLE_ZERO_NORM(tmp);
-        res[j] = FPRED_SINGLE( (FP_DOUBLEPREC) synd[j] + FPRED_OPPOSITE(tmp) );
+        tmp = FPRED_SINGLE( (FP_DOUBLEPREC) synd[j] + FPRED_OPPOSITE(tmp) );
+        res[j] = FP_DOUBLE_ZERO_NORM(tmp);
     }
 }
 
@@ -409,3 +828,45 @@ void convert_restr_vec_to_fp(FP_ELEM res[N],
         res[j] = RESTR_TO_VAL(in[j]);
     }
 }
+#endif
+
+/* Computes the product e*H of an n-element restricted vector by a (n-k)*n
+ * FP H is in systematic form. Only the non systematic portion of H =[V I],
+ * V, is provided, transposed, hence linearized by columns so that syndrome
+ * computation is vectorizable. The syndrome is returned with the redundant
+ * zero normalized. */
+#if defined(HIGH_PERFORMANCE_X86_64)
+/* The restricted vector is mapped to FP by the vectorized
+ * convert_restr_vec_to_fp, then the AVX2 fp_vec_by_fp_matrix is employed */
+static
+void restr_vec_by_fp_matrix(FP_ELEM res[N-K],
+                            FZ_ELEM e[N],
+                            V_TR_ELEM V_tr[K][V_TR_COLS]){
+    FP_ELEM e_fp[N];
+    convert_restr_vec_to_fp(e_fp, e);
+    fp_vec_by_fp_matrix(res, e_fp, V_tr);
+}
+#else /* no AVX2, fallback to the reference implementation */
+static
+void restr_vec_by_fp_matrix(FP_ELEM res[N-K],
+                            FZ_ELEM e[N],
+                            FP_ELEM V_tr[K][N-K]){
+    FP_DOUBLEPREC res_dprec[N-K] = {0};
+    for(int i=0; i< N-K;i++) {
+        res_dprec[i]=RESTR_TO_VAL(e[K+i]);
+    }
+    for(int i = 0; i < K; i++){
+       for(int j = 0; j < N-K; j++){
+           res_dprec[j] += FPRED_SINGLE(
+                                  (FP_DOUBLEPREC) RESTR_TO_VAL(e[i]) *
+                                  (FP_DOUBLEPREC) V_tr[i][j]);
+           if(i == P-1) { res_dprec[j] = FPRED_SINGLE(res_dprec[j]); }
+       }
+    }
+    /* Save result trimming to regular precision */
+    for(int i=0; i< N-K;i++) {
+        FP_ELEM tmp = FPRED_SINGLE(res_dprec[i]);
+        res[i] = FP_DOUBLE_ZERO_NORM(tmp);
+    }
+}
+#endif /* defined(HIGH_PERFORMANCE_X86_64) */
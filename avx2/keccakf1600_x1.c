@@ -0,0 +1,247 @@
+/**
+ *
+ * Reference ISO-C11 Implementation of CROSS.
+ *
+ * @version 2.0 (February 2025)
+ *
+ * Authors listed in alphabetical order:
+ * 
+ * @author: Alessandro Barenghi <alessandro.barenghi@polimi.it>
+ * @author: Marco Gianvecchio <marco.gianvecchio@mail.polimi.it>
+ * @author: Patrick Karl <patrick.karl@tum.de>
+ * @author: Gerardo Pelosi <gerardo.pelosi@polimi.it>
+ * @author: Jonas Schupp <jonas.schupp@tum.de>
+ * 
+ * 
+ * This code is hereby placed in the public domain.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ''AS IS'' AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **/
+
+
+#include "keccakf1600_x1.h"
+
+#define ROL64(a, offset) (((a) << (offset)) ^ ((a) >> (64-(offset))))
+
+static const uint64_t keccakf1600_rc[24] = {
+   0x0000000000000001ULL, 0x0000000000008082ULL, 0x800000000000808aULL,
+   0x8000000080008000ULL, 0x000000000000808bULL, 0x0000000080000001ULL,
+   0x8000000080008081ULL, 0x8000000000008009ULL, 0x000000000000008aULL,
+   0x0000000000000088ULL, 0x0000000080008009ULL, 0x000000008000000aULL,
+   0x000000008000808bULL, 0x800000000000008bULL, 0x8000000000008089ULL,
+   0x8000000000008003ULL, 0x8000000000008002ULL, 0x8000000000000080ULL,
+   0x000000000000800aULL, 0x800000008000000aULL, 0x8000000080008081ULL,
+   0x8000000000008080ULL, 0x0000000080000001ULL, 0x8000000080008008ULL
+};
+
+/* Each round reads the 25 lanes from one set of variables and writes them to
+ * the other one, the loop body runs two rounds so that the state ends where
+ * it started. B holds the row being computed, after theta, rho and pi */
+void keccakf1600_x1_permute(uint64_t state[25]){
+    uint64_t Aba, Abe, Abi, Abo, Abu, Aga, Age, Agi, Ago, Agu, Aka, Ake, Aki, Ako, Aku, Ama, Ame, Ami, Amo, Amu, Asa, Ase, Asi, Aso, Asu;
+    uint64_t Eba, Ebe, Ebi, Ebo, Ebu, Ega, Ege, Egi, Ego, Egu, Eka, Eke, Eki, Eko, Eku, Ema, Eme, Emi, Emo, Emu, Esa, Ese, Esi, Eso, Esu;
+    uint64_t Ba, Be, Bi, Bo, Bu;
+    uint64_t Ca, Ce, Ci, Co, Cu;
+    uint64_t Da, De, Di, Do, Du;
+
+    Aba = state[0]; Abe = state[1]; Abi = state[2]; Abo = state[3]; Abu = state[4];
+    Aga = state[5]; Age = state[6]; Agi = state[7]; Ago = state[8]; Agu = state[9];
+    Aka = state[10]; Ake = state[11]; Aki = state[12]; Ako = state[13]; Aku = state[14];
+    Ama = state[15]; Ame = state[16]; Ami = state[17]; Amo = state[18]; Amu = state[19];
+    Asa = state[20]; Ase = state[21]; Asi = state[22]; Aso = state[23]; Asu = state[24];
+
+    for(int round = 0; round < 24; round += 2){
+        /* theta */
+        Ca = Aba ^ Aga ^ Aka ^ Ama ^ Asa;
+        Ce = Abe ^ Age ^ Ake ^ Ame ^ Ase;
+        Ci = Abi ^ Agi ^ Aki ^ Ami ^ Asi;
+        Co = Abo ^ Ago ^ Ako ^ Amo ^ Aso;
+        Cu = Abu ^ Agu ^ Aku ^ Amu ^ Asu;
+        Da = Cu ^ ROL64(Ce, 1);
+        De = Ca ^ ROL64(Ci, 1);
+        Di = Ce ^ ROL64(Co, 1);
+        Do = Ci ^ ROL64(Cu, 1);
+        Du = Co ^ ROL64(Ca, 1);
+        /* rho, pi, chi and iota, one output row at a time */
+        Aba ^= Da;
+        Ba = Aba;
+        Age ^= De;
+        Be = ROL64(Age, 44);
+        Aki ^= Di;
+        Bi = ROL64(Aki, 43);
+        Amo ^= Do;
+        Bo = ROL64(Amo, 21);
+        Asu ^= Du;
+        Bu = ROL64(Asu, 14);
+        Eba = Ba ^ (~Be & Bi) ^ keccakf1600_rc[round];
+        Ebe = Be ^ (~Bi & Bo);
+        Ebi = Bi ^ (~Bo & Bu);
+        Ebo = Bo ^ (~Bu & Ba);
+        Ebu = Bu ^ (~Ba & Be);
+        Abo ^= Do;
+        Ba = ROL64(Abo, 28);
+        Agu ^= Du;
+        Be = ROL64(Agu, 20);
+        Aka ^= Da;
+        Bi = ROL64(Aka, 3);
+        Ame ^= De;
+        Bo = ROL64(Ame, 45);
+        Asi ^= Di;
+        Bu = ROL64(Asi, 61);
+        Ega = Ba ^ (~Be & Bi);
+        Ege = Be ^ (~Bi & Bo);
+        Egi = Bi ^ (~Bo & Bu);
+        Ego = Bo ^ (~Bu & Ba);
+        Egu = Bu ^ (~Ba & Be);
+        Abe ^= De;
+        Ba = ROL64(Abe, 1);
+        Agi ^= Di;
+        Be = ROL64(Agi, 6);
+        Ako ^= Do;
+        Bi = ROL64(Ako, 25);
+        Amu ^= Du;
+        Bo = ROL64(Amu, 8);
+        Asa ^= Da;
+        Bu = ROL64(Asa, 18);
+        Eka = Ba ^ (~Be & Bi);
+        Eke = Be ^ (~Bi & Bo);
+        Eki = Bi ^ (~Bo & Bu);
+        Eko = Bo ^ (~Bu & Ba);
+        Eku = Bu ^ (~Ba & Be);
+        Abu ^= Du;
+        Ba = ROL64(Abu, 27);
+        Aga ^= Da;
+        Be = ROL64(Aga, 36);
+        Ake ^= De;
+        Bi = ROL64(Ake, 10);
+        Ami ^= Di;
+        Bo = ROL64(Ami, 15);
+        Aso ^= Do;
+        Bu = ROL64(Aso, 56);
+        Ema = Ba ^ (~Be & Bi);
+        Eme = Be ^ (~Bi & Bo);
+        Emi = Bi ^ (~Bo & Bu);
+        Emo = Bo ^ (~Bu & Ba);
+        Emu = Bu ^ (~Ba & Be);
+        Abi ^= Di;
+        Ba = ROL64(Abi, 62);
+        Ago ^= Do;
+        Be = ROL64(Ago, 55);
+        Aku ^= Du;
+        Bi = ROL64(Aku, 39);
+        Ama ^= Da;
+        Bo = ROL64(Ama, 41);
+        Ase ^= De;
+        Bu = ROL64(Ase, 2);
+        Esa = Ba ^ (~Be & Bi);
+        Ese = Be ^ (~Bi & Bo);
+        Esi = Bi ^ (~Bo & Bu);
+        Eso = Bo ^ (~Bu & Ba);
+        Esu = Bu ^ (~Ba & Be);
+
+        /* theta */
+        Ca = Eba ^ Ega ^ Eka ^ Ema ^ Esa;
+        Ce = Ebe ^ Ege ^ Eke ^ Eme ^ Ese;
+        Ci = Ebi ^ Egi ^ Eki ^ Emi ^ Esi;
+        Co = Ebo ^ Ego ^ Eko ^ Emo ^ Eso;
+        Cu = Ebu ^ Egu ^ Eku ^ Emu ^ Esu;
+        Da = Cu ^ ROL64(Ce, 1);
+        De = Ca ^ ROL64(Ci, 1);
+        Di = Ce ^ ROL64(Co, 1);
+        Do = Ci ^ ROL64(Cu, 1);
+        Du = Co ^ ROL64(Ca, 1);
+        /* rho, pi, chi and iota, one output row at a time */
+        Eba ^= Da;
+        Ba = Eba;
+        Ege ^= De;
+        Be = ROL64(Ege, 44);
+        Eki ^= Di;
+        Bi = ROL64(Eki, 43);
+        Emo ^= Do;
+        Bo = ROL64(Emo, 21);
+        Esu ^= Du;
+        Bu = ROL64(Esu, 14);
+        Aba = Ba ^ (~Be & Bi) ^ keccakf1600_rc[round+1];
+        Abe = Be ^ (~Bi & Bo);
+        Abi = Bi ^ (~Bo & Bu);
+        Abo = Bo ^ (~Bu & Ba);
+        Abu = Bu ^ (~Ba & Be);
+        Ebo ^= Do;
+        Ba = ROL64(Ebo, 28);
+        Egu ^= Du;
+        Be = ROL64(Egu, 20);
+        Eka ^= Da;
+        Bi = ROL64(Eka, 3);
+        Eme ^= De;
+        Bo = ROL64(Eme, 45);
+        Esi ^= Di;
+        Bu = ROL64(Esi, 61);
+        Aga = Ba ^ (~Be & Bi);
+        Age = Be ^ (~Bi & Bo);
+        Agi = Bi ^ (~Bo & Bu);
+        Ago = Bo ^ (~Bu & Ba);
+        Agu = Bu ^ (~Ba & Be);
+        Ebe ^= De;
+        Ba = ROL64(Ebe, 1);
+        Egi ^= Di;
+        Be = ROL64(Egi, 6);
+        Eko ^= Do;
+        Bi = ROL64(Eko, 25);
+        Emu ^= Du;
+        Bo = ROL64(Emu, 8);
+        Esa ^= Da;
+        Bu = ROL64(Esa, 18);
+        Aka = Ba ^ (~Be & Bi);
+        Ake = Be ^ (~Bi & Bo);
+        Aki = Bi ^ (~Bo & Bu);
+        Ako = Bo ^ (~Bu & Ba);
+        Aku = Bu ^ (~Ba & Be);
+        Ebu ^= Du;
+        Ba = ROL64(Ebu, 27);
+        Ega ^= Da;
+        Be = ROL64(Ega, 36);
+        Eke ^= De;
+        Bi = ROL64(Eke, 10);
+        Emi ^= Di;
+        Bo = ROL64(Emi, 15);
+        Eso ^= Do;
+        Bu = ROL64(Eso, 56);
+        Ama = Ba ^ (~Be & Bi);
+        Ame = Be ^ (~Bi & Bo);
+        Ami = Bi ^ (~Bo & Bu);
+        Amo = Bo ^ (~Bu & Ba);
+        Amu = Bu ^ (~Ba & Be);
+        Ebi ^= Di;
+        Ba = ROL64(Ebi, 62);
+        Ego ^= Do;
+        Be = ROL64(Ego, 55);
+        Eku ^= Du;
+        Bi = ROL64(Eku, 39);
+        Ema ^= Da;
+        Bo = ROL64(Ema, 41);
+        Ese ^= De;
+        Bu = ROL64(Ese, 2);
+        Asa = Ba ^ (~Be & Bi);
+        Ase = Be ^ (~Bi & Bo);
+        Asi = Bi ^ (~Bo & Bu);
+        Aso = Bo ^ (~Bu & Ba);
+        Asu = Bu ^ (~Ba & Be);
+    }
+
+    state[0] = Aba; state[1] = Abe; state[2] = Abi; state[3] = Abo; state[4] = Abu;
+    state[5] = Aga; state[6] = Age; state[7] = Agi; state[8] = Ago; state[9] = Agu;
+    state[10] = Aka; state[11] = Ake; state[12] = Aki; state[13] = Ako; state[14] = Aku;
+    state[15] = Ama; state[16] = Ame; state[17] = Ami; state[18] = Amo; state[19] = Amu;
+    state[20] = Asa; state[21] = Ase; state[22] = Asi; state[23] = Aso; state[24] = Asu;
+}
@@ -31,6 +31,7 @@
 
 #pragma once
 
+#include "architecture_detect.h"
 #include "parameters.h"
 
 #if defined(RSDP)
@@ -45,7 +46,73 @@
 #define FZ_DOUBLE_ZERO_NORM(x) (((x) + (((x) + 1) >> 7)) & 0x7f)
 #endif
 
+#define NUM_BITS_Z (BITS_TO_REPRESENT(Z))
+
+#if defined(HIGH_PERFORMANCE_X86_64)
+/* Mersenne reduction modulo 2^nbits-1 of 32 bytes packed in a register, i.e.,
+ * FZRED_SINGLE resp. FPRED_SINGLE in RSDP. No _mm256_srli_epi8 is available:
+ * the 16-bit shift drags in bits from the adjacent byte, which are masked off */
+static inline
+__m256i mersenne_red_single_epi8(__m256i x, int nbits){
+    __m256i mred_mask = _mm256_set1_epi8((uint8_t)((1 << nbits) - 1));
+    __m256i shr_mask = _mm256_set1_epi8((uint8_t)(0xFF >> nbits));
+    __m256i hi = _mm256_and_si256(_mm256_srli_epi16(x, nbits), shr_mask);
+    return _mm256_add_epi8(_mm256_and_si256(x, mred_mask), hi);
+}
+
+/* Normalization of the redundant zero representation of 32 packed bytes, i.e.,
+ * FZ_DOUBLE_ZERO_NORM resp. FP_DOUBLE_ZERO_NORM in RSDP. To avoid the
+ * overflow of x+1 in 8-bit lanes, (x+1) >> nbits is computed as
+ * (x >> nbits) + ((x & mask) == mask) */
+static inline
+__m256i mersenne_dz_norm_epi8(__m256i x, int nbits){
+    __m256i mred_mask = _mm256_set1_epi8((uint8_t)((1 << nbits) - 1));
+    __m256i shr_mask = _mm256_set1_epi8((uint8_t)(0xFF >> nbits));
+    __m256i one = _mm256_set1_epi8(1);
+    __m256i hi = _mm256_and_si256(_mm256_srli_epi16(x, nbits), shr_mask);
+    __m256i carry = _mm256_cmpeq_epi8(_mm256_and_si256(x, mred_mask), mred_mask);
+    hi = _mm256_add_epi8(hi, _mm256_and_si256(carry, one));
+    return _mm256_and_si256(_mm256_add_epi8(x, hi), mred_mask);
+}
+
+/* a - b over 32 packed restricted exponents */
+static inline
+__m256i fz_sub_epi8(__m256i a, __m256i b){
+    __m256i mred_mask = _mm256_set1_epi8((uint8_t)Z);
+    return mersenne_red_single_epi8(
+               _mm256_add_epi8(a, _mm256_xor_si256(b, mred_mask)), NUM_BITS_Z);
+}
 
+static inline
+void fz_dz_norm_n(FZ_ELEM v[N]){
+    int i;
+    for (i = 0; i+EPI8_PER_REG <= N; i += EPI8_PER_REG){
+        __m256i v_w = _mm256_lddqu_si256((__m256i const *) &v[i]);
+        v_w = mersenne_dz_norm_epi8(v_w, NUM_BITS_Z);
+        _mm256_storeu_si256((__m256i *) &v[i], v_w);
+    }
+    for (; i < N; i++){
+       v[i] = FZ_DOUBLE_ZERO_NORM(v[i]);
+    }
+}
+
+/* Elements of the restricted subgroups are represented as the exponents of
+ * the generator */
+static inline
+void fz_vec_sub_n(FZ_ELEM res[N],
+                  const FZ_ELEM a[N],
+                  const FZ_ELEM b[N]){
+    int i;
+    for(i = 0; i+EPI8_PER_REG <= N; i += EPI8_PER_REG){
+        __m256i a_w = _mm256_lddqu_si256((__m256i const *) &a[i]);
+        __m256i b_w = _mm256_lddqu_si256((__m256i const *) &b[i]);
+        _mm256_storeu_si256((__m256i *) &res[i], fz_sub_epi8(a_w, b_w));
+    }
+    for(; i < N; i++){
+        res[i]= FZRED_SINGLE( a[i] + FZRED_OPPOSITE(b[i]) );
+    }
+}
+#else /* no AVX2, fallback to the reference implementation */
 static inline
 void fz_dz_norm_n(FZ_ELEM v[N]){
     for (int i = 0; i < N; i++){
@@ -63,6 +130,7 @@ void fz_vec_sub_n(FZ_ELEM res[N],
         res[i]= FZRED_SINGLE( a[i] + FZRED_OPPOSITE(b[i]) );
     }
 }
+#endif /* defined(HIGH_PERFORMANCE_X86_64) */
 
 static inline
 int is_fz_vec_in_restr_group_n(const FZ_ELEM in[N]){
@@ -134,6 +202,22 @@ void fz_inf_w_by_fz_matrix(FZ_ELEM res[N],
 }
 #endif
 
+#if defined(HIGH_PERFORMANCE_X86_64)
+static inline
+void fz_vec_sub_m(FZ_ELEM res[M],
+                  const FZ_ELEM a[M],
+                  const FZ_ELEM b[M]){
+    int i;
+    for(i = 0; i+EPI8_PER_REG <= M; i += EPI8_PER_REG){
+        __m256i a_w = _mm256_lddqu_si256((__m256i const *) &a[i]);
+        __m256i b_w = _mm256_lddqu_si256((__m256i const *) &b[i]);
+        _mm256_storeu_si256((__m256i *) &res[i], fz_sub_epi8(a_w, b_w));
+    }
+    for(; i < M; i++){
+        res[i]= FZRED_SINGLE( a[i] + FZRED_OPPOSITE(b[i]) );
+    }
+}
+#else
 static inline
 void fz_vec_sub_m(FZ_ELEM res[M],
                   const FZ_ELEM a[M],
@@ -142,6 +226,7 @@ void fz_vec_sub_m(FZ_ELEM res[M],
         res[i]= FZRED_SINGLE( a[i] + FZRED_OPPOSITE(b[i]) );
     }
 }
+#endif
 
 static inline
 int is_fz_vec_in_restr_group_m(const FZ_ELEM in[M]){
@@ -151,6 +236,20 @@ int is_fz_vec_in_restr_group_m(const FZ_ELEM in[M]){
     }
     return is_in_ok;
 }
+#if defined(HIGH_PERFORMANCE_X86_64)
+static inline
+void fz_dz_norm_m(FZ_ELEM v[M]){
+    int i;
+    for (i = 0; i+EPI8_PER_REG <= M; i += EPI8_PER_REG){
+        __m256i v_w = _mm256_lddqu_si256((__m256i const *) &v[i]);
+        v_w = mersenne_dz_norm_epi8(v_w, NUM_BITS_Z);
+        _mm256_storeu_si256((__m256i *) &v[i], v_w);
+    }
+    for (; i < M; i++){
+       v[i] = FZ_DOUBLE_ZERO_NORM(v[i]);
+    }
+}
+#else
 static inline
 void fz_dz_norm_m(FZ_ELEM v[M]){
     for (int i = 0; i < M; i++){
@@ -158,3 +257,4 @@ void fz_dz_norm_m(FZ_ELEM v[M]){
     }
 }
 #endif
+#endif
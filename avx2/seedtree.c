@@ -33,7 +33,9 @@
 #include <string.h> // memcpy(...), memset(...)
 
 #include "csprng_hash.h"
+#include "hash_stats.h"
 #include "seedtree.h"
+#include "tree_tables.h"
 
 #define LEFT_CHILD(i) (2*(i)+1)
 #define RIGHT_CHILD(i) (2*(i)+2)
@@ -45,7 +47,6 @@
  */
 
 #define TO_PUBLISH 1
-#define NOT_TO_PUBLISH 0
 
 #if defined(NO_TREES)
 int seed_leaves(unsigned char rounds_seeds[T*SEED_LENGTH_BYTES],
@@ -89,6 +90,7 @@ int seed_leaves(unsigned char rounds_seeds[T*SEED_LENGTH_BYTES],
    }
 
    /* make 4 (parallel) calls to the CSPRNG */
+   HASH_STATS_PAR(HASH_STATS_SITE_SEED_LEAVES, 4);
    csprng_initialize_par(
         4,
         &par_csprng_state, 
@@ -125,214 +127,258 @@ int seed_leaves(unsigned char rounds_seeds[T*SEED_LENGTH_BYTES],
 
 int seed_path(unsigned char *seed_storage,
               const unsigned char rounds_seeds[T*SEED_LENGTH_BYTES],
-              const unsigned char indices_to_publish[T]){
-    int published = 0;
-    for(int i=0; i<T; i++){
-       if(indices_to_publish[i] == TO_PUBLISH){
-          memcpy(&seed_storage[SEED_LENGTH_BYTES*published],
-                 &rounds_seeds[i*SEED_LENGTH_BYTES],
-                 SEED_LENGTH_BYTES);
-          published++;
-       }
+              const chall_2_t *chall_2){
+    for(int i=0; i<W; i++){
+       memcpy(&seed_storage[SEED_LENGTH_BYTES*i],
+              &rounds_seeds[chall_2->rounds_1[i]*SEED_LENGTH_BYTES],
+              SEED_LENGTH_BYTES);
     }
-    return published;
+    return W;
 }
 
 /* simply picks seeds out of the storage and places them in the in-memory array */
 uint8_t rebuild_leaves(unsigned char rounds_seeds[T*SEED_LENGTH_BYTES],
-                       const unsigned char indices_to_publish[T],
+                       const chall_2_t *chall_2,
                        const unsigned char *seed_storage){
-    int published = 0;
-    for(int i=0; i<T; i++){
-       if(indices_to_publish[i] == TO_PUBLISH){
-           memcpy(&rounds_seeds[i*SEED_LENGTH_BYTES],
-                  &seed_storage[SEED_LENGTH_BYTES*published],
-                  SEED_LENGTH_BYTES);
-           published++;
-       }
-   }      
+    for(int i=0; i<W; i++){
+       memcpy(&rounds_seeds[chall_2->rounds_1[i]*SEED_LENGTH_BYTES],
+              &seed_storage[SEED_LENGTH_BYTES*i],
+              SEED_LENGTH_BYTES);
+    }
+    return 1;
+}
+
+uint8_t is_seed_path_padding_ok(const chall_2_t *chall_2,
+                                const unsigned char *seed_storage){
+   /* the path holds exactly W seeds, there is no padding to check */
+   (void)chall_2;
+   (void)seed_storage;
    return 1;
 }
 #else
-/*****************************************************************************/
-/**
- * const unsigned char *indices: input parameter denoting an array
- * with a number of binary cells equal to "leaves" representing
- * the labels of the nodes identified as leaves of the tree[...]
- * passed as second parameter.
- * A label = 1 means that the byteseed of the node having the same index
- * has to be released; = 0, otherwise.
- *
- * unsigned char *tree: input/output parameter denoting an array
- * with a number of binary cells equal to "2*leaves-1";
- * the first "leaves" cells (i.e., the ones with positions from 0 to leaves-1)
- * are the ones that will be modified by the current subroutine,
- * the last "leaves" cells will be a copy of the input array passed as first
- * parameter.
- *
- * uint64_t leaves: input parameter;
- *
- */
-
+/* Nodes waiting to be expanded by one of the 4 lanes of the CSPRNG. Each lane
+ * walks its subtrees depth first, thus it holds at most one pending node per
+ * level, but for the deepest one where it may hold two siblings */
+#define LANE_MAX_PENDING (LOG2(T)+1)
+
+typedef struct {
+    int cnt;
+    uint16_t node[LANE_MAX_PENDING];
+    uint8_t level[LANE_MAX_PENDING];
+    unsigned char seed[LANE_MAX_PENDING][SEED_LENGTH_BYTES];
+} seed_tree_lane_t;
+
+/* position of a leaf node among the round seeds, as laid out by seed_leaves */
 static
-void label_leaves(unsigned char flag_tree[NUM_NODES_SEED_TREE],
-                     const unsigned char indices_to_publish[T])
-{
+int leaf_to_round(uint16_t node){
     const uint16_t cons_leaves[TREE_SUBROOTS] = TREE_CONSECUTIVE_LEAVES;
     const uint16_t leaves_start_indices[TREE_SUBROOTS] = TREE_LEAVES_START_INDICES;
 
-    unsigned int cnt = 0;
-    for (size_t i=0; i<TREE_SUBROOTS; i++) {
-        for (size_t j=0; j<cons_leaves[i]; j++) {
-            flag_tree[leaves_start_indices[i]+j] = indices_to_publish[cnt];
-            cnt++;
-        }
+    /* the leaves of a subtree come after the ones of the following,
+     * shallower, subtrees */
+    int cnt = 0;
+    size_t i = 0;
+    while (i+1 < TREE_SUBROOTS && node < leaves_start_indices[i]) {
+        cnt += cons_leaves[i];
+        i++;
     }
+    return cnt + (node - leaves_start_indices[i]);
 }
 
-static void compute_seeds_to_publish(
-    /* linearized binary tree of boolean nodes containing
-     * flags for each node 1-filled nodes are to be released */
-    unsigned char flags_tree_to_publish[NUM_NODES_SEED_TREE],
-    /* Boolean Array indicating which of the T seeds must be
-     * released convention as per the above defines */
-    const unsigned char indices_to_publish[T]) {
-    /* the indices to publish may be less than the full leaves, copy them
-     * into the linearized tree leaves */
-    label_leaves(flags_tree_to_publish, indices_to_publish);
-
-    const uint16_t off[LOG2(T)+1] = TREE_OFFSETS;
-    const uint16_t npl[LOG2(T)+1] = TREE_NODES_PER_LEVEL;
-    const uint16_t leaves_start_indices[TREE_SUBROOTS] = TREE_LEAVES_START_INDICES;
-
-    /* compute the value for the internal nodes of the tree starting from the
-     * the leaves, right to left */
-    unsigned int start_node = leaves_start_indices[0];
-    for (int level=LOG2(T); level>0; level--) {
-        for (int i=npl[level]-2; i>=0; i-=2) {
-            uint16_t current_node = start_node + i;
-            uint16_t parent_node = PARENT(current_node) + (off[level-1] >> 1);
-
-            flags_tree_to_publish[parent_node] = (flags_tree_to_publish[current_node] == TO_PUBLISH)
-                && (flags_tree_to_publish[SIBLING(current_node)] == TO_PUBLISH);
-        }
-        start_node -= npl[level-1];
-    }
-} /* end compute_seeds_to_publish */
-
-/**
- * unsigned char *seed_tree:
- * it is intended as an output parameter;
- * storing the linearized seed tree
- *
- * The root seed is taken as a parameter.
- * The seed of its TWO children are computed expanding (i.e., shake128...) the
- * entropy in "salt" + "seedBytes of the parent" +
- *            "int, encoded over 16 bits - uint16_t,  associated to each node
- *             from roots to leaves layer-by-layer from left to right,
- *             counting from 0 (the integer bound with the root node)"
- */
-void gen_seed_tree(unsigned char seed_tree[NUM_NODES_SEED_TREE * SEED_LENGTH_BYTES],
-                   const unsigned char root_seed[SEED_LENGTH_BYTES],
-                   const unsigned char salt[SALT_LENGTH_BYTES])
+/* Expands the seed tree from the root, storing all the nodes in seed_tree,
+ * if it is not NULL, and the leaves in rounds_seeds, if it is not NULL.
+ * The children of a node only depend on its seed and index, so the nodes are
+ * expanded in subtree order rather than level by level: every lane takes the
+ * deepest node of its subtrees, and a lane running out of them takes over the
+ * shallowest (i.e., largest) pending subtree of the busiest lane. Thus all 4
+ * lanes are busy but for the first two levels and the last expansion. */
+static
+void seed_tree_expand(unsigned char *seed_tree,
+                      unsigned char *rounds_seeds,
+                      const unsigned char root_seed[SEED_LENGTH_BYTES],
+                      const unsigned char salt[SALT_LENGTH_BYTES])
 {
     PAR_CSPRNG_STATE_T tree_csprng_state;
 
     /* CSPRNG input: father seed | salt | father node index
      * CSPRNG output: left child seed | right child seed */
-
-    /* enqueue the calls to the CSPRNG */
-    int to_expand = 0;
     unsigned char in_queue[4][CSPRNG_INPUT_LENGTH];
-    uint16_t in_queue_dsc[4];
-    int out_pos_queue[4] = {0};
+    uint16_t in_queue_dsc[4] = {0};
+    unsigned char out_queue[4][2*SEED_LENGTH_BYTES];
+    unsigned char *out_pos_queue[4];
+    /* left child index and level, and lane of each expanded node */
+    uint16_t node_queue[4];
+    uint8_t level_queue[4];
+    int lane_queue[4];
 
     /* copy the salt into all 4 CSPRNG inputs */
     for(int i=0; i<4; i++){
         memcpy(in_queue[i]+SEED_LENGTH_BYTES, salt, SALT_LENGTH_BYTES);
+        out_pos_queue[i] = out_queue[i];
     }
 
-    /* Set the root seed in the tree from the received parameter */
-    memcpy(seed_tree,root_seed,SEED_LENGTH_BYTES);
+    if(seed_tree != NULL){
+        memcpy(seed_tree,root_seed,SEED_LENGTH_BYTES);
+    }
 
     /* off contains the offsets required to move between two layers in order
      * to compensate for the truncation.
      * npl contains the number of nodes per level.
-     * lpl contains the number of leaves per level 
+     * lpl contains the number of leaves per level, which are the last ones
+     * of the level
      * */
     const uint16_t off[LOG2(T)+1] = TREE_OFFSETS;
     const uint16_t npl[LOG2(T)+1] = TREE_NODES_PER_LEVEL;
     const uint16_t lpl[LOG2(T)+1] = TREE_LEAVES_PER_LEVEL;
+    uint16_t start_node[LOG2(T)+1];
+    start_node[0] = 0;
+    for (int level = 1; level <= LOG2(T); level++){
+        start_node[level] = start_node[level-1] + npl[level-1];
+    }
 
-    /* Generate the log_2(t) layers from the root, each iteration generates a tree
-     * level; iterate on nodes of the parent level; the leaf nodes on each level 
-     * don't need to be expanded, thus only iterate to npl[level]-lpl[level] */
-    int start_node = 0;
-    for (int level = 0; level < LOG2(T); level++){
-        for (int node_in_level = 0; node_in_level < npl[level]-lpl[level]; node_in_level++ ) {
+    seed_tree_lane_t lanes[4];
+    for(int l=0; l<4; l++){
+        lanes[l].cnt = 0;
+    }
+    lanes[0].node[0] = 0;
+    lanes[0].level[0] = 0;
+    memcpy(lanes[0].seed[0], root_seed, SEED_LENGTH_BYTES);
+    lanes[0].cnt = 1;
+
+    for(;;){
+        /* idle lanes take the shallowest pending node of the busiest lane */
+        for(int l=0; l<4; l++){
+            if(lanes[l].cnt > 0){
+                continue;
+            }
+            int busiest = 0;
+            for(int k=1; k<4; k++){
+                if(lanes[k].cnt > lanes[busiest].cnt){
+                    busiest = k;
+                }
+            }
+            seed_tree_lane_t *from = &lanes[busiest];
+            if(from->cnt < 2){
+                continue;
+            }
+            lanes[l].node[0] = from->node[0];
+            lanes[l].level[0] = from->level[0];
+            memcpy(lanes[l].seed[0], from->seed[0], SEED_LENGTH_BYTES);
+            lanes[l].cnt = 1;
+            from->cnt--;
+            memmove(from->node, from->node+1, from->cnt*sizeof(from->node[0]));
+            memmove(from->level, from->level+1, from->cnt*sizeof(from->level[0]));
+            memmove(from->seed, from->seed+1, from->cnt*SEED_LENGTH_BYTES);
+        }
 
+        /* each busy lane expands its deepest pending node */
+        int to_expand = 0;
+        for(int l=0; l<4; l++){
+            seed_tree_lane_t *lane = &lanes[l];
+            if(lane->cnt == 0){
+                continue;
+            }
+            lane->cnt--;
+            uint16_t father_node = lane->node[lane->cnt];
+            uint8_t level = lane->level[lane->cnt];
+            memcpy(in_queue[to_expand], lane->seed[lane->cnt], SEED_LENGTH_BYTES);
+            in_queue_dsc[to_expand] = CSPRNG_DOMAIN_SEP_CONST + father_node;
+            node_queue[to_expand] = LEFT_CHILD(father_node) - off[level];
+            level_queue[to_expand] = level+1;
+            lane_queue[to_expand] = l;
+            if(seed_tree != NULL){
+                out_pos_queue[to_expand] = seed_tree + node_queue[to_expand]*SEED_LENGTH_BYTES;
+            }
             to_expand++;
-            uint16_t father_node = start_node + node_in_level;
-            uint16_t left_child_node = LEFT_CHILD(father_node) - off[level];
-
-            /* save the father seed in the CSPRNG input */
-            memcpy(in_queue[to_expand-1],
-                    seed_tree + father_node*SEED_LENGTH_BYTES,
-                    SEED_LENGTH_BYTES);
-
-            /* save the position of the CSPRNG output (the left child) */
-            out_pos_queue[to_expand-1] = left_child_node*SEED_LENGTH_BYTES;  
+        }
+        if(to_expand == 0){
+            break;
+        }
 
-            /* add a domain separator to the CSPRNG input (the index of the father node) */
-            in_queue_dsc[to_expand-1] = CSPRNG_DOMAIN_SEP_CONST + father_node;
-
-            /* call CSPRNG in batches of 4 (or less when changing tree level) */
-            if(to_expand == 4 || node_in_level == (npl[level]-lpl[level] - 1)) {
-                csprng_initialize_par(
-                    to_expand, 
-                    &tree_csprng_state, 
-                    in_queue[0],
-                    in_queue[1],
-                    in_queue[2],
-                    in_queue[3],
-                    CSPRNG_INPUT_LENGTH,
-                    in_queue_dsc[0],
-                    in_queue_dsc[1],
-                    in_queue_dsc[2],
-                    in_queue_dsc[3]);
-                csprng_randombytes_par(
-                    to_expand, 
-                    &tree_csprng_state, 
-                    seed_tree + out_pos_queue[0],
-                    seed_tree + out_pos_queue[1],
-                    seed_tree + out_pos_queue[2],
-                    seed_tree + out_pos_queue[3],
-                    2*SEED_LENGTH_BYTES);
-                /* PQClean-edit: CSPRNG release context */
-                csprng_release_par(to_expand, &tree_csprng_state);
-                to_expand = 0;
+        HASH_STATS_PAR(HASH_STATS_SITE_GEN_SEED_TREE, to_expand);
+        csprng_initialize_par(
+            to_expand,
+            &tree_csprng_state,
+            in_queue[0],
+            in_queue[1],
+            in_queue[2],
+            in_queue[3],
+            CSPRNG_INPUT_LENGTH,
+            in_queue_dsc[0],
+            in_queue_dsc[1],
+            in_queue_dsc[2],
+            in_queue_dsc[3]);
+        csprng_randombytes_par(
+            to_expand,
+            &tree_csprng_state,
+            out_pos_queue[0],
+            out_pos_queue[1],
+            out_pos_queue[2],
+            out_pos_queue[3],
+            2*SEED_LENGTH_BYTES);
+        /* PQClean-edit: CSPRNG release context */
+        csprng_release_par(to_expand, &tree_csprng_state);
+
+        /* children which are not leaves are pushed onto the lane which
+         * generated them, right child first so that the left one is expanded
+         * first; leaves are round seeds */
+        for(int q=0; q<to_expand; q++){
+            seed_tree_lane_t *lane = &lanes[lane_queue[q]];
+            for(int c=1; c>=0; c--){
+                uint16_t child = node_queue[q]+c;
+                uint8_t level = level_queue[q];
+                const unsigned char *child_seed = out_pos_queue[q]+c*SEED_LENGTH_BYTES;
+                if(child-start_node[level] < npl[level]-lpl[level]){
+                    lane->node[lane->cnt] = child;
+                    lane->level[lane->cnt] = level;
+                    memcpy(lane->seed[lane->cnt], child_seed, SEED_LENGTH_BYTES);
+                    lane->cnt++;
+                } else if(rounds_seeds != NULL){
+                    memcpy(rounds_seeds + leaf_to_round(child)*SEED_LENGTH_BYTES,
+                           child_seed,
+                           SEED_LENGTH_BYTES);
+                }
             }
         }
-        start_node += npl[level];
     }
+} /* end seed_tree_expand */
+
+/**
+ * unsigned char *seed_tree:
+ * it is intended as an output parameter;
+ * storing the linearized seed tree
+ *
+ * The root seed is taken as a parameter.
+ * The seed of its TWO children are computed expanding (i.e., shake128...) the
+ * entropy in "salt" + "seedBytes of the parent" +
+ *            "int, encoded over 16 bits - uint16_t,  associated to each node
+ *             from roots to leaves layer-by-layer from left to right,
+ *             counting from 0 (the integer bound with the root node)"
+ */
+void gen_seed_tree(unsigned char seed_tree[NUM_NODES_SEED_TREE * SEED_LENGTH_BYTES],
+                   const unsigned char root_seed[SEED_LENGTH_BYTES],
+                   const unsigned char salt[SALT_LENGTH_BYTES])
+{
+    seed_tree_expand(seed_tree, NULL, root_seed, salt);
 } /* end generate_seed_tree */
 
+void gen_seed_tree_leaves(unsigned char *seed_tree,
+                          unsigned char rounds_seeds[T*SEED_LENGTH_BYTES],
+                          const unsigned char root_seed[SEED_LENGTH_BYTES],
+                          const unsigned char salt[SALT_LENGTH_BYTES])
+{
+    seed_tree_expand(seed_tree, rounds_seeds, root_seed, salt);
+}
+
 
 /*****************************************************************************/
 void seed_leaves(unsigned char rounds_seeds[T*SEED_LENGTH_BYTES],
                  unsigned char seed_tree[NUM_NODES_SEED_TREE*SEED_LENGTH_BYTES])
 {
-    const uint16_t cons_leaves[TREE_SUBROOTS] = TREE_CONSECUTIVE_LEAVES;
-    const uint16_t leaves_start_indices[TREE_SUBROOTS] = TREE_LEAVES_START_INDICES;
-
-    unsigned int cnt = 0;
-    for (size_t i=0; i<TREE_SUBROOTS; i++) {
-        for (size_t j=0; j<cons_leaves[i]; j++) {
-            memcpy(rounds_seeds + cnt*SEED_LENGTH_BYTES,
-                   seed_tree + (leaves_start_indices[i]+j)*SEED_LENGTH_BYTES,
-                   SEED_LENGTH_BYTES);
-            cnt++;
-        }
+    for (size_t i=0; i<T; i++) {
+        memcpy(rounds_seeds + i*SEED_LENGTH_BYTES,
+               seed_tree + TREE_LEAF_NODES[i]*SEED_LENGTH_BYTES,
+               SEED_LENGTH_BYTES);
     }
 }
 
@@ -343,30 +389,25 @@ int seed_path(unsigned char *seed_storage,
               const unsigned char
               seed_tree[NUM_NODES_SEED_TREE*SEED_LENGTH_BYTES],
               // INPUT: linearized seedtree array with 2T-1 nodes each of size SEED_LENGTH_BYTES
-              const unsigned char indices_to_publish[T]
-              // INPUT: binary array denoting which node has to be released (cell == TO_PUBLISH) or not
+              const chall_2_t *chall_2
+              // INPUT: the seeds of the rounds where chall_2 is TO_PUBLISH are released
               ){
-    /* complete linearized binary tree containing boolean values determining
-     * if a node is to be released or not according to convention above.
-     * */
-    unsigned char flags_tree_to_publish[NUM_NODES_SEED_TREE] = {NOT_TO_PUBLISH};
-    compute_seeds_to_publish(flags_tree_to_publish, indices_to_publish);
+    /* flags of the nodes whose subtree has only leaves to be released: the
+     * ones to be released are the flagged nodes whose parent is not */
+    tree_flags_t flags;
+    tree_flags(&flags, chall_2, TO_PUBLISH, 1);
 
-    const uint16_t off[LOG2(T)+1] = TREE_OFFSETS;
     const uint16_t npl[LOG2(T)+1] = TREE_NODES_PER_LEVEL;
 
     /* no sense in trying to publish the root node, start examining from level 1 */
     int start_node = 1;
     int num_seeds_published = 0;
     for (int level = 1; level <= LOG2(T); level++){
-        for (int node_in_level = 0; node_in_level < npl[level]; node_in_level++ ) {
-            uint16_t current_node = start_node + node_in_level;
-            uint16_t father_node = PARENT(current_node) + (off[level-1] >> 1);
-
-            /* if seed is to published and its ancestor/parent node is not,
-             * add it to the seed storage */
-            if ( (flags_tree_to_publish[current_node] == TO_PUBLISH) &&
-                (flags_tree_to_publish[father_node] == NOT_TO_PUBLISH) ) {
+        for (int c = 0; 64*c < npl[level]; c++) {
+            uint64_t to_publish = tree_flags_subroots(&flags, level, c);
+            while (to_publish != 0) {
+                uint16_t current_node = start_node + 64*c + bits_lowest(to_publish);
+                to_publish &= to_publish-1;
                 memcpy(seed_storage + num_seeds_published*SEED_LENGTH_BYTES,
                         seed_tree + current_node*SEED_LENGTH_BYTES,
                         SEED_LENGTH_BYTES);
@@ -379,21 +420,70 @@ int seed_path(unsigned char *seed_storage,
 } /* end publish_seeds */
 
 /*****************************************************************************/
+/* expands the to_expand <= 4 seeds in the queue, each into the two children
+ * found at out_pos_queue */
+static
+void expand_queued_seeds(unsigned char seed_tree[NUM_NODES_SEED_TREE*SEED_LENGTH_BYTES],
+                         int to_expand,
+                         unsigned char in_queue[4][CSPRNG_INPUT_LENGTH],
+                         const uint16_t in_queue_dsc[4],
+                         const int out_pos_queue[4])
+{
+    PAR_CSPRNG_STATE_T tree_csprng_state;
+    HASH_STATS_PAR(HASH_STATS_SITE_REBUILD_TREE, to_expand);
+    csprng_initialize_par(
+        to_expand, 
+        &tree_csprng_state, 
+        in_queue[0],
+        in_queue[1],
+        in_queue[2],
+        in_queue[3],
+        CSPRNG_INPUT_LENGTH,
+        in_queue_dsc[0],
+        in_queue_dsc[1],
+        in_queue_dsc[2],
+        in_queue_dsc[3]);
+    csprng_randombytes_par(
+        to_expand, 
+        &tree_csprng_state, 
+        seed_tree + out_pos_queue[0],
+        seed_tree + out_pos_queue[1],
+        seed_tree + out_pos_queue[2],
+        seed_tree + out_pos_queue[3],
+        2*SEED_LENGTH_BYTES);
+    /* PQClean-edit: CSPRNG release context */
+    csprng_release_par(to_expand, &tree_csprng_state);
+}
 
-uint8_t rebuild_tree(unsigned char
-                     seed_tree[NUM_NODES_SEED_TREE*SEED_LENGTH_BYTES],
-                     const unsigned char indices_to_publish[T],
-                     const unsigned char *stored_seeds,
-                     const unsigned char salt[SALT_LENGTH_BYTES])
+/*****************************************************************************/
+
+void rebuild_tree_init(seed_tree_rebuild_t *rebuild,
+                       const chall_2_t *chall_2)
 {
-    /* complete linearized binary tree containing boolean values determining
-     * if a node is to be released or not according to aboves convention
-     */
-    unsigned char flags_tree_to_publish[NUM_NODES_SEED_TREE] = {0};
-    compute_seeds_to_publish(flags_tree_to_publish, indices_to_publish);
+    /* flags of the nodes whose subtree has only leaves to be rebuilt: the
+     * published seeds are the flagged nodes whose parent is not */
+    tree_flags(&rebuild->flags, chall_2, TO_PUBLISH, 1);
 
-    PAR_CSPRNG_STATE_T tree_csprng_state;
+    /* regenerating the seed tree never starts from the root, as it is never
+     * disclosed */
+    rebuild->level = 1;
+    rebuild->c = 0;
+    rebuild->start_node = 1;
+    rebuild->word_level = 1;
+    rebuild->word_node = 1;
+    rebuild->to_expand = 0;
+    rebuild->nodes_used = 0;
+}
+
+/*****************************************************************************/
 
+int rebuild_tree_step(seed_tree_rebuild_t *rebuild,
+                      unsigned char
+                      seed_tree[NUM_NODES_SEED_TREE*SEED_LENGTH_BYTES],
+                      const unsigned char *stored_seeds,
+                      const unsigned char salt[SALT_LENGTH_BYTES],
+                      int max_nodes)
+{
     /* enqueue the calls to the CSPRNG */
     int to_expand = 0;
     unsigned char in_queue[4][CSPRNG_INPUT_LENGTH];
@@ -409,82 +499,130 @@ uint8_t rebuild_tree(unsigned char
     const uint16_t npl[LOG2(T)+1] = TREE_NODES_PER_LEVEL;
     const uint16_t lpl[LOG2(T)+1] = TREE_LEAVES_PER_LEVEL;
 
-    /* regenerating the seed tree never starts from the root, as it is never
-     * disclosed */
-    int nodes_used = 0;
-    int start_node = 1;
-    for (int level = 1; level <= LOG2(T); level++){
-        for (int node_in_level = 0; node_in_level < npl[level]; node_in_level++ ) {
-
-            uint16_t current_node = start_node + node_in_level;
-            uint16_t father_node = PARENT(current_node) + (off[level-1] >> 1);
-            uint16_t left_child = LEFT_CHILD(current_node) - off[level];
-
-            /* if the current node is a seed which was published (thus its father 
-             * was not), memcpy it in place */
-            if ( flags_tree_to_publish[current_node] == TO_PUBLISH ) {
-                if ( flags_tree_to_publish[father_node] == NOT_TO_PUBLISH ) {
-                    memcpy(seed_tree + current_node*SEED_LENGTH_BYTES,
-                            stored_seeds + nodes_used*SEED_LENGTH_BYTES,
-                            SEED_LENGTH_BYTES );
-                    nodes_used++;
-                }
-            }
-            /* If the current node is published and not a leaf, CSPRNG-expand its children.
-             * Since there is no reason of expanding leaves, only iterate to nodes per level (npl)
-             * minus leaves per level (lpl) in each level */
-            if ( ( flags_tree_to_publish[current_node] == TO_PUBLISH ) && (node_in_level < npl[level]-lpl[level] ) ) {
-                
-                to_expand++;
-                
-                /* save the father seed in the CSPRNG input */
-                memcpy(in_queue[to_expand-1],
-                        seed_tree + current_node*SEED_LENGTH_BYTES,
-                        SEED_LENGTH_BYTES);
+    for (;;) {
+        while (rebuild->to_expand != 0 && max_nodes > 0) {
+            uint16_t current_node = rebuild->word_node + bits_lowest(rebuild->to_expand);
+            uint16_t left_child = LEFT_CHILD(current_node) - off[rebuild->word_level];
+            rebuild->to_expand &= rebuild->to_expand-1;
+            max_nodes--;
 
-                /* save the position of the CSPRNG output (the left child) */
-                out_pos_queue[to_expand-1] = left_child*SEED_LENGTH_BYTES; 
+            to_expand++;
 
-                /* add a domain separator to the CSPRNG input (the index of the father node) */
-                in_queue_dsc[to_expand-1] = CSPRNG_DOMAIN_SEP_CONST + current_node;
-            }
+            /* save the father seed in the CSPRNG input */
+            memcpy(in_queue[to_expand-1],
+                    seed_tree + current_node*SEED_LENGTH_BYTES,
+                    SEED_LENGTH_BYTES);
+
+            /* save the position of the CSPRNG output (the left child) */
+            out_pos_queue[to_expand-1] = left_child*SEED_LENGTH_BYTES; 
+
+            /* add a domain separator to the CSPRNG input (the index of the father node) */
+            in_queue_dsc[to_expand-1] = CSPRNG_DOMAIN_SEP_CONST + current_node;
 
-            /* call CSPRNG in batches of 4 (or less when changing tree level) */
-            if(to_expand == 4 || node_in_level == (npl[level]-lpl[level] - 1)) {
-                csprng_initialize_par(
-                    to_expand, 
-                    &tree_csprng_state, 
-                    in_queue[0],
-                    in_queue[1],
-                    in_queue[2],
-                    in_queue[3],
-                    CSPRNG_INPUT_LENGTH,
-                    in_queue_dsc[0],
-                    in_queue_dsc[1],
-                    in_queue_dsc[2],
-                    in_queue_dsc[3]);
-                csprng_randombytes_par(
-                    to_expand, 
-                    &tree_csprng_state, 
-                    seed_tree + out_pos_queue[0],
-                    seed_tree + out_pos_queue[1],
-                    seed_tree + out_pos_queue[2],
-                    seed_tree + out_pos_queue[3],
-                    2*SEED_LENGTH_BYTES);
-                /* PQClean-edit: CSPRNG release context */
-                csprng_release_par(to_expand, &tree_csprng_state);
+            /* call CSPRNG in batches of 4 */
+            if(to_expand == 4) {
+                expand_queued_seeds(seed_tree, to_expand, in_queue, in_queue_dsc, out_pos_queue);
                 to_expand = 0;
             }
         }
-        start_node += npl[level];
+        if (rebuild->to_expand != 0 || max_nodes == 0 ||
+            rebuild->level > LOG2(T)) {
+            break;
+        }
+
+        /* the remaining ones, before moving to the children level */
+        if (to_expand > 0 && rebuild->level != rebuild->word_level) {
+            expand_queued_seeds(seed_tree, to_expand, in_queue, in_queue_dsc, out_pos_queue);
+            to_expand = 0;
+        }
+
+        /* the published seeds of the next word (flagged nodes whose father
+         * is not) are memcpy'd in place */
+        int level = rebuild->level;
+        int c = rebuild->c;
+        uint64_t published = tree_flags_subroots(&rebuild->flags, level, c);
+        while (published != 0) {
+            uint16_t current_node = rebuild->start_node + 64*c + bits_lowest(published);
+            published &= published-1;
+            memcpy(seed_tree + current_node*SEED_LENGTH_BYTES,
+                    stored_seeds + rebuild->nodes_used*SEED_LENGTH_BYTES,
+                    SEED_LENGTH_BYTES );
+            rebuild->nodes_used++;
+        }
+
+        /* flagged nodes which are not leaves are CSPRNG-expanded; the
+         * leaves of a level are its rightmost lpl nodes */
+        rebuild->to_expand = rebuild->flags.level[level][c] &
+                             bits_mask(npl[level]-lpl[level]-64*c);
+        rebuild->word_level = level;
+        rebuild->word_node = rebuild->start_node + 64*c;
+
+        rebuild->c++;
+        if (64*rebuild->c >= npl[level]) {
+            rebuild->c = 0;
+            rebuild->start_node += npl[level];
+            rebuild->level++;
+        }
     }
 
+    /* the ones left at the end of the step */
+    if (to_expand > 0) {
+        expand_queued_seeds(seed_tree, to_expand, in_queue, in_queue_dsc, out_pos_queue);
+    }
+    return rebuild->to_expand == 0 && rebuild->level > LOG2(T);
+}
+
+/*****************************************************************************/
+
+uint8_t rebuild_tree_finish(const seed_tree_rebuild_t *rebuild,
+                            const unsigned char *stored_seeds)
+{
     // Check for correct zero padding in the remaining parth of the seed path to 
     // prevent trivial forgery
     uint8_t error = 0;
-    for (int i=nodes_used*SEED_LENGTH_BYTES; i<TREE_NODES_TO_STORE*SEED_LENGTH_BYTES; i++) {
+    for (int i=rebuild->nodes_used*SEED_LENGTH_BYTES; i<TREE_NODES_TO_STORE*SEED_LENGTH_BYTES; i++) {
         error |= stored_seeds[i];
     }
     return (error == 0);
+}
+
+/*****************************************************************************/
+
+uint8_t rebuild_tree(unsigned char
+                     seed_tree[NUM_NODES_SEED_TREE*SEED_LENGTH_BYTES],
+                     const chall_2_t *chall_2,
+                     const unsigned char *stored_seeds,
+                     const unsigned char salt[SALT_LENGTH_BYTES])
+{
+    seed_tree_rebuild_t rebuild;
+    rebuild_tree_init(&rebuild, chall_2);
+    rebuild_tree_step(&rebuild, seed_tree, stored_seeds, salt, NUM_NODES_SEED_TREE);
+    return rebuild_tree_finish(&rebuild, stored_seeds);
 } /* end regenerate_leaves */
+
+/*****************************************************************************/
+
+/* counts the seeds rebuild_tree would take from the path, without expanding
+ * any of them, and checks the zero padding after them */
+uint8_t is_seed_path_padding_ok(const chall_2_t *chall_2,
+                                const unsigned char *stored_seeds)
+{
+    tree_flags_t flags;
+    tree_flags(&flags, chall_2, TO_PUBLISH, 1);
+
+    const uint16_t npl[LOG2(T)+1] = TREE_NODES_PER_LEVEL;
+
+    int nodes_used = 0;
+    for (int level = 1; level <= LOG2(T); level++){
+        for (int c = 0; 64*c < npl[level]; c++) {
+            nodes_used += bits_count(tree_flags_subroots(&flags, level, c));
+        }
+    }
+
+    uint8_t error = 0;
+    for (int i=nodes_used*SEED_LENGTH_BYTES; i<TREE_NODES_TO_STORE*SEED_LENGTH_BYTES; i++) {
+        error |= stored_seeds[i];
+    }
+    return (error == 0);
+} /* end is_seed_path_padding_ok */
 #endif
@@ -31,6 +31,16 @@
 
 #pragma once
 
+#if defined(HASH_STATS)
+/* the wrappers below are wrapped once more by the ones counting the
+ * permutations, see hash_stats.h */
+#define xof_shake_init xof_shake_uncounted_init
+#define xof_shake_update xof_shake_uncounted_update
+#define xof_shake_final xof_shake_uncounted_final
+#define xof_shake_extract xof_shake_uncounted_extract
+#define xof_shake_release xof_shake_uncounted_release
+#endif
+
 #if defined(SHA_3_LIBKECCAK)
 #include <libkeccak.a.headers/KeccakHash.h>
 
@@ -74,6 +84,57 @@ void xof_shake_extract(SHAKE_STATE_STRUCT *state,
                       (BitLength) outputByteLen*8 );
 }
 
+#elif defined(SHA_3_KECCAK_X86_64)
+
+// %%%%%%%%%%%%%%%%%%%%% x86-64 single lane SHAKE Wrappers %%%%%%%%%%%%%%%%%%%%%%%%
+
+#include "keccakf1600_x1.h"
+
+#define SHAKE_STATE_STRUCT keccak_x1_ctx
+/* as for the standalone FIPS-202 implementation, the rate depends on the
+ * security level */
+#if defined(CATEGORY_1)
+#define KECCAK_X1_RATE KECCAK_X1_SHAKE128_RATE
+#else
+#define KECCAK_X1_RATE KECCAK_X1_SHAKE256_RATE
+#endif
+
+static inline
+void xof_shake_init(SHAKE_STATE_STRUCT *state, int val)
+{
+   keccak_x1_init(state);
+   /* avoid -Werror=unused-parameter */
+   (void)val;
+}
+
+static inline
+void xof_shake_update(SHAKE_STATE_STRUCT *state,
+                      const unsigned char *input,
+                      unsigned int inputByteLen)
+{
+   keccak_x1_absorb(state, KECCAK_X1_RATE, (const uint8_t *)input, inputByteLen);
+}
+
+static inline
+void xof_shake_final(SHAKE_STATE_STRUCT *state)
+{
+   keccak_x1_finalize(state, KECCAK_X1_RATE);
+}
+
+static inline
+void xof_shake_extract(SHAKE_STATE_STRUCT *state,
+                       unsigned char *output,
+                       unsigned int outputByteLen){
+   keccak_x1_squeeze(output, outputByteLen, state, KECCAK_X1_RATE);
+}
+
+/* PQClean-edit: SHAKE release context */
+static inline
+void xof_shake_release(SHAKE_STATE_STRUCT *state){
+   /* the state lives in the context itself, nothing to free */
+   (void)state;
+}
+
 #else
 
 // %%%%%%%%%%%%%%%%%% Self-contained SHAKE x1 Wrappers %%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -147,6 +208,69 @@ void xof_shake_release(SHAKE_STATE_STRUCT *state){
 }
 #endif
 
+#if defined(HASH_STATS)
+
+// %%%%%%%%%%%%%%%%%% SHAKE x1 Wrappers counting permutations %%%%%%%%%%%%%%%%%%%%%
+
+#include "hash_stats.h"
+
+#undef xof_shake_init
+#undef xof_shake_update
+#undef xof_shake_final
+#undef xof_shake_extract
+#undef xof_shake_release
+
+#if defined(CATEGORY_1)
+#define HASH_STATS_SHAKE_RATE 168
+#else
+#define HASH_STATS_SHAKE_RATE 136
+#endif
+
+typedef struct {
+   SHAKE_STATE_STRUCT state;
+   hash_stats_sponge_t sponge;
+} shake_counted_ctx;
+#undef SHAKE_STATE_STRUCT
+#define SHAKE_STATE_STRUCT shake_counted_ctx
+
+static inline
+void xof_shake_init(SHAKE_STATE_STRUCT *state, int val)
+{
+   xof_shake_uncounted_init(&state->state, val);
+   state->sponge.pos = 0;
+}
+
+static inline
+void xof_shake_update(SHAKE_STATE_STRUCT *state,
+                      const unsigned char *input,
+                      unsigned int inputByteLen)
+{
+   xof_shake_uncounted_update(&state->state, input, inputByteLen);
+   hash_stats_absorb(&state->sponge, HASH_STATS_SHAKE_RATE, inputByteLen, 0);
+}
+
+static inline
+void xof_shake_final(SHAKE_STATE_STRUCT *state)
+{
+   xof_shake_uncounted_final(&state->state);
+   hash_stats_finalize(&state->sponge);
+}
+
+static inline
+void xof_shake_extract(SHAKE_STATE_STRUCT *state,
+                       unsigned char *output,
+                       unsigned int outputByteLen){
+   xof_shake_uncounted_extract(&state->state, output, outputByteLen);
+   hash_stats_squeeze(&state->sponge, HASH_STATS_SHAKE_RATE, outputByteLen, 0);
+}
+
+/* PQClean-edit: SHAKE release context */
+static inline
+void xof_shake_release(SHAKE_STATE_STRUCT *state){
+   xof_shake_uncounted_release(&state->state);
+}
+#endif
+
 #if defined(HIGH_PERFORMANCE_X86_64)
 
 // %%%%%%%%%%%%%%%%%% Self-contained SHAKE x4 Wrappers %%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -168,6 +292,14 @@ void xof_shake_release(SHAKE_STATE_STRUCT *state){
    #define SHAKE_X4_RELEASE shake256x4_inc_ctx_release
 #endif
 
+#if defined(HASH_STATS)
+#define xof_shake_x4_init xof_shake_x4_uncounted_init
+#define xof_shake_x4_update xof_shake_x4_uncounted_update
+#define xof_shake_x4_final xof_shake_x4_uncounted_final
+#define xof_shake_x4_extract xof_shake_x4_uncounted_extract
+#define xof_shake_x4_release xof_shake_x4_uncounted_release
+#endif
+
 static inline void xof_shake_x4_init(SHAKE_X4_STATE_STRUCT *states) {
    SHAKE_X4_INIT(states);
 }
@@ -195,6 +327,53 @@ static inline void xof_shake_x4_release(SHAKE_X4_STATE_STRUCT *states){
    SHAKE_X4_RELEASE(states);
 }
 
+#if defined(HASH_STATS)
+/* the 4 lanes are permuted at once, their sponges move in lockstep */
+#undef xof_shake_x4_init
+#undef xof_shake_x4_update
+#undef xof_shake_x4_final
+#undef xof_shake_x4_extract
+#undef xof_shake_x4_release
+
+typedef struct {
+   SHAKE_X4_STATE_STRUCT states;
+   hash_stats_sponge_t sponge;
+} shake_x4_counted_ctx;
+#undef SHAKE_X4_STATE_STRUCT
+#define SHAKE_X4_STATE_STRUCT shake_x4_counted_ctx
+
+static inline void xof_shake_x4_init(SHAKE_X4_STATE_STRUCT *states) {
+   xof_shake_x4_uncounted_init(&states->states);
+   states->sponge.pos = 0;
+}
+static inline void xof_shake_x4_update(SHAKE_X4_STATE_STRUCT *states,
+                      const unsigned char *in1,
+                      const unsigned char *in2,
+                      const unsigned char *in3,
+                      const unsigned char *in4,
+                      uint32_t singleInputByteLen) {
+   xof_shake_x4_uncounted_update(&states->states, in1, in2, in3, in4, singleInputByteLen);
+   hash_stats_absorb(&states->sponge, HASH_STATS_SHAKE_RATE, singleInputByteLen, 1);
+}
+static inline void xof_shake_x4_final(SHAKE_X4_STATE_STRUCT *states) {
+   xof_shake_x4_uncounted_final(&states->states);
+   hash_stats_finalize(&states->sponge);
+}
+static inline void xof_shake_x4_extract(SHAKE_X4_STATE_STRUCT *states,
+                       unsigned char *out1,
+                       unsigned char *out2,
+                       unsigned char *out3,
+                       unsigned char *out4,
+                       uint32_t singleOutputByteLen){
+   xof_shake_x4_uncounted_extract(&states->states, out1, out2, out3, out4, singleOutputByteLen);
+   hash_stats_squeeze(&states->sponge, HASH_STATS_SHAKE_RATE, singleOutputByteLen, 1);
+}
+/* PQClean-edit: SHAKE release context */
+static inline void xof_shake_x4_release(SHAKE_X4_STATE_STRUCT *states){
+   xof_shake_x4_uncounted_release(&states->states);
+}
+#endif
+
 #else
 
 // %%%%%%%%% Self-contained SHAKE x4 Wrappers (AVX2 missing: fallback) %%%%%%%%%%%%
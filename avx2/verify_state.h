@@ -0,0 +1,99 @@
+/**
+ *
+ * Reference ISO-C11 Implementation of CROSS.
+ *
+ * @version 2.0 (February 2025)
+ *
+ * Authors listed in alphabetical order:
+ * 
+ * @author: Alessandro Barenghi <alessandro.barenghi@polimi.it>
+ * @author: Marco Gianvecchio <marco.gianvecchio@mail.polimi.it>
+ * @author: Patrick Karl <patrick.karl@tum.de>
+ * @author: Gerardo Pelosi <gerardo.pelosi@polimi.it>
+ * @author: Jonas Schupp <jonas.schupp@tum.de>
+ * 
+ * 
+ * This code is hereby placed in the public domain.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ''AS IS'' AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **/
+
+#pragma once
+
+#include <stdint.h>
+
+#include "CROSS.h"
+#include "challenge.h"
+#include "csprng_hash.h"
+#include "merkle_tree.h"
+#include "namespace.h"
+#include "parameters.h"
+#include "pk_expanded.h"
+#include "seedtree.h"
+
+/* State of a verification carried out step by step, see CROSS_verify_start.
+ * It refers to itself and to the signature being verified: it may be
+ * neither moved nor copied between start and finish or abort, and the
+ * signature must remain available until then. Its alignment is the one of
+ * pk_expanded_t */
+struct CROSS_verify_state_s {
+   /* the expanded key, EPK points either to pk_expanded or to a key
+    * expanded by the caller */
+   pk_expanded_t pk_expanded;
+   const pk_expanded_t *EPK;
+   const CROSS_sig_t *sig;
+
+   uint8_t digest_chall_1[HASH_DIGEST_LENGTH];
+   FP_ELEM chall_1[T];
+   chall_2_t chall_2;
+   uint8_t round_seeds[T*SEED_LENGTH_BYTES];
+
+   /* the work the next step resumes, one of the VERIFY_PHASE_ in CROSS.c */
+   int phase;
+#if !defined(NO_TREES)
+   seed_tree_rebuild_t seed_tree_rebuild;
+   tree_recompute_t merkle_recompute;
+   /* the seed tree is done with before the Merkle tree is started */
+   union {
+      uint8_t seed[NUM_NODES_SEED_TREE*SEED_LENGTH_BYTES];
+      uint8_t merkle[NUM_NODES_MERKLE_TREE*HASH_DIGEST_LENGTH];
+   } tree;
+#endif
+
+   /* next position in each list of rounds of chall_2: the rounds with
+    * chall_2 == 1 are processed first */
+   int next_chall_2_1;
+   int next_chall_2_0;
+
+   uint8_t cmt_0[T][HASH_DIGEST_LENGTH];
+   uint8_t merkle_root[HASH_DIGEST_LENGTH];
+   /* cmt_1 of the rounds with chall_2 == 1, in round order */
+   uint8_t cmt_1_chall_2_1[W][HASH_DIGEST_LENGTH];
+   /* cmt_1 and the packed y are absorbed into their digests in round order,
+    * as soon as the rounds up to theirs are processed */
+   CSPRNG_STATE_T cmt_1_state;
+   CSPRNG_STATE_T y_state;
+   int absorb_pos[3];
+   FP_ELEM y[T][N];
+
+   int is_signature_ok;
+   uint8_t is_padd_key_ok;
+   uint8_t is_stree_padding_ok;
+   uint8_t is_mtree_padding_ok;
+   uint8_t is_packed_padd_ok;
+   /* set once there is no work left and no hash state held: the signature
+    * was rejected before any round, or the verification was finished or
+    * aborted */
+   uint8_t is_ended;
+};
@@ -0,0 +1,415 @@
+/**
+ *
+ * Reference ISO-C11 Implementation of CROSS.
+ *
+ * @version 2.0 (February 2025)
+ *
+ * Authors listed in alphabetical order:
+ * 
+ * @author: Alessandro Barenghi <alessandro.barenghi@polimi.it>
+ * @author: Marco Gianvecchio <marco.gianvecchio@mail.polimi.it>
+ * @author: Patrick Karl <patrick.karl@tum.de>
+ * @author: Gerardo Pelosi <gerardo.pelosi@polimi.it>
+ * @author: Jonas Schupp <jonas.schupp@tum.de>
+ * 
+ * 
+ * This code is hereby placed in the public domain.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ''AS IS'' AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **/
+
+
+/* Microbenchmarks of the kernels of one implementation of one parameter set,
+ * compiled against its internal headers (see Makefile), which define
+ * BENCH_SET and BENCH_IMPL. All the kernels are timed in turn, ROUNDS
+ * times, each time taking ITERATIONS samples of a batch of calls which lasts
+ * at least SAMPLE_NS; the minimum over the rounds of the median time of a
+ * call in nanoseconds is printed on a line: set, implementation, kernel,
+ * time. Batching keeps the clock resolution and the timing overhead out of
+ * the short kernels, and the minimum of the medians, taken over rounds
+ * spread across the whole run, the stretches of time in which the host is
+ * busy with other work.
+ * Given a baseline, i.e., the output of an earlier run, every kernel slower
+ * than its time in there by more than tolerance percent is reported, once
+ * RETRIES more runs of all the rounds, each after a pause of PAUSE_NS, have
+ * not brought it back within the tolerance, as is
+ * every kernel of the set and implementation found in only one of the
+ * baseline and the run, and the exit status is 1 if there is any.
+ * Usage: microbench [-n iterations] [-b baseline] [-t tolerance] */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "CROSS.h"
+#include "challenge.h"
+#include "csprng_hash.h"
+#include "fp_arith.h"
+#include "merkle_tree.h"
+#include "pack_unpack.h"
+#include "parameters.h"
+#include "pk_expanded.h"
+#include "restr_arith.h"
+#include "seedtree.h"
+
+#define ITERATIONS 64
+#define ROUNDS 8
+#define SAMPLE_NS 20000
+#define RETRIES 5
+#define PAUSE_NS 2000000000L
+#define TOLERANCE 100
+#define MAX_KERNELS 32
+#define KERNEL_NAME_LENGTH 32
+
+typedef struct {
+   char name[KERNEL_NAME_LENGTH];
+   uint64_t ns;
+} kernel_time_t;
+
+static kernel_time_t results[MAX_KERNELS];
+static int num_results;
+
+/* the inputs and outputs of the kernels, so that they are not optimized
+ * away */
+static pk_t pk;
+static sk_t sk;
+static pk_expanded_t epk;
+static CROSS_sig_t sig;
+static FP_ELEM fp_vec[N];
+static FP_ELEM fp_syn[N-K];
+static FZ_ELEM fz_vec[N];
+#if defined(RSDPG)
+static FZ_ELEM fz_inf_w[M];
+static uint8_t packed_fz_rsdp_g_vec[DENSELY_PACKED_FZ_RSDP_G_VEC_SIZE];
+#endif
+static uint8_t packed_fp_vec[DENSELY_PACKED_FP_VEC_SIZE];
+static uint8_t packed_fp_syn[DENSELY_PACKED_FP_SYN_SIZE];
+static uint8_t packed_fz_vec[DENSELY_PACKED_FZ_VEC_SIZE];
+static uint8_t seed[SEED_LENGTH_BYTES];
+static uint8_t salt[SALT_LENGTH_BYTES];
+static uint8_t digest[HASH_DIGEST_LENGTH];
+static uint8_t digests[4][HASH_DIGEST_LENGTH];
+static uint8_t hash_input[4][2*HASH_DIGEST_LENGTH];
+static uint8_t fixed_weight[T];
+static chall_2_t chall_2;
+static uint8_t leaves[T][HASH_DIGEST_LENGTH];
+#if defined(NO_TREES)
+static uint8_t rounds_seeds[T*SEED_LENGTH_BYTES];
+#else
+static uint8_t seed_tree[NUM_NODES_SEED_TREE*SEED_LENGTH_BYTES];
+static uint8_t merkle_tree[NUM_NODES_MERKLE_TREE*HASH_DIGEST_LENGTH];
+#endif
+static volatile uint8_t sink;
+
+static
+uint64_t now_ns(void){
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec*1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+static
+int compare_u64(const void *a, const void *b){
+    uint64_t x = *(const uint64_t *)a;
+    uint64_t y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+static
+uint64_t median(uint64_t *t, int n){
+    qsort(t, n, sizeof(uint64_t), compare_u64);
+    return t[n/2];
+}
+
+/* keeps the lowest median of the kernel over the rounds run so far */
+static
+void record(const char *name, uint64_t ns){
+    int r = 0;
+    while(r < num_results && strcmp(results[r].name, name) != 0){
+        r++;
+    }
+    if(r == num_results){
+        if(num_results == MAX_KERNELS){
+            return;
+        }
+        snprintf(results[r].name, KERNEL_NAME_LENGTH, "%s", name);
+        results[r].ns = ns;
+        num_results++;
+    } else if(ns < results[r].ns){
+        results[r].ns = ns;
+    }
+}
+
+/* times iterations samples of code, whose outputs are stored in the static
+ * variables above; the size of the batches is taken from a warm run */
+#define BENCH(name, code) do {                                    \
+    code;                                                         \
+    uint64_t start_ = now_ns();                                   \
+    code;                                                         \
+    uint64_t batch_ = SAMPLE_NS/(now_ns() - start_ + 1) + 1;      \
+    for(int i_ = 0; i_ < iterations; i_++){                       \
+        start_ = now_ns();                                        \
+        for(uint64_t b_ = 0; b_ < batch_; b_++){                  \
+            code;                                                 \
+        }                                                         \
+        t[i_] = (now_ns() - start_)/batch_;                       \
+        sink ^= digest[0] ^ fixed_weight[0];                      \
+    }                                                             \
+    record(name, median(t, iterations));                          \
+} while(0)
+
+static
+void bench_csprng(uint64_t *t, int iterations){
+    CSPRNG_STATE_T csprng_state;
+    BENCH("csprng_fp_vec",
+          csprng_initialize(&csprng_state, seed, SEED_LENGTH_BYTES, 0);
+          csprng_fp_vec(fp_vec, &csprng_state);
+          csprng_release(&csprng_state));
+#if defined(RSDP)
+    BENCH("csprng_fz_vec",
+          csprng_initialize(&csprng_state, seed, SEED_LENGTH_BYTES, 0);
+          csprng_fz_vec(fz_vec, &csprng_state);
+          csprng_release(&csprng_state));
+#elif defined(RSDPG)
+    BENCH("csprng_fz_inf_w",
+          csprng_initialize(&csprng_state, seed, SEED_LENGTH_BYTES, 0);
+          csprng_fz_inf_w(fz_inf_w, &csprng_state);
+          csprng_release(&csprng_state));
+    BENCH("csprng_fz_mat",
+          csprng_initialize(&csprng_state, seed, SEED_LENGTH_BYTES, 0);
+          csprng_fz_mat(epk.W_mat, &csprng_state);
+          csprng_release(&csprng_state));
+#endif
+    BENCH("csprng_fp_mat",
+          csprng_initialize(&csprng_state, seed, SEED_LENGTH_BYTES, 0);
+          csprng_fp_mat(epk.V_tr, &csprng_state);
+          csprng_release(&csprng_state));
+}
+
+static
+void bench_arith(uint64_t *t, int iterations){
+    BENCH("fp_vec_by_fp_matrix", fp_vec_by_fp_matrix(fp_syn, fp_vec, epk.V_tr));
+    BENCH("restr_vec_by_fp_matrix", restr_vec_by_fp_matrix(fp_syn, fz_vec, epk.V_tr));
+#if defined(RSDPG)
+#if defined(HIGH_PERFORMANCE_X86_64)
+    BENCH("fz_inf_w_by_fz_matrix", fz_inf_w_by_fz_matrix(fz_vec, fz_inf_w, epk.W_mat_avx));
+#else
+    BENCH("fz_inf_w_by_fz_matrix", fz_inf_w_by_fz_matrix(fz_vec, fz_inf_w, epk.W_mat));
+#endif
+#endif
+}
+
+static
+void bench_pack(uint64_t *t, int iterations){
+    BENCH("pack_fp_vec", pack_fp_vec(packed_fp_vec, fp_vec));
+    BENCH("unpack_fp_vec", sink ^= unpack_fp_vec(fp_vec, packed_fp_vec));
+    BENCH("pack_fp_syn", pack_fp_syn(packed_fp_syn, fp_syn));
+    BENCH("unpack_fp_syn", sink ^= unpack_fp_syn(fp_syn, packed_fp_syn));
+    BENCH("pack_fz_vec", pack_fz_vec(packed_fz_vec, fz_vec));
+    BENCH("unpack_fz_vec", sink ^= unpack_fz_vec(fz_vec, packed_fz_vec));
+#if defined(RSDPG)
+    BENCH("pack_fz_rsdp_g_vec", pack_fz_rsdp_g_vec(packed_fz_rsdp_g_vec, fz_inf_w));
+    BENCH("unpack_fz_rsdp_g_vec", sink ^= unpack_fz_rsdp_g_vec(fz_inf_w, packed_fz_rsdp_g_vec));
+#endif
+}
+
+/* four digests of two digests each, as the ones of the Merkle tree nodes */
+static
+void bench_hash(uint64_t *t, int iterations){
+    BENCH("hash_x4",
+          for(int l = 0; l < 4; l++){
+              hash(digests[l], hash_input[l], sizeof(hash_input[l]), HASH_DOMAIN_SEP_CONST);
+          });
+#if defined(HIGH_PERFORMANCE_X86_64)
+    BENCH("hash_par_x4",
+          hash_par(4, digests[0], digests[1], digests[2], digests[3],
+                   hash_input[0], hash_input[1], hash_input[2], hash_input[3],
+                   sizeof(hash_input[0]),
+                   HASH_DOMAIN_SEP_CONST, HASH_DOMAIN_SEP_CONST,
+                   HASH_DOMAIN_SEP_CONST, HASH_DOMAIN_SEP_CONST));
+#endif
+}
+
+static
+void bench_trees(uint64_t *t, int iterations){
+    BENCH("expand_digest_to_fixed_weight", expand_digest_to_fixed_weight(fixed_weight, digest));
+    expand_digest_to_chall_2(&chall_2, digest);
+#if defined(NO_TREES)
+    BENCH("seed_leaves", sink ^= seed_leaves(rounds_seeds, seed, salt));
+    seed_path(sig.path, rounds_seeds, &chall_2);
+    BENCH("rebuild_leaves", sink ^= rebuild_leaves(rounds_seeds, &chall_2, sig.path));
+    BENCH("tree_root", tree_root(digest, leaves));
+    tree_proof(sig.proof, leaves, &chall_2);
+#else
+    BENCH("gen_seed_tree", gen_seed_tree(seed_tree, seed, salt));
+    seed_path(sig.path, seed_tree, &chall_2);
+    BENCH("rebuild_tree", sink ^= rebuild_tree(seed_tree, &chall_2, sig.path, salt));
+    BENCH("tree_root", tree_root(digest, merkle_tree, leaves));
+    tree_proof(sig.proof, merkle_tree, &chall_2);
+#endif
+    BENCH("recompute_root", sink ^= recompute_root(digest, leaves, sig.proof, &chall_2));
+}
+
+/* returns 1 if every kernel measured has a time in baseline, and the other
+ * way round, and none is slower than in there by more than tolerance
+ * percent, 0 otherwise; the kernels which are slower are counted in slow.
+ * Unless quiet, the reasons are printed on stderr */
+static
+int check_baseline(const char *baseline, int tolerance, int quiet, int *slow){
+    *slow = 0;
+    FILE *f = fopen(baseline, "r");
+    if(f == NULL){
+        if(!quiet){
+            fprintf(stderr, "%s: cannot read %s\n", BENCH_SET, baseline);
+        }
+        return 0;
+    }
+    int ok = 1;
+    /* the baseline entries of the set and implementation, and the ones of
+     * them matching each measured kernel */
+    int entries = 0;
+    int matches[MAX_KERNELS] = {0};
+    char set[64], impl[16], name[KERNEL_NAME_LENGTH];
+    unsigned long long base_ns;
+    int fields;
+    while((fields = fscanf(f, "%63s %15s %31s %llu", set, impl, name, &base_ns)) == 4){
+        if(strcmp(set, BENCH_SET) != 0 || strcmp(impl, BENCH_IMPL) != 0){
+            continue;
+        }
+        entries++;
+        int r = 0;
+        while(r < num_results && strcmp(results[r].name, name) != 0){
+            r++;
+        }
+        if(r == num_results){
+            if(!quiet){
+                fprintf(stderr, "%s %s %s: in %s, not measured\n",
+                        BENCH_SET, BENCH_IMPL, name, baseline);
+            }
+            ok = 0;
+            continue;
+        }
+        matches[r]++;
+        if(results[r].ns*100 > base_ns*(100+tolerance)){
+            if(!quiet){
+                fprintf(stderr, "%s %s %s: %llu ns, baseline %llu ns (+%.1f%%)\n",
+                        BENCH_SET, BENCH_IMPL, name,
+                        (unsigned long long)results[r].ns, base_ns,
+                        100.0*results[r].ns/base_ns - 100.0);
+            }
+            (*slow)++;
+            ok = 0;
+        }
+    }
+    if(fields != EOF){
+        if(!quiet){
+            fprintf(stderr, "%s: malformed line in %s\n", BENCH_SET, baseline);
+        }
+        ok = 0;
+    }
+    fclose(f);
+    if(entries == 0){
+        if(!quiet){
+            fprintf(stderr, "%s %s: no kernel in %s\n", BENCH_SET, BENCH_IMPL, baseline);
+        }
+        return 0;
+    }
+    for(int r = 0; r < num_results; r++){
+        if(matches[r] == 0){
+            if(!quiet){
+                fprintf(stderr, "%s %s %s: measured, not in %s\n",
+                        BENCH_SET, BENCH_IMPL, results[r].name, baseline);
+            }
+            ok = 0;
+        }
+    }
+    return ok;
+}
+
+/* all the rounds of all the kernels */
+static
+void bench_rounds(uint64_t *t, int iterations){
+    for(int r = 0; r < ROUNDS; r++){
+        bench_csprng(t, iterations);
+        bench_arith(t, iterations);
+        bench_pack(t, iterations);
+        bench_hash(t, iterations);
+        bench_trees(t, iterations);
+    }
+}
+
+int main(int argc, char **argv){
+    int iterations = ITERATIONS;
+    int tolerance = TOLERANCE;
+    const char *baseline = NULL;
+    for(int a = 1; a+1 < argc; a += 2){
+        if(strcmp(argv[a], "-n") == 0){
+            iterations = atoi(argv[a+1]);
+        } else if(strcmp(argv[a], "-b") == 0){
+            baseline = argv[a+1];
+        } else if(strcmp(argv[a], "-t") == 0){
+            tolerance = atoi(argv[a+1]);
+        } else {
+            iterations = 0;
+        }
+    }
+    if(iterations < 1 || tolerance < 0 || argc % 2 == 0){
+        fprintf(stderr, "usage: %s [-n iterations] [-b baseline] [-t tolerance]\n", argv[0]);
+        return 1;
+    }
+    uint64_t *t = malloc(iterations*sizeof(uint64_t));
+    if(t == NULL){
+        return 1;
+    }
+
+    CROSS_keygen(&sk, &pk);
+    CROSS_pk_expand(&epk, &pk);
+    memcpy(seed, sk.seed_sk, SEED_LENGTH_BYTES);
+    memcpy(salt, pk.seed_pk, SALT_LENGTH_BYTES);
+    hash(digest, pk.s, sizeof(pk.s), HASH_DOMAIN_SEP_CONST);
+    for(int l = 0; l < 4; l++){
+        memset(hash_input[l], l, sizeof(hash_input[l]));
+    }
+    for(int i = 0; i < T; i++){
+        memset(leaves[i], i, HASH_DIGEST_LENGTH);
+    }
+
+    bench_rounds(t, iterations);
+    int slow = 0;
+    if(baseline != NULL){
+        /* a slow kernel is timed again after a pause, which a busy stretch
+         * of the host is unlikely to outlast, a regression is not */
+        for(int retry = 0;
+            retry < RETRIES && !check_baseline(baseline, tolerance, 1, &slow) && slow > 0;
+            retry++){
+            struct timespec pause = { PAUSE_NS/1000000000, PAUSE_NS%1000000000 };
+            nanosleep(&pause, NULL);
+            bench_rounds(t, iterations);
+        }
+    }
+    free(t);
+    for(int r = 0; r < num_results; r++){
+        printf("%s %s %s %llu\n", BENCH_SET, BENCH_IMPL, results[r].name,
+               (unsigned long long)results[r].ns);
+    }
+
+    if(baseline != NULL && !check_baseline(baseline, tolerance, 0, &slow)){
+        return 1;
+    }
+    return 0;
+}
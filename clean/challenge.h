@@ -0,0 +1,186 @@
+/**
+ *
+ * Reference ISO-C11 Implementation of CROSS.
+ *
+ * @version 2.0 (February 2025)
+ *
+ * Authors listed in alphabetical order:
+ * 
+ * @author: Alessandro Barenghi <alessandro.barenghi@polimi.it>
+ * @author: Marco Gianvecchio <marco.gianvecchio@mail.polimi.it>
+ * @author: Patrick Karl <patrick.karl@tum.de>
+ * @author: Gerardo Pelosi <gerardo.pelosi@polimi.it>
+ * @author: Jonas Schupp <jonas.schupp@tum.de>
+ * 
+ * 
+ * This code is hereby placed in the public domain.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ''AS IS'' AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **/
+
+
+#pragma once
+
+#include <stdint.h>
+
+#include "namespace.h"
+#include "parameters.h"
+
+#define CHALL_2_WORDS ((T+63)/64)
+
+/* Second challenge, the fixed weight string derived from digest_chall_2,
+ * along with its sparse forms: the rounds where it is 0 (their responses
+ * are published) and the ones where it is 1 (their seeds are published),
+ * both in increasing order, and the bitmap of the latter, bit i%64 of word
+ * i/64 standing for round i */
+typedef struct {
+   uint8_t value[T];
+   uint16_t rounds_0[T-W];
+   uint16_t rounds_1[W];
+   uint64_t bitmap[CHALL_2_WORDS];
+} chall_2_t;
+
+/* expands digest into the fixed weight string, as
+ * expand_digest_to_fixed_weight does, and into its sparse forms */
+void expand_digest_to_chall_2(chall_2_t *chall_2,
+                              const uint8_t digest[HASH_DIGEST_LENGTH]);
+
+/* Bit manipulation on 64-bit words, for the flags of the tree nodes */
+
+/* the n lowest bits set */
+static inline
+uint64_t bits_mask(int n){
+   if(n <= 0){
+      return 0;
+   }
+   return (n >= 64) ? ~(uint64_t)0 : (((uint64_t)1 << n)-1);
+}
+
+static inline
+int bits_count(uint64_t w){
+#if defined(__GNUC__)
+   return __builtin_popcountll(w);
+#else
+   int cnt = 0;
+   for(; w != 0; w &= w-1){
+      cnt++;
+   }
+   return cnt;
+#endif
+}
+
+/* position of the lowest set bit, w != 0 */
+static inline
+int bits_lowest(uint64_t w){
+#if defined(__GNUC__)
+   return __builtin_ctzll(w);
+#else
+   int pos = 0;
+   while(!((w >> pos) & 1)){
+      pos++;
+   }
+   return pos;
+#endif
+}
+
+/* position of the highest set bit, w != 0 */
+static inline
+int bits_highest(uint64_t w){
+#if defined(__GNUC__)
+   return 63-__builtin_clzll(w);
+#else
+   int pos = 63;
+   while(!((w >> pos) & 1)){
+      pos--;
+   }
+   return pos;
+#endif
+}
+
+/* the even bits of w packed into the 32 lowest ones */
+static inline
+uint64_t bits_compress(uint64_t w){
+   w &= 0x5555555555555555ULL;
+   w = (w | (w >> 1)) & 0x3333333333333333ULL;
+   w = (w | (w >> 2)) & 0x0F0F0F0F0F0F0F0FULL;
+   w = (w | (w >> 4)) & 0x00FF00FF00FF00FFULL;
+   w = (w | (w >> 8)) & 0x0000FFFF0000FFFFULL;
+   w = (w | (w >> 16)) & 0x00000000FFFFFFFFULL;
+   return w;
+}
+
+/* each of the 32 lowest bits of w repeated twice, the inverse of
+ * bits_compress */
+static inline
+uint64_t bits_spread(uint64_t w){
+   w &= 0x00000000FFFFFFFFULL;
+   w = (w | (w << 16)) & 0x0000FFFF0000FFFFULL;
+   w = (w | (w << 8)) & 0x00FF00FF00FF00FFULL;
+   w = (w | (w << 4)) & 0x0F0F0F0F0F0F0F0FULL;
+   w = (w | (w << 2)) & 0x3333333333333333ULL;
+   w = (w | (w << 1)) & 0x5555555555555555ULL;
+   return w | (w << 1);
+}
+
+/* each bit of w swapped with its sibling, i.e., bits 2j and 2j+1 */
+static inline
+uint64_t bits_swap_siblings(uint64_t w){
+   return ((w >> 1) & 0x5555555555555555ULL) | ((w << 1) & 0xAAAAAAAAAAAAAAAAULL);
+}
+
+#if !defined(NO_TREES)
+/* Flags of the nodes of the seed and Merkle trees, one bitmap per level:
+ * bit i%64 of word i/64 stands for the i-th node of the level from the
+ * left. A level never holds more than T nodes, and the children of the
+ * i-th node of a level are the (2i)-th and (2i+1)-th of the next one, thus
+ * the flags of the parents of the nodes in a word are found in half of a
+ * word of the level above */
+#define TREE_FLAGS_WORDS CHALL_2_WORDS
+
+typedef struct {
+   uint64_t level[LOG2(T)+1][TREE_FLAGS_WORDS];
+} tree_flags_t;
+
+/* flags the leaves of the rounds where chall_2 is chall_value, and the
+ * internal nodes either having both children flagged (both_children != 0,
+ * the seeds to publish) or at least one (both_children == 0, the computed
+ * Merkle tree nodes) */
+void tree_flags(tree_flags_t *flags,
+                const chall_2_t *chall_2,
+                uint8_t chall_value,
+                int both_children);
+
+/* flagged nodes among the ones in word c of level > 0, whose parent is not
+ * flagged */
+static inline
+uint64_t tree_flags_subroots(const tree_flags_t *flags, int level, int c){
+   uint64_t parents = flags->level[level-1][c/2] >> (32*(c%2));
+   return flags->level[level][c] & ~bits_spread(parents);
+}
+
+/* left nodes, among the ones in word c of level > 0, of the siblings of
+ * which at least one is flagged */
+static inline
+uint64_t tree_flags_pairs(const tree_flags_t *flags, int level, int c){
+   uint64_t w = flags->level[level][c];
+   return (w | (w >> 1)) & 0x5555555555555555ULL;
+}
+
+/* not flagged nodes among the ones in word c of level > 0, whose sibling
+ * is flagged */
+static inline
+uint64_t tree_flags_siblings(const tree_flags_t *flags, int level, int c){
+   return ~flags->level[level][c] & bits_swap_siblings(flags->level[level][c]);
+}
+#endif
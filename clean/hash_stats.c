@@ -0,0 +1,173 @@
+/**
+ *
+ * Reference ISO-C11 Implementation of CROSS.
+ *
+ * @version 2.0 (February 2025)
+ *
+ * Authors listed in alphabetical order:
+ * 
+ * @author: Alessandro Barenghi <alessandro.barenghi@polimi.it>
+ * @author: Marco Gianvecchio <marco.gianvecchio@mail.polimi.it>
+ * @author: Patrick Karl <patrick.karl@tum.de>
+ * @author: Gerardo Pelosi <gerardo.pelosi@polimi.it>
+ * @author: Jonas Schupp <jonas.schupp@tum.de>
+ * 
+ * 
+ * This code is hereby placed in the public domain.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ''AS IS'' AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **/
+
+#include "hash_stats.h"
+
+static const char *const hash_stats_site_names[HASH_STATS_SITES] = {
+   "keygen_batch/seed_sk",
+   "keygen_batch/seed_pk",
+   "keygen_batch/seed_e",
+   "sign/round_seeds",
+   "sign/cmt_0",
+   "sign/cmt_1",
+   "verify/round_seeds",
+   "verify/cmt_1",
+   "verify/cmt_0",
+   "seed_leaves",
+   "gen_seed_tree",
+   "rebuild_tree",
+   "tree_root",
+   "tree_builder",
+   "recompute_root"
+};
+
+const char *hash_stats_site_name(size_t site){
+   if(site >= HASH_STATS_SITES){
+      return NULL;
+   }
+   return hash_stats_site_names[site];
+}
+
+#if defined(HASH_STATS)
+
+static uint64_t hash_stats_calls[HASH_STATS_SITES][4];
+static uint64_t hash_stats_runs[HASH_STATS_OPS];
+static uint64_t hash_stats_perms[HASH_STATS_OPS][2];
+
+/* the operation running on the thread, the entry points of it running, and
+ * the permutations it took so far */
+static __thread hash_stats_op_t hash_stats_op;
+static __thread unsigned int hash_stats_depth;
+static __thread uint64_t hash_stats_pending[2];
+
+void hash_stats_par(hash_stats_site_t site,
+                    int par_level){
+   __atomic_fetch_add(&hash_stats_calls[site][par_level-1], 1, __ATOMIC_RELAXED);
+}
+
+void hash_stats_enter(hash_stats_op_t op){
+   if(hash_stats_depth++ > 0){
+      return;
+   }
+   hash_stats_op = op;
+   hash_stats_pending[0] = 0;
+   hash_stats_pending[1] = 0;
+}
+
+void hash_stats_leave(int completed){
+   if(--hash_stats_depth > 0){
+      return;
+   }
+   hash_stats_op_t op = hash_stats_op;
+   __atomic_fetch_add(&hash_stats_perms[op][0], hash_stats_pending[0], __ATOMIC_RELAXED);
+   __atomic_fetch_add(&hash_stats_perms[op][1], hash_stats_pending[1], __ATOMIC_RELAXED);
+   __atomic_fetch_add(&hash_stats_runs[op], (uint64_t) completed, __ATOMIC_RELAXED);
+   hash_stats_op = HASH_STATS_NONE;
+   hash_stats_pending[0] = 0;
+   hash_stats_pending[1] = 0;
+}
+
+void hash_stats_keccak(int x4,
+                       uint64_t permutations){
+   /* the permutations outside sign and verify, e.g., of keygen, are not
+    * counted */
+   if(hash_stats_op != HASH_STATS_NONE){
+      hash_stats_pending[x4] += permutations;
+   }
+}
+
+void hash_stats_lanes(size_t site,
+                      uint64_t calls[4]){
+   for(int l = 0; l < 4; l++){
+      calls[l] = (site < HASH_STATS_SITES) ?
+                 __atomic_load_n(&hash_stats_calls[site][l], __ATOMIC_RELAXED) : 0;
+   }
+}
+
+void hash_stats_permutations(hash_stats_op_t op,
+                             uint64_t *runs,
+                             uint64_t *permutations,
+                             uint64_t *permutations_x4){
+   int valid = (op > HASH_STATS_NONE && op < HASH_STATS_OPS);
+   if(runs != NULL){
+      *runs = valid ? __atomic_load_n(&hash_stats_runs[op], __ATOMIC_RELAXED) : 0;
+   }
+   if(permutations != NULL){
+      *permutations = valid ? __atomic_load_n(&hash_stats_perms[op][0], __ATOMIC_RELAXED) : 0;
+   }
+   if(permutations_x4 != NULL){
+      *permutations_x4 = valid ? __atomic_load_n(&hash_stats_perms[op][1], __ATOMIC_RELAXED) : 0;
+   }
+}
+
+void hash_stats_reset(void){
+   for(int s = 0; s < HASH_STATS_SITES; s++){
+      for(int l = 0; l < 4; l++){
+         __atomic_store_n(&hash_stats_calls[s][l], 0, __ATOMIC_RELAXED);
+      }
+   }
+   for(int op = 0; op < HASH_STATS_OPS; op++){
+      __atomic_store_n(&hash_stats_runs[op], 0, __ATOMIC_RELAXED);
+      __atomic_store_n(&hash_stats_perms[op][0], 0, __ATOMIC_RELAXED);
+      __atomic_store_n(&hash_stats_perms[op][1], 0, __ATOMIC_RELAXED);
+   }
+}
+
+#else
+
+void hash_stats_lanes(size_t site,
+                      uint64_t calls[4]){
+   (void)site;
+   for(int l = 0; l < 4; l++){
+      calls[l] = 0;
+   }
+}
+
+void hash_stats_permutations(hash_stats_op_t op,
+                             uint64_t *runs,
+                             uint64_t *permutations,
+                             uint64_t *permutations_x4){
+   (void)op;
+   if(runs != NULL){
+      *runs = 0;
+   }
+   if(permutations != NULL){
+      *permutations = 0;
+   }
+   if(permutations_x4 != NULL){
+      *permutations_x4 = 0;
+   }
+}
+
+void hash_stats_reset(void){
+}
+
+#endif
@@ -0,0 +1,166 @@
+/**
+ *
+ * Reference ISO-C11 Implementation of CROSS.
+ *
+ * @version 2.0 (February 2025)
+ *
+ * Authors listed in alphabetical order:
+ * 
+ * @author: Alessandro Barenghi <alessandro.barenghi@polimi.it>
+ * @author: Marco Gianvecchio <marco.gianvecchio@mail.polimi.it>
+ * @author: Patrick Karl <patrick.karl@tum.de>
+ * @author: Gerardo Pelosi <gerardo.pelosi@polimi.it>
+ * @author: Jonas Schupp <jonas.schupp@tum.de>
+ * 
+ * 
+ * This code is hereby placed in the public domain.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ''AS IS'' AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **/
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "namespace.h"
+
+/* Counters of the use of the lanes of the parallel SHAKE calls.
+ * When HASH_STATS is defined, every call site of hash_par and
+ * csprng_initialize_par records how many of the 4 lanes it fills, and the
+ * wrappers in sha3.h count the Keccak-f[1600] permutations, the single lane
+ * and the 4-way ones apart. The permutations are charged to the signing or
+ * verifying entry point running on the thread, and added to the process
+ * wide counters when it returns; those called by another one, e.g.,
+ * CROSS_presign by CROSS_sign, are charged as part of the outermost.
+ * Requires GCC or Clang, e.g., building with EXTRAFLAGS="-DHASH_STATS". Without HASH_STATS, the HASH_STATS_* macros
+ * expand to nothing and all counters read zero. */
+
+/* the call sites of hash_par and csprng_initialize_par */
+typedef enum {
+   HASH_STATS_SITE_KEYGEN_SEED_SK,
+   HASH_STATS_SITE_KEYGEN_SEED_PK,
+   HASH_STATS_SITE_KEYGEN_SEED_E,
+   HASH_STATS_SITE_SIGN_ROUND_SEEDS,
+   HASH_STATS_SITE_SIGN_CMT_0,
+   HASH_STATS_SITE_SIGN_CMT_1,
+   HASH_STATS_SITE_VERIFY_ROUND_SEEDS,
+   HASH_STATS_SITE_VERIFY_CMT_1,
+   HASH_STATS_SITE_VERIFY_CMT_0,
+   HASH_STATS_SITE_SEED_LEAVES,
+   HASH_STATS_SITE_GEN_SEED_TREE,
+   HASH_STATS_SITE_REBUILD_TREE,
+   HASH_STATS_SITE_TREE_ROOT,
+   HASH_STATS_SITE_TREE_BUILDER,
+   HASH_STATS_SITE_RECOMPUTE_ROOT,
+   HASH_STATS_SITES
+} hash_stats_site_t;
+
+/* the operations the permutations are charged to */
+typedef enum {
+   HASH_STATS_NONE,
+   HASH_STATS_SIGN,
+   HASH_STATS_VERIFY,
+   HASH_STATS_OPS
+} hash_stats_op_t;
+
+/* name of the call site numbered site, NULL if there is no such site */
+const char *hash_stats_site_name(size_t site);
+
+/* calls of the call site numbered site filling 1, 2, 3 and 4 lanes, in
+ * calls[0] to calls[3] */
+void hash_stats_lanes(size_t site,
+                      uint64_t calls[4]);
+
+/* completed runs of op, and the single lane and 4-way permutations they
+ * took; any pointer may be NULL */
+void hash_stats_permutations(hash_stats_op_t op,
+                             uint64_t *runs,
+                             uint64_t *permutations,
+                             uint64_t *permutations_x4);
+
+/* zeroes all the counters */
+void hash_stats_reset(void);
+
+#if defined(HASH_STATS)
+
+/* records a call of site filling par_level lanes */
+void hash_stats_par(hash_stats_site_t site,
+                    int par_level);
+
+/* charges the permutations of the calling thread to op from now on, unless
+ * the thread is already within an operation; nests with hash_stats_leave */
+void hash_stats_enter(hash_stats_op_t op);
+
+/* leaves the operation entered last; when it is the outermost, adds the
+ * permutations charged so far to the counters of the operation and completed
+ * to its runs, 0 on the helper threads of an operation and for the parts of
+ * one, e.g., a presignature */
+void hash_stats_leave(int completed);
+
+/* counts permutations Keccak-f[1600] calls, single lane (x4 == 0) or 4-way
+ * (x4 == 1) */
+void hash_stats_keccak(int x4,
+                       uint64_t permutations);
+
+/* position of a sponge in its current block: the bytes absorbed into it, or,
+ * once finalized, the bytes still to be squeezed out of it */
+typedef struct {
+   uint32_t pos;
+} hash_stats_sponge_t;
+
+static inline
+void hash_stats_absorb(hash_stats_sponge_t *sponge,
+                       uint32_t rate,
+                       uint64_t len,
+                       int x4){
+   /* a block is permuted as soon as it is full */
+   uint64_t blocks = (sponge->pos + len) / rate;
+   sponge->pos = (uint32_t) ((sponge->pos + len) % rate);
+   if(blocks > 0){
+      hash_stats_keccak(x4, blocks);
+   }
+}
+
+static inline
+void hash_stats_finalize(hash_stats_sponge_t *sponge){
+   /* the padded block is permuted by the first squeeze */
+   sponge->pos = 0;
+}
+
+static inline
+void hash_stats_squeeze(hash_stats_sponge_t *sponge,
+                        uint32_t rate,
+                        uint64_t len,
+                        int x4){
+   if(len <= sponge->pos){
+      sponge->pos -= (uint32_t) len;
+      return;
+   }
+   uint64_t blocks = (len - sponge->pos + rate - 1) / rate;
+   sponge->pos = (uint32_t) (blocks*rate - (len - sponge->pos));
+   hash_stats_keccak(x4, blocks);
+}
+
+#define HASH_STATS_PAR(site, par_level) hash_stats_par(site, par_level)
+#define HASH_STATS_ENTER(op) hash_stats_enter(op)
+#define HASH_STATS_LEAVE(completed) hash_stats_leave(completed)
+
+#else
+
+#define HASH_STATS_PAR(site, par_level) ((void) 0)
+#define HASH_STATS_ENTER(op) ((void) 0)
+#define HASH_STATS_LEAVE(completed) ((void) 0)
+
+#endif
@@ -0,0 +1,293 @@
+/**
+ *
+ * Reference ISO-C11 Implementation of CROSS.
+ *
+ * @version 2.0 (February 2025)
+ *
+ * Authors listed in alphabetical order:
+ * 
+ * @author: Alessandro Barenghi <alessandro.barenghi@polimi.it>
+ * @author: Marco Gianvecchio <marco.gianvecchio@mail.polimi.it>
+ * @author: Patrick Karl <patrick.karl@tum.de>
+ * @author: Gerardo Pelosi <gerardo.pelosi@polimi.it>
+ * @author: Jonas Schupp <jonas.schupp@tum.de>
+ * 
+ * 
+ * This code is hereby placed in the public domain.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ''AS IS'' AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **/
+
+#if defined(PK_CACHE) && !defined(_POSIX_C_SOURCE)
+/* pthreads are POSIX, not ISO C */
+#define _POSIX_C_SOURCE 200112L
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+#if defined(PK_CACHE)
+#include <pthread.h>
+#endif
+
+#include "pk_cache.h"
+
+#if defined(PK_CACHE)
+
+typedef struct pk_cache_entry_s {
+   struct pk_cache_entry_s *prev;
+   struct pk_cache_entry_s *next;
+   uint8_t seed_pk[KEYPAIR_SEED_LENGTH_BYTES];
+   size_t len;
+   uint8_t expanded[];
+} pk_cache_entry_t;
+
+typedef struct {
+   pthread_mutex_t lock;
+   /* most recently used entry first */
+   pk_cache_entry_t *head;
+   pk_cache_entry_t *tail;
+   size_t bytes;
+} pk_cache_shard_t;
+
+static pk_cache_shard_t pk_cache_shards[PK_CACHE_SHARDS];
+static pthread_once_t pk_cache_once = PTHREAD_ONCE_INIT;
+static size_t pk_cache_budget = PK_CACHE_BUDGET_BYTES;
+
+static uint64_t pk_cache_hits;
+static uint64_t pk_cache_misses;
+static uint64_t pk_cache_evictions;
+
+static
+void pk_cache_init(void)
+{
+   for(int i = 0; i < PK_CACHE_SHARDS; i++){
+      pthread_mutex_init(&pk_cache_shards[i].lock, NULL);
+   }
+}
+
+/* seed_pk is CSPRNG output for honestly generated keys, its first bytes
+ * spread them evenly among the shards */
+static
+pk_cache_shard_t *pk_cache_shard(
+   const uint8_t seed_pk[KEYPAIR_SEED_LENGTH_BYTES])
+{
+   pthread_once(&pk_cache_once, pk_cache_init);
+   unsigned int idx = ((unsigned int) seed_pk[0] |
+                       ((unsigned int) seed_pk[1] << 8)) % PK_CACHE_SHARDS;
+   return &pk_cache_shards[idx];
+}
+
+static
+size_t pk_cache_shard_budget(void)
+{
+   return __atomic_load_n(&pk_cache_budget, __ATOMIC_RELAXED) / PK_CACHE_SHARDS;
+}
+
+/* the following helpers are called with the shard lock held */
+static
+void pk_cache_unlink(pk_cache_shard_t *shard, pk_cache_entry_t *e)
+{
+   if(e->prev != NULL){
+      e->prev->next = e->next;
+   } else {
+      shard->head = e->next;
+   }
+   if(e->next != NULL){
+      e->next->prev = e->prev;
+   } else {
+      shard->tail = e->prev;
+   }
+}
+
+static
+void pk_cache_push_front(pk_cache_shard_t *shard, pk_cache_entry_t *e)
+{
+   e->prev = NULL;
+   e->next = shard->head;
+   if(shard->head != NULL){
+      shard->head->prev = e;
+   } else {
+      shard->tail = e;
+   }
+   shard->head = e;
+}
+
+static
+pk_cache_entry_t *pk_cache_find(
+   pk_cache_shard_t *shard,
+   const uint8_t seed_pk[KEYPAIR_SEED_LENGTH_BYTES])
+{
+   for(pk_cache_entry_t *e = shard->head; e != NULL; e = e->next){
+      if(memcmp(e->seed_pk, seed_pk, KEYPAIR_SEED_LENGTH_BYTES) == 0){
+         return e;
+      }
+   }
+   return NULL;
+}
+
+static
+void pk_cache_evict_to(pk_cache_shard_t *shard, size_t limit)
+{
+   while(shard->bytes > limit && shard->tail != NULL){
+      pk_cache_entry_t *e = shard->tail;
+      pk_cache_unlink(shard, e);
+      shard->bytes -= sizeof(pk_cache_entry_t) + e->len;
+      free(e);
+      __atomic_fetch_add(&pk_cache_evictions, 1, __ATOMIC_RELAXED);
+   }
+}
+
+int pk_cache_lookup(const uint8_t seed_pk[KEYPAIR_SEED_LENGTH_BYTES],
+                    void *expanded,
+                    size_t len)
+{
+   pk_cache_shard_t *shard = pk_cache_shard(seed_pk);
+   int found = 0;
+   pthread_mutex_lock(&shard->lock);
+   pk_cache_entry_t *e = pk_cache_find(shard, seed_pk);
+   if(e != NULL && e->len == len){
+      /* copied out under the lock: the entry may be evicted right after */
+      memcpy(expanded, e->expanded, len);
+      pk_cache_unlink(shard, e);
+      pk_cache_push_front(shard, e);
+      found = 1;
+   }
+   pthread_mutex_unlock(&shard->lock);
+   __atomic_fetch_add(found ? &pk_cache_hits : &pk_cache_misses, 1,
+                      __ATOMIC_RELAXED);
+   return found;
+}
+
+void pk_cache_insert(const uint8_t seed_pk[KEYPAIR_SEED_LENGTH_BYTES],
+                     const void *expanded,
+                     size_t len)
+{
+   size_t footprint = sizeof(pk_cache_entry_t) + len;
+   if(footprint > pk_cache_shard_budget()){
+      return;
+   }
+   /* allocated and filled before taking the lock, the cache is best effort
+    * and silently skips the insertion if memory is short */
+   pk_cache_entry_t *e = malloc(footprint);
+   if(e == NULL){
+      return;
+   }
+   memcpy(e->seed_pk, seed_pk, KEYPAIR_SEED_LENGTH_BYTES);
+   e->len = len;
+   memcpy(e->expanded, expanded, len);
+
+   pk_cache_shard_t *shard = pk_cache_shard(seed_pk);
+   pthread_mutex_lock(&shard->lock);
+   pk_cache_entry_t *old = pk_cache_find(shard, seed_pk);
+   if(old != NULL){
+      /* inserted by another thread which missed at the same time */
+      pk_cache_unlink(shard, old);
+      shard->bytes -= sizeof(pk_cache_entry_t) + old->len;
+      free(old);
+   }
+   pk_cache_push_front(shard, e);
+   shard->bytes += footprint;
+   pk_cache_evict_to(shard, pk_cache_shard_budget());
+   pthread_mutex_unlock(&shard->lock);
+}
+
+void pk_cache_set_budget(size_t budget_bytes)
+{
+   __atomic_store_n(&pk_cache_budget, budget_bytes, __ATOMIC_RELAXED);
+   pthread_once(&pk_cache_once, pk_cache_init);
+   for(int i = 0; i < PK_CACHE_SHARDS; i++){
+      pthread_mutex_lock(&pk_cache_shards[i].lock);
+      pk_cache_evict_to(&pk_cache_shards[i], budget_bytes / PK_CACHE_SHARDS);
+      pthread_mutex_unlock(&pk_cache_shards[i].lock);
+   }
+}
+
+void pk_cache_stats(uint64_t *hits,
+                    uint64_t *misses,
+                    uint64_t *evictions)
+{
+   if(hits != NULL){
+      *hits = __atomic_load_n(&pk_cache_hits, __ATOMIC_RELAXED);
+   }
+   if(misses != NULL){
+      *misses = __atomic_load_n(&pk_cache_misses, __ATOMIC_RELAXED);
+   }
+   if(evictions != NULL){
+      *evictions = __atomic_load_n(&pk_cache_evictions, __ATOMIC_RELAXED);
+   }
+}
+
+void pk_cache_release(void)
+{
+   pthread_once(&pk_cache_once, pk_cache_init);
+   for(int i = 0; i < PK_CACHE_SHARDS; i++){
+      pk_cache_shard_t *shard = &pk_cache_shards[i];
+      pthread_mutex_lock(&shard->lock);
+      while(shard->head != NULL){
+         pk_cache_entry_t *e = shard->head;
+         shard->head = e->next;
+         free(e);
+      }
+      shard->tail = NULL;
+      shard->bytes = 0;
+      pthread_mutex_unlock(&shard->lock);
+   }
+}
+
+#else
+
+int pk_cache_lookup(const uint8_t seed_pk[KEYPAIR_SEED_LENGTH_BYTES],
+                    void *expanded,
+                    size_t len)
+{
+   (void)seed_pk;
+   (void)expanded;
+   (void)len;
+   return 0;
+}
+
+void pk_cache_insert(const uint8_t seed_pk[KEYPAIR_SEED_LENGTH_BYTES],
+                     const void *expanded,
+                     size_t len)
+{
+   (void)seed_pk;
+   (void)expanded;
+   (void)len;
+}
+
+void pk_cache_set_budget(size_t budget_bytes)
+{
+   (void)budget_bytes;
+}
+
+void pk_cache_stats(uint64_t *hits,
+                    uint64_t *misses,
+                    uint64_t *evictions)
+{
+   if(hits != NULL){
+      *hits = 0;
+   }
+   if(misses != NULL){
+      *misses = 0;
+   }
+   if(evictions != NULL){
+      *evictions = 0;
+   }
+}
+
+void pk_cache_release(void)
+{
+}
+
+#endif
@@ -0,0 +1,461 @@
+/**
+ *
+ * Reference ISO-C11 Implementation of CROSS.
+ *
+ * @version 2.0 (February 2025)
+ *
+ * Authors listed in alphabetical order:
+ * 
+ * @author: Alessandro Barenghi <alessandro.barenghi@polimi.it>
+ * @author: Marco Gianvecchio <marco.gianvecchio@mail.polimi.it>
+ * @author: Patrick Karl <patrick.karl@tum.de>
+ * @author: Gerardo Pelosi <gerardo.pelosi@polimi.it>
+ * @author: Jonas Schupp <jonas.schupp@tum.de>
+ * 
+ * 
+ * This code is hereby placed in the public domain.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ''AS IS'' AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **/
+
+/* mmap() is POSIX, not ISO C */
+#if defined(PK_EXPANDED_FILE) && !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200112L
+#endif
+/* fopen() is deprecated by the Microsoft C runtime */
+#if defined(PK_EXPANDED_FILE) && defined(_WIN32) && !defined(_CRT_SECURE_NO_WARNINGS)
+#define _CRT_SECURE_NO_WARNINGS
+#endif
+
+#include <stddef.h>
+#if defined(PK_EXPANDED_FILE)
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#endif
+
+#include "CROSS.h"
+#include "pk_expanded.h"
+
+/* Files of expanded public keys take dynamic memory and file I/O, which the
+ * scheme does not otherwise employ: they are compiled in only when
+ * PK_EXPANDED_FILE is defined, e.g., building with
+ * EXTRAFLAGS="-DPK_EXPANDED_FILE". Without it, storing fails and mapping
+ * returns NULL. */
+
+#if defined(PK_EXPANDED_FILE)
+
+/* A file of expanded public keys is made of a header, zero padded to
+ * PK_EXPANDED_FILE_HEADER_BYTES, followed by the entries: pk_expanded_t in
+ * the layout of the implementation which wrote them, with zeroed padding,
+ * sorted by pk and without duplicates, and by the CRC32C of every entry.
+ * Everything is in the byte order of the writer. The header carries its own
+ * CRC32C, taken with a zero header_crc field.
+ * Mapping checks the header and the file size only, so that its cost does
+ * not grow with the number of keys; the CRC32C of an entry is checked the
+ * first time CROSS_pk_expanded_find looks it up, and the outcome is kept
+ * with the map. A CRC32C detects corruption, not tampering: the file is as
+ * trusted as the keys it is written from. */
+
+#define PK_EXPANDED_FILE_MAGIC "CROSSEPK"
+#define PK_EXPANDED_FILE_VERSION 2
+#define PK_EXPANDED_FILE_ENDIANNESS 0x01020304
+/* a multiple of the alignment of pk_expanded_t, so that entries in a page
+ * aligned mapping are aligned as well */
+#define PK_EXPANDED_FILE_HEADER_BYTES 128
+
+/* reflected Castagnoli polynomial */
+#define PK_EXPANDED_CRC32C_POLY 0x82F63B78u
+
+typedef struct {
+   uint8_t magic[8];
+   uint32_t version;
+   uint32_t endianness;
+   uint32_t layout;
+   /* P, N, K and M, the latter is zero for RSDP */
+   uint32_t params[4];
+   uint32_t entry_bytes;
+   uint32_t offset_s;
+   uint32_t offset_pk;
+   uint64_t num_keys;
+   uint32_t header_crc;
+} pk_expanded_file_header_t;
+
+/* ISO C99 has no static_assert */
+typedef char pk_expanded_file_header_fits[
+   (sizeof(pk_expanded_file_header_t) <= PK_EXPANDED_FILE_HEADER_BYTES) ? 1 : -1];
+
+/* CRC32C, computed eight bytes at a time (slicing-by-8) */
+typedef struct {
+   uint32_t table[8][256];
+} pk_expanded_crc_t;
+
+/* outcomes of the check of an entry */
+#define PK_EXPANDED_ENTRY_UNCHECKED 0
+#define PK_EXPANDED_ENTRY_OK 1
+#define PK_EXPANDED_ENTRY_CORRUPTED 2
+
+/* concurrent lookups of an unchecked entry may both check it, and store the
+ * same outcome */
+#if defined(__GNUC__)
+#define PK_EXPANDED_ENTRY_LOAD(p) __atomic_load_n((p), __ATOMIC_RELAXED)
+#define PK_EXPANDED_ENTRY_STORE(p, v) __atomic_store_n((p), (v), __ATOMIC_RELAXED)
+#else
+#define PK_EXPANDED_ENTRY_LOAD(p) (*(volatile uint8_t *) (p))
+#define PK_EXPANDED_ENTRY_STORE(p, v) (*(volatile uint8_t *) (p) = (v))
+#endif
+
+struct pk_expanded_map_s {
+   /* file contents, either mapped or read into allocation */
+   const uint8_t *data;
+   size_t size;
+   void *allocation;
+   const pk_expanded_t *entries;
+   const uint8_t *entry_crcs;
+   size_t num_keys;
+   /* PK_EXPANDED_ENTRY_* of every entry */
+   uint8_t *entry_states;
+   pk_expanded_crc_t crc;
+};
+
+static
+void pk_expanded_crc_init(pk_expanded_crc_t *crc){
+   for(uint32_t b = 0; b < 256; b++){
+      uint32_t c = b;
+      for(int i = 0; i < 8; i++){
+         c = (c >> 1) ^ (PK_EXPANDED_CRC32C_POLY & (0u - (c & 1)));
+      }
+      crc->table[0][b] = c;
+   }
+   for(uint32_t b = 0; b < 256; b++){
+      for(int t = 1; t < 8; t++){
+         uint32_t c = crc->table[t-1][b];
+         crc->table[t][b] = (c >> 8) ^ crc->table[0][c & 0xFF];
+      }
+   }
+}
+
+static
+uint32_t pk_expanded_crc(const pk_expanded_crc_t *crc,
+                         const uint8_t *in,
+                         size_t len){
+   uint32_t c = 0xFFFFFFFFu;
+   while(len >= 8){
+      uint32_t lo = c ^ ((uint32_t) in[0] | (uint32_t) in[1] << 8 |
+                         (uint32_t) in[2] << 16 | (uint32_t) in[3] << 24);
+      c = crc->table[7][lo & 0xFF] ^ crc->table[6][(lo >> 8) & 0xFF] ^
+          crc->table[5][(lo >> 16) & 0xFF] ^ crc->table[4][lo >> 24] ^
+          crc->table[3][in[4]] ^ crc->table[2][in[5]] ^
+          crc->table[1][in[6]] ^ crc->table[0][in[7]];
+      in += 8;
+      len -= 8;
+   }
+   while(len > 0){
+      c = (c >> 8) ^ crc->table[0][(c ^ *in) & 0xFF];
+      in++;
+      len--;
+   }
+   return c ^ 0xFFFFFFFFu;
+}
+
+/* CRC32Cs are stored little endian */
+static
+void pk_expanded_crc_store(uint8_t out[4], uint32_t c){
+   for(int i = 0; i < 4; i++){
+      out[i] = (uint8_t) (c >> (8*i));
+   }
+}
+
+static
+uint32_t pk_expanded_crc_load(const uint8_t in[4]){
+   return (uint32_t) in[0] | (uint32_t) in[1] << 8 |
+          (uint32_t) in[2] << 16 | (uint32_t) in[3] << 24;
+}
+
+/* the header this implementation writes and accepts, header_crc excluded */
+static
+void pk_expanded_file_header(uint8_t out[PK_EXPANDED_FILE_HEADER_BYTES],
+                             uint64_t num_keys){
+   pk_expanded_file_header_t header;
+   memset(&header, 0, sizeof(header));
+   memcpy(header.magic, PK_EXPANDED_FILE_MAGIC, sizeof(header.magic));
+   header.version = PK_EXPANDED_FILE_VERSION;
+   header.endianness = PK_EXPANDED_FILE_ENDIANNESS;
+   header.layout = PK_EXPANDED_LAYOUT;
+   header.params[0] = P;
+   header.params[1] = N;
+   header.params[2] = K;
+#if defined(RSDPG)
+   header.params[3] = M;
+#endif
+   header.entry_bytes = (uint32_t) sizeof(pk_expanded_t);
+   header.offset_s = (uint32_t) offsetof(pk_expanded_t, s);
+   header.offset_pk = (uint32_t) offsetof(pk_expanded_t, pk);
+   header.num_keys = num_keys;
+   memset(out, 0, PK_EXPANDED_FILE_HEADER_BYTES);
+   memcpy(out, &header, sizeof(header));
+}
+
+static
+int pk_compare(const void *a, const void *b){
+   return memcmp(a, b, sizeof(pk_t));
+}
+
+int CROSS_pk_expanded_store(const char *path,
+                            const pk_t *PK,
+                            size_t n){
+   pk_t *sorted = malloc((n > 0 ? n : 1) * sizeof(pk_t));
+   if(sorted == NULL){
+      return 0;
+   }
+   memcpy(sorted, PK, n * sizeof(pk_t));
+   qsort(sorted, n, sizeof(pk_t), pk_compare);
+   size_t num_keys = 0;
+   for(size_t i = 0; i < n; i++){
+      if(num_keys == 0 || pk_compare(&sorted[num_keys-1], &sorted[i]) != 0){
+         sorted[num_keys] = sorted[i];
+         num_keys++;
+      }
+   }
+
+   pk_expanded_crc_t *crc = malloc(sizeof(pk_expanded_crc_t));
+   uint8_t *entry_crcs = malloc((num_keys > 0 ? num_keys : 1) * 4);
+   FILE *f = NULL;
+   int ok = crc != NULL && entry_crcs != NULL &&
+            (f = fopen(path, "wb")) != NULL;
+   if(ok){
+      pk_expanded_crc_init(crc);
+      uint8_t header[PK_EXPANDED_FILE_HEADER_BYTES];
+      pk_expanded_file_header(header, num_keys);
+      pk_expanded_crc_store(header + offsetof(pk_expanded_file_header_t, header_crc),
+                            pk_expanded_crc(crc, header, sizeof(header)));
+      ok = fwrite(header, sizeof(header), 1, f) == 1;
+      pk_expanded_t entry;
+      for(size_t i = 0; ok && i < num_keys; i++){
+         /* padding is zeroed, as it is covered by the CRC32C */
+         memset(&entry, 0, sizeof(entry));
+         ok = CROSS_pk_expand(&entry, &sorted[i]) &&
+              fwrite(&entry, sizeof(entry), 1, f) == 1;
+         pk_expanded_crc_store(entry_crcs + 4*i,
+                               pk_expanded_crc(crc, (const uint8_t *) &entry, sizeof(entry)));
+      }
+      ok = ok && (num_keys == 0 || fwrite(entry_crcs, 4*num_keys, 1, f) == 1);
+   }
+   if(f != NULL){
+      ok = (fclose(f) == 0) && ok;
+      if(!ok){
+         remove(path);
+      }
+   }
+   free(crc);
+   free(entry_crcs);
+   free(sorted);
+   return ok;
+}
+
+/* checks the header of the file in map and that its size agrees with it;
+ * the entries are checked by CROSS_pk_expanded_find */
+static
+int pk_expanded_map_check(pk_expanded_map_t *map){
+   if(map->size < PK_EXPANDED_FILE_HEADER_BYTES){
+      return 0;
+   }
+   pk_expanded_file_header_t stored;
+   memcpy(&stored, map->data, sizeof(stored));
+   /* the number of keys must agree with the file size */
+   const size_t stored_entry_bytes = sizeof(pk_expanded_t) + 4;
+   if(stored.num_keys > (map->size - PK_EXPANDED_FILE_HEADER_BYTES) / stored_entry_bytes ||
+      PK_EXPANDED_FILE_HEADER_BYTES + stored.num_keys * stored_entry_bytes != map->size){
+      return 0;
+   }
+   uint8_t expected[PK_EXPANDED_FILE_HEADER_BYTES];
+   pk_expanded_file_header(expected, stored.num_keys);
+   uint8_t header[PK_EXPANDED_FILE_HEADER_BYTES];
+   memcpy(header, map->data, PK_EXPANDED_FILE_HEADER_BYTES);
+   memset(header + offsetof(pk_expanded_file_header_t, header_crc), 0, 4);
+   if(memcmp(header, expected, PK_EXPANDED_FILE_HEADER_BYTES) != 0){
+      return 0;
+   }
+   pk_expanded_crc_init(&map->crc);
+   if(pk_expanded_crc(&map->crc, header, sizeof(header)) !=
+      pk_expanded_crc_load(map->data + offsetof(pk_expanded_file_header_t, header_crc))){
+      return 0;
+   }
+
+   map->num_keys = (size_t) stored.num_keys;
+   map->entries = (const pk_expanded_t *) (map->data + PK_EXPANDED_FILE_HEADER_BYTES);
+   map->entry_crcs = map->data + PK_EXPANDED_FILE_HEADER_BYTES +
+                     map->num_keys * sizeof(pk_expanded_t);
+   map->entry_states = calloc(map->num_keys > 0 ? map->num_keys : 1, 1);
+   return map->entry_states != NULL;
+}
+
+#if !defined(_WIN32)
+/* maps the file read-only, the entries are employed in place */
+static
+int pk_expanded_map_file(pk_expanded_map_t *map, const char *path){
+   int fd = open(path, O_RDONLY);
+   if(fd < 0){
+      return 0;
+   }
+   struct stat st;
+   if(fstat(fd, &st) != 0 || st.st_size <= 0){
+      close(fd);
+      return 0;
+   }
+   map->size = (size_t) st.st_size;
+   void *data = mmap(NULL, map->size, PROT_READ, MAP_PRIVATE, fd, 0);
+   close(fd);
+   if(data == MAP_FAILED){
+      return 0;
+   }
+   map->data = (const uint8_t *) data;
+   return 1;
+}
+
+static
+void pk_expanded_unmap_file(pk_expanded_map_t *map){
+   munmap((void *) map->data, map->size);
+}
+#else
+/* no mmap(): the file is read into a buffer aligned as a page would be */
+#define PK_EXPANDED_READ_ALIGN 64
+
+static
+int pk_expanded_map_file(pk_expanded_map_t *map, const char *path){
+   FILE *f = fopen(path, "rb");
+   if(f == NULL){
+      return 0;
+   }
+   long size = -1;
+   if(fseek(f, 0, SEEK_END) == 0){
+      size = ftell(f);
+   }
+   if(size <= 0 || fseek(f, 0, SEEK_SET) != 0){
+      fclose(f);
+      return 0;
+   }
+   map->size = (size_t) size;
+   map->allocation = malloc(map->size + PK_EXPANDED_READ_ALIGN);
+   if(map->allocation == NULL){
+      fclose(f);
+      return 0;
+   }
+   uint8_t *data = (uint8_t *) map->allocation;
+   data += (PK_EXPANDED_READ_ALIGN - ((uintptr_t) data % PK_EXPANDED_READ_ALIGN)) % PK_EXPANDED_READ_ALIGN;
+   int ok = fread(data, map->size, 1, f) == 1;
+   fclose(f);
+   if(!ok){
+      free(map->allocation);
+      return 0;
+   }
+   map->data = data;
+   return 1;
+}
+
+static
+void pk_expanded_unmap_file(pk_expanded_map_t *map){
+   free(map->allocation);
+}
+#endif
+
+pk_expanded_map_t *CROSS_pk_expanded_map(const char *path){
+   pk_expanded_map_t *map = calloc(1, sizeof(pk_expanded_map_t));
+   if(map == NULL){
+      return NULL;
+   }
+   if(!pk_expanded_map_file(map, path)){
+      free(map);
+      return NULL;
+   }
+   if(!pk_expanded_map_check(map)){
+      pk_expanded_unmap_file(map);
+      free(map->entry_states);
+      free(map);
+      return NULL;
+   }
+   return map;
+}
+
+const pk_expanded_t *CROSS_pk_expanded_find(const pk_expanded_map_t *map,
+                                            const pk_t *PK){
+   /* entries are sorted by pk */
+   size_t lo = 0, hi = map->num_keys;
+   while(lo < hi){
+      size_t mid = lo + (hi - lo) / 2;
+      int c = pk_compare(&map->entries[mid].pk, PK);
+      if(c == 0){
+         uint8_t state = PK_EXPANDED_ENTRY_LOAD(&map->entry_states[mid]);
+         if(state == PK_EXPANDED_ENTRY_UNCHECKED){
+            uint32_t entry_crc = pk_expanded_crc(&map->crc,
+                                                 (const uint8_t *) &map->entries[mid],
+                                                 sizeof(pk_expanded_t));
+            state = (entry_crc == pk_expanded_crc_load(map->entry_crcs + 4*mid)) ?
+                    PK_EXPANDED_ENTRY_OK : PK_EXPANDED_ENTRY_CORRUPTED;
+            PK_EXPANDED_ENTRY_STORE(&map->entry_states[mid], state);
+         }
+         return (state == PK_EXPANDED_ENTRY_OK) ? &map->entries[mid] : NULL;
+      }
+      if(c < 0){
+         lo = mid + 1;
+      } else {
+         hi = mid;
+      }
+   }
+   return NULL;
+}
+
+void CROSS_pk_expanded_unmap(pk_expanded_map_t *map){
+   if(map == NULL){
+      return;
+   }
+   pk_expanded_unmap_file(map);
+   free(map->entry_states);
+   free(map);
+}
+
+#else
+
+int CROSS_pk_expanded_store(const char *path,
+                            const pk_t *PK,
+                            size_t n){
+   (void) path;
+   (void) PK;
+   (void) n;
+   return 0;
+}
+
+pk_expanded_map_t *CROSS_pk_expanded_map(const char *path){
+   (void) path;
+   return NULL;
+}
+
+const pk_expanded_t *CROSS_pk_expanded_find(const pk_expanded_map_t *map,
+                                            const pk_t *PK){
+   (void) map;
+   (void) PK;
+   return NULL;
+}
+
+void CROSS_pk_expanded_unmap(pk_expanded_map_t *map){
+   (void) map;
+}
+
+#endif
@@ -0,0 +1,58 @@
+/**
+ *
+ * Reference ISO-C11 Implementation of CROSS.
+ *
+ * @version 2.0 (February 2025)
+ *
+ * Authors listed in alphabetical order:
+ * 
+ * @author: Alessandro Barenghi <alessandro.barenghi@polimi.it>
+ * @author: Marco Gianvecchio <marco.gianvecchio@mail.polimi.it>
+ * @author: Patrick Karl <patrick.karl@tum.de>
+ * @author: Gerardo Pelosi <gerardo.pelosi@polimi.it>
+ * @author: Jonas Schupp <jonas.schupp@tum.de>
+ * 
+ * 
+ * This code is hereby placed in the public domain.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ''AS IS'' AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **/
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "CROSS.h"
+#include "namespace.h"
+#include "parameters.h"
+
+/* identifies the memory layout of pk_expanded_t in files of expanded keys,
+ * together with its size and field offsets */
+#define PK_EXPANDED_LAYOUT 1
+
+/* Public key expanded for verification: the matrices generated from seed_pk
+ * are stored first, so that they can be cached as a single block of
+ * PK_EXPANDED_MATRICES_BYTES, followed by the unpacked syndrome and by the
+ * key itself */
+struct pk_expanded_s {
+   FP_ELEM V_tr[K][N-K];
+#if defined(RSDPG)
+   FZ_ELEM W_mat[M][N-M];
+#endif
+   FP_ELEM s[N-K];
+   pk_t pk;
+};
+
+#define PK_EXPANDED_MATRICES_BYTES (offsetof(pk_expanded_t, s))
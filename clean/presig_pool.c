@@ -0,0 +1,255 @@
+/**
+ *
+ * Reference ISO-C11 Implementation of CROSS.
+ *
+ * @version 2.0 (February 2025)
+ *
+ * Authors listed in alphabetical order:
+ * 
+ * @author: Alessandro Barenghi <alessandro.barenghi@polimi.it>
+ * @author: Marco Gianvecchio <marco.gianvecchio@mail.polimi.it>
+ * @author: Patrick Karl <patrick.karl@tum.de>
+ * @author: Gerardo Pelosi <gerardo.pelosi@polimi.it>
+ * @author: Jonas Schupp <jonas.schupp@tum.de>
+ * 
+ * 
+ * This code is hereby placed in the public domain.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ''AS IS'' AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **/
+
+
+#if defined(PRESIG_POOL) && !defined(_POSIX_C_SOURCE)
+/* pthreads are POSIX, not ISO C */
+#define _POSIX_C_SOURCE 200112L
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+#if defined(PRESIG_POOL)
+#include <pthread.h>
+#endif
+
+#include "presig.h"
+#include "presig_pool.h"
+
+#if defined(PRESIG_POOL)
+
+typedef struct {
+   pthread_mutex_t lock;
+   /* signalled when a presignature is consumed, or the pool is stopped */
+   pthread_cond_t not_full;
+   pthread_t refill;
+   int is_running;
+   sk_t SK;
+   CROSS_presig_t *slots;
+   size_t capacity;
+   /* stacks of slots holding a presignature, and of wiped ones */
+   CROSS_presig_t **ready;
+   size_t ready_cnt;
+   CROSS_presig_t **spare;
+   size_t spare_cnt;
+} presig_pool_t;
+
+static presig_pool_t presig_pool = {
+   .lock = PTHREAD_MUTEX_INITIALIZER,
+   .not_full = PTHREAD_COND_INITIALIZER,
+};
+
+static pthread_once_t presig_pool_atfork_once = PTHREAD_ONCE_INIT;
+
+/* a single thread refills the pool: presignatures are computed outside of
+ * the lock, one at a time, from the SK copy which is constant meanwhile */
+static
+void *presig_pool_refill(void *arg){
+   (void)arg;
+   pthread_mutex_lock(&presig_pool.lock);
+   for(;;){
+      while(presig_pool.is_running && presig_pool.spare_cnt == 0){
+         pthread_cond_wait(&presig_pool.not_full, &presig_pool.lock);
+      }
+      if(!presig_pool.is_running){
+         break;
+      }
+      CROSS_presig_t *presig = presig_pool.spare[--presig_pool.spare_cnt];
+      pthread_mutex_unlock(&presig_pool.lock);
+      CROSS_presign(&presig_pool.SK, presig);
+      pthread_mutex_lock(&presig_pool.lock);
+      presig_pool.ready[presig_pool.ready_cnt++] = presig;
+   }
+   pthread_mutex_unlock(&presig_pool.lock);
+   return NULL;
+}
+
+static
+void presig_pool_free(void){
+   /* spare slots are wiped already, ready ones are not */
+   for(size_t i = 0; i < presig_pool.ready_cnt; i++){
+      presig_wipe(presig_pool.ready[i], sizeof(CROSS_presig_t));
+   }
+   presig_wipe(&presig_pool.SK, sizeof(sk_t));
+   free(presig_pool.slots);
+   free(presig_pool.ready);
+   free(presig_pool.spare);
+   presig_pool.slots = NULL;
+   presig_pool.ready = NULL;
+   presig_pool.spare = NULL;
+   presig_pool.capacity = 0;
+   presig_pool.ready_cnt = 0;
+   presig_pool.spare_cnt = 0;
+}
+
+/* fork() runs while holding the lock, so that the child does not inherit it
+ * locked by a thread which does not exist there */
+static
+void presig_pool_atfork_prepare(void){
+   pthread_mutex_lock(&presig_pool.lock);
+}
+
+static
+void presig_pool_atfork_parent(void){
+   pthread_mutex_unlock(&presig_pool.lock);
+}
+
+/* the child inherits the presignatures of the parent, but not the refill
+ * thread: signing with them in both processes would reveal the secret key.
+ * Every slot is wiped, also the ones being computed or consumed by the
+ * threads of the parent, and the pool is stopped without joining the refill
+ * thread, which the child lacks */
+static
+void presig_pool_atfork_child(void){
+   if(presig_pool.slots != NULL){
+      presig_wipe(presig_pool.slots, presig_pool.capacity*sizeof(CROSS_presig_t));
+   }
+   presig_pool.ready_cnt = 0;
+   presig_pool.is_running = 0;
+   presig_pool_free();
+   pthread_mutex_unlock(&presig_pool.lock);
+   pthread_cond_init(&presig_pool.not_full, NULL);
+}
+
+static
+void presig_pool_atfork_register(void){
+   pthread_atfork(presig_pool_atfork_prepare,
+                  presig_pool_atfork_parent,
+                  presig_pool_atfork_child);
+}
+
+int presig_pool_start(const sk_t *const SK,
+                      const size_t capacity){
+   int res = -1;
+   pthread_once(&presig_pool_atfork_once, presig_pool_atfork_register);
+   pthread_mutex_lock(&presig_pool.lock);
+   if(presig_pool.is_running || capacity == 0 ||
+      capacity > SIZE_MAX / sizeof(CROSS_presig_t)){
+      goto end;
+   }
+   presig_pool.slots = malloc(capacity * sizeof(CROSS_presig_t));
+   presig_pool.ready = malloc(capacity * sizeof(CROSS_presig_t *));
+   presig_pool.spare = malloc(capacity * sizeof(CROSS_presig_t *));
+   if(presig_pool.slots == NULL || presig_pool.ready == NULL ||
+      presig_pool.spare == NULL){
+      presig_pool_free();
+      goto end;
+   }
+   for(size_t i = 0; i < capacity; i++){
+      presig_pool.slots[i].is_ready = 0;
+      presig_pool.spare[i] = &presig_pool.slots[i];
+   }
+   presig_pool.capacity = capacity;
+   presig_pool.spare_cnt = capacity;
+   memcpy(&presig_pool.SK, SK, sizeof(sk_t));
+   presig_pool.is_running = 1;
+   if(pthread_create(&presig_pool.refill, NULL, presig_pool_refill, NULL) != 0){
+      presig_pool.is_running = 0;
+      presig_pool_free();
+      goto end;
+   }
+   res = 0;
+end:
+   pthread_mutex_unlock(&presig_pool.lock);
+   return res;
+}
+
+int presig_pool_sign(const char *const m,
+                     const uint64_t mlen,
+                     CROSS_sig_t *const sig){
+   CROSS_presig_t *presig = NULL;
+   pthread_mutex_lock(&presig_pool.lock);
+   if(!presig_pool.is_running){
+      pthread_mutex_unlock(&presig_pool.lock);
+      return -1;
+   }
+   if(presig_pool.ready_cnt > 0){
+      presig = presig_pool.ready[--presig_pool.ready_cnt];
+   }
+   pthread_mutex_unlock(&presig_pool.lock);
+
+   if(presig == NULL){
+      /* the refill thread is behind: the latency is the one of CROSS_sign */
+      CROSS_sign(&presig_pool.SK, m, mlen, sig);
+      return 0;
+   }
+   /* the slot was removed from ready under the lock, no other thread can
+    * employ it; CROSS_sign_online wipes it once used, the slot is wiped here
+    * as well should it fail, so that spare ones are always wiped */
+   int is_signed = CROSS_sign_online(presig, m, mlen, sig);
+   if(!is_signed){
+      presig_wipe(presig, sizeof(CROSS_presig_t));
+   }
+   pthread_mutex_lock(&presig_pool.lock);
+   presig_pool.spare[presig_pool.spare_cnt++] = presig;
+   pthread_cond_signal(&presig_pool.not_full);
+   pthread_mutex_unlock(&presig_pool.lock);
+   return is_signed ? 0 : -1;
+}
+
+void presig_pool_stop(void){
+   pthread_mutex_lock(&presig_pool.lock);
+   if(!presig_pool.is_running){
+      pthread_mutex_unlock(&presig_pool.lock);
+      return;
+   }
+   presig_pool.is_running = 0;
+   pthread_cond_signal(&presig_pool.not_full);
+   pthread_mutex_unlock(&presig_pool.lock);
+   pthread_join(presig_pool.refill, NULL);
+
+   pthread_mutex_lock(&presig_pool.lock);
+   presig_pool_free();
+   pthread_mutex_unlock(&presig_pool.lock);
+}
+
+#else
+
+int presig_pool_start(const sk_t *const SK,
+                      const size_t capacity){
+   (void)SK;
+   (void)capacity;
+   return -1;
+}
+
+int presig_pool_sign(const char *const m,
+                     const uint64_t mlen,
+                     CROSS_sig_t *const sig){
+   (void)m;
+   (void)mlen;
+   (void)sig;
+   return -1;
+}
+
+void presig_pool_stop(void){
+}
+
+#endif
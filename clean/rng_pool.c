@@ -0,0 +1,177 @@
+/**
+ *
+ * Reference ISO-C11 Implementation of CROSS.
+ *
+ * @version 2.0 (February 2025)
+ *
+ * Authors listed in alphabetical order:
+ * 
+ * @author: Alessandro Barenghi <alessandro.barenghi@polimi.it>
+ * @author: Marco Gianvecchio <marco.gianvecchio@mail.polimi.it>
+ * @author: Patrick Karl <patrick.karl@tum.de>
+ * @author: Gerardo Pelosi <gerardo.pelosi@polimi.it>
+ * @author: Jonas Schupp <jonas.schupp@tum.de>
+ * 
+ * 
+ * This code is hereby placed in the public domain.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ''AS IS'' AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **/
+
+/* pthreads are POSIX, not ISO C */
+#if defined(RNG_POOL) && !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200112L
+#endif
+
+#include <string.h>
+#if defined(RNG_POOL) && !defined(_WIN32)
+#include <pthread.h>
+#endif
+
+#include "csprng_hash.h"
+#include "parameters.h"
+#include "randombytes.h"
+#include "rng_pool.h"
+
+#if defined(RNG_POOL)
+
+#if defined(_MSC_VER)
+#define RNG_POOL_THREAD_LOCAL __declspec(thread)
+#else
+#define RNG_POOL_THREAD_LOCAL __thread
+#endif
+
+/* the DRBG key is 2*lambda bits long */
+#define RNG_POOL_KEY_BYTES HASH_DIGEST_LENGTH
+
+/* domain separator of the pool SHAKE, distinct from all the CSPRNG and hash
+ * ones employed by the scheme */
+#define RNG_POOL_DSC ((uint16_t)0xFFFF)
+
+typedef struct {
+   uint8_t key[RNG_POOL_KEY_BYTES];
+   uint8_t buffer[RNG_POOL_BYTES];
+   /* unread bytes, placed at the end of buffer */
+   size_t available;
+   uint32_t refills;
+   /* rng_pool_generation when the pool was seeded */
+   unsigned int generation;
+   int is_seeded;
+} rng_pool_t;
+
+static RNG_POOL_THREAD_LOCAL rng_pool_t rng_pool;
+
+/* bumped in the child by every fork(), so that a pool inherited from the
+ * parent is told apart from its own ones without a system call per draw.
+ * The child runs the handler before any other of its threads exists. */
+static unsigned int rng_pool_generation;
+
+#if !defined(_WIN32)
+static pthread_once_t rng_pool_atfork_once = PTHREAD_ONCE_INIT;
+
+static
+void rng_pool_atfork_child(void){
+   rng_pool_generation++;
+}
+
+static
+void rng_pool_atfork_register(void){
+   pthread_atfork(NULL, NULL, rng_pool_atfork_child);
+}
+#endif
+
+/* accesses through a volatile pointer are not optimized away */
+static
+void rng_pool_wipe(void *p, size_t len){
+   volatile uint8_t *v = (volatile uint8_t *) p;
+   while(len > 0){
+      *v++ = 0;
+      len--;
+   }
+}
+
+/* SHAKE(key || extra) yields the next key followed by a full buffer */
+static
+void rng_pool_refill(const uint8_t *extra, size_t extra_len){
+   uint8_t input[2*RNG_POOL_KEY_BYTES];
+   memcpy(input, rng_pool.key, RNG_POOL_KEY_BYTES);
+   if(extra_len > 0){
+      memcpy(input+RNG_POOL_KEY_BYTES, extra, extra_len);
+   }
+   CSPRNG_STATE_T csprng_state;
+   csprng_initialize(&csprng_state, input, RNG_POOL_KEY_BYTES+extra_len, RNG_POOL_DSC);
+   csprng_randombytes(rng_pool.key, RNG_POOL_KEY_BYTES, &csprng_state);
+   csprng_randombytes(rng_pool.buffer, RNG_POOL_BYTES, &csprng_state);
+   /* PQClean-edit: CSPRNG release context */
+   csprng_release(&csprng_state);
+   rng_pool_wipe(&csprng_state, sizeof(csprng_state));
+   rng_pool_wipe(input, sizeof(input));
+   rng_pool.available = RNG_POOL_BYTES;
+   rng_pool.refills++;
+}
+
+static
+void rng_pool_reseed(void){
+   uint8_t fresh[RNG_POOL_KEY_BYTES];
+   randombytes(fresh, RNG_POOL_KEY_BYTES);
+   rng_pool_refill(fresh, RNG_POOL_KEY_BYTES);
+   rng_pool_wipe(fresh, sizeof(fresh));
+   rng_pool.refills = 0;
+}
+
+void rng_pool_randombytes(uint8_t *x, size_t xlen){
+   if(!rng_pool.is_seeded || rng_pool.generation != rng_pool_generation){
+      /* first use in this thread, or a forked child inherited the pool
+       * of its parent: discard everything and seed afresh */
+#if !defined(_WIN32)
+      pthread_once(&rng_pool_atfork_once, rng_pool_atfork_register);
+#endif
+      rng_pool_wipe(&rng_pool, sizeof(rng_pool));
+      rng_pool_reseed();
+      rng_pool.generation = rng_pool_generation;
+      rng_pool.is_seeded = 1;
+   }
+   while(xlen > 0){
+      if(rng_pool.available == 0){
+         if(rng_pool.refills >= RNG_POOL_RESEED_INTERVAL){
+            rng_pool_reseed();
+         } else {
+            rng_pool_refill(NULL, 0);
+         }
+      }
+      size_t amount = (xlen < rng_pool.available) ? xlen : rng_pool.available;
+      uint8_t *src = rng_pool.buffer + (RNG_POOL_BYTES - rng_pool.available);
+      memcpy(x, src, amount);
+      /* handed out bytes do not stay in memory */
+      rng_pool_wipe(src, amount);
+      rng_pool.available -= amount;
+      x += amount;
+      xlen -= amount;
+   }
+}
+
+void rng_pool_release(void){
+   rng_pool_wipe(&rng_pool, sizeof(rng_pool));
+}
+
+#else
+
+void rng_pool_randombytes(uint8_t *x, size_t xlen){
+   randombytes(x, xlen);
+}
+
+void rng_pool_release(void){
+}
+
+#endif
@@ -0,0 +1,68 @@
+/**
+ *
+ * Reference ISO-C11 Implementation of CROSS.
+ *
+ * @version 2.0 (February 2025)
+ *
+ * Authors listed in alphabetical order:
+ * 
+ * @author: Alessandro Barenghi <alessandro.barenghi@polimi.it>
+ * @author: Marco Gianvecchio <marco.gianvecchio@mail.polimi.it>
+ * @author: Patrick Karl <patrick.karl@tum.de>
+ * @author: Gerardo Pelosi <gerardo.pelosi@polimi.it>
+ * @author: Jonas Schupp <jonas.schupp@tum.de>
+ * 
+ * 
+ * This code is hereby placed in the public domain.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ''AS IS'' AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **/
+
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "namespace.h"
+
+/* Buffered randomness for the seeds and salts drawn in keygen and sign.
+ * When RNG_POOL is defined, each thread owns a SHAKE-based DRBG, seeded from
+ * randombytes, which serves RNG_POOL_BYTES of output per refill. Every
+ * refill replaces the DRBG key with part of its own output (fast key
+ * erasure) and every RNG_POOL_RESEED_INTERVAL refills fresh randombytes
+ * material is mixed into the key. A child process created by fork() never
+ * reuses the parent's pool: a pthread_atfork handler makes its first draw
+ * reseed. It requires pthreads outside Windows, e.g., building with
+ * EXTRAFLAGS="-DRNG_POOL -pthread". Without RNG_POOL, randombytes is called
+ * directly and no pool is compiled in. */
+
+#if !defined(RNG_POOL_BYTES)
+#define RNG_POOL_BYTES 4096
+#endif
+#if !defined(RNG_POOL_RESEED_INTERVAL)
+#define RNG_POOL_RESEED_INTERVAL 256
+#endif
+
+/* fills x with xlen bytes from the pool of the calling thread */
+void rng_pool_randombytes(uint8_t *x, size_t xlen);
+
+/* wipes the pool of the calling thread, the next draw reseeds it */
+void rng_pool_release(void);
+
+#if defined(RNG_POOL)
+#define secret_randombytes(x, xlen) rng_pool_randombytes((x), (xlen))
+#else
+#define secret_randombytes(x, xlen) randombytes((x), (xlen))
+#endif
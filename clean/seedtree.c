@@ -33,6 +33,7 @@
 #include <string.h> // memcpy(...), memset(...)
 
 #include "seedtree.h"
+#include "tree_tables.h"
 
 #define LEFT_CHILD(i) (2*(i)+1)
 #define RIGHT_CHILD(i) (2*(i)+2)
@@ -44,7 +45,6 @@
  */
 
 #define TO_PUBLISH 1
-#define NOT_TO_PUBLISH 0
 
 #if defined(NO_TREES)
 int seed_leaves(unsigned char rounds_seeds[T*SEED_LENGTH_BYTES],
@@ -85,101 +85,35 @@ int seed_leaves(unsigned char rounds_seeds[T*SEED_LENGTH_BYTES],
 
 int seed_path(unsigned char *seed_storage,
               const unsigned char rounds_seeds[T*SEED_LENGTH_BYTES],
-              const unsigned char indices_to_publish[T]){
-    int published = 0;
-    for(int i=0; i<T; i++){
-       if(indices_to_publish[i] == TO_PUBLISH){
-          memcpy(&seed_storage[SEED_LENGTH_BYTES*published],
-                 &rounds_seeds[i*SEED_LENGTH_BYTES],
-                 SEED_LENGTH_BYTES);
-          published++;
-       }
+              const chall_2_t *chall_2){
+    for(int i=0; i<W; i++){
+       memcpy(&seed_storage[SEED_LENGTH_BYTES*i],
+              &rounds_seeds[chall_2->rounds_1[i]*SEED_LENGTH_BYTES],
+              SEED_LENGTH_BYTES);
     }
-    return published;
+    return W;
 }
 
 /* simply picks seeds out of the storage and places them in the in-memory array */
-uint8_t rebuild_leaves(unsigned char rounds_seeds[T*SEED_LENGTH_BYTES],                           
-                           const unsigned char indices_to_publish[T],
-                           const unsigned char *seed_storage){
-    int published = 0;
-    for(int i=0; i<T; i++){
-       if(indices_to_publish[i] == TO_PUBLISH){
-           memcpy(&rounds_seeds[i*SEED_LENGTH_BYTES],
-                  &seed_storage[SEED_LENGTH_BYTES*published],
-                  SEED_LENGTH_BYTES);
-           published++;
-       }
-   }      
-   return 1;
-}
-#else
-/*****************************************************************************/
-/**
- * const unsigned char *indices: input parameter denoting an array
- * with a number of binary cells equal to "leaves" representing
- * the labels of the nodes identified as leaves of the tree[...]
- * passed as second parameter.
- * A label = 1 means that the byteseed of the node having the same index
- * has to be released; = 0, otherwise.
- *
- * unsigned char *tree: input/output parameter denoting an array
- * with a number of binary cells equal to "2*leaves-1";
- * the first "leaves" cells (i.e., the ones with positions from 0 to leaves-1)
- * are the ones that will be modified by the current subroutine,
- * the last "leaves" cells will be a copy of the input array passed as first
- * parameter.
- *
- * uint64_t leaves: input parameter;
- *
- */
-
-static
-void label_leaves(unsigned char flag_tree[NUM_NODES_SEED_TREE],
-                     const unsigned char indices_to_publish[T])
-{
-    const uint16_t cons_leaves[TREE_SUBROOTS] = TREE_CONSECUTIVE_LEAVES;
-    const uint16_t leaves_start_indices[TREE_SUBROOTS] = TREE_LEAVES_START_INDICES;
-
-    unsigned int cnt = 0;
-    for (size_t i=0; i<TREE_SUBROOTS; i++) {
-        for (size_t j=0; j<cons_leaves[i]; j++) {
-            flag_tree[leaves_start_indices[i]+j] = indices_to_publish[cnt];
-            cnt++;
-        }
+uint8_t rebuild_leaves(unsigned char rounds_seeds[T*SEED_LENGTH_BYTES],
+                       const chall_2_t *chall_2,
+                       const unsigned char *seed_storage){
+    for(int i=0; i<W; i++){
+       memcpy(&rounds_seeds[chall_2->rounds_1[i]*SEED_LENGTH_BYTES],
+              &seed_storage[SEED_LENGTH_BYTES*i],
+              SEED_LENGTH_BYTES);
     }
+    return 1;
 }
 
-static void compute_seeds_to_publish(
-    /* linearized binary tree of boolean nodes containing
-     * flags for each node 1-filled nodes are to be released */
-    unsigned char flags_tree_to_publish[NUM_NODES_SEED_TREE],
-    /* Boolean Array indicating which of the T seeds must be
-     * released convention as per the above defines */
-    const unsigned char indices_to_publish[T]) {
-    /* the indices to publish may be less than the full leaves, copy them
-     * into the linearized tree leaves */
-    label_leaves(flags_tree_to_publish, indices_to_publish);
-
-    const uint16_t off[LOG2(T)+1] = TREE_OFFSETS;
-    const uint16_t npl[LOG2(T)+1] = TREE_NODES_PER_LEVEL;
-    const uint16_t leaves_start_indices[TREE_SUBROOTS] = TREE_LEAVES_START_INDICES;
-
-    /* compute the value for the internal nodes of the tree starting from the
-     * the leaves, right to left */
-    unsigned int start_node = leaves_start_indices[0];
-    for (int level=LOG2(T); level>0; level--) {
-        for (int i=npl[level]-2; i>=0; i-=2) {
-            uint16_t current_node = start_node + i;
-            uint16_t parent_node = PARENT(current_node) + (off[level-1] >> 1);
-
-            flags_tree_to_publish[parent_node] = (flags_tree_to_publish[current_node] == TO_PUBLISH)
-                && (flags_tree_to_publish[SIBLING(current_node)] == TO_PUBLISH);
-        }
-        start_node -= npl[level-1];
-    }
-} /* end compute_seeds_to_publish */
-
+uint8_t is_seed_path_padding_ok(const chall_2_t *chall_2,
+                                const unsigned char *seed_storage){
+   /* the path holds exactly W seeds, there is no padding to check */
+   (void)chall_2;
+   (void)seed_storage;
+   return 1;
+}
+#else
 /**
  * unsigned char *seed_tree:
  * it is intended as an output parameter;
@@ -244,22 +178,28 @@ void gen_seed_tree(unsigned char seed_tree[NUM_NODES_SEED_TREE * SEED_LENGTH_BYT
     }
 } /* end generate_seed_tree */
 
+void gen_seed_tree_leaves(unsigned char *seed_tree,
+                          unsigned char rounds_seeds[T*SEED_LENGTH_BYTES],
+                          const unsigned char root_seed[SEED_LENGTH_BYTES],
+                          const unsigned char salt[SALT_LENGTH_BYTES])
+{
+    unsigned char local_tree[NUM_NODES_SEED_TREE*SEED_LENGTH_BYTES];
+    if (seed_tree == NULL) {
+        seed_tree = local_tree;
+    }
+    gen_seed_tree(seed_tree, root_seed, salt);
+    seed_leaves(rounds_seeds, seed_tree);
+}
+
 
 /*****************************************************************************/
 void seed_leaves(unsigned char rounds_seeds[T*SEED_LENGTH_BYTES],
                  unsigned char seed_tree[NUM_NODES_SEED_TREE*SEED_LENGTH_BYTES])
 {
-    const uint16_t cons_leaves[TREE_SUBROOTS] = TREE_CONSECUTIVE_LEAVES;
-    const uint16_t leaves_start_indices[TREE_SUBROOTS] = TREE_LEAVES_START_INDICES;
-
-    unsigned int cnt = 0;
-    for (size_t i=0; i<TREE_SUBROOTS; i++) {
-        for (size_t j=0; j<cons_leaves[i]; j++) {
-            memcpy(rounds_seeds + cnt*SEED_LENGTH_BYTES,
-                   seed_tree + (leaves_start_indices[i]+j)*SEED_LENGTH_BYTES,
-                   SEED_LENGTH_BYTES);
-            cnt++;
-        }
+    for (size_t i=0; i<T; i++) {
+        memcpy(rounds_seeds + i*SEED_LENGTH_BYTES,
+               seed_tree + TREE_LEAF_NODES[i]*SEED_LENGTH_BYTES,
+               SEED_LENGTH_BYTES);
     }
 }
 
@@ -270,30 +210,25 @@ int seed_path(unsigned char *seed_storage,
               const unsigned char
               seed_tree[NUM_NODES_SEED_TREE*SEED_LENGTH_BYTES],
               // INPUT: linearized seedtree array with 2T-1 nodes each of size SEED_LENGTH_BYTES
-              const unsigned char indices_to_publish[T]
-              // INPUT: binary array denoting which node has to be released (cell == TO_PUBLISH) or not
+              const chall_2_t *chall_2
+              // INPUT: the seeds of the rounds where chall_2 is TO_PUBLISH are released
               ){
-    /* complete linearized binary tree containing boolean values determining
-     * if a node is to be released or not according to convention above.
-     * */
-    unsigned char flags_tree_to_publish[NUM_NODES_SEED_TREE] = {NOT_TO_PUBLISH};
-    compute_seeds_to_publish(flags_tree_to_publish, indices_to_publish);
+    /* flags of the nodes whose subtree has only leaves to be released: the
+     * ones to be released are the flagged nodes whose parent is not */
+    tree_flags_t flags;
+    tree_flags(&flags, chall_2, TO_PUBLISH, 1);
 
-    const uint16_t off[LOG2(T)+1] = TREE_OFFSETS;
     const uint16_t npl[LOG2(T)+1] = TREE_NODES_PER_LEVEL;
 
     /* no sense in trying to publish the root node, start examining from level 1 */
     int start_node = 1;
     int num_seeds_published = 0;
     for (int level = 1; level <= LOG2(T); level++){
-        for (int node_in_level = 0; node_in_level < npl[level]; node_in_level++ ) {
-            uint16_t current_node = start_node + node_in_level;
-            uint16_t father_node = PARENT(current_node) + (off[level-1] >> 1);
-
-            /* if seed is to published and its ancestor/parent node is not,
-             * add it to the seed storage */
-            if ( (flags_tree_to_publish[current_node] == TO_PUBLISH) &&
-                (flags_tree_to_publish[father_node] == NOT_TO_PUBLISH) ) {
+        for (int c = 0; 64*c < npl[level]; c++) {
+            uint64_t to_publish = tree_flags_subroots(&flags, level, c);
+            while (to_publish != 0) {
+                uint16_t current_node = start_node + 64*c + bits_lowest(to_publish);
+                to_publish &= to_publish-1;
                 memcpy(seed_storage + num_seeds_published*SEED_LENGTH_BYTES,
                         seed_tree + current_node*SEED_LENGTH_BYTES,
                         SEED_LENGTH_BYTES);
@@ -307,18 +242,33 @@ int seed_path(unsigned char *seed_storage,
 
 /*****************************************************************************/
 
-uint8_t rebuild_tree(unsigned char
+void rebuild_tree_init(seed_tree_rebuild_t *rebuild,
+                       const chall_2_t *chall_2)
+{
+    /* flags of the nodes whose subtree has only leaves to be rebuilt: the
+     * published seeds are the flagged nodes whose parent is not */
+    tree_flags(&rebuild->flags, chall_2, TO_PUBLISH, 1);
+
+    /* regenerating the seed tree never starts from the root, as it is never
+     * disclosed */
+    rebuild->level = 1;
+    rebuild->c = 0;
+    rebuild->start_node = 1;
+    rebuild->word_level = 1;
+    rebuild->word_node = 1;
+    rebuild->to_expand = 0;
+    rebuild->nodes_used = 0;
+}
+
+/*****************************************************************************/
+
+int rebuild_tree_step(seed_tree_rebuild_t *rebuild,
+                      unsigned char
                       seed_tree[NUM_NODES_SEED_TREE*SEED_LENGTH_BYTES],
-                      const unsigned char indices_to_publish[T],
                       const unsigned char *stored_seeds,
-                      const unsigned char salt[SALT_LENGTH_BYTES])
+                      const unsigned char salt[SALT_LENGTH_BYTES],
+                      int max_nodes)
 {
-    /* complete linearized binary tree containing boolean values determining
-     * if a node is to be released or not according to aboves convention
-     */
-    unsigned char flags_tree_to_publish[NUM_NODES_SEED_TREE] = {0};
-    compute_seeds_to_publish(flags_tree_to_publish, indices_to_publish);
-
     unsigned char csprng_input[CSPRNG_INPUT_LENGTH];
     CSPRNG_STATE_T tree_csprng_state;
 
@@ -328,56 +278,116 @@ uint8_t rebuild_tree(unsigned char
 
     memcpy(csprng_input + SEED_LENGTH_BYTES, salt, SALT_LENGTH_BYTES);
 
-    /* regenerating the seed tree never starts from the root, as it is never
-     * disclosed */
-    int nodes_used = 0;
-    int start_node = 1;
-    for (int level = 1; level <= LOG2(T); level++){
-        for (int node_in_level = 0; node_in_level < npl[level]; node_in_level++ ) {
-            uint16_t current_node = start_node + node_in_level;
-            uint16_t father_node = PARENT(current_node) + (off[level-1] >> 1);
-            uint16_t left_child = LEFT_CHILD(current_node) - off[level];
-
-            /* if the current node is a seed which was published (thus its father 
-             * was not), memcpy it in place */
-            if ( flags_tree_to_publish[current_node] == TO_PUBLISH ) {
-                if ( flags_tree_to_publish[father_node] == NOT_TO_PUBLISH ) {
-                    memcpy(seed_tree + current_node*SEED_LENGTH_BYTES,
-                            stored_seeds + nodes_used*SEED_LENGTH_BYTES,
-                            SEED_LENGTH_BYTES );
-                    nodes_used++;
-                }
-            }
-            /* If the current node is published and not a leaf, CSPRNG-expand its children.
-             * Since there is no reason of expanding leaves, only iterate to nodes per level (npl)
-             * minus leaves per level (lpl) in each level */
-            if ( ( flags_tree_to_publish[current_node] == TO_PUBLISH ) && (node_in_level < npl[level]-lpl[level] ) ) {
-                /* prepare the CSPRNG input to expand the children of node current_node */
-                memcpy(csprng_input,
-                        seed_tree + current_node*SEED_LENGTH_BYTES,
-                        SEED_LENGTH_BYTES);
+    for (;;) {
+        while (rebuild->to_expand != 0 && max_nodes > 0) {
+            uint16_t current_node = rebuild->word_node + bits_lowest(rebuild->to_expand);
+            uint16_t left_child = LEFT_CHILD(current_node) - off[rebuild->word_level];
+            rebuild->to_expand &= rebuild->to_expand-1;
+            max_nodes--;
+
+            /* prepare the CSPRNG input to expand the children of node current_node */
+            memcpy(csprng_input,
+                    seed_tree + current_node*SEED_LENGTH_BYTES,
+                    SEED_LENGTH_BYTES);
 
-                /* Domain separation using father node index */
-                uint16_t domain_sep = CSPRNG_DOMAIN_SEP_CONST + current_node;
+            /* Domain separation using father node index */
+            uint16_t domain_sep = CSPRNG_DOMAIN_SEP_CONST + current_node;
 
-                /* expand the children (stored contiguously), by construction always two children */
-                csprng_initialize(&tree_csprng_state, csprng_input, CSPRNG_INPUT_LENGTH, domain_sep);
-                csprng_randombytes(seed_tree + left_child*SEED_LENGTH_BYTES,
-                        2*SEED_LENGTH_BYTES,
-                        &tree_csprng_state);
-                /* PQClean-edit: CSPRNG release context */
-                csprng_release(&tree_csprng_state);
-            }
+            /* expand the children (stored contiguously), by construction always two children */
+            csprng_initialize(&tree_csprng_state, csprng_input, CSPRNG_INPUT_LENGTH, domain_sep);
+            csprng_randombytes(seed_tree + left_child*SEED_LENGTH_BYTES,
+                    2*SEED_LENGTH_BYTES,
+                    &tree_csprng_state);
+            /* PQClean-edit: CSPRNG release context */
+            csprng_release(&tree_csprng_state);
+        }
+        if (rebuild->to_expand != 0 || max_nodes == 0 ||
+            rebuild->level > LOG2(T)) {
+            break;
+        }
+
+        /* the published seeds of the next word (flagged nodes whose father
+         * is not) are memcpy'd in place */
+        int level = rebuild->level;
+        int c = rebuild->c;
+        uint64_t published = tree_flags_subroots(&rebuild->flags, level, c);
+        while (published != 0) {
+            uint16_t current_node = rebuild->start_node + 64*c + bits_lowest(published);
+            published &= published-1;
+            memcpy(seed_tree + current_node*SEED_LENGTH_BYTES,
+                    stored_seeds + rebuild->nodes_used*SEED_LENGTH_BYTES,
+                    SEED_LENGTH_BYTES );
+            rebuild->nodes_used++;
+        }
+
+        /* flagged nodes which are not leaves are CSPRNG-expanded; the
+         * leaves of a level are its rightmost lpl nodes */
+        rebuild->to_expand = rebuild->flags.level[level][c] &
+                             bits_mask(npl[level]-lpl[level]-64*c);
+        rebuild->word_level = level;
+        rebuild->word_node = rebuild->start_node + 64*c;
+
+        rebuild->c++;
+        if (64*rebuild->c >= npl[level]) {
+            rebuild->c = 0;
+            rebuild->start_node += npl[level];
+            rebuild->level++;
         }
-        start_node += npl[level];
     }
+    return rebuild->to_expand == 0 && rebuild->level > LOG2(T);
+}
 
+/*****************************************************************************/
+
+uint8_t rebuild_tree_finish(const seed_tree_rebuild_t *rebuild,
+                            const unsigned char *stored_seeds)
+{
     // Check for correct zero padding in the remaining parth of the seed path to 
     // prevent trivial forgery
     uint8_t error = 0;
-    for (int i=nodes_used*SEED_LENGTH_BYTES; i<TREE_NODES_TO_STORE*SEED_LENGTH_BYTES; i++) {
+    for (int i=rebuild->nodes_used*SEED_LENGTH_BYTES; i<TREE_NODES_TO_STORE*SEED_LENGTH_BYTES; i++) {
         error |= stored_seeds[i];
     }
     return (error == 0);
+}
+
+/*****************************************************************************/
+
+uint8_t rebuild_tree(unsigned char
+                     seed_tree[NUM_NODES_SEED_TREE*SEED_LENGTH_BYTES],
+                     const chall_2_t *chall_2,
+                     const unsigned char *stored_seeds,
+                     const unsigned char salt[SALT_LENGTH_BYTES])
+{
+    seed_tree_rebuild_t rebuild;
+    rebuild_tree_init(&rebuild, chall_2);
+    rebuild_tree_step(&rebuild, seed_tree, stored_seeds, salt, NUM_NODES_SEED_TREE);
+    return rebuild_tree_finish(&rebuild, stored_seeds);
 } /* end regenerate_leaves */
+
+/*****************************************************************************/
+
+/* counts the seeds rebuild_tree would take from the path, without expanding
+ * any of them, and checks the zero padding after them */
+uint8_t is_seed_path_padding_ok(const chall_2_t *chall_2,
+                                const unsigned char *stored_seeds)
+{
+    tree_flags_t flags;
+    tree_flags(&flags, chall_2, TO_PUBLISH, 1);
+
+    const uint16_t npl[LOG2(T)+1] = TREE_NODES_PER_LEVEL;
+
+    int nodes_used = 0;
+    for (int level = 1; level <= LOG2(T); level++){
+        for (int c = 0; 64*c < npl[level]; c++) {
+            nodes_used += bits_count(tree_flags_subroots(&flags, level, c));
+        }
+    }
+
+    uint8_t error = 0;
+    for (int i=nodes_used*SEED_LENGTH_BYTES; i<TREE_NODES_TO_STORE*SEED_LENGTH_BYTES; i++) {
+        error |= stored_seeds[i];
+    }
+    return (error == 0);
+} /* end is_seed_path_padding_ok */
 #endif
@@ -31,6 +31,7 @@
 
 #pragma once
 
+#include "challenge.h"
 #include "csprng_hash.h"
 #include "namespace.h"
 #include "parameters.h"
@@ -42,11 +43,14 @@ int seed_leaves(unsigned char rounds_seeds[T*SEED_LENGTH_BYTES],
 
 int seed_path(unsigned char *seed_storage,
               const unsigned char rounds_seeds[T*SEED_LENGTH_BYTES],
-              const unsigned char indices_to_publish[T]);
+              const chall_2_t *chall_2);
 
-uint8_t rebuild_leaves(unsigned char rounds_seeds[T*SEED_LENGTH_BYTES],                           
-                       const unsigned char indices_to_publish[T],
+uint8_t rebuild_leaves(unsigned char rounds_seeds[T*SEED_LENGTH_BYTES],
+                       const chall_2_t *chall_2,
                        const unsigned char *seed_storage);
+
+uint8_t is_seed_path_padding_ok(const chall_2_t *chall_2,
+                                const unsigned char *seed_storage);
 #else
 
 /******************************************************************************/
@@ -58,20 +62,66 @@ void gen_seed_tree(unsigned char seed_tree[NUM_NODES_SEED_TREE * SEED_LENGTH_BYT
                const unsigned char root_seed[SEED_LENGTH_BYTES],
                const unsigned char salt[SALT_LENGTH_BYTES]);
 
+/******************************************************************************/
+/* gen_seed_tree followed by seed_leaves; seed_tree may be NULL when only the
+ * leaves are needed */
+void gen_seed_tree_leaves(unsigned char *seed_tree,
+                          unsigned char rounds_seeds[T*SEED_LENGTH_BYTES],
+                          const unsigned char root_seed[SEED_LENGTH_BYTES],
+                          const unsigned char salt[SALT_LENGTH_BYTES]);
+
 /******************************************************************************/
 /* returns the number of seeds which have been published */
 int seed_path(unsigned char *seed_storage,
               const unsigned char
               seed_tree[NUM_NODES_SEED_TREE*SEED_LENGTH_BYTES],
-              // binary array denoting if node has to be released (cell == 0) or not
-              const unsigned char indices_to_publish[T]);
+              // the seeds of the rounds where chall_2 is 1 are released
+              const chall_2_t *chall_2);
 
 /******************************************************************************/
 /* returns 1 if padding was correct 0 if there was a mistake */
 uint8_t rebuild_tree(unsigned char
                      seed_tree[NUM_NODES_SEED_TREE*SEED_LENGTH_BYTES],
-                     const unsigned char indices_to_publish[T],
+                     const chall_2_t *chall_2,
                      const unsigned char *stored_seeds,
                      const unsigned char salt[SALT_LENGTH_BYTES]);   // input
 
+/******************************************************************************/
+/* rebuild_tree carried out a few nodes at a time: init, then step until it
+ * returns 1, each time expanding at most max_nodes nodes, then finish, which
+ * returns the same as rebuild_tree. The tree is the one of rebuild_tree */
+typedef struct {
+   /* flags of the nodes whose subtree has only leaves to be rebuilt */
+   tree_flags_t flags;
+   /* next word of flags to be taken, and first node of its level */
+   int level;
+   int c;
+   int start_node;
+   /* nodes of the word taken last still to be expanded */
+   int word_level;
+   int word_node;
+   uint64_t to_expand;
+   /* seeds taken from the path so far */
+   int nodes_used;
+} seed_tree_rebuild_t;
+
+void rebuild_tree_init(seed_tree_rebuild_t *rebuild,
+                       const chall_2_t *chall_2);
+
+int rebuild_tree_step(seed_tree_rebuild_t *rebuild,
+                      unsigned char
+                      seed_tree[NUM_NODES_SEED_TREE*SEED_LENGTH_BYTES],
+                      const unsigned char *stored_seeds,
+                      const unsigned char salt[SALT_LENGTH_BYTES],
+                      int max_nodes);
+
+uint8_t rebuild_tree_finish(const seed_tree_rebuild_t *rebuild,
+                            const unsigned char *stored_seeds);
+
+/******************************************************************************/
+/* returns 1 if the padding of the stored seeds is correct, 0 otherwise, the
+ * same as rebuild_tree but without regenerating the tree */
+uint8_t is_seed_path_padding_ok(const chall_2_t *chall_2,
+                                const unsigned char *stored_seeds);
+
 #endif
@@ -14,6 +14,7 @@
 #if defined(IMPLEMENTATION_avx2)
 #define HIGH_COMPATIBILITY_X86_64
 #define HIGH_PERFORMANCE_X86_64
+#define SHA_3_KECCAK_X86_64
 #endif
 
 /* PQClean-edit: avoid VLA */
@@ -50,3 +51,39 @@
 #ifndef SIG_SIZE
 #undef SIG_SIZE
 #endif
+/* Extensions and their tunables, off unless requested on the command line,
+ * so that the generated implementations carry none of them (see also
+ * utility.py) */
+#ifndef HASH_STATS
+#undef HASH_STATS
+#endif
+#ifndef PK_CACHE
+#undef PK_CACHE
+#endif
+#ifndef PK_CACHE_BUDGET_BYTES
+#undef PK_CACHE_BUDGET_BYTES
+#endif
+#ifndef PK_CACHE_SHARDS
+#undef PK_CACHE_SHARDS
+#endif
+#ifndef PK_EXPANDED_FILE
+#undef PK_EXPANDED_FILE
+#endif
+#ifndef PRESIG_POOL
+#undef PRESIG_POOL
+#endif
+#ifndef RNG_POOL
+#undef RNG_POOL
+#endif
+#ifndef RNG_POOL_BYTES
+#undef RNG_POOL_BYTES
+#endif
+#ifndef RNG_POOL_RESEED_INTERVAL
+#undef RNG_POOL_RESEED_INTERVAL
+#endif
+#ifndef USDT_PROBES
+#undef USDT_PROBES
+#endif
+#ifndef VERIFY_EARLY_REJECT
+#undef VERIFY_EARLY_REJECT
+#endif
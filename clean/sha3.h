@@ -31,6 +31,16 @@
 
 #pragma once
 
+#if defined(HASH_STATS)
+/* the wrappers below are wrapped once more by the ones counting the
+ * permutations, see hash_stats.h */
+#define xof_shake_init xof_shake_uncounted_init
+#define xof_shake_update xof_shake_uncounted_update
+#define xof_shake_final xof_shake_uncounted_final
+#define xof_shake_extract xof_shake_uncounted_extract
+#define xof_shake_release xof_shake_uncounted_release
+#endif
+
 #if defined(SHA_3_LIBKECCAK)
 #include <libkeccak.a.headers/KeccakHash.h>
 
@@ -144,3 +154,66 @@ void xof_shake_release(SHAKE_STATE_STRUCT *state){
 #endif
 }
 #endif
+
+#if defined(HASH_STATS)
+
+// %%%%%%%%%%%%%%%%%% SHAKE x1 Wrappers counting permutations %%%%%%%%%%%%%%%%%%%%%
+
+#include "hash_stats.h"
+
+#undef xof_shake_init
+#undef xof_shake_update
+#undef xof_shake_final
+#undef xof_shake_extract
+#undef xof_shake_release
+
+#if defined(CATEGORY_1)
+#define HASH_STATS_SHAKE_RATE 168
+#else
+#define HASH_STATS_SHAKE_RATE 136
+#endif
+
+typedef struct {
+   SHAKE_STATE_STRUCT state;
+   hash_stats_sponge_t sponge;
+} shake_counted_ctx;
+#undef SHAKE_STATE_STRUCT
+#define SHAKE_STATE_STRUCT shake_counted_ctx
+
+static inline
+void xof_shake_init(SHAKE_STATE_STRUCT *state, int val)
+{
+   xof_shake_uncounted_init(&state->state, val);
+   state->sponge.pos = 0;
+}
+
+static inline
+void xof_shake_update(SHAKE_STATE_STRUCT *state,
+                      const unsigned char *input,
+                      unsigned int inputByteLen)
+{
+   xof_shake_uncounted_update(&state->state, input, inputByteLen);
+   hash_stats_absorb(&state->sponge, HASH_STATS_SHAKE_RATE, inputByteLen, 0);
+}
+
+static inline
+void xof_shake_final(SHAKE_STATE_STRUCT *state)
+{
+   xof_shake_uncounted_final(&state->state);
+   hash_stats_finalize(&state->sponge);
+}
+
+static inline
+void xof_shake_extract(SHAKE_STATE_STRUCT *state,
+                       unsigned char *output,
+                       unsigned int outputByteLen){
+   xof_shake_uncounted_extract(&state->state, output, outputByteLen);
+   hash_stats_squeeze(&state->sponge, HASH_STATS_SHAKE_RATE, outputByteLen, 0);
+}
+
+/* PQClean-edit: SHAKE release context */
+static inline
+void xof_shake_release(SHAKE_STATE_STRUCT *state){
+   xof_shake_uncounted_release(&state->state);
+}
+#endif
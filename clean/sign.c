@@ -34,8 +34,12 @@
 
 #include "CROSS.h"
 #include "api.h"
+#include "hash_stats.h"
 #include "namespace.h"
 #include "parameters.h"
+#include "pk_cache.h"
+#include "presig_pool.h"
+#include "rng_pool.h"
 
 /*----------------------------------------------------------------------------*/
 
@@ -49,6 +53,22 @@ int crypto_sign_keypair(unsigned char *pk,
    return 0; // NIST convention: 0 == zero errors
 } // end crypto_sign_keypair
 
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*... generating n keypairs pk[0],...,pk[n*CRYPTO_PUBLICKEYBYTES-1]          */
+/*... and sk[0],...,sk[n*CRYPTO_SECRETKEYBYTES-1]                            */
+int crypto_sign_keypair_batch(unsigned char *pk,
+                              unsigned char *sk,
+                              size_t n)
+{
+   /* keygen cannot fail */
+   CROSS_keygen_batch((sk_t *) sk,
+                      (pk_t *) pk,
+                      n);
+
+   return 0; // NIST convention: 0 == zero errors
+} // end crypto_sign_keypair_batch
+
 /*----------------------------------------------------------------------------*/
 /*                                                                            */
 /*... generating a signed message sm[0],sm[1],...,sm[*smlen-1]                */
@@ -144,3 +164,124 @@ int crypto_sign_verify(const unsigned char *sig,                // in parameter
 } // end crypto_sign_verify
 
 /*----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*.  ... wiping the randomness pool of the calling thread                     */
+void crypto_sign_rng_pool_release(void)
+{
+#if defined(RNG_POOL)
+   rng_pool_release();
+#endif
+} // end crypto_sign_rng_pool_release
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*.  ... bounding the memory of the cache of expanded public keys             */
+void crypto_sign_pk_cache_set_budget(size_t budget_bytes)
+{
+   pk_cache_set_budget(budget_bytes);
+} // end crypto_sign_pk_cache_set_budget
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*.  ... reading the counters of the cache of expanded public keys            */
+void crypto_sign_pk_cache_stats(uint64_t *hits,
+                                uint64_t *misses,
+                                uint64_t *evictions)
+{
+   pk_cache_stats(hits, misses, evictions);
+} // end crypto_sign_pk_cache_stats
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*.  ... freeing the cache of expanded public keys                            */
+void crypto_sign_pk_cache_release(void)
+{
+   pk_cache_release();
+} // end crypto_sign_pk_cache_release
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*.  ... starting the pool of presignatures under secret key sk[0],sk[1],...  */
+int crypto_sign_presig_pool_start(const unsigned char *sk,      // in parameter
+                                  size_t capacity               // in parameter
+               )
+{
+   return presig_pool_start((const sk_t *) sk, capacity);
+} // end crypto_sign_presig_pool_start
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*... generating a signature sig[0],sig[1],...,sig[*siglen-1]                 */
+/*... from original message m[0],m[1],...,m[mlen-1]                           */
+/*... out of the pool of presignatures                                        */
+int crypto_sign_signature_pooled(unsigned char *sig,            // out parameter
+                                 size_t *siglen,                // out parameter
+                                 const unsigned char *m,        // in parameter
+                                 size_t mlen                    // in parameter
+               )
+{
+   if(presig_pool_sign((const char *const) m, (const size_t) mlen,
+                       (CROSS_sig_t *) sig) != 0){
+      return -1;
+   }
+   *siglen = (size_t) sizeof(CROSS_sig_t);
+
+   return 0;  // NIST convention: 0 == zero errors
+} // end crypto_sign_signature_pooled
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*.  ... stopping and wiping the pool of presignatures                        */
+void crypto_sign_presig_pool_stop(void)
+{
+   presig_pool_stop();
+} // end crypto_sign_presig_pool_stop
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*.  ... naming the call sites of the parallel SHAKE                          */
+const char *crypto_sign_hash_stats_site(size_t site)
+{
+   return hash_stats_site_name(site);
+} // end crypto_sign_hash_stats_site
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*.  ... reading the lanes filled by a call site of the parallel SHAKE        */
+void crypto_sign_hash_stats_lanes(size_t site,
+                                  uint64_t calls[4])
+{
+   hash_stats_lanes(site, calls);
+} // end crypto_sign_hash_stats_lanes
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*.  ... reading the Keccak permutations taken by the signatures              */
+void crypto_sign_hash_stats_sign(uint64_t *signs,
+                                 uint64_t *permutations,
+                                 uint64_t *permutations_x4)
+{
+   hash_stats_permutations(HASH_STATS_SIGN, signs, permutations, permutations_x4);
+} // end crypto_sign_hash_stats_sign
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*.  ... reading the Keccak permutations taken by the verifications           */
+void crypto_sign_hash_stats_verify(uint64_t *verifies,
+                                   uint64_t *permutations,
+                                   uint64_t *permutations_x4)
+{
+   hash_stats_permutations(HASH_STATS_VERIFY, verifies, permutations, permutations_x4);
+} // end crypto_sign_hash_stats_verify
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*.  ... zeroing the counters of the parallel SHAKE                           */
+void crypto_sign_hash_stats_reset(void)
+{
+   hash_stats_reset();
+} // end crypto_sign_hash_stats_reset
+
+/*----------------------------------------------------------------------------*/
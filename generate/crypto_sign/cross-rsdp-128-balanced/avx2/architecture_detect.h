@@ -5,14 +5,14 @@
  * @version 2.0 (February 2025)
  *
  * Authors listed in alphabetical order:
- *
+ * 
  * @author: Alessandro Barenghi <alessandro.barenghi@polimi.it>
  * @author: Marco Gianvecchio <marco.gianvecchio@mail.polimi.it>
  * @author: Patrick Karl <patrick.karl@tum.de>
  * @author: Gerardo Pelosi <gerardo.pelosi@polimi.it>
  * @author: Jonas Schupp <jonas.schupp@tum.de>
- *
- *
+ * 
+ * 
  * This code is hereby placed in the public domain.
  *
  * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ''AS IS'' AND ANY EXPRESS
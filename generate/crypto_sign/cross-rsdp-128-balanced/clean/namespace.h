@@ -4,25 +4,86 @@
 #define CROSS_NAMESPACE(s) PQCLEAN_CROSSRSDP128BALANCED_CLEAN_ ## s
 
 #define crypto_sign                             CROSS_NAMESPACE(crypto_sign)
+#define crypto_sign_hash_stats_lanes            CROSS_NAMESPACE(crypto_sign_hash_stats_lanes)
+#define crypto_sign_hash_stats_reset            CROSS_NAMESPACE(crypto_sign_hash_stats_reset)
+#define crypto_sign_hash_stats_sign             CROSS_NAMESPACE(crypto_sign_hash_stats_sign)
+#define crypto_sign_hash_stats_site             CROSS_NAMESPACE(crypto_sign_hash_stats_site)
+#define crypto_sign_hash_stats_verify           CROSS_NAMESPACE(crypto_sign_hash_stats_verify)
 #define crypto_sign_keypair                     CROSS_NAMESPACE(crypto_sign_keypair)
+#define crypto_sign_keypair_batch               CROSS_NAMESPACE(crypto_sign_keypair_batch)
 #define crypto_sign_open                        CROSS_NAMESPACE(crypto_sign_open)
+#define crypto_sign_pk_cache_release            CROSS_NAMESPACE(crypto_sign_pk_cache_release)
+#define crypto_sign_pk_cache_set_budget         CROSS_NAMESPACE(crypto_sign_pk_cache_set_budget)
+#define crypto_sign_pk_cache_stats              CROSS_NAMESPACE(crypto_sign_pk_cache_stats)
+#define crypto_sign_presig_pool_start           CROSS_NAMESPACE(crypto_sign_presig_pool_start)
+#define crypto_sign_presig_pool_stop            CROSS_NAMESPACE(crypto_sign_presig_pool_stop)
+#define crypto_sign_rng_pool_release            CROSS_NAMESPACE(crypto_sign_rng_pool_release)
 #define crypto_sign_signature                   CROSS_NAMESPACE(crypto_sign_signature)
+#define crypto_sign_signature_pooled            CROSS_NAMESPACE(crypto_sign_signature_pooled)
 #define crypto_sign_verify                      CROSS_NAMESPACE(crypto_sign_verify)
 
 #define CROSS_keygen                            CROSS_NAMESPACE(CROSS_keygen)
+#define CROSS_keygen_batch                      CROSS_NAMESPACE(CROSS_keygen_batch)
+#define CROSS_pk_expand                         CROSS_NAMESPACE(CROSS_pk_expand)
+#define CROSS_pk_expanded_find                  CROSS_NAMESPACE(CROSS_pk_expanded_find)
+#define CROSS_pk_expanded_map                   CROSS_NAMESPACE(CROSS_pk_expanded_map)
+#define CROSS_pk_expanded_store                 CROSS_NAMESPACE(CROSS_pk_expanded_store)
+#define CROSS_pk_expanded_unmap                 CROSS_NAMESPACE(CROSS_pk_expanded_unmap)
+#define CROSS_presign                           CROSS_NAMESPACE(CROSS_presign)
 #define CROSS_sign                              CROSS_NAMESPACE(CROSS_sign)
+#define CROSS_sign_online                       CROSS_NAMESPACE(CROSS_sign_online)
 #define CROSS_verify                            CROSS_NAMESPACE(CROSS_verify)
+#define CROSS_verify_abort                      CROSS_NAMESPACE(CROSS_verify_abort)
+#define CROSS_verify_expanded                   CROSS_NAMESPACE(CROSS_verify_expanded)
+#define CROSS_verify_finish                     CROSS_NAMESPACE(CROSS_verify_finish)
+#define CROSS_verify_start                      CROSS_NAMESPACE(CROSS_verify_start)
+#define CROSS_verify_start_expanded             CROSS_NAMESPACE(CROSS_verify_start_expanded)
+#define CROSS_verify_step                       CROSS_NAMESPACE(CROSS_verify_step)
+#define expand_digest_to_chall_2                CROSS_NAMESPACE(expand_digest_to_chall_2)
 #define expand_digest_to_fixed_weight           CROSS_NAMESPACE(expand_digest_to_fixed_weight)
 #define gen_seed_tree                           CROSS_NAMESPACE(gen_seed_tree)
+#define gen_seed_tree_leaves                    CROSS_NAMESPACE(gen_seed_tree_leaves)
+#define hash_stats_enter                        CROSS_NAMESPACE(hash_stats_enter)
+#define hash_stats_keccak                       CROSS_NAMESPACE(hash_stats_keccak)
+#define hash_stats_lanes                        CROSS_NAMESPACE(hash_stats_lanes)
+#define hash_stats_leave                        CROSS_NAMESPACE(hash_stats_leave)
+#define hash_stats_par                          CROSS_NAMESPACE(hash_stats_par)
+#define hash_stats_permutations                 CROSS_NAMESPACE(hash_stats_permutations)
+#define hash_stats_reset                        CROSS_NAMESPACE(hash_stats_reset)
+#define hash_stats_site_name                    CROSS_NAMESPACE(hash_stats_site_name)
+#define is_seed_path_padding_ok                 CROSS_NAMESPACE(is_seed_path_padding_ok)
+#define is_tree_proof_padding_ok                CROSS_NAMESPACE(is_tree_proof_padding_ok)
+#define keccakf1600_x1_permute                  CROSS_NAMESPACE(keccakf1600_x1_permute)
 #define pack_fp_syn                             CROSS_NAMESPACE(pack_fp_syn)
 #define pack_fp_vec                             CROSS_NAMESPACE(pack_fp_vec)
 #define pack_fz_rsdp_g_vec                      CROSS_NAMESPACE(pack_fz_rsdp_g_vec)
 #define pack_fz_vec                             CROSS_NAMESPACE(pack_fz_vec)
+#define pk_cache_insert                         CROSS_NAMESPACE(pk_cache_insert)
+#define pk_cache_lookup                         CROSS_NAMESPACE(pk_cache_lookup)
+#define pk_cache_release                        CROSS_NAMESPACE(pk_cache_release)
+#define pk_cache_set_budget                     CROSS_NAMESPACE(pk_cache_set_budget)
+#define pk_cache_stats                          CROSS_NAMESPACE(pk_cache_stats)
+#define presig_pool_sign                        CROSS_NAMESPACE(presig_pool_sign)
+#define presig_pool_start                       CROSS_NAMESPACE(presig_pool_start)
+#define presig_pool_stop                        CROSS_NAMESPACE(presig_pool_stop)
 #define rebuild_leaves                          CROSS_NAMESPACE(rebuild_leaves)
 #define rebuild_tree                            CROSS_NAMESPACE(rebuild_tree)
+#define rebuild_tree_finish                     CROSS_NAMESPACE(rebuild_tree_finish)
+#define rebuild_tree_init                       CROSS_NAMESPACE(rebuild_tree_init)
+#define rebuild_tree_step                       CROSS_NAMESPACE(rebuild_tree_step)
 #define recompute_root                          CROSS_NAMESPACE(recompute_root)
+#define recompute_root_finish                   CROSS_NAMESPACE(recompute_root_finish)
+#define recompute_root_init                     CROSS_NAMESPACE(recompute_root_init)
+#define recompute_root_step                     CROSS_NAMESPACE(recompute_root_step)
+#define rng_pool_randombytes                    CROSS_NAMESPACE(rng_pool_randombytes)
+#define rng_pool_release                        CROSS_NAMESPACE(rng_pool_release)
 #define seed_leaves                             CROSS_NAMESPACE(seed_leaves)
 #define seed_path                               CROSS_NAMESPACE(seed_path)
+#define tree_builder_add                        CROSS_NAMESPACE(tree_builder_add)
+#define tree_builder_init                       CROSS_NAMESPACE(tree_builder_init)
+#define tree_builder_root                       CROSS_NAMESPACE(tree_builder_root)
+#define tree_flags                              CROSS_NAMESPACE(tree_flags)
+#define tree_leaf                               CROSS_NAMESPACE(tree_leaf)
 #define tree_proof                              CROSS_NAMESPACE(tree_proof)
 #define tree_root                               CROSS_NAMESPACE(tree_root)
 #define unpack_fp_syn                           CROSS_NAMESPACE(unpack_fp_syn)
@@ -0,0 +1,71 @@
+/**
+ *
+ * Reference ISO-C11 Implementation of CROSS.
+ *
+ * @version 2.0 (February 2025)
+ *
+ * Authors listed in alphabetical order:
+ * 
+ * @author: Alessandro Barenghi <alessandro.barenghi@polimi.it>
+ * @author: Marco Gianvecchio <marco.gianvecchio@mail.polimi.it>
+ * @author: Patrick Karl <patrick.karl@tum.de>
+ * @author: Gerardo Pelosi <gerardo.pelosi@polimi.it>
+ * @author: Jonas Schupp <jonas.schupp@tum.de>
+ * 
+ * 
+ * This code is hereby placed in the public domain.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ''AS IS'' AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **/
+
+/* mmap() is POSIX, not ISO C */
+/* fopen() is deprecated by the Microsoft C runtime */
+
+#include <stddef.h>
+
+#include "CROSS.h"
+#include "pk_expanded.h"
+
+/* Files of expanded public keys take dynamic memory and file I/O, which the
+ * scheme does not otherwise employ: they are compiled in only when
+ * PK_EXPANDED_FILE is defined, e.g., building with
+ * EXTRAFLAGS="-DPK_EXPANDED_FILE". Without it, storing fails and mapping
+ * returns NULL. */
+
+
+int CROSS_pk_expanded_store(const char *path,
+                            const pk_t *PK,
+                            size_t n){
+   (void) path;
+   (void) PK;
+   (void) n;
+   return 0;
+}
+
+pk_expanded_map_t *CROSS_pk_expanded_map(const char *path){
+   (void) path;
+   return NULL;
+}
+
+const pk_expanded_t *CROSS_pk_expanded_find(const pk_expanded_map_t *map,
+                                            const pk_t *PK){
+   (void) map;
+   (void) PK;
+   return NULL;
+}
+
+void CROSS_pk_expanded_unmap(pk_expanded_map_t *map){
+   (void) map;
+}
+
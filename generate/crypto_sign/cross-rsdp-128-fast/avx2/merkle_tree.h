@@ -5,14 +5,14 @@
  * @version 2.0 (February 2025)
  *
  * Authors listed in alphabetical order:
- *
+ * 
  * @author: Alessandro Barenghi <alessandro.barenghi@polimi.it>
  * @author: Marco Gianvecchio <marco.gianvecchio@mail.polimi.it>
  * @author: Patrick Karl <patrick.karl@tum.de>
  * @author: Gerardo Pelosi <gerardo.pelosi@polimi.it>
  * @author: Jonas Schupp <jonas.schupp@tum.de>
- *
- *
+ * 
+ * 
  * This code is hereby placed in the public domain.
  *
  * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ''AS IS'' AND ANY EXPRESS
@@ -31,16 +31,22 @@
 
 #pragma once
 
+#include "challenge.h"
 #include "namespace.h"
 
+
 void tree_root(uint8_t root[HASH_DIGEST_LENGTH],
                uint8_t leaves[T][HASH_DIGEST_LENGTH]);
 
-uint16_t tree_proof(uint8_t mtp[W * HASH_DIGEST_LENGTH],
+uint16_t tree_proof(uint8_t mtp[W*HASH_DIGEST_LENGTH],
                     uint8_t leaves[T][HASH_DIGEST_LENGTH],
-                    const uint8_t leaves_to_reveal[T]);
+                    const chall_2_t *chall_2);
 
 uint8_t recompute_root(uint8_t root[HASH_DIGEST_LENGTH],
                        uint8_t recomputed_leaves[T][HASH_DIGEST_LENGTH],
-                       const uint8_t mtp[W * HASH_DIGEST_LENGTH],
-                       const uint8_t leaves_to_reveal[T]);
+                       const uint8_t mtp[W*HASH_DIGEST_LENGTH],
+                       const chall_2_t *chall_2);
+
+uint8_t is_tree_proof_padding_ok(const uint8_t mtp[W*HASH_DIGEST_LENGTH],
+                                 const chall_2_t *chall_2);
+
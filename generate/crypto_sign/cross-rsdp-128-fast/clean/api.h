@@ -5,14 +5,14 @@
  * @version 2.0 (February 2025)
  *
  * Authors listed in alphabetical order:
- *
+ * 
  * @author: Alessandro Barenghi <alessandro.barenghi@polimi.it>
  * @author: Marco Gianvecchio <marco.gianvecchio@mail.polimi.it>
  * @author: Patrick Karl <patrick.karl@tum.de>
  * @author: Gerardo Pelosi <gerardo.pelosi@polimi.it>
  * @author: Jonas Schupp <jonas.schupp@tum.de>
- *
- *
+ * 
+ * 
  * This code is hereby placed in the public domain.
  *
  * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ''AS IS'' AND ANY EXPRESS
@@ -51,36 +51,107 @@
 /* required bytes of input randomness */
 #define PQCLEAN_CROSSRSDP128FAST_CLEAN_CRYPTO_RANDOMBYTES 16
 
+
 int PQCLEAN_CROSSRSDP128FAST_CLEAN_crypto_sign_keypair(unsigned char *pk,
-        unsigned char *sk
-                                                      );
+                        unsigned char *sk
+                       );
+
+/* n keypairs, stored contiguously in pk (n*CRYPTO_PUBLICKEYBYTES bytes) and
+ * sk (n*CRYPTO_SECRETKEYBYTES bytes) */
+int PQCLEAN_CROSSRSDP128FAST_CLEAN_crypto_sign_keypair_batch(unsigned char *pk,
+                        unsigned char *sk,
+                        size_t n
+                       );
 
 int PQCLEAN_CROSSRSDP128FAST_CLEAN_crypto_sign(unsigned char *sm,
-        size_t *smlen,
-        const unsigned char *m,
-        size_t mlen,
-        const unsigned char *sk
-                                              );
+                size_t *smlen,
+                const unsigned char *m,
+                size_t mlen,
+                const unsigned char *sk
+               );
 
 int PQCLEAN_CROSSRSDP128FAST_CLEAN_crypto_sign_open(unsigned char *m,
-        size_t *mlen,
-        const unsigned char *sm,
-        size_t smlen,
-        const unsigned char *pk
-                                                   );
+                     size_t *mlen,
+                     const unsigned char *sm,
+                     size_t smlen,
+                     const unsigned char *pk
+                    );
 
 int PQCLEAN_CROSSRSDP128FAST_CLEAN_crypto_sign_signature(unsigned char *sig,
-        size_t *siglen,
-        const unsigned char *m,
-        size_t mlen,
-        const unsigned char *sk
-                                                        );
+                size_t *siglen,
+                const unsigned char *m,
+                size_t mlen,
+                const unsigned char *sk
+               );
 
 int PQCLEAN_CROSSRSDP128FAST_CLEAN_crypto_sign_verify(const unsigned char *sig,
-        size_t siglen,
-        const unsigned char *m,
-        size_t mlen,
-        const unsigned char *pk
-                                                     );
+                size_t siglen,
+                const unsigned char *m,
+                size_t mlen,
+                const unsigned char *pk
+               );
+
+/* wipes the randomness pool of the calling thread, to be called before the
+ * thread exits; no-op unless built with RNG_POOL */
+void PQCLEAN_CROSSRSDP128FAST_CLEAN_crypto_sign_rng_pool_release(void);
+
+/* bounds the memory taken by the cache of expanded public keys employed by
+ * verify; no-op unless built with PK_CACHE */
+void PQCLEAN_CROSSRSDP128FAST_CLEAN_crypto_sign_pk_cache_set_budget(size_t budget_bytes);
+
+/* hits, misses and evictions of the cache of expanded public keys, all zero
+ * unless built with PK_CACHE; any pointer may be NULL */
+void PQCLEAN_CROSSRSDP128FAST_CLEAN_crypto_sign_pk_cache_stats(uint64_t *hits,
+                                uint64_t *misses,
+                                uint64_t *evictions);
+
+/* frees the cache of expanded public keys, no other thread may be using the
+ * library meanwhile; no-op unless built with PK_CACHE */
+void PQCLEAN_CROSSRSDP128FAST_CLEAN_crypto_sign_pk_cache_release(void);
+
+/* starts a background thread keeping up to capacity message-independent
+ * presignatures of sk, returns 0 on success, -1 otherwise (also when not
+ * built with PRESIG_POOL) */
+int PQCLEAN_CROSSRSDP128FAST_CLEAN_crypto_sign_presig_pool_start(const unsigned char *sk,
+                                  size_t capacity
+                                 );
+
+/* as crypto_sign_signature, with the secret key of the presignature pool;
+ * returns -1 if the pool is not started, also in a child process forked
+ * after it was started, which does not inherit the pool, or if no signature
+ * was produced */
+int PQCLEAN_CROSSRSDP128FAST_CLEAN_crypto_sign_signature_pooled(unsigned char *sig,
+                                 size_t *siglen,
+                                 const unsigned char *m,
+                                 size_t mlen
+                                );
+
+/* stops the presignature pool and wipes it, no other thread may be signing
+ * with it meanwhile */
+void PQCLEAN_CROSSRSDP128FAST_CLEAN_crypto_sign_presig_pool_stop(void);
+
+/* name of the parallel SHAKE call site numbered site, NULL past the last one */
+const char *PQCLEAN_CROSSRSDP128FAST_CLEAN_crypto_sign_hash_stats_site(size_t site);
+
+/* calls of the call site numbered site filling 1, 2, 3 and 4 of the SHAKE
+ * lanes, in calls[0] to calls[3]; all zero unless built with HASH_STATS */
+void PQCLEAN_CROSSRSDP128FAST_CLEAN_crypto_sign_hash_stats_lanes(size_t site,
+                                  uint64_t calls[4]);
+
+/* signatures computed and the single lane and 4-way Keccak permutations they
+ * took, all zero unless built with HASH_STATS; any pointer may be NULL. The
+ * permutations of the presignatures computed ahead by the presignature pool
+ * are counted as they are computed, the signatures as they are completed */
+void PQCLEAN_CROSSRSDP128FAST_CLEAN_crypto_sign_hash_stats_sign(uint64_t *signs,
+                                 uint64_t *permutations,
+                                 uint64_t *permutations_x4);
+
+/* as crypto_sign_hash_stats_sign, for the verifications */
+void PQCLEAN_CROSSRSDP128FAST_CLEAN_crypto_sign_hash_stats_verify(uint64_t *verifies,
+                                   uint64_t *permutations,
+                                   uint64_t *permutations_x4);
+
+/* zeroes the counters of HASH_STATS */
+void PQCLEAN_CROSSRSDP128FAST_CLEAN_crypto_sign_hash_stats_reset(void);
 
-#endif
+#endif
\ No newline at end of file
@@ -0,0 +1,66 @@
+/**
+ *
+ * Reference ISO-C11 Implementation of CROSS.
+ *
+ * @version 2.0 (February 2025)
+ *
+ * Authors listed in alphabetical order:
+ * 
+ * @author: Alessandro Barenghi <alessandro.barenghi@polimi.it>
+ * @author: Marco Gianvecchio <marco.gianvecchio@mail.polimi.it>
+ * @author: Patrick Karl <patrick.karl@tum.de>
+ * @author: Gerardo Pelosi <gerardo.pelosi@polimi.it>
+ * @author: Jonas Schupp <jonas.schupp@tum.de>
+ * 
+ * 
+ * This code is hereby placed in the public domain.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ''AS IS'' AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **/
+
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "CROSS.h"
+#include "namespace.h"
+
+/* Pool of presignatures of a single secret key.
+ * When PRESIG_POOL is defined, presig_pool_start spawns a thread which keeps
+ * up to capacity presignatures computed by CROSS_presign, so that
+ * presig_pool_sign only performs CROSS_sign_online. Each presignature is
+ * employed once and wiped as soon as it is consumed; when the pool is
+ * empty, presig_pool_sign signs from scratch. A child process forked while
+ * the pool runs gets it stopped and wiped: presig_pool_sign returns -1 there
+ * until presig_pool_start is called again. Requires pthreads, e.g.,
+ * building with EXTRAFLAGS="-DPRESIG_POOL -pthread". Without PRESIG_POOL,
+ * the pool cannot be started. */
+
+/* copies SK and starts refilling a pool of capacity presignatures; returns
+ * 0 on success, -1 if the pool is already running or memory is short */
+int presig_pool_start(const sk_t *SK,
+                      size_t capacity);
+
+/* signs m with the secret key of the pool; returns 0 on success, -1 if the
+ * pool is not running or the presignature drawn from it cannot be employed.
+ * May be called by any number of threads at once. */
+int presig_pool_sign(const char *m,
+                     uint64_t mlen,
+                     CROSS_sig_t *sig);
+
+/* stops the refill thread and wipes the presignatures and the secret key;
+ * no other thread may be signing with the pool meanwhile */
+void presig_pool_stop(void);
@@ -0,0 +1,129 @@
+/**
+ *
+ * Reference ISO-C11 Implementation of CROSS.
+ *
+ * @version 2.0 (February 2025)
+ *
+ * Authors listed in alphabetical order:
+ * 
+ * @author: Alessandro Barenghi <alessandro.barenghi@polimi.it>
+ * @author: Marco Gianvecchio <marco.gianvecchio@mail.polimi.it>
+ * @author: Patrick Karl <patrick.karl@tum.de>
+ * @author: Gerardo Pelosi <gerardo.pelosi@polimi.it>
+ * @author: Jonas Schupp <jonas.schupp@tum.de>
+ * 
+ * 
+ * This code is hereby placed in the public domain.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ''AS IS'' AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **/
+
+
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+
+#include "namespace.h"
+
+/* Single lane Keccak-f[1600] and incremental SHAKE for x86-64, backing the
+ * SHAKE calls of the avx2 implementation outside hash_par, as set.h defines
+ * SHA_3_KECCAK_X86_64 for it (see sha3.h). The permutation keeps the
+ * state in 64-bit variables, unrolled two rounds at a time: built for BMI1
+ * and BMI2 targets, as with -march=native, the chi step compiles to andn and
+ * the rotations to rorx. Absorbing and squeezing act on whole lanes, relying
+ * on the little endian byte order of x86-64 */
+
+#define KECCAK_X1_SHAKE128_RATE 168
+#define KECCAK_X1_SHAKE256_RATE 136
+
+typedef struct {
+   uint64_t state[25];
+   /* bytes absorbed into, resp. squeezed out of, the current block */
+   unsigned int pos;
+} keccak_x1_ctx;
+
+void keccakf1600_x1_permute(uint64_t state[25]);
+
+static inline
+void keccak_x1_init(keccak_x1_ctx *ctx){
+   memset(ctx->state, 0, sizeof(ctx->state));
+   ctx->pos = 0;
+}
+
+static inline
+void keccak_x1_absorb(keccak_x1_ctx *ctx,
+                      const unsigned int rate,
+                      const uint8_t *in,
+                      uint64_t inlen){
+   uint8_t *state_bytes = (uint8_t *) ctx->state;
+   /* complete the current block */
+   while(ctx->pos > 0 && inlen > 0){
+      state_bytes[ctx->pos] ^= *in;
+      ctx->pos++;
+      in++;
+      inlen--;
+      if(ctx->pos == rate){
+         keccakf1600_x1_permute(ctx->state);
+         ctx->pos = 0;
+      }
+   }
+   /* whole blocks, a lane at a time */
+   while(inlen >= rate){
+      for(unsigned int i = 0; i < rate/8; i++){
+         uint64_t lane;
+         memcpy(&lane, in+8*i, 8);
+         ctx->state[i] ^= lane;
+      }
+      keccakf1600_x1_permute(ctx->state);
+      in += rate;
+      inlen -= rate;
+   }
+   /* either the block was left incomplete above, or pos is zero here */
+   for(unsigned int i = 0; i < inlen; i++){
+      state_bytes[ctx->pos + i] ^= in[i];
+   }
+   ctx->pos += (unsigned int) inlen;
+}
+
+/* SHAKE padding, the context is then ready to be squeezed */
+static inline
+void keccak_x1_finalize(keccak_x1_ctx *ctx, const unsigned int rate){
+   uint8_t *state_bytes = (uint8_t *) ctx->state;
+   state_bytes[ctx->pos] ^= 0x1F;
+   state_bytes[rate-1] ^= 0x80;
+   ctx->pos = rate;
+}
+
+static inline
+void keccak_x1_squeeze(uint8_t *out,
+                       uint64_t outlen,
+                       keccak_x1_ctx *ctx,
+                       const unsigned int rate){
+   const uint8_t *state_bytes = (const uint8_t *) ctx->state;
+   while(outlen > 0){
+      if(ctx->pos == rate){
+         keccakf1600_x1_permute(ctx->state);
+         ctx->pos = 0;
+      }
+      unsigned int amount = rate - ctx->pos;
+      if(amount > outlen){
+         amount = (unsigned int) outlen;
+      }
+      memcpy(out, state_bytes+ctx->pos, amount);
+      ctx->pos += amount;
+      out += amount;
+      outlen -= amount;
+   }
+}
@@ -0,0 +1,69 @@
+/**
+ *
+ * Reference ISO-C11 Implementation of CROSS.
+ *
+ * @version 2.0 (February 2025)
+ *
+ * Authors listed in alphabetical order:
+ * 
+ * @author: Alessandro Barenghi <alessandro.barenghi@polimi.it>
+ * @author: Marco Gianvecchio <marco.gianvecchio@mail.polimi.it>
+ * @author: Patrick Karl <patrick.karl@tum.de>
+ * @author: Gerardo Pelosi <gerardo.pelosi@polimi.it>
+ * @author: Jonas Schupp <jonas.schupp@tum.de>
+ * 
+ * 
+ * This code is hereby placed in the public domain.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ''AS IS'' AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **/
+
+#pragma once
+
+#include "api.h"
+#include "namespace.h"
+#include "parameters.h"
+
+/* Static tracepoints of keygen, sign and verify.
+ * When USDT_PROBES is defined, the probes below are placed as SystemTap
+ * (USDT) probes of provider "cross", which eBPF tools such as bpftrace
+ * attach to at runtime; until then, each one is a single nop. Requires
+ * <sys/sdt.h>, e.g., from systemtap-sdt-dev. On Linux, USDT_PROBES is
+ * defined whenever the compiler finds <sys/sdt.h>; building with
+ * EXTRAFLAGS="-DNO_USDT_PROBES" places no probe in any case.
+ *
+ * keygen_entry(set, T, W)         keygen_return(set)
+ * sign_entry(set, T, W)           sign_return(set)
+ * verify_entry(set, T, W)         verify_return(set, is_signature_ok)
+ * phase_entry(set, phase, rounds) phase_return(set, phase)
+ *
+ * set is the name of the parameter set, e.g., "cross-rsdp-128-balanced",
+ * phase one of "expand_key", "seed_tree", "rounds", "merkle_root",
+ * "chall_1", "responses_y", "chall_2", "merkle_proof", "seed_path",
+ * "pack_responses", and rounds the number of rounds the phase works on,
+ * 0 if it does not work round by round. */
+
+/* the string arguments are passed as pointers: sys/sdt.h takes the size and
+ * the signedness of each argument from its type, which an array lacks */
+#define CROSS_PROBE_SET ((const char *) CROSS_NAMESPACE(CRYPTO_ALGNAME))
+
+#undef USDT_PROBES
+
+
+#define CROSS_PROBE_ENTRY(op) ((void) 0)
+#define CROSS_PROBE_RETURN(op) ((void) 0)
+#define CROSS_PROBE_RETURN_VALUE(op, value) ((void) 0)
+#define CROSS_PROBE_PHASE_ENTRY(phase, rounds) ((void) 0)
+#define CROSS_PROBE_PHASE_RETURN(phase) ((void) 0)
+
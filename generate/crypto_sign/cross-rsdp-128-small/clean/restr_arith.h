@@ -5,14 +5,14 @@
  * @version 2.0 (February 2025)
  *
  * Authors listed in alphabetical order:
- *
+ * 
  * @author: Alessandro Barenghi <alessandro.barenghi@polimi.it>
  * @author: Marco Gianvecchio <marco.gianvecchio@mail.polimi.it>
  * @author: Patrick Karl <patrick.karl@tum.de>
  * @author: Gerardo Pelosi <gerardo.pelosi@polimi.it>
  * @author: Jonas Schupp <jonas.schupp@tum.de>
- *
- *
+ * 
+ * 
  * This code is hereby placed in the public domain.
  *
  * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ''AS IS'' AND ANY EXPRESS
@@ -37,11 +37,13 @@
 #define FZRED_OPPOSITE(x) ((x) ^ 0x07)
 #define FZ_DOUBLE_ZERO_NORM(x) (((x) + (((x) + 1) >> 3)) & 0x07)
 
+
+
 static inline
-void fz_dz_norm_n(FZ_ELEM v[N]) {
-	for (int i = 0; i < N; i++) {
-		v[i] = FZ_DOUBLE_ZERO_NORM(v[i]);
-	}
+void fz_dz_norm_n(FZ_ELEM v[N]){
+    for (int i = 0; i < N; i++){
+       v[i] = FZ_DOUBLE_ZERO_NORM(v[i]);
+    }
 }
 
 /* Elements of the restricted subgroups are represented as the exponents of
@@ -49,17 +51,18 @@ void fz_dz_norm_n(FZ_ELEM v[N]) {
 static inline
 void fz_vec_sub_n(FZ_ELEM res[N],
                   const FZ_ELEM a[N],
-                  const FZ_ELEM b[N]) {
-	for (int i = 0; i < N; i++) {
-		res[i] = FZRED_SINGLE( a[i] + FZRED_OPPOSITE(b[i]) );
-	}
+                  const FZ_ELEM b[N]){
+    for(int i = 0; i < N; i++){
+        res[i]= FZRED_SINGLE( a[i] + FZRED_OPPOSITE(b[i]) );
+    }
 }
 
 static inline
-int is_fz_vec_in_restr_group_n(const FZ_ELEM in[N]) {
-	int is_in_ok = 1;
-	for (int i = 0; i < N; i++) {
-		is_in_ok = is_in_ok && (in[i] < Z);
-	}
-	return is_in_ok;
+int is_fz_vec_in_restr_group_n(const FZ_ELEM in[N]){
+    int is_in_ok = 1;
+    for(int i=0; i<N; i++){
+        is_in_ok = is_in_ok && (in[i] < Z);
+    }
+    return is_in_ok;
 }
+
@@ -0,0 +1,74 @@
+/**
+ *
+ * Reference ISO-C11 Implementation of CROSS.
+ *
+ * @version 2.0 (February 2025)
+ *
+ * Authors listed in alphabetical order:
+ * 
+ * @author: Alessandro Barenghi <alessandro.barenghi@polimi.it>
+ * @author: Marco Gianvecchio <marco.gianvecchio@mail.polimi.it>
+ * @author: Patrick Karl <patrick.karl@tum.de>
+ * @author: Gerardo Pelosi <gerardo.pelosi@polimi.it>
+ * @author: Jonas Schupp <jonas.schupp@tum.de>
+ * 
+ * 
+ * This code is hereby placed in the public domain.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ''AS IS'' AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **/
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "namespace.h"
+#include "parameters.h"
+
+/* Cache of the matrices expanded from seed_pk in CROSS_verify.
+ * When PK_CACHE is defined, the expansion of a seed_pk which was recently
+ * verified against is replaced by a copy out of the cache. The cache is
+ * split into PK_CACHE_SHARDS shards, each one behind its own mutex and
+ * evicting in least recently used order, and it never holds more than
+ * PK_CACHE_BUDGET_BYTES (changeable at runtime) of entries. The cached
+ * material is public, no wiping is needed. Requires pthreads, e.g.,
+ * building with EXTRAFLAGS="-DPK_CACHE -pthread". Without PK_CACHE, lookups
+ * always miss and insertions are discarded. */
+
+#define PK_CACHE_BUDGET_BYTES (4*1024*1024)
+#define PK_CACHE_SHARDS 16
+
+/* copies the len bytes cached for seed_pk into expanded and returns 1, or
+ * returns 0 if seed_pk is not in the cache */
+int pk_cache_lookup(const uint8_t seed_pk[KEYPAIR_SEED_LENGTH_BYTES],
+                    void *expanded,
+                    size_t len);
+
+/* stores a copy of the len bytes expanded from seed_pk, evicting the least
+ * recently used entries of its shard to stay within the budget */
+void pk_cache_insert(const uint8_t seed_pk[KEYPAIR_SEED_LENGTH_BYTES],
+                     const void *expanded,
+                     size_t len);
+
+/* sets the memory budget of the cache, evicting entries if needed */
+void pk_cache_set_budget(size_t budget_bytes);
+
+/* counters since the start of the process, any pointer may be NULL */
+void pk_cache_stats(uint64_t *hits,
+                    uint64_t *misses,
+                    uint64_t *evictions);
+
+/* frees all the entries; no other thread may be using the cache */
+void pk_cache_release(void);
@@ -0,0 +1,81 @@
+/**
+ *
+ * Reference ISO-C11 Implementation of CROSS.
+ *
+ * @version 2.0 (February 2025)
+ *
+ * Authors listed in alphabetical order:
+ * 
+ * @author: Alessandro Barenghi <alessandro.barenghi@polimi.it>
+ * @author: Marco Gianvecchio <marco.gianvecchio@mail.polimi.it>
+ * @author: Patrick Karl <patrick.karl@tum.de>
+ * @author: Gerardo Pelosi <gerardo.pelosi@polimi.it>
+ * @author: Jonas Schupp <jonas.schupp@tum.de>
+ * 
+ * 
+ * This code is hereby placed in the public domain.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ''AS IS'' AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **/
+
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "pk_cache.h"
+
+
+int pk_cache_lookup(const uint8_t seed_pk[KEYPAIR_SEED_LENGTH_BYTES],
+                    void *expanded,
+                    size_t len)
+{
+   (void)seed_pk;
+   (void)expanded;
+   (void)len;
+   return 0;
+}
+
+void pk_cache_insert(const uint8_t seed_pk[KEYPAIR_SEED_LENGTH_BYTES],
+                     const void *expanded,
+                     size_t len)
+{
+   (void)seed_pk;
+   (void)expanded;
+   (void)len;
+}
+
+void pk_cache_set_budget(size_t budget_bytes)
+{
+   (void)budget_bytes;
+}
+
+void pk_cache_stats(uint64_t *hits,
+                    uint64_t *misses,
+                    uint64_t *evictions)
+{
+   if(hits != NULL){
+      *hits = 0;
+   }
+   if(misses != NULL){
+      *misses = 0;
+   }
+   if(evictions != NULL){
+      *evictions = 0;
+   }
+}
+
+void pk_cache_release(void)
+{
+}
+
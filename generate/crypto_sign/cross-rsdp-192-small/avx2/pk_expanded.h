@@ -0,0 +1,60 @@
+/**
+ *
+ * Reference ISO-C11 Implementation of CROSS.
+ *
+ * @version 2.0 (February 2025)
+ *
+ * Authors listed in alphabetical order:
+ * 
+ * @author: Alessandro Barenghi <alessandro.barenghi@polimi.it>
+ * @author: Marco Gianvecchio <marco.gianvecchio@mail.polimi.it>
+ * @author: Patrick Karl <patrick.karl@tum.de>
+ * @author: Gerardo Pelosi <gerardo.pelosi@polimi.it>
+ * @author: Jonas Schupp <jonas.schupp@tum.de>
+ * 
+ * 
+ * This code is hereby placed in the public domain.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ''AS IS'' AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **/
+
+#pragma once
+
+#include <stdalign.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "architecture_detect.h"
+#include "CROSS.h"
+#include "csprng_hash.h"
+#include "namespace.h"
+#include "parameters.h"
+
+/* identifies the memory layout of pk_expanded_t in files of expanded keys,
+ * together with its size and field offsets: the padded AVX2 layout is
+ * stored as-is */
+#define PK_EXPANDED_LAYOUT 2
+
+/* Public key expanded for verification: the matrices generated from seed_pk
+ * are stored first, so that they can be cached as a single block of
+ * PK_EXPANDED_MATRICES_BYTES, followed by the unpacked syndrome and by the
+ * key itself. For RSDPG, W_mat_avx is the copy of W_mat employed by the
+ * AVX2 arithmetic, W_mat is only read while expanding */
+struct pk_expanded_s {
+   alignas(EPI8_PER_REG) V_TR_ELEM V_tr[K][V_TR_COLS];
+   FP_ELEM s[N-K];
+   pk_t pk;
+};
+
+#define PK_EXPANDED_MATRICES_BYTES (offsetof(pk_expanded_t, s))
@@ -0,0 +1,86 @@
+/**
+ *
+ * Reference ISO-C11 Implementation of CROSS.
+ *
+ * @version 2.0 (February 2025)
+ *
+ * Authors listed in alphabetical order:
+ * 
+ * @author: Alessandro Barenghi <alessandro.barenghi@polimi.it>
+ * @author: Marco Gianvecchio <marco.gianvecchio@mail.polimi.it>
+ * @author: Patrick Karl <patrick.karl@tum.de>
+ * @author: Gerardo Pelosi <gerardo.pelosi@polimi.it>
+ * @author: Jonas Schupp <jonas.schupp@tum.de>
+ * 
+ * 
+ * This code is hereby placed in the public domain.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ''AS IS'' AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **/
+
+#include "hash_stats.h"
+
+static const char *const hash_stats_site_names[HASH_STATS_SITES] = {
+   "keygen_batch/seed_sk",
+   "keygen_batch/seed_pk",
+   "keygen_batch/seed_e",
+   "sign/round_seeds",
+   "sign/cmt_0",
+   "sign/cmt_1",
+   "verify/round_seeds",
+   "verify/cmt_1",
+   "verify/cmt_0",
+   "seed_leaves",
+   "gen_seed_tree",
+   "rebuild_tree",
+   "tree_root",
+   "tree_builder",
+   "recompute_root"
+};
+
+const char *hash_stats_site_name(size_t site){
+   if(site >= HASH_STATS_SITES){
+      return NULL;
+   }
+   return hash_stats_site_names[site];
+}
+
+
+void hash_stats_lanes(size_t site,
+                      uint64_t calls[4]){
+   (void)site;
+   for(int l = 0; l < 4; l++){
+      calls[l] = 0;
+   }
+}
+
+void hash_stats_permutations(hash_stats_op_t op,
+                             uint64_t *runs,
+                             uint64_t *permutations,
+                             uint64_t *permutations_x4){
+   (void)op;
+   if(runs != NULL){
+      *runs = 0;
+   }
+   if(permutations != NULL){
+      *permutations = 0;
+   }
+   if(permutations_x4 != NULL){
+      *permutations_x4 = 0;
+   }
+}
+
+void hash_stats_reset(void){
+}
+
@@ -0,0 +1,100 @@
+/**
+ *
+ * Reference ISO-C11 Implementation of CROSS.
+ *
+ * @version 2.0 (February 2025)
+ *
+ * Authors listed in alphabetical order:
+ * 
+ * @author: Alessandro Barenghi <alessandro.barenghi@polimi.it>
+ * @author: Marco Gianvecchio <marco.gianvecchio@mail.polimi.it>
+ * @author: Patrick Karl <patrick.karl@tum.de>
+ * @author: Gerardo Pelosi <gerardo.pelosi@polimi.it>
+ * @author: Jonas Schupp <jonas.schupp@tum.de>
+ * 
+ * 
+ * This code is hereby placed in the public domain.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ''AS IS'' AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **/
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "namespace.h"
+
+/* Counters of the use of the lanes of the parallel SHAKE calls.
+ * When HASH_STATS is defined, every call site of hash_par and
+ * csprng_initialize_par records how many of the 4 lanes it fills, and the
+ * wrappers in sha3.h count the Keccak-f[1600] permutations, the single lane
+ * and the 4-way ones apart. The permutations are charged to the signing or
+ * verifying entry point running on the thread, and added to the process
+ * wide counters when it returns; those called by another one, e.g.,
+ * CROSS_presign by CROSS_sign, are charged as part of the outermost.
+ * Requires GCC or Clang, e.g., building with EXTRAFLAGS="-DHASH_STATS". Without HASH_STATS, the HASH_STATS_* macros
+ * expand to nothing and all counters read zero. */
+
+/* the call sites of hash_par and csprng_initialize_par */
+typedef enum {
+   HASH_STATS_SITE_KEYGEN_SEED_SK,
+   HASH_STATS_SITE_KEYGEN_SEED_PK,
+   HASH_STATS_SITE_KEYGEN_SEED_E,
+   HASH_STATS_SITE_SIGN_ROUND_SEEDS,
+   HASH_STATS_SITE_SIGN_CMT_0,
+   HASH_STATS_SITE_SIGN_CMT_1,
+   HASH_STATS_SITE_VERIFY_ROUND_SEEDS,
+   HASH_STATS_SITE_VERIFY_CMT_1,
+   HASH_STATS_SITE_VERIFY_CMT_0,
+   HASH_STATS_SITE_SEED_LEAVES,
+   HASH_STATS_SITE_GEN_SEED_TREE,
+   HASH_STATS_SITE_REBUILD_TREE,
+   HASH_STATS_SITE_TREE_ROOT,
+   HASH_STATS_SITE_TREE_BUILDER,
+   HASH_STATS_SITE_RECOMPUTE_ROOT,
+   HASH_STATS_SITES
+} hash_stats_site_t;
+
+/* the operations the permutations are charged to */
+typedef enum {
+   HASH_STATS_NONE,
+   HASH_STATS_SIGN,
+   HASH_STATS_VERIFY,
+   HASH_STATS_OPS
+} hash_stats_op_t;
+
+/* name of the call site numbered site, NULL if there is no such site */
+const char *hash_stats_site_name(size_t site);
+
+/* calls of the call site numbered site filling 1, 2, 3 and 4 lanes, in
+ * calls[0] to calls[3] */
+void hash_stats_lanes(size_t site,
+                      uint64_t calls[4]);
+
+/* completed runs of op, and the single lane and 4-way permutations they
+ * took; any pointer may be NULL */
+void hash_stats_permutations(hash_stats_op_t op,
+                             uint64_t *runs,
+                             uint64_t *permutations,
+                             uint64_t *permutations_x4);
+
+/* zeroes all the counters */
+void hash_stats_reset(void);
+
+
+#define HASH_STATS_PAR(site, par_level) ((void) 0)
+#define HASH_STATS_ENTER(op) ((void) 0)
+#define HASH_STATS_LEAVE(completed) ((void) 0)
+
@@ -5,14 +5,14 @@
  * @version 2.0 (February 2025)
  *
  * Authors listed in alphabetical order:
- *
+ * 
  * @author: Alessandro Barenghi <alessandro.barenghi@polimi.it>
  * @author: Marco Gianvecchio <marco.gianvecchio@mail.polimi.it>
  * @author: Patrick Karl <patrick.karl@tum.de>
  * @author: Gerardo Pelosi <gerardo.pelosi@polimi.it>
  * @author: Jonas Schupp <jonas.schupp@tum.de>
- *
- *
+ * 
+ * 
  * This code is hereby placed in the public domain.
  *
  * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ''AS IS'' AND ANY EXPRESS
@@ -33,65 +33,60 @@
 #include <string.h>
 
 #include "csprng_hash.h"
+#include "hash_stats.h"
 #include "merkle_tree.h"
 #include "parameters.h"
+#include "tree_tables.h"
 
-#define TO_PUBLISH 1
-#define NOT_TO_PUBLISH 0
 
 void tree_root(uint8_t root[HASH_DIGEST_LENGTH],
-               uint8_t leaves[T][HASH_DIGEST_LENGTH]) {
+               uint8_t leaves[T][HASH_DIGEST_LENGTH]){
 
-	int remainders[4] = {0};
-	if (T % 4 > 0) {
-		remainders[0] = 1;
-	}
-	if (T % 4 > 1) {
-		remainders[1] = 1;
-	}
-	if (T % 4 > 2) {
-		remainders[2] = 1;
-	}
+   int remainders[4] = {0};
+   if(T%4 > 0){ remainders[0] = 1; } 
+   if(T%4 > 1){ remainders[1] = 1; } 
+   if(T%4 > 2){ remainders[2] = 1; }
 
-	uint8_t hash_input[4 * HASH_DIGEST_LENGTH];
+   uint8_t hash_input[4*HASH_DIGEST_LENGTH];
 
-	int offset = 0;
-	for (int i = 0; i < 4; i++) {
-		hash(&hash_input[i * HASH_DIGEST_LENGTH], leaves[(T / 4)*i + offset], (T / 4 + remainders[i])*HASH_DIGEST_LENGTH, HASH_DOMAIN_SEP_CONST);
-		offset += remainders[i];
-	}
+   int offset = 0;
+   for (int i = 0; i < 4; i++){
+       hash(&hash_input[i*HASH_DIGEST_LENGTH], leaves[(T/4)*i+offset], (T/4+remainders[i])*HASH_DIGEST_LENGTH, HASH_DOMAIN_SEP_CONST);
+       offset += remainders[i];  
+   }
 
-	hash(root, hash_input, sizeof(hash_input), HASH_DOMAIN_SEP_CONST);
+   hash(root,hash_input,sizeof(hash_input),HASH_DOMAIN_SEP_CONST);
 }
 
-uint16_t tree_proof(uint8_t mtp[W * HASH_DIGEST_LENGTH],
+uint16_t tree_proof(uint8_t mtp[W*HASH_DIGEST_LENGTH],
                     uint8_t leaves[T][HASH_DIGEST_LENGTH],
-                    const uint8_t leaves_to_reveal[T]) {
-	uint16_t published = 0;
-	for (int i = 0; i < T; i++) {
-		if (leaves_to_reveal[i] == TO_PUBLISH) {
-			memcpy(&mtp[HASH_DIGEST_LENGTH * published],
-			       &leaves[i],
-			       HASH_DIGEST_LENGTH);
-			published++;
-		}
-	}
-	return published;
+                    const chall_2_t *chall_2){
+    for(int i=0; i<W; i++){
+       memcpy(&mtp[HASH_DIGEST_LENGTH*i],
+              &leaves[chall_2->rounds_1[i]],
+              HASH_DIGEST_LENGTH);
+    }
+    return W;
 }
 
 uint8_t recompute_root(uint8_t root[HASH_DIGEST_LENGTH],
                        uint8_t recomputed_leaves[T][HASH_DIGEST_LENGTH],
-                       const uint8_t mtp[W * HASH_DIGEST_LENGTH],
-                       const uint8_t leaves_to_reveal[T]) {
-	uint16_t published = 0;
-	for (int i = 0; i < T; i++) {
-		if (leaves_to_reveal[i] == TO_PUBLISH) {
-			memcpy(&recomputed_leaves[i],
-			       &mtp[HASH_DIGEST_LENGTH * published],
-			       HASH_DIGEST_LENGTH);
-			published++;
-		}
-	}
-	tree_root(root, recomputed_leaves);
-	return 1;
+                       const uint8_t mtp[W*HASH_DIGEST_LENGTH],
+                       const chall_2_t *chall_2){
+    for(int i=0; i<W; i++){
+       memcpy(&recomputed_leaves[chall_2->rounds_1[i]],
+              &mtp[HASH_DIGEST_LENGTH*i],
+              HASH_DIGEST_LENGTH);
+    }
+    tree_root(root,recomputed_leaves);
+    return 1;
 }
+
+uint8_t is_tree_proof_padding_ok(const uint8_t mtp[W*HASH_DIGEST_LENGTH],
+                                 const chall_2_t *chall_2){
+    /* the proof holds exactly W digests, there is no padding to check */
+    (void)mtp;
+    (void)chall_2;
+    return 1;
+}
+
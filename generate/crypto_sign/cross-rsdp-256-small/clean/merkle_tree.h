@@ -5,14 +5,14 @@
  * @version 2.0 (February 2025)
  *
  * Authors listed in alphabetical order:
- *
+ * 
  * @author: Alessandro Barenghi <alessandro.barenghi@polimi.it>
  * @author: Marco Gianvecchio <marco.gianvecchio@mail.polimi.it>
  * @author: Patrick Karl <patrick.karl@tum.de>
  * @author: Gerardo Pelosi <gerardo.pelosi@polimi.it>
  * @author: Jonas Schupp <jonas.schupp@tum.de>
- *
- *
+ * 
+ * 
  * This code is hereby placed in the public domain.
  *
  * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ''AS IS'' AND ANY EXPRESS
@@ -31,8 +31,10 @@
 
 #pragma once
 
+#include "challenge.h"
 #include "namespace.h"
 
+
 /* Stub of the interface to Merkle tree root computer from all leaves */
 void tree_root(uint8_t root[HASH_DIGEST_LENGTH],
                uint8_t tree[NUM_NODES_MERKLE_TREE * HASH_DIGEST_LENGTH],
@@ -40,15 +42,86 @@ void tree_root(uint8_t root[HASH_DIGEST_LENGTH],
                 * tolerated in strict ISO C */
                uint8_t leaves[T][HASH_DIGEST_LENGTH]);
 
+/* Incremental computation of the Merkle tree, for commitments which become
+ * available in round order: each one is written in its leaf, found by
+ * tree_leaf, then added to the builder, which computes every node as soon as
+ * both of its children are, TREE_BUILDER_QUEUE at a time. The resulting tree
+ * is the one of tree_root. */
+#define TREE_BUILDER_QUEUE 4
+
+typedef struct {
+   /* rounds whose leaf was added */
+   int leaves;
+   /* left children of the nodes ready to be computed */
+   int to_hash;
+   uint16_t queue[TREE_BUILDER_QUEUE];
+   uint8_t is_computed[NUM_NODES_MERKLE_TREE];
+} tree_builder_t;
+
+/* position in tree of the leaf of round */
+uint8_t *tree_leaf(uint8_t tree[NUM_NODES_MERKLE_TREE*HASH_DIGEST_LENGTH],
+                   int round);
+
+void tree_builder_init(tree_builder_t *builder);
+
+/* the leaves of the next count rounds were written in tree */
+void tree_builder_add(tree_builder_t *builder,
+                      uint8_t tree[NUM_NODES_MERKLE_TREE*HASH_DIGEST_LENGTH],
+                      int count);
+
+/* completes tree once the leaves of all the T rounds were added */
+void tree_builder_root(tree_builder_t *builder,
+                       uint8_t root[HASH_DIGEST_LENGTH],
+                       uint8_t tree[NUM_NODES_MERKLE_TREE*HASH_DIGEST_LENGTH]);
+
 /* Stub interface to the function computing the Merkle tree proof, storing it
  * in the signature. Returns the number of digests in the merkle tree proof */
-uint16_t tree_proof(uint8_t mtp[HASH_DIGEST_LENGTH * TREE_NODES_TO_STORE],
-                    const uint8_t tree[NUM_NODES_MERKLE_TREE * HASH_DIGEST_LENGTH],
-                    const uint8_t leaves_to_reveal[T]);
+uint16_t tree_proof(uint8_t mtp[HASH_DIGEST_LENGTH*TREE_NODES_TO_STORE],
+                    const uint8_t tree[NUM_NODES_MERKLE_TREE*HASH_DIGEST_LENGTH],
+                    const chall_2_t *chall_2);
 
 /* stub of the interface to Merkle tree recomputation given the proof and
  * the computed leaves */
 uint8_t recompute_root(uint8_t root[HASH_DIGEST_LENGTH],
                        uint8_t recomputed_leaves[T][HASH_DIGEST_LENGTH],
-                       const uint8_t mtp[HASH_DIGEST_LENGTH * TREE_NODES_TO_STORE],
-                       const uint8_t leaves_to_reveal[T]);
+                       const uint8_t mtp[HASH_DIGEST_LENGTH*TREE_NODES_TO_STORE],
+                       const chall_2_t *chall_2);
+
+/* recompute_root carried out a few nodes at a time: init places the leaves
+ * in tree, then step is called until it returns 1, each time computing at
+ * most max_nodes nodes, then finish returns the same as recompute_root */
+typedef struct {
+   /* flags of the nodes the verifier computes */
+   tree_flags_t flags;
+   /* next word of flags to be taken, and first node of its level */
+   int level;
+   int c;
+   unsigned int start_node;
+   /* pairs of siblings of the word taken last still to be hashed */
+   int word_level;
+   unsigned int word_node;
+   uint64_t computed;
+   uint64_t to_hash;
+   /* digests taken from the proof so far */
+   unsigned int published;
+} tree_recompute_t;
+
+void recompute_root_init(tree_recompute_t *recompute,
+                         uint8_t tree[NUM_NODES_MERKLE_TREE*HASH_DIGEST_LENGTH],
+                         uint8_t recomputed_leaves[T][HASH_DIGEST_LENGTH],
+                         const chall_2_t *chall_2);
+
+int recompute_root_step(tree_recompute_t *recompute,
+                        uint8_t tree[NUM_NODES_MERKLE_TREE*HASH_DIGEST_LENGTH],
+                        const uint8_t mtp[HASH_DIGEST_LENGTH*TREE_NODES_TO_STORE],
+                        int max_nodes);
+
+uint8_t recompute_root_finish(const tree_recompute_t *recompute,
+                              uint8_t root[HASH_DIGEST_LENGTH],
+                              const uint8_t tree[NUM_NODES_MERKLE_TREE*HASH_DIGEST_LENGTH],
+                              const uint8_t mtp[HASH_DIGEST_LENGTH*TREE_NODES_TO_STORE]);
+
+/* returns 1 if the padding of the proof is correct, 0 otherwise, the same as
+ * recompute_root but without hashing */
+uint8_t is_tree_proof_padding_ok(const uint8_t mtp[HASH_DIGEST_LENGTH*TREE_NODES_TO_STORE],
+                                 const chall_2_t *chall_2);
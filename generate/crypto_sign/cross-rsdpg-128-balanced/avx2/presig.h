@@ -0,0 +1,64 @@
+/**
+ *
+ * Reference ISO-C11 Implementation of CROSS.
+ *
+ * @version 2.0 (February 2025)
+ *
+ * Authors listed in alphabetical order:
+ * 
+ * @author: Alessandro Barenghi <alessandro.barenghi@polimi.it>
+ * @author: Marco Gianvecchio <marco.gianvecchio@mail.polimi.it>
+ * @author: Patrick Karl <patrick.karl@tum.de>
+ * @author: Gerardo Pelosi <gerardo.pelosi@polimi.it>
+ * @author: Jonas Schupp <jonas.schupp@tum.de>
+ * 
+ * 
+ * This code is hereby placed in the public domain.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ''AS IS'' AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **/
+
+
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+
+#include "CROSS.h"
+#include "namespace.h"
+#include "parameters.h"
+
+/* State of a signature computed by CROSS_presign up to its commitments,
+ * which are independent of the message. It holds the secret round
+ * material of the signature: CROSS_sign_online consumes it and wipes it */
+struct CROSS_presig_s {
+   uint8_t salt[SALT_LENGTH_BYTES];
+   uint8_t digest_cmt[HASH_DIGEST_LENGTH];
+   uint8_t seed_tree[SEED_LENGTH_BYTES*NUM_NODES_SEED_TREE];
+   uint8_t merkle_tree[NUM_NODES_MERKLE_TREE*HASH_DIGEST_LENGTH];
+   uint8_t cmt_1[T*HASH_DIGEST_LENGTH];
+   FZ_ELEM e_bar_prime[T][N];
+   FZ_ELEM v_bar[T][N];
+   FP_ELEM u_prime[T][N];
+   FZ_ELEM v_G_bar[T][M];
+   /* 1 from CROSS_presign to CROSS_sign_online, 0 otherwise */
+   uint8_t is_ready;
+};
+
+/* memset called through a volatile pointer is not optimized away */
+static inline
+void presig_wipe(void *p, size_t len){
+   static void *(*const volatile wipe_memset)(void *, int, size_t) = memset;
+   wipe_memset(p, 0, len);
+}
@@ -5,14 +5,14 @@
  * @version 2.0 (February 2025)
  *
  * Authors listed in alphabetical order:
- *
+ * 
  * @author: Alessandro Barenghi <alessandro.barenghi@polimi.it>
  * @author: Marco Gianvecchio <marco.gianvecchio@mail.polimi.it>
  * @author: Patrick Karl <patrick.karl@tum.de>
  * @author: Gerardo Pelosi <gerardo.pelosi@polimi.it>
  * @author: Jonas Schupp <jonas.schupp@tum.de>
- *
- *
+ * 
+ * 
  * This code is hereby placed in the public domain.
  *
  * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ''AS IS'' AND ANY EXPRESS
@@ -31,35 +31,42 @@
 
 #pragma once
 
+#include "architecture_detect.h"
 #include "namespace.h"
 #include "parameters.h"
 #include "sha3.h"
 
+/* The transposed matrix V_tr is expanded directly in the layout employed by
+ * fp_vec_by_fp_matrix: in the AVX2 implementation, rows are widened to the
+ * lane size and zero-padded to a whole number of registers */
+#define V_TR_ELEM FP_DOUBLEPREC
+#define V_TR_COLS ROUND_UP(N-K,EPI32_PER_REG)
+
 /************************* CSPRNG ********************************/
 
 #define CSPRNG_STATE_T SHAKE_STATE_STRUCT
 /* initializes a CSPRNG, given the seed and a state pointer */
 static inline
-void csprng_initialize(CSPRNG_STATE_T *const csprng_state,
-                       const unsigned char *const seed,
+void csprng_initialize(CSPRNG_STATE_T * const csprng_state,
+                       const unsigned char * const seed,
                        const uint32_t seed_len_bytes,
                        const uint16_t dsc) {
-	// the second parameter is the security level of the SHAKE instance
-	xof_shake_init(csprng_state, SEED_LENGTH_BYTES * 8);
-	xof_shake_update(csprng_state, seed, seed_len_bytes);
-	uint8_t dsc_ordered[2];
-	dsc_ordered[0] = dsc & 0xff;
-	dsc_ordered[1] = (dsc >> 8) & 0xff;
-	xof_shake_update(csprng_state, dsc_ordered, 2);
-	xof_shake_final(csprng_state);
+   // the second parameter is the security level of the SHAKE instance
+   xof_shake_init(csprng_state, SEED_LENGTH_BYTES*8);
+   xof_shake_update(csprng_state,seed,seed_len_bytes);
+   uint8_t dsc_ordered[2];
+   dsc_ordered[0] = dsc & 0xff;
+   dsc_ordered[1] = (dsc >> 8) & 0xff;
+   xof_shake_update(csprng_state,dsc_ordered,2);
+   xof_shake_final(csprng_state);
 } /* end csprng_initialize */
 
 /* extracts xlen bytes from the CSPRNG, given the state */
 static inline
-void csprng_randombytes(unsigned char *const x,
+void csprng_randombytes(unsigned char * const x,
                         unsigned long long xlen,
-                        CSPRNG_STATE_T *const csprng_state) {
-	xof_shake_extract(csprng_state, x, xlen);
+                        CSPRNG_STATE_T * const csprng_state){
+   xof_shake_extract(csprng_state,x,xlen);
 }
 
 /* PQClean-edit: CSPRNG release context */
@@ -77,153 +84,139 @@ void csprng_release(CSPRNG_STATE_T *const csprng_state) {
 
 /* initialize */
 static inline
-void csprng_initialize_x2(CSPRNG_X2_STATE_T *const csprng_state,
-                          const unsigned char *const seed1,
-                          const unsigned char *const seed2,
+void csprng_initialize_x2(CSPRNG_X2_STATE_T * const csprng_state,
+                          const unsigned char * const seed1,
+                          const unsigned char * const seed2,
                           const uint32_t seed_len_bytes,
                           const uint16_t dsc1,
                           const uint16_t dsc2) {
-	xof_shake_x2_init(csprng_state, SEED_LENGTH_BYTES * 8);
-	xof_shake_x2_update(csprng_state, seed1, seed2, seed_len_bytes);
-	uint8_t dsc_ordered1[2], dsc_ordered2[2];
-	dsc_ordered1[0] = dsc1 & 0xff;
-	dsc_ordered1[1] = (dsc1 >> 8) & 0xff;
-	dsc_ordered2[0] = dsc2 & 0xff;
-	dsc_ordered2[1] = (dsc2 >> 8) & 0xff;
-	xof_shake_x2_update(csprng_state, dsc_ordered1, dsc_ordered2, 2);
-	xof_shake_x2_final(csprng_state);
-}
-static inline
-void csprng_initialize_x3(CSPRNG_X3_STATE_T *const csprng_state,
-                          const unsigned char *const seed1,
-                          const unsigned char *const seed2,
-                          const unsigned char *const seed3,
+   xof_shake_x2_init(csprng_state, SEED_LENGTH_BYTES*8);
+   xof_shake_x2_update(csprng_state,seed1,seed2,seed_len_bytes);
+   uint8_t dsc_ordered1[2], dsc_ordered2[2];
+   dsc_ordered1[0] = dsc1 & 0xff;
+   dsc_ordered1[1] = (dsc1 >> 8) & 0xff;
+   dsc_ordered2[0] = dsc2 & 0xff;
+   dsc_ordered2[1] = (dsc2 >> 8) & 0xff;
+   xof_shake_x2_update(csprng_state,dsc_ordered1,dsc_ordered2,2);
+   xof_shake_x2_final(csprng_state);
+}
+static inline
+void csprng_initialize_x3(CSPRNG_X3_STATE_T * const csprng_state,
+                          const unsigned char * const seed1,
+                          const unsigned char * const seed2,
+                          const unsigned char * const seed3,
                           const uint32_t seed_len_bytes,
                           const uint16_t dsc1,
                           const uint16_t dsc2,
                           const uint16_t dsc3) {
-	/* PQClean-edit: avoid VLA */
-	// const unsigned char seed4[seed_len_bytes]; // discarded
-	unsigned char *seed4 = (unsigned char *)malloc(seed_len_bytes); // discarded
-	xof_shake_x4_init(csprng_state);
-	xof_shake_x4_update(csprng_state, seed1, seed2, seed3, seed4, seed_len_bytes);
-	uint8_t dsc_ordered1[2], dsc_ordered2[2], dsc_ordered3[2], dsc_ordered4[2]; // dsc_ordered4 is discarded
-	dsc_ordered1[0] = dsc1 & 0xff;
-	dsc_ordered1[1] = (dsc1 >> 8) & 0xff;
-	dsc_ordered2[0] = dsc2 & 0xff;
-	dsc_ordered2[1] = (dsc2 >> 8) & 0xff;
-	dsc_ordered3[0] = dsc3 & 0xff;
-	dsc_ordered3[1] = (dsc3 >> 8) & 0xff;
-	xof_shake_x4_update(csprng_state, dsc_ordered1, dsc_ordered2, dsc_ordered3, dsc_ordered4, 2);
-	xof_shake_x4_final(csprng_state);
-	free(seed4);
-}
-static inline
-void csprng_initialize_x4(CSPRNG_X4_STATE_T *const csprng_state,
-                          const unsigned char *const seed1,
-                          const unsigned char *const seed2,
-                          const unsigned char *const seed3,
-                          const unsigned char *const seed4,
+   /* PQClean-edit: avoid VLA */
+   // const unsigned char seed4[seed_len_bytes]; // discarded
+   unsigned char *seed4 = (unsigned char *)malloc(seed_len_bytes); // discarded
+   xof_shake_x4_init(csprng_state);
+   xof_shake_x4_update(csprng_state,seed1,seed2,seed3,seed4,seed_len_bytes);
+   uint8_t dsc_ordered1[2], dsc_ordered2[2], dsc_ordered3[2], dsc_ordered4[2]; // dsc_ordered4 is discarded
+   dsc_ordered1[0] = dsc1 & 0xff;
+   dsc_ordered1[1] = (dsc1 >> 8) & 0xff;
+   dsc_ordered2[0] = dsc2 & 0xff;
+   dsc_ordered2[1] = (dsc2 >> 8) & 0xff;
+   dsc_ordered3[0] = dsc3 & 0xff;
+   dsc_ordered3[1] = (dsc3 >> 8) & 0xff;
+   xof_shake_x4_update(csprng_state,dsc_ordered1,dsc_ordered2,dsc_ordered3,dsc_ordered4,2);
+   xof_shake_x4_final(csprng_state);
+   free(seed4);
+}
+static inline
+void csprng_initialize_x4(CSPRNG_X4_STATE_T * const csprng_state,
+                          const unsigned char * const seed1,
+                          const unsigned char * const seed2,
+                          const unsigned char * const seed3,
+                          const unsigned char * const seed4,
                           const uint32_t seed_len_bytes,
                           const uint16_t dsc1,
                           const uint16_t dsc2,
                           const uint16_t dsc3,
                           const uint16_t dsc4) {
-	xof_shake_x4_init(csprng_state);
-	xof_shake_x4_update(csprng_state, seed1, seed2, seed3, seed4, seed_len_bytes);
-	uint8_t dsc_ordered1[2], dsc_ordered2[2], dsc_ordered3[2], dsc_ordered4[2];
-	dsc_ordered1[0] = dsc1 & 0xff;
-	dsc_ordered1[1] = (dsc1 >> 8) & 0xff;
-	dsc_ordered2[0] = dsc2 & 0xff;
-	dsc_ordered2[1] = (dsc2 >> 8) & 0xff;
-	dsc_ordered3[0] = dsc3 & 0xff;
-	dsc_ordered3[1] = (dsc3 >> 8) & 0xff;
-	dsc_ordered4[0] = dsc4 & 0xff;
-	dsc_ordered4[1] = (dsc4 >> 8) & 0xff;
-	xof_shake_x4_update(csprng_state, dsc_ordered1, dsc_ordered2, dsc_ordered3, dsc_ordered4, 2);
-	xof_shake_x4_final(csprng_state);
+   xof_shake_x4_init(csprng_state);
+   xof_shake_x4_update(csprng_state,seed1,seed2,seed3,seed4,seed_len_bytes);
+   uint8_t dsc_ordered1[2], dsc_ordered2[2], dsc_ordered3[2], dsc_ordered4[2];
+   dsc_ordered1[0] = dsc1 & 0xff;
+   dsc_ordered1[1] = (dsc1 >> 8) & 0xff;
+   dsc_ordered2[0] = dsc2 & 0xff;
+   dsc_ordered2[1] = (dsc2 >> 8) & 0xff;
+   dsc_ordered3[0] = dsc3 & 0xff;
+   dsc_ordered3[1] = (dsc3 >> 8) & 0xff;
+   dsc_ordered4[0] = dsc4 & 0xff;
+   dsc_ordered4[1] = (dsc4 >> 8) & 0xff;
+   xof_shake_x4_update(csprng_state,dsc_ordered1,dsc_ordered2,dsc_ordered3,dsc_ordered4,2);
+   xof_shake_x4_final(csprng_state);
 }
 /* randombytes */
 static inline
-void csprng_randombytes_x2(unsigned char *const x1, unsigned char *const x2, uint64_t xlen, CSPRNG_X2_STATE_T *const csprng_state) {
-	xof_shake_x2_extract(csprng_state, x1, x2, xlen);
+void csprng_randombytes_x2(unsigned char * const x1, unsigned char * const x2, uint64_t xlen, CSPRNG_X2_STATE_T * const csprng_state){
+   xof_shake_x2_extract(csprng_state,x1,x2,xlen);
 }
 static inline
-void csprng_randombytes_x3(unsigned char *const x1, unsigned char *const x2, unsigned char *const x3, uint64_t xlen, CSPRNG_X3_STATE_T *const csprng_state) {
-	/* PQClean-edit: avoid VLA */
-	// unsigned char x4[xlen]; // discarded
-	unsigned char *x4 = (unsigned char *)malloc(xlen); // discarded
-	xof_shake_x4_extract(csprng_state, x1, x2, x3, x4, xlen);
-	free(x4);
+void csprng_randombytes_x3(unsigned char * const x1,unsigned char * const x2,unsigned char * const x3,uint64_t xlen,CSPRNG_X3_STATE_T * const csprng_state){
+   /* PQClean-edit: avoid VLA */
+   // unsigned char x4[xlen]; // discarded
+   unsigned char *x4 = (unsigned char *)malloc(xlen); // discarded
+   xof_shake_x4_extract(csprng_state,x1,x2,x3,x4,xlen);
+   free(x4);
 }
 static inline
-void csprng_randombytes_x4(unsigned char *const x1, unsigned char *const x2, unsigned char *const x3, unsigned char *const x4, uint64_t xlen, CSPRNG_X4_STATE_T *const csprng_state) {
-	xof_shake_x4_extract(csprng_state, x1, x2, x3, x4, xlen);
+void csprng_randombytes_x4(unsigned char * const x1,unsigned char * const x2,unsigned char * const x3,unsigned char * const x4,uint64_t xlen,CSPRNG_X4_STATE_T * const csprng_state){
+   xof_shake_x4_extract(csprng_state,x1,x2,x3,x4,xlen);
 }
 /* PQClean-edit: CSPRNG release context */
 static inline
-void csprng_release_x2(CSPRNG_X2_STATE_T *const csprng_state) {
-	xof_shake_x2_release(csprng_state);
+void csprng_release_x2(CSPRNG_X2_STATE_T * const csprng_state){
+   xof_shake_x2_release(csprng_state);
 }
 static inline
-void csprng_release_x3(CSPRNG_X3_STATE_T *const csprng_state) {
-	xof_shake_x4_release(csprng_state);
+void csprng_release_x3(CSPRNG_X3_STATE_T * const csprng_state){
+   xof_shake_x4_release(csprng_state);
 }
 static inline
-void csprng_release_x4(CSPRNG_X4_STATE_T *const csprng_state) {
-	xof_shake_x4_release(csprng_state);
+void csprng_release_x4(CSPRNG_X4_STATE_T * const csprng_state){
+   xof_shake_x4_release(csprng_state);
 }
 
+
 /**************** Common API for Parallel CSPRNG *****************/
 
 #define PAR_CSPRNG_STATE_T par_shake_ctx
 
 static inline
 void csprng_initialize_par(int par_level,
-                           PAR_CSPRNG_STATE_T *const states,
-                           const unsigned char *const seed1,
-                           const unsigned char *const seed2,
-                           const unsigned char *const seed3,
-                           const unsigned char *const seed4,
+                           PAR_CSPRNG_STATE_T * const states,
+                           const unsigned char * const seed1,
+                           const unsigned char * const seed2,
+                           const unsigned char * const seed3,
+                           const unsigned char * const seed4,
                            const uint32_t seed_len_bytes,
                            const uint16_t dsc1,
                            const uint16_t dsc2,
                            const uint16_t dsc3,
                            const uint16_t dsc4) {
-	if (par_level == 1) {
-		csprng_initialize(&(states->state1), seed1, seed_len_bytes, dsc1);
-	} else if (par_level == 2) {
-		csprng_initialize_x2(&(states->state2), seed1, seed2, seed_len_bytes, dsc1, dsc2);
-	} else if (par_level == 3) {
-		csprng_initialize_x3(&(states->state4), seed1, seed2, seed3, seed_len_bytes, dsc1, dsc2, dsc3);
-	} else if (par_level == 4) {
-		csprng_initialize_x4(&(states->state4), seed1, seed2, seed3, seed4, seed_len_bytes, dsc1, dsc2, dsc3, dsc4);
-	}
-}
-static inline
-void csprng_randombytes_par(int par_level, PAR_CSPRNG_STATE_T *const states, unsigned char *const x1, unsigned char *const x2, unsigned char *const x3, unsigned char *const x4, uint64_t xlen) {
-	if (par_level == 1) {
-		csprng_randombytes(x1, xlen, &(states->state1));
-	} else if (par_level == 2) {
-		csprng_randombytes_x2(x1, x2, xlen, &(states->state2));
-	} else if (par_level == 3) {
-		csprng_randombytes_x3(x1, x2, x3, xlen, &(states->state4));
-	} else if (par_level == 4) {
-		csprng_randombytes_x4(x1, x2, x3, x4, xlen, &(states->state4));
-	}
+   if(par_level == 1) csprng_initialize(&(states->state1), seed1, seed_len_bytes, dsc1);
+   else if(par_level == 2) csprng_initialize_x2(&(states->state2), seed1, seed2, seed_len_bytes, dsc1, dsc2);
+   else if(par_level == 3) csprng_initialize_x3(&(states->state4), seed1, seed2, seed3, seed_len_bytes, dsc1, dsc2, dsc3);
+   else if(par_level == 4) csprng_initialize_x4(&(states->state4), seed1, seed2, seed3, seed4, seed_len_bytes, dsc1, dsc2, dsc3, dsc4);
+}
+static inline
+void csprng_randombytes_par(int par_level, PAR_CSPRNG_STATE_T * const states, unsigned char * const x1,unsigned char * const x2,unsigned char * const x3,unsigned char * const x4,uint64_t xlen){
+   if(par_level == 1) csprng_randombytes(x1, xlen, &(states->state1));
+   else if(par_level == 2) csprng_randombytes_x2(x1, x2, xlen, &(states->state2));
+   else if(par_level == 3) csprng_randombytes_x3(x1, x2, x3, xlen, &(states->state4));
+   else if(par_level == 4) csprng_randombytes_x4(x1, x2, x3, x4, xlen, &(states->state4));
 }
 /* PQClean-edit: CSPRNG release context */
 static inline
-void csprng_release_par(int par_level, PAR_CSPRNG_STATE_T *const states) {
-	if (par_level == 1) {
-		csprng_release(&(states->state1));
-	} else if (par_level == 2) {
-		csprng_release_x2(&(states->state2));
-	} else if (par_level == 3) {
-		csprng_release_x3(&(states->state4));
-	} else if (par_level == 4) {
-		csprng_release_x4(&(states->state4));
-	}
+void csprng_release_par(int par_level, PAR_CSPRNG_STATE_T * const states){
+   if(par_level == 1) csprng_release(&(states->state1));
+   else if(par_level == 2) csprng_release_x2(&(states->state2));
+   else if(par_level == 3) csprng_release_x3(&(states->state4));
+   else if(par_level == 4) csprng_release_x4(&(states->state4));
 }
 
 /************************* HASH functions ********************************/
@@ -233,19 +226,55 @@ static inline
 void hash(uint8_t digest[HASH_DIGEST_LENGTH],
           const unsigned char *const m,
           const uint64_t mlen,
-          const uint16_t dsc) {
-	/* SHAKE with a 2*lambda bit digest is employed also for hashing */
-	CSPRNG_STATE_T csprng_state;
-	xof_shake_init(&csprng_state, SEED_LENGTH_BYTES * 8);
-	xof_shake_update(&csprng_state, m, mlen);
-	uint8_t dsc_ordered[2];
-	dsc_ordered[0] = dsc & 0xff;
-	dsc_ordered[1] = (dsc >> 8) & 0xff;
-	xof_shake_update(&csprng_state, dsc_ordered, 2);
-	xof_shake_final(&csprng_state);
-	xof_shake_extract(&csprng_state, digest, HASH_DIGEST_LENGTH);
-	/* PQClean-edit: SHAKE release context */
-	xof_shake_release(&csprng_state);
+          const uint16_t dsc){
+   /* SHAKE with a 2*lambda bit digest is employed also for hashing */
+   CSPRNG_STATE_T csprng_state;    
+   xof_shake_init(&csprng_state, SEED_LENGTH_BYTES*8);
+   xof_shake_update(&csprng_state,m,mlen);
+   uint8_t dsc_ordered[2];
+   dsc_ordered[0] = dsc & 0xff;
+   dsc_ordered[1] = (dsc >> 8) & 0xff;
+   xof_shake_update(&csprng_state,dsc_ordered,2);
+   xof_shake_final(&csprng_state);    
+   xof_shake_extract(&csprng_state,digest,HASH_DIGEST_LENGTH);
+   /* PQClean-edit: SHAKE release context */
+   xof_shake_release(&csprng_state);
+}
+
+/* Incremental counterpart of hash(): the message is absorbed over any number
+ * of hash_update calls, hash_final appends the domain separation constant */
+static inline
+void hash_init(CSPRNG_STATE_T *const csprng_state){
+   /* SHAKE with a 2*lambda bit digest is employed also for hashing */
+   xof_shake_init(csprng_state, SEED_LENGTH_BYTES*8);
+}
+
+static inline
+void hash_update(CSPRNG_STATE_T *const csprng_state,
+                 const unsigned char *const m,
+                 const uint64_t mlen){
+   xof_shake_update(csprng_state,m,mlen);
+}
+
+static inline
+void hash_final(uint8_t digest[HASH_DIGEST_LENGTH],
+                CSPRNG_STATE_T *const csprng_state,
+                const uint16_t dsc){
+   uint8_t dsc_ordered[2];
+   dsc_ordered[0] = dsc & 0xff;
+   dsc_ordered[1] = (dsc >> 8) & 0xff;
+   xof_shake_update(csprng_state,dsc_ordered,2);
+   xof_shake_final(csprng_state);
+   xof_shake_extract(csprng_state,digest,HASH_DIGEST_LENGTH);
+   /* PQClean-edit: SHAKE release context */
+   xof_shake_release(csprng_state);
+}
+
+/* releases a state of hash_init which will not reach hash_final */
+static inline
+void hash_release(CSPRNG_STATE_T *const csprng_state){
+   /* PQClean-edit: SHAKE release context */
+   xof_shake_release(csprng_state);
 }
 
 #define par_xof_input csprng_initialize_par
@@ -255,11 +284,11 @@ void hash(uint8_t digest[HASH_DIGEST_LENGTH],
 
 static inline
 void hash_par(int par_level,
-              uint8_t digest_1[HASH_DIGEST_LENGTH],
+              uint8_t digest_1[HASH_DIGEST_LENGTH], 
               uint8_t digest_2[HASH_DIGEST_LENGTH],
               uint8_t digest_3[HASH_DIGEST_LENGTH],
               uint8_t digest_4[HASH_DIGEST_LENGTH],
-              const unsigned char *const m_1,
+              const unsigned char *const m_1, 
               const unsigned char *const m_2,
               const unsigned char *const m_3,
               const unsigned char *const m_4,
@@ -268,11 +297,11 @@ void hash_par(int par_level,
               const uint16_t dsc2,
               const uint16_t dsc3,
               const uint16_t dsc4) {
-	PAR_CSPRNG_STATE_T states;
-	par_xof_input(par_level, &states, m_1, m_2, m_3, m_4, mlen, dsc1, dsc2, dsc3, dsc4);
-	par_xof_output(par_level, &states, digest_1, digest_2, digest_3, digest_4, HASH_DIGEST_LENGTH);
-	/* PQClean-edit: SHAKE release context */
-	par_xof_release(par_level, &states);
+   PAR_CSPRNG_STATE_T states;
+   par_xof_input(par_level, &states, m_1, m_2, m_3, m_4, mlen, dsc1, dsc2, dsc3, dsc4);
+   par_xof_output(par_level, &states, digest_1, digest_2, digest_3, digest_4, HASH_DIGEST_LENGTH);
+   /* PQClean-edit: SHAKE release context */
+   par_xof_release(par_level, &states);
 }
 
 /***************** Specialized CSPRNGs for non binary domains *****************/
@@ -281,219 +310,419 @@ void hash_par(int par_level,
 void expand_digest_to_fixed_weight(uint8_t fixed_weight_string[T],
                                    const uint8_t digest[HASH_DIGEST_LENGTH]);
 
-#define BITS_FOR_P BITS_TO_REPRESENT(P-1)
-#define BITS_FOR_Z BITS_TO_REPRESENT(Z-1)
+#define BITS_FOR_P BITS_TO_REPRESENT(P-1) 
+#define BITS_FOR_Z BITS_TO_REPRESENT(Z-1) 
+
+#define CSPRNG_FP_VEC_BYTES (ROUND_UP(BITS_N_FP_CT_RNG,8)/8)
+/* samples u_prime out of CSPRNG_FP_VEC_BYTES bytes already extracted from a CSPRNG */
+static inline
+void csprng_fp_vec_from_buffer(FP_ELEM res[N],
+                               const uint8_t CSPRNG_buffer[CSPRNG_FP_VEC_BYTES]){
+    const FP_ELEM mask = ( (FP_ELEM) 1 << BITS_FOR_P) - 1;
+    /* To facilitate hardware implementations, the uint64_t 
+     * sub-buffer is consumed starting from the least significant byte 
+     * i.e., from the first being output by SHAKE. Bits in the byte are 
+     * discarded shifting them out to the right, shifting fresh ones
+     * in from the left end */
+    int placed = 0;
+    uint64_t sub_buffer = 0;
+    for (int i=0; i<8; i++) {
+        sub_buffer |= ((uint64_t) CSPRNG_buffer[i]) << 8*i;
+    }
+    /* position of the next fresh byte in CSPRNG_buffer*/
+    int bits_in_sub_buf = 64;
+    int pos_in_buf = 8;
+    int pos_remaining = CSPRNG_FP_VEC_BYTES - pos_in_buf;
+    while(placed < N) {
+        if (bits_in_sub_buf <= 32 && pos_remaining > 0) {
+            /* get at most 4 bytes from buffer */
+            int refresh_amount = (pos_remaining >= 4) ? 4 : pos_remaining; 
+            uint32_t refresh_buf = 0;
+            for (int i=0; i<refresh_amount; i++) {
+                refresh_buf |= ((uint32_t)CSPRNG_buffer[pos_in_buf+i]) << 8*i;
+            }
+            pos_in_buf += refresh_amount;
+            sub_buffer |=  ((uint64_t) refresh_buf) << bits_in_sub_buf;
+            bits_in_sub_buf += 8*refresh_amount; 
+            pos_remaining -= refresh_amount;
+        }
+        res[placed] = sub_buffer & mask;
+        if (res[placed] < P) {
+           placed++;
+        }
+        sub_buffer = sub_buffer >> BITS_FOR_P;
+        bits_in_sub_buf -= BITS_FOR_P;
+    }
+}
 
 static inline
 void csprng_fp_vec(FP_ELEM res[N],
-                   CSPRNG_STATE_T *const csprng_state) {
-	const FP_ELEM mask = ( (FP_ELEM) 1 << BITS_FOR_P) - 1;
-	uint8_t CSPRNG_buffer[ROUND_UP(BITS_N_FP_CT_RNG, 8) / 8];
-	/* To facilitate hardware implementations, the uint64_t
-	 * sub-buffer is consumed starting from the least significant byte
-	 * i.e., from the first being output by SHAKE. Bits in the byte are
-	 * discarded shifting them out to the right, shifting fresh ones
-	 * in from the left end */
-	csprng_randombytes(CSPRNG_buffer, sizeof(CSPRNG_buffer), csprng_state);
-	int placed = 0;
-	uint64_t sub_buffer = 0;
-	for (int i = 0; i < 8; i++) {
-		sub_buffer |= ((uint64_t) CSPRNG_buffer[i]) << 8 * i;
-	}
-	/* position of the next fresh byte in CSPRNG_buffer*/
-	int bits_in_sub_buf = 64;
-	int pos_in_buf = 8;
-	int pos_remaining = sizeof(CSPRNG_buffer) - pos_in_buf;
-	while (placed < N) {
-		if (bits_in_sub_buf <= 32 && pos_remaining > 0) {
-			/* get at most 4 bytes from buffer */
-			int refresh_amount = (pos_remaining >= 4) ? 4 : pos_remaining;
-			uint32_t refresh_buf = 0;
-			for (int i = 0; i < refresh_amount; i++) {
-				refresh_buf |= ((uint32_t)CSPRNG_buffer[pos_in_buf + i]) << 8 * i;
-			}
-			pos_in_buf += refresh_amount;
-			sub_buffer |=  ((uint64_t) refresh_buf) << bits_in_sub_buf;
-			bits_in_sub_buf += 8 * refresh_amount;
-			pos_remaining -= refresh_amount;
-		}
-		res[placed] = sub_buffer & mask;
-		if (res[placed] < P) {
-			placed++;
-		}
-		sub_buffer = sub_buffer >> BITS_FOR_P;
-		bits_in_sub_buf -= BITS_FOR_P;
-	}
-}
-
-#define BITS_FOR_P_M_ONE BITS_TO_REPRESENT(P-2)
+                   CSPRNG_STATE_T * const csprng_state){
+    uint8_t CSPRNG_buffer[CSPRNG_FP_VEC_BYTES];
+    csprng_randombytes(CSPRNG_buffer,sizeof(CSPRNG_buffer),csprng_state);
+    csprng_fp_vec_from_buffer(res, CSPRNG_buffer);
+}
+
+#define BITS_FOR_P_M_ONE BITS_TO_REPRESENT(P-2) 
 
 static inline
 void csprng_fp_vec_chall_1(FP_ELEM res[T],
-                           CSPRNG_STATE_T *const csprng_state) {
-	const FP_ELEM mask = ( (FP_ELEM) 1 << BITS_FOR_P_M_ONE) - 1;
-	uint8_t CSPRNG_buffer[ROUND_UP(BITS_CHALL_1_FPSTAR_CT_RNG, 8) / 8];
-	/* To facilitate hardware implementations, the uint64_t
-	 * sub-buffer is consumed starting from the least significant byte
-	 * i.e., from the first being output by SHAKE. Bits in the byte are
-	 * discarded shifting them out to the right , shifting fresh ones
-	 * in from the left end */
-	csprng_randombytes(CSPRNG_buffer, sizeof(CSPRNG_buffer), csprng_state);
-	int placed = 0;
-	uint64_t sub_buffer = 0;
-	for (int i = 0; i < 8; i++) {
-		sub_buffer |= ((uint64_t) CSPRNG_buffer[i]) << 8 * i;
-	}
+                   CSPRNG_STATE_T * const csprng_state){
+    const FP_ELEM mask = ( (FP_ELEM) 1 << BITS_FOR_P_M_ONE) - 1;
+    uint8_t CSPRNG_buffer[ROUND_UP(BITS_CHALL_1_FPSTAR_CT_RNG,8)/8];
+    /* To facilitate hardware implementations, the uint64_t 
+     * sub-buffer is consumed starting from the least significant byte 
+     * i.e., from the first being output by SHAKE. Bits in the byte are 
+     * discarded shifting them out to the right , shifting fresh ones
+     * in from the left end */
+    csprng_randombytes(CSPRNG_buffer,sizeof(CSPRNG_buffer),csprng_state);    
+    int placed = 0;
+    uint64_t sub_buffer = 0;
+    for (int i=0; i<8; i++) {
+        sub_buffer |= ((uint64_t) CSPRNG_buffer[i]) << 8*i;
+    }
+    /* position of the next fresh byte in CSPRNG_buffer*/
+    int bits_in_sub_buf = 64;
+    int pos_in_buf = 8;
+    int pos_remaining = sizeof(CSPRNG_buffer) - pos_in_buf;
+    while(placed < T) {
+        if (bits_in_sub_buf <= 32 && pos_remaining > 0) {
+            /* get at most 4 bytes from buffer */
+            int refresh_amount = (pos_remaining >= 4) ? 4 : pos_remaining; 
+            uint32_t refresh_buf = 0;
+            for (int i=0; i<refresh_amount; i++) {
+                refresh_buf |= ((uint32_t)CSPRNG_buffer[pos_in_buf+i]) << 8*i;
+            }
+            pos_in_buf += refresh_amount;
+            sub_buffer |=  ((uint64_t) refresh_buf) << bits_in_sub_buf;
+            bits_in_sub_buf += 8*refresh_amount; 
+            pos_remaining -= refresh_amount;
+        }
+        /* draw from 0 ... P-2, then add 1*/
+        res[placed] = (sub_buffer & mask)+1;
+        if (res[placed] < P) {
+           placed++;
+        }
+        sub_buffer = sub_buffer >> BITS_FOR_P_M_ONE;
+        bits_in_sub_buf -= BITS_FOR_P_M_ONE;
+    }
+}
+
+#define CSPRNG_FP_MAT_BYTES (ROUND_UP(BITS_V_CT_RNG,8)/8)
+/* samples V_tr out of CSPRNG_FP_MAT_BYTES bytes already extracted from a CSPRNG */
+static inline
+void csprng_fp_mat_from_buffer(V_TR_ELEM res[K][V_TR_COLS],
+                               const uint8_t CSPRNG_buffer[CSPRNG_FP_MAT_BYTES]){
+    const FP_ELEM mask = ( (FP_ELEM) 1 << BITS_TO_REPRESENT(P-1)) - 1;
+    /* To facilitate hardware implementations, the uint64_t 
+     * sub-buffer is consumed starting from the least significant byte 
+     * i.e., from the first being output by SHAKE. Bits in the byte are 
+     * discarded shifting them out to the right , shifting fresh ones
+     * in from the left end */
+    int placed = 0;
+    uint64_t sub_buffer = 0;
+    for (int i=0; i<8; i++) {
+        sub_buffer |= ((uint64_t) CSPRNG_buffer[i]) << 8*i;
+    }
 	/* position of the next fresh byte in CSPRNG_buffer*/
-	int bits_in_sub_buf = 64;
-	int pos_in_buf = 8;
-	int pos_remaining = sizeof(CSPRNG_buffer) - pos_in_buf;
-	while (placed < T) {
-		if (bits_in_sub_buf <= 32 && pos_remaining > 0) {
-			/* get at most 4 bytes from buffer */
-			int refresh_amount = (pos_remaining >= 4) ? 4 : pos_remaining;
-			uint32_t refresh_buf = 0;
-			for (int i = 0; i < refresh_amount; i++) {
-				refresh_buf |= ((uint32_t)CSPRNG_buffer[pos_in_buf + i]) << 8 * i;
-			}
-			pos_in_buf += refresh_amount;
-			sub_buffer |=  ((uint64_t) refresh_buf) << bits_in_sub_buf;
-			bits_in_sub_buf += 8 * refresh_amount;
-			pos_remaining -= refresh_amount;
-		}
-		/* draw from 0 ... P-2, then add 1*/
-		res[placed] = (sub_buffer & mask) + 1;
-		if (res[placed] < P) {
-			placed++;
-		}
-		sub_buffer = sub_buffer >> BITS_FOR_P_M_ONE;
-		bits_in_sub_buf -= BITS_FOR_P_M_ONE;
-	}
-}
-
-static inline
-void csprng_fp_mat(FP_ELEM res[K][N - K],
-                   CSPRNG_STATE_T *const csprng_state) {
-	const FP_ELEM mask = ( (FP_ELEM) 1 << BITS_TO_REPRESENT(P - 1)) - 1;
-	uint8_t CSPRNG_buffer[ROUND_UP(BITS_V_CT_RNG, 8) / 8];
-	/* To facilitate hardware implementations, the uint64_t
-	 * sub-buffer is consumed starting from the least significant byte
-	 * i.e., from the first being output by SHAKE. Bits in the byte are
-	 * discarded shifting them out to the right , shifting fresh ones
-	 * in from the left end */
-	csprng_randombytes(CSPRNG_buffer, sizeof(CSPRNG_buffer), csprng_state);
-	int placed = 0;
-	uint64_t sub_buffer = 0;
-	for (int i = 0; i < 8; i++) {
-		sub_buffer |= ((uint64_t) CSPRNG_buffer[i]) << 8 * i;
-	}
+    int bits_in_sub_buf = 64;
+    int pos_in_buf = 8;
+    int pos_remaining = CSPRNG_FP_MAT_BYTES - pos_in_buf;
+    for (int row = 0; row < K; row++) {
+        for (int col = N-K; col < V_TR_COLS; col++) {
+            res[row][col] = 0;
+        }
+    }
+    int row = 0, col = 0;
+    while(placed < K*(N-K)) {
+        if (bits_in_sub_buf <= 32 && pos_remaining > 0) {
+            /* get at most 4 bytes from buffer */
+            int refresh_amount = (pos_remaining >= 4) ? 4 : pos_remaining; 
+            uint32_t refresh_buf = 0;
+            for (int i=0; i<refresh_amount; i++) {
+                refresh_buf |= ((uint32_t)CSPRNG_buffer[pos_in_buf+i]) << 8*i;
+            }
+            pos_in_buf += refresh_amount;
+            sub_buffer |=  ((uint64_t) refresh_buf) << bits_in_sub_buf;
+            bits_in_sub_buf += 8*refresh_amount; 
+            pos_remaining -= refresh_amount;
+        }
+        FP_ELEM elem = sub_buffer & mask;
+        if (elem < P) {
+           res[row][col] = elem;
+           placed++;
+           col++;
+           if (col == N-K) {
+              col = 0;
+              row++;
+           }
+        }
+        sub_buffer = sub_buffer >> BITS_FOR_P;
+        bits_in_sub_buf -= BITS_FOR_P;
+    }   
+}
+
+static inline
+void csprng_fp_mat(V_TR_ELEM res[K][V_TR_COLS],
+                   CSPRNG_STATE_T * const csprng_state){
+    uint8_t CSPRNG_buffer[CSPRNG_FP_MAT_BYTES];
+    csprng_randombytes(CSPRNG_buffer,sizeof(CSPRNG_buffer),csprng_state);
+    csprng_fp_mat_from_buffer(res, CSPRNG_buffer);
+}
+
+#define CSPRNG_FZ_INF_W_BYTES (ROUND_UP(BITS_M_FZ_CT_RNG,8)/8)
+/* samples e_G_bar out of CSPRNG_FZ_INF_W_BYTES bytes already extracted from a CSPRNG */
+static inline
+void csprng_fz_inf_w_from_buffer(FZ_ELEM res[M],
+                                 const uint8_t CSPRNG_buffer[CSPRNG_FZ_INF_W_BYTES]){
+    const FZ_ELEM mask = ( (FZ_ELEM) 1 << BITS_TO_REPRESENT(Z-1)) - 1;
+    /* To facilitate hardware implementations, the uint64_t 
+     * sub-buffer is consumed starting from the least significant byte 
+     * i.e., from the first being output by SHAKE. Bits in the byte are 
+     * discarded shifting them out to the right , shifting fresh ones
+     * in from the left end */
+    int placed = 0;
+    uint64_t sub_buffer = 0;
+    for (int i=0; i<8; i++) {
+        sub_buffer |= ((uint64_t) CSPRNG_buffer[i]) << 8*i;
+    }
 	/* position of the next fresh byte in CSPRNG_buffer*/
-	int bits_in_sub_buf = 64;
-	int pos_in_buf = 8;
-	int pos_remaining = sizeof(CSPRNG_buffer) - pos_in_buf;
-	while (placed < K * (N - K)) {
-		if (bits_in_sub_buf <= 32 && pos_remaining > 0) {
-			/* get at most 4 bytes from buffer */
-			int refresh_amount = (pos_remaining >= 4) ? 4 : pos_remaining;
-			uint32_t refresh_buf = 0;
-			for (int i = 0; i < refresh_amount; i++) {
-				refresh_buf |= ((uint32_t)CSPRNG_buffer[pos_in_buf + i]) << 8 * i;
-			}
-			pos_in_buf += refresh_amount;
-			sub_buffer |=  ((uint64_t) refresh_buf) << bits_in_sub_buf;
-			bits_in_sub_buf += 8 * refresh_amount;
-			pos_remaining -= refresh_amount;
-		}
-		*((FP_ELEM *)res + placed) = sub_buffer & mask;
-		if (*((FP_ELEM *)res + placed) < P) {
-			placed++;
-		}
-		sub_buffer = sub_buffer >> BITS_FOR_P;
-		bits_in_sub_buf -= BITS_FOR_P;
-	}
+    int bits_in_sub_buf = 64;
+    int pos_in_buf = 8;
+    int pos_remaining = CSPRNG_FZ_INF_W_BYTES - pos_in_buf;
+    while(placed < M) {
+        if (bits_in_sub_buf <= 32 && pos_remaining > 0) {
+            /* get at most 4 bytes from buffer */
+            int refresh_amount = (pos_remaining >= 4) ? 4 : pos_remaining; 
+            uint32_t refresh_buf = 0;
+            for (int i=0; i<refresh_amount; i++) {
+                refresh_buf |= ((uint32_t)CSPRNG_buffer[pos_in_buf+i]) << 8*i;
+            }
+            pos_in_buf += refresh_amount;
+            sub_buffer |=  ((uint64_t) refresh_buf) << bits_in_sub_buf;
+            bits_in_sub_buf += 8*refresh_amount; 
+            pos_remaining -= refresh_amount;
+        }
+        res[placed] = sub_buffer & mask;
+        if (res[placed] < Z) {
+           placed++;
+        }
+        sub_buffer = sub_buffer >> BITS_FOR_Z;
+        bits_in_sub_buf -= BITS_FOR_Z;
+    }
 }
 
 static inline
 void csprng_fz_inf_w(FZ_ELEM res[M],
-                     CSPRNG_STATE_T *const csprng_state) {
-	const FZ_ELEM mask = ( (FZ_ELEM) 1 << BITS_TO_REPRESENT(Z - 1)) - 1;
-	uint8_t CSPRNG_buffer[ROUND_UP(BITS_M_FZ_CT_RNG, 8) / 8];
-	/* To facilitate hardware implementations, the uint64_t
-	 * sub-buffer is consumed starting from the least significant byte
-	 * i.e., from the first being output by SHAKE. Bits in the byte are
-	 * discarded shifting them out to the right , shifting fresh ones
-	 * in from the left end */
-	csprng_randombytes(CSPRNG_buffer, sizeof(CSPRNG_buffer), csprng_state);
-	int placed = 0;
-	uint64_t sub_buffer = 0;
-	for (int i = 0; i < 8; i++) {
-		sub_buffer |= ((uint64_t) CSPRNG_buffer[i]) << 8 * i;
-	}
-	/* position of the next fresh byte in CSPRNG_buffer*/
-	int bits_in_sub_buf = 64;
-	int pos_in_buf = 8;
-	int pos_remaining = sizeof(CSPRNG_buffer) - pos_in_buf;
-	while (placed < M) {
-		if (bits_in_sub_buf <= 32 && pos_remaining > 0) {
-			/* get at most 4 bytes from buffer */
-			int refresh_amount = (pos_remaining >= 4) ? 4 : pos_remaining;
-			uint32_t refresh_buf = 0;
-			for (int i = 0; i < refresh_amount; i++) {
-				refresh_buf |= ((uint32_t)CSPRNG_buffer[pos_in_buf + i]) << 8 * i;
-			}
-			pos_in_buf += refresh_amount;
-			sub_buffer |=  ((uint64_t) refresh_buf) << bits_in_sub_buf;
-			bits_in_sub_buf += 8 * refresh_amount;
-			pos_remaining -= refresh_amount;
-		}
-		res[placed] = sub_buffer & mask;
-		if (res[placed] < Z) {
-			placed++;
-		}
-		sub_buffer = sub_buffer >> BITS_FOR_Z;
-		bits_in_sub_buf -= BITS_FOR_Z;
-	}
-}
-
-static inline
-void csprng_fz_mat(FZ_ELEM res[M][N - M],
-                   CSPRNG_STATE_T *const csprng_state) {
-	const FZ_ELEM mask = ( (FZ_ELEM) 1 << BITS_TO_REPRESENT(Z - 1)) - 1;
-	uint8_t CSPRNG_buffer[ROUND_UP(BITS_W_CT_RNG, 8) / 8];
-	/* To facilitate hardware implementations, the uint64_t
-	 * sub-buffer is consumed starting from the least significant byte
-	 * i.e., from the first being output by SHAKE. Bits in the byte are
-	 * discarded shifting them out to the right , shifting fresh ones
-	 * in from the left end */
-	csprng_randombytes(CSPRNG_buffer, sizeof(CSPRNG_buffer), csprng_state);
-
-	int placed = 0;
-	uint64_t sub_buffer = 0;
-	for (int i = 0; i < 8; i++) {
-		sub_buffer |= ((uint64_t) CSPRNG_buffer[i]) << 8 * i;
-	}
+                     CSPRNG_STATE_T * const csprng_state){
+    uint8_t CSPRNG_buffer[CSPRNG_FZ_INF_W_BYTES];
+    csprng_randombytes(CSPRNG_buffer,sizeof(CSPRNG_buffer),csprng_state);
+    csprng_fz_inf_w_from_buffer(res, CSPRNG_buffer);
+}
+
+#define CSPRNG_FZ_MAT_BYTES (ROUND_UP(BITS_W_CT_RNG,8)/8)
+/* samples W_mat out of CSPRNG_FZ_MAT_BYTES bytes already extracted from a CSPRNG */
+static inline
+void csprng_fz_mat_from_buffer(FZ_ELEM res[M][N-M],
+                               const uint8_t CSPRNG_buffer[CSPRNG_FZ_MAT_BYTES]){
+    const FZ_ELEM mask = ( (FZ_ELEM) 1 << BITS_TO_REPRESENT(Z-1)) - 1;
+    /* To facilitate hardware implementations, the uint64_t 
+     * sub-buffer is consumed starting from the least significant byte 
+     * i.e., from the first being output by SHAKE. Bits in the byte are 
+     * discarded shifting them out to the right , shifting fresh ones
+     * in from the left end */
+    int placed = 0;
+    uint64_t sub_buffer = 0;
+    for (int i=0; i<8; i++) {
+        sub_buffer |= ((uint64_t) CSPRNG_buffer[i]) << 8*i;
+    }
 	/* position of the next fresh byte in CSPRNG_buffer*/
-	int bits_in_sub_buf = 64;
-	int pos_in_buf = 8;
-	int pos_remaining = sizeof(CSPRNG_buffer) - pos_in_buf;
-	while (placed < M * (N - M)) {
-		if (bits_in_sub_buf <= 32 && pos_remaining > 0) {
-			/* get at most 4 bytes from buffer */
-			int refresh_amount = (pos_remaining >= 4) ? 4 : pos_remaining;
-			uint32_t refresh_buf = 0;
-			for (int i = 0; i < refresh_amount; i++) {
-				refresh_buf |= ((uint32_t)CSPRNG_buffer[pos_in_buf + i]) << 8 * i;
-			}
-			pos_in_buf += refresh_amount;
-			sub_buffer |=  ((uint64_t) refresh_buf) << bits_in_sub_buf;
-			bits_in_sub_buf += 8 * refresh_amount;
-			pos_remaining -= refresh_amount;
-		}
-		*((FZ_ELEM *)res + placed) = sub_buffer & mask;
-		if (*((FZ_ELEM *)res + placed) < Z) {
-			placed++;
-		}
-		sub_buffer = sub_buffer >> BITS_FOR_Z;
-		bits_in_sub_buf -= BITS_FOR_Z;
-	}
+    int bits_in_sub_buf = 64;
+    int pos_in_buf = 8;
+    int pos_remaining = CSPRNG_FZ_MAT_BYTES - pos_in_buf;
+    while(placed < M*(N-M)) {
+        if (bits_in_sub_buf <= 32 && pos_remaining > 0) {
+            /* get at most 4 bytes from buffer */
+            int refresh_amount = (pos_remaining >= 4) ? 4 : pos_remaining; 
+            uint32_t refresh_buf = 0;
+            for (int i=0; i<refresh_amount; i++) {
+                refresh_buf |= ((uint32_t)CSPRNG_buffer[pos_in_buf+i]) << 8*i;
+            }
+            pos_in_buf += refresh_amount;
+            sub_buffer |=  ((uint64_t) refresh_buf) << bits_in_sub_buf;
+            bits_in_sub_buf += 8*refresh_amount; 
+            pos_remaining -= refresh_amount;
+        }
+        *((FZ_ELEM*)res+placed) = sub_buffer & mask;
+        if (*((FZ_ELEM*)res+placed) < Z) {
+           placed++;
+        }
+        sub_buffer = sub_buffer >> BITS_FOR_Z;
+        bits_in_sub_buf -= BITS_FOR_Z;
+    }    
+}
+
+static inline
+void csprng_fz_mat(FZ_ELEM res[M][N-M],
+                   CSPRNG_STATE_T * const csprng_state){
+    uint8_t CSPRNG_buffer[CSPRNG_FZ_MAT_BYTES];
+    csprng_randombytes(CSPRNG_buffer,sizeof(CSPRNG_buffer),csprng_state);
+    csprng_fz_mat_from_buffer(res, CSPRNG_buffer);
+}
+
+/************** Variable-time sampling, for public values only ***************/
+
+/* bytes extracted from the CSPRNG per Keccak permutation, the SHAKE rate */
+#define CSPRNG_BLOCK_BYTES 168
+
+/* The samplers above extract from the CSPRNG, up front, the amount of bytes
+ * (ct_bytes) which suffices to their rejection sampling in all but a
+ * negligible fraction of the cases, so that their timing does not depend on
+ * the values sampled. When the values are public, e.g., the matrices
+ * expanded from seed_pk and the first challenge, the bytes are rather
+ * extracted one block at a time, as long as more candidates are needed.
+ * The bits are consumed in the same order and out of the same ct_bytes,
+ * thus the values are the same as the ones of the constant-time samplers */
+typedef struct {
+    CSPRNG_STATE_T *csprng_state;
+    uint8_t block[CSPRNG_BLOCK_BYTES];
+    int pos_in_block;
+    int block_len;
+    /* bytes out of ct_bytes not yet extracted from the CSPRNG */
+    int to_extract;
+    uint64_t sub_buffer;
+    int bits_in_sub_buf;
+    /* bytes out of ct_bytes not yet moved into sub_buffer */
+    int pos_remaining;
+} csprng_lazy_t;
+
+static inline
+uint8_t csprng_lazy_byte(csprng_lazy_t *const lazy){
+    if (lazy->pos_in_block == lazy->block_len) {
+        lazy->block_len = (lazy->to_extract < CSPRNG_BLOCK_BYTES) ? lazy->to_extract : CSPRNG_BLOCK_BYTES;
+        csprng_randombytes(lazy->block, lazy->block_len, lazy->csprng_state);
+        lazy->to_extract -= lazy->block_len;
+        lazy->pos_in_block = 0;
+    }
+    return lazy->block[lazy->pos_in_block++];
+}
+
+static inline
+void csprng_lazy_init(csprng_lazy_t *const lazy,
+                      CSPRNG_STATE_T * const csprng_state,
+                      const int ct_bytes){
+    lazy->csprng_state = csprng_state;
+    lazy->pos_in_block = 0;
+    lazy->block_len = 0;
+    lazy->to_extract = ct_bytes;
+    lazy->sub_buffer = 0;
+    for (int i=0; i<8; i++) {
+        lazy->sub_buffer |= ((uint64_t) csprng_lazy_byte(lazy)) << 8*i;
+    }
+    lazy->bits_in_sub_buf = 64;
+    lazy->pos_remaining = ct_bytes - 8;
+}
+
+/* refills sub_buffer as the constant-time samplers do */
+static inline
+void csprng_lazy_refill(csprng_lazy_t *const lazy){
+    if (lazy->bits_in_sub_buf <= 32 && lazy->pos_remaining > 0) {
+        /* get at most 4 bytes from the CSPRNG */
+        int refresh_amount = (lazy->pos_remaining >= 4) ? 4 : lazy->pos_remaining;
+        uint32_t refresh_buf = 0;
+        for (int i=0; i<refresh_amount; i++) {
+            refresh_buf |= ((uint32_t)csprng_lazy_byte(lazy)) << 8*i;
+        }
+        lazy->sub_buffer |= ((uint64_t) refresh_buf) << lazy->bits_in_sub_buf;
+        lazy->bits_in_sub_buf += 8*refresh_amount;
+        lazy->pos_remaining -= refresh_amount;
+    }
+}
+
+static inline
+void csprng_lazy_drop(csprng_lazy_t *const lazy, const int bits){
+    lazy->sub_buffer = lazy->sub_buffer >> bits;
+    lazy->bits_in_sub_buf -= bits;
+}
+
+/* extracts the rest of ct_bytes, leaving the CSPRNG as the constant-time
+ * sampler does, for it to be employed further */
+static inline
+void csprng_lazy_complete(csprng_lazy_t *const lazy){
+    while (lazy->to_extract > 0) {
+        int len = (lazy->to_extract < CSPRNG_BLOCK_BYTES) ? lazy->to_extract : CSPRNG_BLOCK_BYTES;
+        csprng_randombytes(lazy->block, len, lazy->csprng_state);
+        lazy->to_extract -= len;
+    }
+}
+
+/* csprng_fp_vec_chall_1 for a public digest; the CSPRNG is left with less
+ * bytes extracted, it is only to be released afterwards */
+static inline
+void csprng_fp_vec_chall_1_lazy(FP_ELEM res[T],
+                                CSPRNG_STATE_T * const csprng_state){
+    const FP_ELEM mask = ( (FP_ELEM) 1 << BITS_FOR_P_M_ONE) - 1;
+    csprng_lazy_t lazy;
+    csprng_lazy_init(&lazy, csprng_state, ROUND_UP(BITS_CHALL_1_FPSTAR_CT_RNG,8)/8);
+    int placed = 0;
+    while(placed < T) {
+        csprng_lazy_refill(&lazy);
+        /* draw from 0 ... P-2, then add 1*/
+        res[placed] = (lazy.sub_buffer & mask)+1;
+        if (res[placed] < P) {
+           placed++;
+        }
+        csprng_lazy_drop(&lazy, BITS_FOR_P_M_ONE);
+    }
+}
+
+/* csprng_fp_mat for a public seed; the CSPRNG is left with less bytes
+ * extracted, it is only to be released afterwards */
+static inline
+void csprng_fp_mat_lazy(V_TR_ELEM res[K][V_TR_COLS],
+                        CSPRNG_STATE_T * const csprng_state){
+    const FP_ELEM mask = ( (FP_ELEM) 1 << BITS_TO_REPRESENT(P-1)) - 1;
+    csprng_lazy_t lazy;
+    csprng_lazy_init(&lazy, csprng_state, CSPRNG_FP_MAT_BYTES);
+    for (int row = 0; row < K; row++) {
+        for (int col = N-K; col < V_TR_COLS; col++) {
+            res[row][col] = 0;
+        }
+    }
+    int placed = 0;
+    int row = 0, col = 0;
+    while(placed < K*(N-K)) {
+        csprng_lazy_refill(&lazy);
+        FP_ELEM elem = lazy.sub_buffer & mask;
+        if (elem < P) {
+           res[row][col] = elem;
+           placed++;
+           col++;
+           if (col == N-K) {
+              col = 0;
+              row++;
+           }
+        }
+        csprng_lazy_drop(&lazy, BITS_FOR_P);
+    }
+}
+
+/* csprng_fz_mat for a public seed, leaving the CSPRNG as csprng_fz_mat
+ * does: it saves the buffer, not the Keccak permutations */
+static inline
+void csprng_fz_mat_lazy(FZ_ELEM res[M][N-M],
+                        CSPRNG_STATE_T * const csprng_state){
+    const FZ_ELEM mask = ( (FZ_ELEM) 1 << BITS_TO_REPRESENT(Z-1)) - 1;
+    csprng_lazy_t lazy;
+    csprng_lazy_init(&lazy, csprng_state, CSPRNG_FZ_MAT_BYTES);
+    int placed = 0;
+    while(placed < M*(N-M)) {
+        csprng_lazy_refill(&lazy);
+        *((FZ_ELEM*)res+placed) = lazy.sub_buffer & mask;
+        if (*((FZ_ELEM*)res+placed) < Z) {
+           placed++;
+        }
+        csprng_lazy_drop(&lazy, BITS_FOR_Z);
+    }
+    csprng_lazy_complete(&lazy);
 }
@@ -5,14 +5,14 @@
  * @version 2.0 (February 2025)
  *
  * Authors listed in alphabetical order:
- *
+ * 
  * @author: Alessandro Barenghi <alessandro.barenghi@polimi.it>
  * @author: Marco Gianvecchio <marco.gianvecchio@mail.polimi.it>
  * @author: Patrick Karl <patrick.karl@tum.de>
  * @author: Gerardo Pelosi <gerardo.pelosi@polimi.it>
  * @author: Jonas Schupp <jonas.schupp@tum.de>
- *
- *
+ * 
+ * 
  * This code is hereby placed in the public domain.
  *
  * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ''AS IS'' AND ANY EXPRESS
@@ -31,6 +31,7 @@
 
 #pragma once
 
+#include "architecture_detect.h"
 #include "parameters.h"
 
 #define FZRED_SINGLE(x)   (((x) & 0x7f) + ((x) >> 7))
@@ -38,11 +39,53 @@
 #define FZRED_OPPOSITE(x) ((x) ^ 0x7f)
 #define FZ_DOUBLE_ZERO_NORM(x) (((x) + (((x) + 1) >> 7)) & 0x7f)
 
+#define NUM_BITS_Z (BITS_TO_REPRESENT(Z))
+
+/* Mersenne reduction modulo 2^nbits-1 of 32 bytes packed in a register, i.e.,
+ * FZRED_SINGLE resp. FPRED_SINGLE in RSDP. No _mm256_srli_epi8 is available:
+ * the 16-bit shift drags in bits from the adjacent byte, which are masked off */
+static inline
+__m256i mersenne_red_single_epi8(__m256i x, int nbits){
+    __m256i mred_mask = _mm256_set1_epi8((uint8_t)((1 << nbits) - 1));
+    __m256i shr_mask = _mm256_set1_epi8((uint8_t)(0xFF >> nbits));
+    __m256i hi = _mm256_and_si256(_mm256_srli_epi16(x, nbits), shr_mask);
+    return _mm256_add_epi8(_mm256_and_si256(x, mred_mask), hi);
+}
+
+/* Normalization of the redundant zero representation of 32 packed bytes, i.e.,
+ * FZ_DOUBLE_ZERO_NORM resp. FP_DOUBLE_ZERO_NORM in RSDP. To avoid the
+ * overflow of x+1 in 8-bit lanes, (x+1) >> nbits is computed as
+ * (x >> nbits) + ((x & mask) == mask) */
+static inline
+__m256i mersenne_dz_norm_epi8(__m256i x, int nbits){
+    __m256i mred_mask = _mm256_set1_epi8((uint8_t)((1 << nbits) - 1));
+    __m256i shr_mask = _mm256_set1_epi8((uint8_t)(0xFF >> nbits));
+    __m256i one = _mm256_set1_epi8(1);
+    __m256i hi = _mm256_and_si256(_mm256_srli_epi16(x, nbits), shr_mask);
+    __m256i carry = _mm256_cmpeq_epi8(_mm256_and_si256(x, mred_mask), mred_mask);
+    hi = _mm256_add_epi8(hi, _mm256_and_si256(carry, one));
+    return _mm256_and_si256(_mm256_add_epi8(x, hi), mred_mask);
+}
+
+/* a - b over 32 packed restricted exponents */
+static inline
+__m256i fz_sub_epi8(__m256i a, __m256i b){
+    __m256i mred_mask = _mm256_set1_epi8((uint8_t)Z);
+    return mersenne_red_single_epi8(
+               _mm256_add_epi8(a, _mm256_xor_si256(b, mred_mask)), NUM_BITS_Z);
+}
+
 static inline
-void fz_dz_norm_n(FZ_ELEM v[N]) {
-	for (int i = 0; i < N; i++) {
-		v[i] = FZ_DOUBLE_ZERO_NORM(v[i]);
-	}
+void fz_dz_norm_n(FZ_ELEM v[N]){
+    int i;
+    for (i = 0; i+EPI8_PER_REG <= N; i += EPI8_PER_REG){
+        __m256i v_w = _mm256_lddqu_si256((__m256i const *) &v[i]);
+        v_w = mersenne_dz_norm_epi8(v_w, NUM_BITS_Z);
+        _mm256_storeu_si256((__m256i *) &v[i], v_w);
+    }
+    for (; i < N; i++){
+       v[i] = FZ_DOUBLE_ZERO_NORM(v[i]);
+    }
 }
 
 /* Elements of the restricted subgroups are represented as the exponents of
@@ -50,19 +93,25 @@ void fz_dz_norm_n(FZ_ELEM v[N]) {
 static inline
 void fz_vec_sub_n(FZ_ELEM res[N],
                   const FZ_ELEM a[N],
-                  const FZ_ELEM b[N]) {
-	for (int i = 0; i < N; i++) {
-		res[i] = FZRED_SINGLE( a[i] + FZRED_OPPOSITE(b[i]) );
-	}
+                  const FZ_ELEM b[N]){
+    int i;
+    for(i = 0; i+EPI8_PER_REG <= N; i += EPI8_PER_REG){
+        __m256i a_w = _mm256_lddqu_si256((__m256i const *) &a[i]);
+        __m256i b_w = _mm256_lddqu_si256((__m256i const *) &b[i]);
+        _mm256_storeu_si256((__m256i *) &res[i], fz_sub_epi8(a_w, b_w));
+    }
+    for(; i < N; i++){
+        res[i]= FZRED_SINGLE( a[i] + FZRED_OPPOSITE(b[i]) );
+    }
 }
 
 static inline
-int is_fz_vec_in_restr_group_n(const FZ_ELEM in[N]) {
-	int is_in_ok = 1;
-	for (int i = 0; i < N; i++) {
-		is_in_ok = is_in_ok && (in[i] < Z);
-	}
-	return is_in_ok;
+int is_fz_vec_in_restr_group_n(const FZ_ELEM in[N]){
+    int is_in_ok = 1;
+    for(int i=0; i<N; i++){
+        is_in_ok = is_in_ok && (in[i] < Z);
+    }
+    return is_in_ok;
 }
 
 /* computes the information word * M_G product to obtain an element of G
@@ -71,56 +120,69 @@ int is_fz_vec_in_restr_group_n(const FZ_ELEM in[N]) {
 static inline
 void fz_inf_w_by_fz_matrix(FZ_ELEM res[N],
                            const FZ_ELEM e[M],
-                           /* although W_mat is constant, it is dynamically
+                           /* although W_mat is constant, it is dynamically 
                             * expanded, ISO C11 forbids const here */
-                           uint16_t W_mat[M][ROUND_UP(N - M, EPI16_PER_REG)]) {
-	alignas(EPI8_PER_REG)FZ_DOUBLEPREC res_dprec[ROUND_UP(N - M, EPI16_PER_REG)] = {0};
-	__m256i mred_mask = _mm256_set1_epi16 (0x007f);
-	for (int i = 0; i < M; i++) {
-		for (int j = 0; j < ROUND_UP(N - M, EPI16_PER_REG) / EPI16_PER_REG; j++) {
-			__m256i res_w = _mm256_load_si256(
-			                    (__m256i const *) &res_dprec[j * EPI16_PER_REG] );
-			__m256i e_coeff = _mm256_set1_epi16(e[i]);
-			__m256i W_mat_slice = _mm256_lddqu_si256(
-			                          (__m256i const *) &W_mat[i][j * EPI16_PER_REG] );
-			__m256i tmp = _mm256_mullo_epi16(e_coeff, W_mat_slice);
-			/* Vector Mersenne reduction */
-			__m256i tmp2 = _mm256_and_si256 (tmp, mred_mask);
-			tmp = _mm256_srli_epi16(tmp, 7);
-			tmp = _mm256_add_epi16(tmp, tmp2);
-			res_w = _mm256_add_epi16(res_w, tmp);
-			/* store back*/
-			_mm256_store_si256 ((__m256i *) &res_dprec[j * EPI16_PER_REG], res_w);
-		}
-	}
+                           uint16_t W_mat[M][ROUND_UP(N-M,EPI16_PER_REG)]){
+    alignas(EPI8_PER_REG)FZ_DOUBLEPREC res_dprec[ROUND_UP(N-M,EPI16_PER_REG)] = {0}; 
+    __m256i mred_mask = _mm256_set1_epi16 (0x007f);
+    for(int i = 0; i < M; i++){
+        for(int j = 0; j < ROUND_UP(N-M,EPI16_PER_REG)/EPI16_PER_REG; j++){
+            __m256i res_w = _mm256_load_si256( 
+                                 (__m256i const *) &res_dprec[j*EPI16_PER_REG] );
+            __m256i e_coeff = _mm256_set1_epi16(e[i]);
+            __m256i W_mat_slice = _mm256_lddqu_si256( 
+                                 (__m256i const *) &W_mat[i][j*EPI16_PER_REG] );
+            __m256i tmp = _mm256_mullo_epi16(e_coeff,W_mat_slice);
+            /* Vector Mersenne reduction */
+            __m256i tmp2 = _mm256_and_si256 (tmp, mred_mask);
+            tmp = _mm256_srli_epi16(tmp, 7);
+            tmp = _mm256_add_epi16(tmp,tmp2);
+            res_w = _mm256_add_epi16(res_w,tmp);
+            /* store back*/
+            _mm256_store_si256 ((__m256i *) &res_dprec[j*EPI16_PER_REG], res_w);            
+        }
+    }
 
-	/* Save result trimming to regular precision */
-	for (int i = 0; i < N - M; i++) {
-		res[i] = FZRED_DOUBLE(res_dprec[i]);
-	}
-	memcpy(res + (N - M), e, M * sizeof(FZ_ELEM));
+    
+    /* Save result trimming to regular precision */
+    for(int i = 0; i< N-M; i++) {
+        res[i] = FZRED_DOUBLE(res_dprec[i]);
+    }         
+    memcpy(res+(N-M),e,M*sizeof(FZ_ELEM));
 }
 
 static inline
 void fz_vec_sub_m(FZ_ELEM res[M],
                   const FZ_ELEM a[M],
-                  const FZ_ELEM b[M]) {
-	for (int i = 0; i < M; i++) {
-		res[i] = FZRED_SINGLE( a[i] + FZRED_OPPOSITE(b[i]) );
-	}
+                  const FZ_ELEM b[M]){
+    int i;
+    for(i = 0; i+EPI8_PER_REG <= M; i += EPI8_PER_REG){
+        __m256i a_w = _mm256_lddqu_si256((__m256i const *) &a[i]);
+        __m256i b_w = _mm256_lddqu_si256((__m256i const *) &b[i]);
+        _mm256_storeu_si256((__m256i *) &res[i], fz_sub_epi8(a_w, b_w));
+    }
+    for(; i < M; i++){
+        res[i]= FZRED_SINGLE( a[i] + FZRED_OPPOSITE(b[i]) );
+    }
 }
 
 static inline
-int is_fz_vec_in_restr_group_m(const FZ_ELEM in[M]) {
-	int is_in_ok = 1;
-	for (int i = 0; i < M; i++) {
-		is_in_ok = is_in_ok && (in[i] < Z);
-	}
-	return is_in_ok;
+int is_fz_vec_in_restr_group_m(const FZ_ELEM in[M]){
+    int is_in_ok = 1;
+    for(int i=0; i<M; i++){
+        is_in_ok = is_in_ok && (in[i] < Z);
+    }
+    return is_in_ok;
 }
 static inline
-void fz_dz_norm_m(FZ_ELEM v[M]) {
-	for (int i = 0; i < M; i++) {
-		v[i] = FZ_DOUBLE_ZERO_NORM(v[i]);
-	}
+void fz_dz_norm_m(FZ_ELEM v[M]){
+    int i;
+    for (i = 0; i+EPI8_PER_REG <= M; i += EPI8_PER_REG){
+        __m256i v_w = _mm256_lddqu_si256((__m256i const *) &v[i]);
+        v_w = mersenne_dz_norm_epi8(v_w, NUM_BITS_Z);
+        _mm256_storeu_si256((__m256i *) &v[i], v_w);
+    }
+    for (; i < M; i++){
+       v[i] = FZ_DOUBLE_ZERO_NORM(v[i]);
+    }
 }
@@ -5,14 +5,14 @@
  * @version 2.0 (February 2025)
  *
  * Authors listed in alphabetical order:
- *
+ * 
  * @author: Alessandro Barenghi <alessandro.barenghi@polimi.it>
  * @author: Marco Gianvecchio <marco.gianvecchio@mail.polimi.it>
  * @author: Patrick Karl <patrick.karl@tum.de>
  * @author: Gerardo Pelosi <gerardo.pelosi@polimi.it>
  * @author: Jonas Schupp <jonas.schupp@tum.de>
- *
- *
+ * 
+ * 
  * This code is hereby placed in the public domain.
  *
  * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ''AS IS'' AND ANY EXPRESS
@@ -31,18 +31,22 @@
 
 #pragma once
 
+#include "challenge.h"
 #include "csprng_hash.h"
 #include "namespace.h"
 #include "parameters.h"
 
-int seed_leaves(unsigned char rounds_seeds[T * SEED_LENGTH_BYTES],
+int seed_leaves(unsigned char rounds_seeds[T*SEED_LENGTH_BYTES],
                 const unsigned char root_seed[SEED_LENGTH_BYTES],
                 const unsigned char salt[SALT_LENGTH_BYTES]);
 
 int seed_path(unsigned char *seed_storage,
-              const unsigned char rounds_seeds[T * SEED_LENGTH_BYTES],
-              const unsigned char indices_to_publish[T]);
+              const unsigned char rounds_seeds[T*SEED_LENGTH_BYTES],
+              const chall_2_t *chall_2);
 
-uint8_t rebuild_leaves(unsigned char rounds_seeds[T * SEED_LENGTH_BYTES],
-                       const unsigned char indices_to_publish[T],
+uint8_t rebuild_leaves(unsigned char rounds_seeds[T*SEED_LENGTH_BYTES],
+                       const chall_2_t *chall_2,
                        const unsigned char *seed_storage);
+
+uint8_t is_seed_path_padding_ok(const chall_2_t *chall_2,
+                                const unsigned char *seed_storage);
@@ -5,14 +5,14 @@
  * @version 2.0 (February 2025)
  *
  * Authors listed in alphabetical order:
- *
+ * 
  * @author: Alessandro Barenghi <alessandro.barenghi@polimi.it>
  * @author: Marco Gianvecchio <marco.gianvecchio@mail.polimi.it>
  * @author: Patrick Karl <patrick.karl@tum.de>
  * @author: Gerardo Pelosi <gerardo.pelosi@polimi.it>
  * @author: Jonas Schupp <jonas.schupp@tum.de>
- *
- *
+ * 
+ * 
  * This code is hereby placed in the public domain.
  *
  * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ''AS IS'' AND ANY EXPRESS
@@ -35,441 +35,693 @@
 #include "CROSS.h"
 #include "csprng_hash.h"
 #include "fp_arith.h"
+#include "hash_stats.h"
 #include "merkle_tree.h"
 #include "namespace.h"
 #include "pack_unpack.h"
+#include "pk_cache.h"
+#include "pk_expanded.h"
+#include "presig.h"
+#include "probes.h"
 #include "randombytes.h"
+#include "rng_pool.h"
 #include "seedtree.h"
+#include "verify_state.h"
 
 static
-void expand_pk(FP_ELEM V_tr[K][N - K],
-               FZ_ELEM W_mat[M][N - M],
-               const uint8_t seed_pk[KEYPAIR_SEED_LENGTH_BYTES]) {
+void expand_pk(FP_ELEM V_tr[K][N-K],
+               FZ_ELEM W_mat[M][N-M],
+               const uint8_t seed_pk[KEYPAIR_SEED_LENGTH_BYTES]){
 
-	/* Expansion of pk->seed, explicit domain separation for CSPRNG as in keygen */
-	const uint16_t dsc_csprng_seed_pk = CSPRNG_DOMAIN_SEP_CONST + (3 * T + 2);
+  /* Expansion of pk->seed, explicit domain separation for CSPRNG as in keygen */
+  const uint16_t dsc_csprng_seed_pk = CSPRNG_DOMAIN_SEP_CONST + (3*T+2);
 
-	CSPRNG_STATE_T csprng_state_mat;
-	csprng_initialize(&csprng_state_mat, seed_pk, KEYPAIR_SEED_LENGTH_BYTES, dsc_csprng_seed_pk);
+  CSPRNG_STATE_T csprng_state_mat;
+  csprng_initialize(&csprng_state_mat, seed_pk, KEYPAIR_SEED_LENGTH_BYTES, dsc_csprng_seed_pk);
 
-	csprng_fz_mat(W_mat, &csprng_state_mat);
-	csprng_fp_mat(V_tr, &csprng_state_mat);
-	/* PQClean-edit: CSPRNG release context */
-	csprng_release(&csprng_state_mat);
+  csprng_fz_mat_lazy(W_mat,&csprng_state_mat);
+  csprng_fp_mat_lazy(V_tr,&csprng_state_mat);
+  /* PQClean-edit: CSPRNG release context */
+  csprng_release(&csprng_state_mat);
 }
 
+
 static
 void expand_sk(FZ_ELEM e_bar[N],
                FZ_ELEM e_G_bar[M],
-               FP_ELEM V_tr[K][N - K],
-               FZ_ELEM W_mat[M][N - M],
-               const uint8_t seed_sk[KEYPAIR_SEED_LENGTH_BYTES]) {
-
-	uint8_t seed_e_seed_pk[2][KEYPAIR_SEED_LENGTH_BYTES];
-	CSPRNG_STATE_T csprng_state;
-
-	/* Expansion of sk->seed, explicit domain separation for CSPRNG, as in keygen */
-	const uint16_t dsc_csprng_seed_sk = CSPRNG_DOMAIN_SEP_CONST + (3 * T + 1);
-
-	csprng_initialize(&csprng_state, seed_sk, KEYPAIR_SEED_LENGTH_BYTES, dsc_csprng_seed_sk);
-	csprng_randombytes((uint8_t *)seed_e_seed_pk,
-	                   2 * KEYPAIR_SEED_LENGTH_BYTES,
-	                   &csprng_state);
-	/* PQClean-edit: CSPRNG release context */
-	csprng_release(&csprng_state);
-
-	expand_pk(V_tr, W_mat, seed_e_seed_pk[1]);
-
-	/* Expansion of seede, explicit domain separation for CSPRNG as in keygen */
-	const uint16_t dsc_csprng_seed_e = CSPRNG_DOMAIN_SEP_CONST + (3 * T + 3);
-
-	CSPRNG_STATE_T csprng_state_e_bar;
-	csprng_initialize(&csprng_state_e_bar, seed_e_seed_pk[0], KEYPAIR_SEED_LENGTH_BYTES, dsc_csprng_seed_e);
-	csprng_fz_inf_w(e_G_bar, &csprng_state_e_bar);
-	/* PQClean-edit: CSPRNG release context */
-	csprng_release(&csprng_state_e_bar);
-	fz_inf_w_by_fz_matrix(e_bar, e_G_bar, W_mat);
-	fz_dz_norm_n(e_bar);
+               FP_ELEM V_tr[K][N-K],
+               FZ_ELEM W_mat[M][N-M],
+               const uint8_t seed_sk[KEYPAIR_SEED_LENGTH_BYTES]){
+
+  uint8_t seed_e_seed_pk[2][KEYPAIR_SEED_LENGTH_BYTES];
+  CSPRNG_STATE_T csprng_state;
+
+  /* Expansion of sk->seed, explicit domain separation for CSPRNG, as in keygen */
+  const uint16_t dsc_csprng_seed_sk = CSPRNG_DOMAIN_SEP_CONST + (3*T+1);
+
+  csprng_initialize(&csprng_state, seed_sk, KEYPAIR_SEED_LENGTH_BYTES, dsc_csprng_seed_sk);
+  csprng_randombytes((uint8_t *)seed_e_seed_pk,
+                     2*KEYPAIR_SEED_LENGTH_BYTES,
+                     &csprng_state);
+  /* PQClean-edit: CSPRNG release context */
+  csprng_release(&csprng_state);
+
+  expand_pk(V_tr,W_mat,seed_e_seed_pk[1]);
+
+  /* Expansion of seede, explicit domain separation for CSPRNG as in keygen */
+  const uint16_t dsc_csprng_seed_e = CSPRNG_DOMAIN_SEP_CONST + (3*T+3);
+
+  CSPRNG_STATE_T csprng_state_e_bar;
+  csprng_initialize(&csprng_state_e_bar, seed_e_seed_pk[0], KEYPAIR_SEED_LENGTH_BYTES, dsc_csprng_seed_e);
+  csprng_fz_inf_w(e_G_bar,&csprng_state_e_bar);
+  /* PQClean-edit: CSPRNG release context */
+  csprng_release(&csprng_state_e_bar);
+  fz_inf_w_by_fz_matrix(e_bar,e_G_bar,W_mat);
+  fz_dz_norm_n(e_bar);
 }
 
+
 void CROSS_keygen(sk_t *SK,
-                  pk_t *PK) {
-	/* generation of random material for public and private key */
-	randombytes(SK->seed_sk, KEYPAIR_SEED_LENGTH_BYTES);
-
-	uint8_t seed_e_seed_pk[2][KEYPAIR_SEED_LENGTH_BYTES];
-
-	/* Expansion of sk->seed, explicit domain separation for CSPRNG */
-	const uint16_t dsc_csprng_seed_sk = CSPRNG_DOMAIN_SEP_CONST + (3 * T + 1);
-
-	CSPRNG_STATE_T csprng_state;
-	csprng_initialize(&csprng_state, SK->seed_sk, KEYPAIR_SEED_LENGTH_BYTES, dsc_csprng_seed_sk);
-	csprng_randombytes((uint8_t *)seed_e_seed_pk,
-	                   2 * KEYPAIR_SEED_LENGTH_BYTES,
-	                   &csprng_state);
-	/* PQClean-edit: CSPRNG release context */
-	csprng_release(&csprng_state);
-	memcpy(PK->seed_pk, seed_e_seed_pk[1], KEYPAIR_SEED_LENGTH_BYTES);
-
-	/* expansion of matrix/matrices */
-	FP_ELEM V_tr[K][N - K];
-	FZ_ELEM W_mat[M][N - M];
-	expand_pk(V_tr, W_mat, PK->seed_pk);
-
-	/* expansion of secret key material */
-	/* Expansion of seede, explicit domain separation for CSPRNG */
-	const uint16_t dsc_csprng_seed_e = CSPRNG_DOMAIN_SEP_CONST + (3 * T + 3);
-
-	CSPRNG_STATE_T csprng_state_e_bar;
-	csprng_initialize(&csprng_state_e_bar, seed_e_seed_pk[0], KEYPAIR_SEED_LENGTH_BYTES, dsc_csprng_seed_e);
-
-	FZ_ELEM e_bar[N];
-	FZ_ELEM e_G_bar[M];
-	csprng_fz_inf_w(e_G_bar, &csprng_state_e_bar);
-	fz_inf_w_by_fz_matrix(e_bar, e_G_bar, W_mat);
-	fz_dz_norm_n(e_bar);
-	/* PQClean-edit: CSPRNG release context */
-	csprng_release(&csprng_state_e_bar);
-	/* compute public syndrome */
-	FP_ELEM s[N - K];
-	restr_vec_by_fp_matrix(s, e_bar, V_tr);
-	fp_dz_norm_synd(s);
-	pack_fp_syn(PK->s, s);
+                  pk_t *PK){
+  CROSS_PROBE_ENTRY(keygen);
+  /* generation of random material for public and private key */
+  secret_randombytes(SK->seed_sk,KEYPAIR_SEED_LENGTH_BYTES);
+
+  uint8_t seed_e_seed_pk[2][KEYPAIR_SEED_LENGTH_BYTES];
+
+  /* Expansion of sk->seed, explicit domain separation for CSPRNG */
+  const uint16_t dsc_csprng_seed_sk = CSPRNG_DOMAIN_SEP_CONST + (3*T+1);
+  
+  CSPRNG_STATE_T csprng_state;
+  csprng_initialize(&csprng_state, SK->seed_sk, KEYPAIR_SEED_LENGTH_BYTES, dsc_csprng_seed_sk);
+  csprng_randombytes((uint8_t *)seed_e_seed_pk,
+                     2*KEYPAIR_SEED_LENGTH_BYTES,
+                     &csprng_state);
+  /* PQClean-edit: CSPRNG release context */
+  csprng_release(&csprng_state);
+  memcpy(PK->seed_pk,seed_e_seed_pk[1],KEYPAIR_SEED_LENGTH_BYTES);
+
+  /* expansion of matrix/matrices */
+  FP_ELEM V_tr[K][N-K];
+  CROSS_PROBE_PHASE_ENTRY("expand_key", 0);
+  FZ_ELEM W_mat[M][N-M];
+  expand_pk(V_tr,W_mat,PK->seed_pk);
+  CROSS_PROBE_PHASE_RETURN("expand_key");
+
+  /* expansion of secret key material */ 
+  /* Expansion of seede, explicit domain separation for CSPRNG */
+  const uint16_t dsc_csprng_seed_e = CSPRNG_DOMAIN_SEP_CONST + (3*T+3);
+
+  CSPRNG_STATE_T csprng_state_e_bar;
+  csprng_initialize(&csprng_state_e_bar, seed_e_seed_pk[0], KEYPAIR_SEED_LENGTH_BYTES, dsc_csprng_seed_e);
+
+  FZ_ELEM e_bar[N];
+  FZ_ELEM e_G_bar[M];
+  csprng_fz_inf_w(e_G_bar,&csprng_state_e_bar);
+  fz_inf_w_by_fz_matrix(e_bar,e_G_bar,W_mat);
+  fz_dz_norm_n(e_bar);
+  /* PQClean-edit: CSPRNG release context */
+  csprng_release(&csprng_state_e_bar);
+  /* compute public syndrome */
+  FP_ELEM s[N-K];
+  restr_vec_by_fp_matrix(s,e_bar,V_tr);
+  fp_dz_norm_synd(s);
+  pack_fp_syn(PK->s,s);
+  CROSS_PROBE_RETURN(keygen);
+}
+
+/* the reference implementation generates the keypairs one at a time */
+void CROSS_keygen_batch(sk_t *SK,
+                        pk_t *PK,
+                        size_t n){
+  for(size_t i = 0; i < n; i++){
+    CROSS_keygen(&SK[i], &PK[i]);
+  }
+}
+
+/* presign cannot fail */
+void CROSS_presign(const sk_t *const SK,
+                   CROSS_presig_t *const presig){
+    HASH_STATS_ENTER(HASH_STATS_SIGN);
+    /* Key material expansion */
+    FP_ELEM V_tr[K][N-K];
+    FZ_ELEM e_bar[N];
+    CROSS_PROBE_PHASE_ENTRY("expand_key", 0);
+    FZ_ELEM e_G_bar[M];
+    FZ_ELEM W_mat[M][N-M];
+    expand_sk(e_bar,e_G_bar,V_tr,W_mat,SK->seed_sk);
+    CROSS_PROBE_PHASE_RETURN("expand_key");
+
+    uint8_t root_seed[SEED_LENGTH_BYTES];
+    secret_randombytes(root_seed,SEED_LENGTH_BYTES);
+    secret_randombytes(presig->salt,SALT_LENGTH_BYTES);
+
+    CROSS_PROBE_PHASE_ENTRY("seed_tree", T);
+    unsigned char *round_seeds = presig->round_seeds;
+    memset(round_seeds, 0, sizeof(presig->round_seeds));
+    seed_leaves(round_seeds,root_seed,presig->salt);
+    CROSS_PROBE_PHASE_RETURN("seed_tree");
+
+    FP_ELEM s_prime[N-K];
+
+    FZ_ELEM e_G_bar_prime[M];
+    uint8_t cmt_0_i_input[DENSELY_PACKED_FP_SYN_SIZE+
+                          DENSELY_PACKED_FZ_RSDP_G_VEC_SIZE+
+                          SALT_LENGTH_BYTES];
+    const int offset_salt = DENSELY_PACKED_FP_SYN_SIZE+DENSELY_PACKED_FZ_RSDP_G_VEC_SIZE;
+    /* cmt_0_i_input is syndrome || v_bar resp. v_G_bar || salt ; place salt at the end */
+    memcpy(cmt_0_i_input+offset_salt, presig->salt, SALT_LENGTH_BYTES);
+
+    uint8_t cmt_1_i_input[SEED_LENGTH_BYTES+
+                          SALT_LENGTH_BYTES];
+    /* cmt_1_i_input is concat(seed,salt,round index + 2T-1) */
+    memcpy(cmt_1_i_input+SEED_LENGTH_BYTES, presig->salt, SALT_LENGTH_BYTES);
+
+    uint8_t (*cmt_0)[HASH_DIGEST_LENGTH] = presig->cmt_0;
+    memset(cmt_0, 0, sizeof(presig->cmt_0));
+    uint8_t *cmt_1 = presig->cmt_1;
+    memset(cmt_1, 0, sizeof(presig->cmt_1));
+
+    /* cmt_1 is absorbed into its digest as the rounds produce it */
+    CSPRNG_STATE_T cmt_1_state;
+    hash_init(&cmt_1_state);
+
+    CSPRNG_STATE_T csprng_state;
+    CROSS_PROBE_PHASE_ENTRY("rounds", T);
+    for(uint16_t i = 0; i<T; i++){
+        /* CSPRNG is fed with concat(seed,salt,round index) represented
+         * as a 2 bytes little endian unsigned integer */
+        uint8_t csprng_input[SEED_LENGTH_BYTES+SALT_LENGTH_BYTES];
+        memcpy(csprng_input,round_seeds+SEED_LENGTH_BYTES*i,SEED_LENGTH_BYTES);
+        memcpy(csprng_input+SEED_LENGTH_BYTES,presig->salt,SALT_LENGTH_BYTES);
+
+        uint16_t domain_sep_csprng = CSPRNG_DOMAIN_SEP_CONST+i+(2*T-1);
+
+        /* expand seed[i] into seed_e and seed_u */
+        csprng_initialize(&csprng_state,
+                          csprng_input,
+                          SEED_LENGTH_BYTES+SALT_LENGTH_BYTES,
+                          domain_sep_csprng);
+        /* expand e_bar_prime */
+        csprng_fz_inf_w(e_G_bar_prime, &csprng_state);
+        fz_vec_sub_m(presig->v_G_bar[i], e_G_bar, e_G_bar_prime);
+        fz_dz_norm_m(presig->v_G_bar[i]);
+        fz_inf_w_by_fz_matrix(presig->e_bar_prime[i], e_G_bar_prime, W_mat);
+        fz_dz_norm_n(presig->e_bar_prime[i]);
+        fz_vec_sub_n(presig->v_bar[i], e_bar, presig->e_bar_prime[i]);
+
+        FP_ELEM v[N];
+        convert_restr_vec_to_fp(v, presig->v_bar[i]);
+        fz_dz_norm_n(presig->v_bar[i]);
+        /* expand u_prime */
+        csprng_fp_vec(presig->u_prime[i], &csprng_state);
+        /* PQClean-edit: CSPRNG release context */
+        csprng_release(&csprng_state);
+
+        FP_ELEM u[N];
+        fp_vec_by_fp_vec_pointwise(u, v, presig->u_prime[i]);
+        fp_vec_by_fp_matrix(s_prime, u, V_tr);
+        fp_dz_norm_synd(s_prime);
+
+        /* cmt_0_i_input contains s_prime || v_bar resp. v_G_bar || salt */
+        pack_fp_syn(cmt_0_i_input,s_prime);
+
+        pack_fz_rsdp_g_vec(cmt_0_i_input + DENSELY_PACKED_FP_SYN_SIZE, presig->v_G_bar[i]);
+        /* Fixed endianness marshalling of round counter */
+        uint16_t domain_sep_hash = HASH_DOMAIN_SEP_CONST+i+(2*T-1);
+
+        hash(cmt_0[i], cmt_0_i_input, sizeof(cmt_0_i_input), domain_sep_hash);
+        memcpy(cmt_1_i_input,
+               round_seeds+SEED_LENGTH_BYTES*i,
+               SEED_LENGTH_BYTES);
+        
+        hash(&cmt_1[i*HASH_DIGEST_LENGTH], cmt_1_i_input, sizeof(cmt_1_i_input), domain_sep_hash);
+        hash_update(&cmt_1_state, &cmt_1[i*HASH_DIGEST_LENGTH], HASH_DIGEST_LENGTH);
+    }
+    CROSS_PROBE_PHASE_RETURN("rounds");
+
+    /* vector containing d_0 and d_1 from spec */
+    uint8_t digest_cmt0_cmt1[2*HASH_DIGEST_LENGTH];
+
+    CROSS_PROBE_PHASE_ENTRY("merkle_root", T);
+    tree_root(digest_cmt0_cmt1, cmt_0);
+    CROSS_PROBE_PHASE_RETURN("merkle_root");
+    hash_final(digest_cmt0_cmt1 + HASH_DIGEST_LENGTH, &cmt_1_state, HASH_DOMAIN_SEP_CONST);
+    hash(presig->digest_cmt, digest_cmt0_cmt1, sizeof(digest_cmt0_cmt1), HASH_DOMAIN_SEP_CONST);
+    presig->is_ready = 1;
+    /* the signature is counted as it is completed by CROSS_sign_online */
+    HASH_STATS_LEAVE(0);
+}
+
+int CROSS_sign_online(CROSS_presig_t *const presig,
+                      const char *const m,
+                      const uint64_t mlen,
+                      CROSS_sig_t *const sig){
+    if(!presig->is_ready){
+        return 0;
+    }
+    HASH_STATS_ENTER(HASH_STATS_SIGN);
+    /* Wipe any residual information in the sig structure allocated by the 
+     * caller */
+    memset(sig,0,sizeof(CROSS_sig_t));
+    memcpy(sig->salt, presig->salt, SALT_LENGTH_BYTES);
+    memcpy(sig->digest_cmt, presig->digest_cmt, HASH_DIGEST_LENGTH);
+
+    /* first challenge extraction */
+    uint8_t digest_msg_cmt_salt[2*HASH_DIGEST_LENGTH+SALT_LENGTH_BYTES];
+
+    CROSS_PROBE_PHASE_ENTRY("chall_1", T);
+    /* place digest_msg at the beginning of the input of the hash generating digest_chall_1 */
+    hash(digest_msg_cmt_salt, (uint8_t*) m, mlen, HASH_DOMAIN_SEP_CONST);
+    memcpy(digest_msg_cmt_salt+HASH_DIGEST_LENGTH, sig->digest_cmt, HASH_DIGEST_LENGTH);
+    memcpy(digest_msg_cmt_salt+2*HASH_DIGEST_LENGTH, sig->salt, SALT_LENGTH_BYTES);
+
+    uint8_t digest_chall_1[HASH_DIGEST_LENGTH];
+    hash(digest_chall_1, digest_msg_cmt_salt, sizeof(digest_msg_cmt_salt), HASH_DOMAIN_SEP_CONST);
+
+    // Domain separation unique for expanding chall_1
+    const uint16_t dsc_csprng_chall_1 = CSPRNG_DOMAIN_SEP_CONST + (3*T-1);
+
+    CSPRNG_STATE_T csprng_state;
+    FP_ELEM chall_1[T];
+    csprng_initialize(&csprng_state, digest_chall_1, sizeof(digest_chall_1), dsc_csprng_chall_1);
+    csprng_fp_vec_chall_1_lazy(chall_1, &csprng_state);
+    /* PQClean-edit: CSPRNG release context */
+    csprng_release(&csprng_state);
+    CROSS_PROBE_PHASE_RETURN("chall_1");
+
+    /* Computation of the first round of responses */
+    CROSS_PROBE_PHASE_ENTRY("responses_y", T);
+    FP_ELEM y[T][N];
+    for(int i = 0; i < T; i++){
+        fp_vec_by_restr_vec_scaled(y[i],
+                                   presig->e_bar_prime[i],
+                                   chall_1[i],
+                                   presig->u_prime[i]);
+        fp_dz_norm(y[i]);
+    }
+    /* y vectors are packed before being hashed */
+    uint8_t y_digest_chall_1[T*DENSELY_PACKED_FP_VEC_SIZE+HASH_DIGEST_LENGTH];
+
+    for(int x = 0; x < T; x++){
+        pack_fp_vec(y_digest_chall_1+(x*DENSELY_PACKED_FP_VEC_SIZE),y[x]);
+    }
+    /* Second challenge extraction */
+    memcpy(y_digest_chall_1+T*DENSELY_PACKED_FP_VEC_SIZE,digest_chall_1,HASH_DIGEST_LENGTH);
+
+    hash(sig->digest_chall_2, y_digest_chall_1, sizeof(y_digest_chall_1), HASH_DOMAIN_SEP_CONST);
+    CROSS_PROBE_PHASE_RETURN("responses_y");
+
+    CROSS_PROBE_PHASE_ENTRY("chall_2", T);
+    chall_2_t chall_2;
+    expand_digest_to_chall_2(&chall_2,sig->digest_chall_2);
+    CROSS_PROBE_PHASE_RETURN("chall_2");
+
+    /* Computation of the second round of responses */
+    CROSS_PROBE_PHASE_ENTRY("merkle_proof", T);
+    tree_proof(sig->proof,presig->cmt_0,&chall_2);
+    CROSS_PROBE_PHASE_RETURN("merkle_proof");
+    CROSS_PROBE_PHASE_ENTRY("seed_path", T);
+    seed_path(sig->path,presig->round_seeds,&chall_2);
+    CROSS_PROBE_PHASE_RETURN("seed_path");
+
+    /* the responses of the rounds where chall_2 is 0, in round order */
+    CROSS_PROBE_PHASE_ENTRY("pack_responses", T-W);
+    for(int published_rsps = 0; published_rsps < T-W; published_rsps++){
+        const int i = chall_2.rounds_0[published_rsps];
+        pack_fp_vec(sig->resp_0[published_rsps].y, y[i]);
+        pack_fz_rsdp_g_vec(sig->resp_0[published_rsps].v_G_bar, presig->v_G_bar[i]);
+        memcpy(sig->resp_1[published_rsps], &presig->cmt_1[i*HASH_DIGEST_LENGTH], HASH_DIGEST_LENGTH);
+    }
+    CROSS_PROBE_PHASE_RETURN("pack_responses");
+    /* a second challenge on the same commitments would reveal the secret
+     * key: the presignature does not survive its use */
+    presig_wipe(presig, sizeof(CROSS_presig_t));
+    HASH_STATS_LEAVE(1);
+    return 1;
 }
 
 /* sign cannot fail */
 void CROSS_sign(const sk_t *const SK,
-                const char *const m,
-                const uint64_t mlen,
-                CROSS_sig_t *const sig) {
-	/* Wipe any residual information in the sig structure allocated by the
-	 * caller */
-	memset(sig, 0, sizeof(CROSS_sig_t));
-	/* Key material expansion */
-	FP_ELEM V_tr[K][N - K];
-	FZ_ELEM e_bar[N];
-	FZ_ELEM e_G_bar[M];
-	FZ_ELEM W_mat[M][N - M];
-	expand_sk(e_bar, e_G_bar, V_tr, W_mat, SK->seed_sk);
-
-	uint8_t root_seed[SEED_LENGTH_BYTES];
-	randombytes(root_seed, SEED_LENGTH_BYTES);
-	randombytes(sig->salt, SALT_LENGTH_BYTES);
-
-	unsigned char round_seeds[T * SEED_LENGTH_BYTES] = {0};
-	seed_leaves(round_seeds, root_seed, sig->salt);
-
-	FZ_ELEM e_bar_prime[T][N];
-	FZ_ELEM v_bar[T][N];
-	FP_ELEM u_prime[T][N];
-	FP_ELEM s_prime[N - K];
-
-	FZ_ELEM e_G_bar_prime[M];
-	FZ_ELEM v_G_bar[T][M];
-	uint8_t cmt_0_i_input[DENSELY_PACKED_FP_SYN_SIZE +
-	                      DENSELY_PACKED_FZ_RSDP_G_VEC_SIZE +
-	                      SALT_LENGTH_BYTES];
-	const int offset_salt = DENSELY_PACKED_FP_SYN_SIZE + DENSELY_PACKED_FZ_RSDP_G_VEC_SIZE;
-	/* cmt_0_i_input is syndrome || v_bar resp. v_G_bar || salt ; place salt at the end */
-	memcpy(cmt_0_i_input + offset_salt, sig->salt, SALT_LENGTH_BYTES);
-
-	uint8_t cmt_1_i_input[SEED_LENGTH_BYTES +
-	                      SALT_LENGTH_BYTES];
-	/* cmt_1_i_input is concat(seed,salt,round index + 2T-1) */
-	memcpy(cmt_1_i_input + SEED_LENGTH_BYTES, sig->salt, SALT_LENGTH_BYTES);
-
-	uint8_t cmt_0[T][HASH_DIGEST_LENGTH] = {0};
-	uint8_t cmt_1[T * HASH_DIGEST_LENGTH] = {0};
-
-	CSPRNG_STATE_T csprng_state;
-	for (uint16_t i = 0; i < T; i++) {
-		/* CSPRNG is fed with concat(seed,salt,round index) represented
-		 * as a 2 bytes little endian unsigned integer */
-		uint8_t csprng_input[SEED_LENGTH_BYTES + SALT_LENGTH_BYTES];
-		memcpy(csprng_input, round_seeds + SEED_LENGTH_BYTES * i, SEED_LENGTH_BYTES);
-		memcpy(csprng_input + SEED_LENGTH_BYTES, sig->salt, SALT_LENGTH_BYTES);
-
-		uint16_t domain_sep_csprng = CSPRNG_DOMAIN_SEP_CONST + i + (2 * T - 1);
-
-		/* expand seed[i] into seed_e and seed_u */
-		csprng_initialize(&csprng_state,
-		                  csprng_input,
-		                  SEED_LENGTH_BYTES + SALT_LENGTH_BYTES,
-		                  domain_sep_csprng);
-		/* expand e_bar_prime */
-		csprng_fz_inf_w(e_G_bar_prime, &csprng_state);
-		fz_vec_sub_m(v_G_bar[i], e_G_bar, e_G_bar_prime);
-		fz_dz_norm_m(v_G_bar[i]);
-		fz_inf_w_by_fz_matrix(e_bar_prime[i], e_G_bar_prime, W_mat);
-		fz_dz_norm_n(e_bar_prime[i]);
-		fz_vec_sub_n(v_bar[i], e_bar, e_bar_prime[i]);
-
-		FP_ELEM v[N];
-		convert_restr_vec_to_fp(v, v_bar[i]);
-		fz_dz_norm_n(v_bar[i]);
-		/* expand u_prime */
-		csprng_fp_vec(u_prime[i], &csprng_state);
-		/* PQClean-edit: CSPRNG release context */
-		csprng_release(&csprng_state);
-
-		FP_ELEM u[N];
-		fp_vec_by_fp_vec_pointwise(u, v, u_prime[i]);
-		fp_vec_by_fp_matrix(s_prime, u, V_tr);
-		fp_dz_norm_synd(s_prime);
-
-		/* cmt_0_i_input contains s_prime || v_bar resp. v_G_bar || salt */
-		pack_fp_syn(cmt_0_i_input, s_prime);
-
-		pack_fz_rsdp_g_vec(cmt_0_i_input + DENSELY_PACKED_FP_SYN_SIZE, v_G_bar[i]);
-		/* Fixed endianness marshalling of round counter */
-		uint16_t domain_sep_hash = HASH_DOMAIN_SEP_CONST + i + (2 * T - 1);
-
-		hash(cmt_0[i], cmt_0_i_input, sizeof(cmt_0_i_input), domain_sep_hash);
-		memcpy(cmt_1_i_input,
-		       round_seeds + SEED_LENGTH_BYTES * i,
-		       SEED_LENGTH_BYTES);
-
-		hash(&cmt_1[i * HASH_DIGEST_LENGTH], cmt_1_i_input, sizeof(cmt_1_i_input), domain_sep_hash);
-	}
-
-	/* vector containing d_0 and d_1 from spec */
-	uint8_t digest_cmt0_cmt1[2 * HASH_DIGEST_LENGTH];
-
-	tree_root(digest_cmt0_cmt1, cmt_0);
-	hash(digest_cmt0_cmt1 + HASH_DIGEST_LENGTH, cmt_1, sizeof(cmt_1), HASH_DOMAIN_SEP_CONST);
-	hash(sig->digest_cmt, digest_cmt0_cmt1, sizeof(digest_cmt0_cmt1), HASH_DOMAIN_SEP_CONST);
-
-	/* first challenge extraction */
-	uint8_t digest_msg_cmt_salt[2 * HASH_DIGEST_LENGTH + SALT_LENGTH_BYTES];
-
-	/* place digest_msg at the beginning of the input of the hash generating digest_chall_1 */
-	hash(digest_msg_cmt_salt, (uint8_t *) m, mlen, HASH_DOMAIN_SEP_CONST);
-	memcpy(digest_msg_cmt_salt + HASH_DIGEST_LENGTH, sig->digest_cmt, HASH_DIGEST_LENGTH);
-	memcpy(digest_msg_cmt_salt + 2 * HASH_DIGEST_LENGTH, sig->salt, SALT_LENGTH_BYTES);
-
-	uint8_t digest_chall_1[HASH_DIGEST_LENGTH];
-	hash(digest_chall_1, digest_msg_cmt_salt, sizeof(digest_msg_cmt_salt), HASH_DOMAIN_SEP_CONST);
-
-	// Domain separation unique for expanding chall_1
-	const uint16_t dsc_csprng_chall_1 = CSPRNG_DOMAIN_SEP_CONST + (3 * T - 1);
-
-	FP_ELEM chall_1[T];
-	csprng_initialize(&csprng_state, digest_chall_1, sizeof(digest_chall_1), dsc_csprng_chall_1);
-	csprng_fp_vec_chall_1(chall_1, &csprng_state);
-	/* PQClean-edit: CSPRNG release context */
-	csprng_release(&csprng_state);
-
-	/* Computation of the first round of responses */
-	FP_ELEM y[T][N];
-	for (int i = 0; i < T; i++) {
-		fp_vec_by_restr_vec_scaled(y[i],
-		                           e_bar_prime[i],
-		                           chall_1[i],
-		                           u_prime[i]);
-		fp_dz_norm(y[i]);
-	}
-	/* y vectors are packed before being hashed */
-	uint8_t y_digest_chall_1[T * DENSELY_PACKED_FP_VEC_SIZE + HASH_DIGEST_LENGTH];
-
-	for (int x = 0; x < T; x++) {
-		pack_fp_vec(y_digest_chall_1 + (x * DENSELY_PACKED_FP_VEC_SIZE), y[x]);
-	}
-	/* Second challenge extraction */
-	memcpy(y_digest_chall_1 + T * DENSELY_PACKED_FP_VEC_SIZE, digest_chall_1, HASH_DIGEST_LENGTH);
-
-	hash(sig->digest_chall_2, y_digest_chall_1, sizeof(y_digest_chall_1), HASH_DOMAIN_SEP_CONST);
-
-	uint8_t chall_2[T] = {0};
-	expand_digest_to_fixed_weight(chall_2, sig->digest_chall_2);
-
-	/* Computation of the second round of responses */
-	tree_proof(sig->proof, cmt_0, chall_2);
-	seed_path(sig->path, round_seeds, chall_2);
-
-	int published_rsps = 0;
-	for (int i = 0; i < T; i++) {
-		if (chall_2[i] == 0) {
-			assert(published_rsps < T - W);
-			pack_fp_vec(sig->resp_0[published_rsps].y, y[i]);
-			pack_fz_rsdp_g_vec(sig->resp_0[published_rsps].v_G_bar, v_G_bar[i]);
-			memcpy(sig->resp_1[published_rsps], &cmt_1[i * HASH_DIGEST_LENGTH], HASH_DIGEST_LENGTH);
-			published_rsps++;
-		}
-	}
+               const char *const m,
+               const uint64_t mlen,
+               CROSS_sig_t *const sig){
+    CROSS_PROBE_ENTRY(sign);
+    HASH_STATS_ENTER(HASH_STATS_SIGN);
+    CROSS_presig_t presig;
+    CROSS_presign(SK, &presig);
+    CROSS_sign_online(&presig, m, mlen, sig);
+    HASH_STATS_LEAVE(1);
+    CROSS_PROBE_RETURN(sign);
+}
+
+
+/* generates the matrices of EPK from seed_pk */
+static
+void expand_pk_matrices(pk_expanded_t *const EPK,
+                        const uint8_t seed_pk[KEYPAIR_SEED_LENGTH_BYTES]){
+    expand_pk(EPK->V_tr,EPK->W_mat,seed_pk);
+}
+
+int CROSS_pk_expand(pk_expanded_t *const EPK,
+                    const pk_t *const PK){
+    memcpy(&EPK->pk, PK, sizeof(pk_t));
+    expand_pk_matrices(EPK, PK->seed_pk);
+    return unpack_fp_syn(EPK->s, PK->s);
+}
+
+/* the phases of a step-wise verification: the seed tree is rebuilt, the
+ * rounds are verified, the Merkle root is recomputed, in this order */
+#define VERIFY_PHASE_SEED_TREE 0
+#define VERIFY_PHASE_ROUNDS 1
+#define VERIFY_PHASE_MERKLE_ROOT 2
+#define VERIFY_PHASE_DONE 3
+
+/* the nodes of the seed tree resp. of the Merkle tree which a step
+ * computes in place of a round */
+#define VERIFY_NODES_PER_ROUND 16
+
+/* the work preceding the rounds but for the seed tree: the first challenge
+ * is derived, state->EPK, sig, chall_2 and is_padd_key_ok are already set */
+static
+void verify_begin(CROSS_verify_state_t *const state,
+                  const char *const m,
+                  const uint64_t mlen){
+    const CROSS_sig_t *const sig = state->sig;
+    CSPRNG_STATE_T csprng_state;
+
+    CROSS_PROBE_PHASE_ENTRY("chall_1", T);
+    uint8_t digest_msg_cmt_salt[2*HASH_DIGEST_LENGTH+SALT_LENGTH_BYTES];
+    hash(digest_msg_cmt_salt, (uint8_t*) m, mlen, HASH_DOMAIN_SEP_CONST);
+    memcpy(digest_msg_cmt_salt+HASH_DIGEST_LENGTH, sig->digest_cmt, HASH_DIGEST_LENGTH);
+    memcpy(digest_msg_cmt_salt+2*HASH_DIGEST_LENGTH, sig->salt, SALT_LENGTH_BYTES);
+
+    hash(state->digest_chall_1, digest_msg_cmt_salt, sizeof(digest_msg_cmt_salt), HASH_DOMAIN_SEP_CONST);
+
+    // Domain separation unique for expanding digest_chall_1
+    const uint16_t dsc_csprng_chall_1 = CSPRNG_DOMAIN_SEP_CONST + (3*T-1);
+    csprng_initialize(&csprng_state, state->digest_chall_1, HASH_DIGEST_LENGTH, dsc_csprng_chall_1);
+
+    csprng_fp_vec_chall_1_lazy(state->chall_1, &csprng_state);
+    /* PQClean-edit: CSPRNG release context */
+    csprng_release(&csprng_state);
+    CROSS_PROBE_PHASE_RETURN("chall_1");
+
+    memset(state->round_seeds, 0, sizeof(state->round_seeds));
+    CROSS_PROBE_PHASE_ENTRY("seed_tree", T);
+    state->is_stree_padding_ok = rebuild_leaves(state->round_seeds, &state->chall_2, sig->path);
+    CROSS_PROBE_PHASE_RETURN("seed_tree");
+    state->phase = VERIFY_PHASE_ROUNDS;
+
+    memset(state->cmt_0, 0, sizeof(state->cmt_0));
+    /* cmt_1 and y are absorbed into their digests round by round, cmt_1
+     * either recomputed or taken from resp_1 */
+    hash_init(&state->cmt_1_state);
+    hash_init(&state->y_state);
+
+    state->round = 0;
+    state->used_rsps = 0;
+    state->is_signature_ok = 1;
+    state->is_packed_padd_ok = 1;
+}
+
+/* round i of the verification, the rounds are processed in order */
+static
+void verify_round(CROSS_verify_state_t *const state,
+                  const uint16_t i){
+    const CROSS_sig_t *const sig = state->sig;
+    CSPRNG_STATE_T csprng_state;
+
+    /* the arithmetic takes the matrices as non-const, they are only read */
+    FP_ELEM (*V_tr)[N-K] = (FP_ELEM (*)[N-K]) state->EPK->V_tr;
+    FZ_ELEM (*W_mat)[N-M] = (FZ_ELEM (*)[N-M]) state->EPK->W_mat;
+    const FP_ELEM *s = state->EPK->s;
+
+    uint16_t domain_sep_csprng = CSPRNG_DOMAIN_SEP_CONST + i + (2*T-1);
+    uint16_t domain_sep_hash = HASH_DOMAIN_SEP_CONST + i + (2*T-1);
+
+    FP_ELEM y[N];
+    if(state->chall_2.value[i] == 1){
+        /* cmt_1_i_input is concat(seed,salt,round index) */
+        uint8_t cmt_1_i_input[SEED_LENGTH_BYTES+SALT_LENGTH_BYTES];
+        memcpy(cmt_1_i_input+SEED_LENGTH_BYTES, sig->salt, SALT_LENGTH_BYTES);
+        memcpy(cmt_1_i_input,
+               state->round_seeds+SEED_LENGTH_BYTES*i,
+               SEED_LENGTH_BYTES);
+
+        uint8_t cmt_1_i[HASH_DIGEST_LENGTH];
+        hash(cmt_1_i,cmt_1_i_input,sizeof(cmt_1_i_input), domain_sep_hash);
+        hash_update(&state->cmt_1_state, cmt_1_i, HASH_DIGEST_LENGTH);
+
+        /* CSPRNG is fed with concat(seed,salt,round index) represented
+        * as a 2 bytes little endian unsigned integer */
+        uint8_t csprng_input[CSPRNG_INPUT_LENGTH];
+        memcpy(csprng_input+SEED_LENGTH_BYTES,sig->salt,SALT_LENGTH_BYTES);
+        memcpy(csprng_input,state->round_seeds+SEED_LENGTH_BYTES*i,SEED_LENGTH_BYTES);
+
+        FZ_ELEM e_bar_prime[N];
+        FP_ELEM u_prime[N];
+
+        /* expand seed[i] into seed_e and seed_u */
+        csprng_initialize(&csprng_state, csprng_input, CSPRNG_INPUT_LENGTH, domain_sep_csprng);
+        FZ_ELEM e_G_bar_prime[M];
+        csprng_fz_inf_w(e_G_bar_prime, &csprng_state);
+        fz_inf_w_by_fz_matrix(e_bar_prime,e_G_bar_prime,W_mat);
+        fz_dz_norm_n(e_bar_prime);
+        /* expand u_prime */
+        csprng_fp_vec(u_prime, &csprng_state);
+        /* PQClean-edit: CSPRNG release context */
+        csprng_release(&csprng_state);
+        fp_vec_by_restr_vec_scaled(y,
+                                   e_bar_prime,
+                                   state->chall_1[i],
+                                   u_prime);
+        fp_dz_norm(y);
+    } else {
+        uint8_t cmt_0_i_input[DENSELY_PACKED_FP_SYN_SIZE+
+                              DENSELY_PACKED_FZ_RSDP_G_VEC_SIZE+
+                              SALT_LENGTH_BYTES];
+        const int offset_salt = DENSELY_PACKED_FP_SYN_SIZE+DENSELY_PACKED_FZ_RSDP_G_VEC_SIZE;
+        /* cmt_0_i_input is syndrome || v_bar resp. v_G_bar || salt */
+        memcpy(cmt_0_i_input+offset_salt, sig->salt, SALT_LENGTH_BYTES);
+
+        const int used_rsps = state->used_rsps;
+        /* place y[i] in the buffer for later on hashing */
+        /* liboqs-edit: separate && operands to avoid "garbage value" in clang static analyzer (scan-build) and valgrind */
+        uint8_t is_packed_padd_y_ok = unpack_fp_vec(y, sig->resp_0[used_rsps].y);
+        state->is_packed_padd_ok = state->is_packed_padd_ok && is_packed_padd_y_ok;
+
+        FZ_ELEM v_bar[N];
+        /*v_G_bar is memcpy'ed directly into cmt_0 input buffer */
+        FZ_ELEM* v_G_bar_ptr = cmt_0_i_input+DENSELY_PACKED_FP_SYN_SIZE;
+        memcpy(v_G_bar_ptr,
+               &sig->resp_0[used_rsps].v_G_bar,
+               DENSELY_PACKED_FZ_RSDP_G_VEC_SIZE);
+        FZ_ELEM v_G_bar[M];
+        /* liboqs-edit: separate && operands to avoid "garbage value" in clang static analyzer (scan-build) and valgrind */
+        uint8_t is_packed_padd_v_G_bar_ok = unpack_fz_rsdp_g_vec(v_G_bar, sig->resp_0[used_rsps].v_G_bar);
+        state->is_packed_padd_ok = state->is_packed_padd_ok && is_packed_padd_v_G_bar_ok;
+        state->is_signature_ok = state->is_signature_ok &&
+                                 is_fz_vec_in_restr_group_m(v_G_bar);
+        fz_inf_w_by_fz_matrix(v_bar,v_G_bar,W_mat);
+
+        hash_update(&state->cmt_1_state, sig->resp_1[used_rsps], HASH_DIGEST_LENGTH);
+        state->used_rsps++;
+
+        FP_ELEM y_prime[N] = {0};
+        FP_ELEM y_prime_H[N-K] = {0};
+        FP_ELEM s_prime[N-K] = {0};
+
+        FP_ELEM v[N];
+        convert_restr_vec_to_fp(v,v_bar);
+        fp_vec_by_fp_vec_pointwise(y_prime,v,y);
+        fp_vec_by_fp_matrix(y_prime_H,y_prime,V_tr);
+        fp_dz_norm_synd(y_prime_H);
+        fp_synd_minus_fp_vec_scaled(s_prime,
+                                    y_prime_H,
+                                    state->chall_1[i],
+                                    s);
+        fp_dz_norm_synd(s_prime);
+        pack_fp_syn(cmt_0_i_input, s_prime);
+
+        hash(state->cmt_0[i], cmt_0_i_input, sizeof(cmt_0_i_input), domain_sep_hash);
+    }
+
+    /* y is absorbed packed, as in the digest of the signature */
+    uint8_t y_packed[DENSELY_PACKED_FP_VEC_SIZE];
+    pack_fp_vec(y_packed, y);
+    hash_update(&state->y_state, y_packed, DENSELY_PACKED_FP_VEC_SIZE);
+}
+
+void CROSS_verify_start(CROSS_verify_state_t *const state,
+                        const pk_t *const PK,
+                        const char *const m,
+                        const uint64_t mlen,
+                        const CROSS_sig_t *const sig){
+    HASH_STATS_ENTER(HASH_STATS_VERIFY);
+    pk_expanded_t *const pk_expanded = &state->pk_expanded;
+    state->EPK = pk_expanded;
+    state->sig = sig;
+    state->is_ended = 0;
+    state->is_padd_key_ok = unpack_fp_syn(pk_expanded->s,PK->s);
+
+    CROSS_PROBE_PHASE_ENTRY("chall_2", T);
+    expand_digest_to_chall_2(&state->chall_2,sig->digest_chall_2);
+    CROSS_PROBE_PHASE_RETURN("chall_2");
+
+
+    /* with PK_CACHE, the matrices of a recently seen seed_pk are copied out
+     * of the cache instead of being expanded again */
+    CROSS_PROBE_PHASE_ENTRY("expand_key", 0);
+    if(!pk_cache_lookup(PK->seed_pk, pk_expanded, PK_EXPANDED_MATRICES_BYTES)){
+        expand_pk_matrices(pk_expanded, PK->seed_pk);
+        pk_cache_insert(PK->seed_pk, pk_expanded, PK_EXPANDED_MATRICES_BYTES);
+    }
+    CROSS_PROBE_PHASE_RETURN("expand_key");
+    verify_begin(state, m, mlen);
+    HASH_STATS_LEAVE(0);
+}
+
+void CROSS_verify_start_expanded(CROSS_verify_state_t *const state,
+                                 const pk_expanded_t *const EPK,
+                                 const char *const m,
+                                 const uint64_t mlen,
+                                 const CROSS_sig_t *const sig){
+    HASH_STATS_ENTER(HASH_STATS_VERIFY);
+    state->EPK = EPK;
+    state->sig = sig;
+    state->is_ended = 0;
+    /* the padding of the key was checked by CROSS_pk_expand */
+    state->is_padd_key_ok = 1;
+
+    CROSS_PROBE_PHASE_ENTRY("chall_2", T);
+    expand_digest_to_chall_2(&state->chall_2,sig->digest_chall_2);
+    CROSS_PROBE_PHASE_RETURN("chall_2");
+
+    verify_begin(state, m, mlen);
+    HASH_STATS_LEAVE(0);
+}
+
+/* a round, VERIFY_NODES_PER_ROUND nodes of the seed tree or of the Merkle
+ * tree take one unit of the budget each */
+int CROSS_verify_step(CROSS_verify_state_t *const state,
+                      unsigned int budget_rounds){
+    if(state->is_ended){
+        return 1;
+    }
+    HASH_STATS_ENTER(HASH_STATS_VERIFY);
+    const CROSS_sig_t *const sig = state->sig;
+    if(state->phase == VERIFY_PHASE_ROUNDS && budget_rounds > 0){
+        /* the rounds this step will verify */
+        CROSS_PROBE_PHASE_ENTRY("rounds", ((unsigned int) (T-state->round) < budget_rounds) ?
+                                          (unsigned int) (T-state->round) : budget_rounds);
+        while(state->round < T && budget_rounds > 0){
+            verify_round(state, (uint16_t) state->round);
+            state->round++;
+            budget_rounds--;
+        }
+        CROSS_PROBE_PHASE_RETURN("rounds");
+        if(state->round == T){
+            state->phase = VERIFY_PHASE_MERKLE_ROOT;
+        }
+    }
+    if(state->phase == VERIFY_PHASE_MERKLE_ROOT && budget_rounds > 0){
+        CROSS_PROBE_PHASE_ENTRY("merkle_root", T);
+        /* the root of the leaves alone is not worth splitting */
+        state->is_mtree_padding_ok = recompute_root(state->merkle_root,
+                                                    state->cmt_0,
+                                                    sig->proof,
+                                                    &state->chall_2);
+        state->phase = VERIFY_PHASE_DONE;
+        CROSS_PROBE_PHASE_RETURN("merkle_root");
+    }
+    HASH_STATS_LEAVE(0);
+    return state->phase == VERIFY_PHASE_DONE;
+}
+
+void CROSS_verify_abort(CROSS_verify_state_t *const state){
+    if(state->is_ended){
+        return;
+    }
+    hash_release(&state->cmt_1_state);
+    hash_release(&state->y_state);
+    state->is_ended = 1;
+}
+
+int CROSS_verify_finish(CROSS_verify_state_t *const state){
+    HASH_STATS_ENTER(HASH_STATS_VERIFY);
+    /* the work left is never done here, the signature is rejected instead */
+    if(state->is_ended || state->phase != VERIFY_PHASE_DONE){
+        CROSS_verify_abort(state);
+        HASH_STATS_LEAVE(1);
+        return 0;
+    }
+    const CROSS_sig_t *const sig = state->sig;
+    int is_signature_ok = state->is_signature_ok;
+
+
+    uint8_t digest_cmt0_cmt1[2*HASH_DIGEST_LENGTH];
+    memcpy(digest_cmt0_cmt1, state->merkle_root, HASH_DIGEST_LENGTH);
+    hash_final(digest_cmt0_cmt1 + HASH_DIGEST_LENGTH, &state->cmt_1_state, HASH_DOMAIN_SEP_CONST);
+
+    uint8_t digest_cmt_prime[HASH_DIGEST_LENGTH];
+    hash(digest_cmt_prime, digest_cmt0_cmt1 ,sizeof(digest_cmt0_cmt1), HASH_DOMAIN_SEP_CONST);
+
+    /* the packed y of all the rounds are already absorbed */
+    uint8_t digest_chall_2_prime[HASH_DIGEST_LENGTH];
+    hash_update(&state->y_state, state->digest_chall_1, HASH_DIGEST_LENGTH);
+    hash_final(digest_chall_2_prime, &state->y_state, HASH_DOMAIN_SEP_CONST);
+    state->is_ended = 1;
+
+    int does_digest_cmt_match = ( memcmp(digest_cmt_prime,
+                                        sig->digest_cmt,
+                                        HASH_DIGEST_LENGTH) == 0);
+
+
+    int does_digest_chall_2_match = ( memcmp(digest_chall_2_prime,
+                                        sig->digest_chall_2,
+                                        HASH_DIGEST_LENGTH) == 0);
+
+    is_signature_ok = is_signature_ok &&
+                      does_digest_cmt_match &&
+                      does_digest_chall_2_match && 
+                      state->is_mtree_padding_ok &&
+                      state->is_stree_padding_ok &&
+                      state->is_padd_key_ok &&
+                      state->is_packed_padd_ok;
+    HASH_STATS_LEAVE(1);
+    return is_signature_ok;
 }
 
 /* verify returns 1 if signature is ok, 0 otherwise */
 int CROSS_verify(const pk_t *const PK,
                  const char *const m,
                  const uint64_t mlen,
-                 const CROSS_sig_t *const sig) {
-	CSPRNG_STATE_T csprng_state;
-
-	FP_ELEM V_tr[K][N - K];
-	FZ_ELEM W_mat[M][N - M];
-	expand_pk(V_tr, W_mat, PK->seed_pk);
-
-	FP_ELEM s[N - K];
-	uint8_t is_padd_key_ok;
-	is_padd_key_ok = unpack_fp_syn(s, PK->s);
-
-	uint8_t digest_msg_cmt_salt[2 * HASH_DIGEST_LENGTH + SALT_LENGTH_BYTES];
-	hash(digest_msg_cmt_salt, (uint8_t *) m, mlen, HASH_DOMAIN_SEP_CONST);
-	memcpy(digest_msg_cmt_salt + HASH_DIGEST_LENGTH, sig->digest_cmt, HASH_DIGEST_LENGTH);
-	memcpy(digest_msg_cmt_salt + 2 * HASH_DIGEST_LENGTH, sig->salt, SALT_LENGTH_BYTES);
-
-	uint8_t digest_chall_1[HASH_DIGEST_LENGTH];
-	hash(digest_chall_1, digest_msg_cmt_salt, sizeof(digest_msg_cmt_salt), HASH_DOMAIN_SEP_CONST);
-
-	// Domain separation unique for expanding digest_chall_1
-	const uint16_t dsc_csprng_chall_1 = CSPRNG_DOMAIN_SEP_CONST + (3 * T - 1);
-	csprng_initialize(&csprng_state, digest_chall_1, sizeof(digest_chall_1), dsc_csprng_chall_1);
-
-	FP_ELEM chall_1[T];
-	csprng_fp_vec_chall_1(chall_1, &csprng_state);
-	/* PQClean-edit: CSPRNG release context */
-	csprng_release(&csprng_state);
-
-	uint8_t chall_2[T] = {0};
-	expand_digest_to_fixed_weight(chall_2, sig->digest_chall_2);
-
-	uint8_t is_stree_padding_ok = 0;
-	uint8_t round_seeds[T * SEED_LENGTH_BYTES] = {0};
-	is_stree_padding_ok = rebuild_leaves(round_seeds, chall_2, sig->path);
-
-	uint8_t cmt_0_i_input[DENSELY_PACKED_FP_SYN_SIZE +
-	                      DENSELY_PACKED_FZ_RSDP_G_VEC_SIZE +
-	                      SALT_LENGTH_BYTES];
-	const int offset_salt = DENSELY_PACKED_FP_SYN_SIZE + DENSELY_PACKED_FZ_RSDP_G_VEC_SIZE;
-	/* cmt_0_i_input is syndrome || v_bar resp. v_G_bar || salt */
-	memcpy(cmt_0_i_input + offset_salt, sig->salt, SALT_LENGTH_BYTES);
-
-	/* cmt_1_i_input is concat(seed,salt,round index) */
-	uint8_t cmt_1_i_input[SEED_LENGTH_BYTES + SALT_LENGTH_BYTES];
-	memcpy(cmt_1_i_input + SEED_LENGTH_BYTES, sig->salt, SALT_LENGTH_BYTES);
-
-	uint8_t cmt_0[T][HASH_DIGEST_LENGTH] = {0};
-	uint8_t cmt_1[T * HASH_DIGEST_LENGTH] = {0};
-
-	FZ_ELEM e_bar_prime[N];
-	FP_ELEM u_prime[N];
-
-	FP_ELEM y_prime[N] = {0};
-	FP_ELEM y_prime_H[N - K] = {0};
-	FP_ELEM s_prime[N - K] = {0};
-
-	FP_ELEM y[T][N];
-
-	int used_rsps = 0;
-	int is_signature_ok = 1;
-	uint8_t is_packed_padd_ok = 1;
-	for (uint16_t i = 0; i < T; i++) {
-
-		uint16_t domain_sep_csprng = CSPRNG_DOMAIN_SEP_CONST + i + (2 * T - 1);
-		uint16_t domain_sep_hash = HASH_DOMAIN_SEP_CONST + i + (2 * T - 1);
-
-		if (chall_2[i] == 1) {
-			memcpy(cmt_1_i_input,
-			       round_seeds + SEED_LENGTH_BYTES * i,
-			       SEED_LENGTH_BYTES);
-
-			hash(&cmt_1[i * HASH_DIGEST_LENGTH], cmt_1_i_input, sizeof(cmt_1_i_input), domain_sep_hash);
-
-			/* CSPRNG is fed with concat(seed,salt,round index) represented
-			* as a 2 bytes little endian unsigned integer */
-			uint8_t csprng_input[CSPRNG_INPUT_LENGTH];
-			memcpy(csprng_input + SEED_LENGTH_BYTES, sig->salt, SALT_LENGTH_BYTES);
-			memcpy(csprng_input, round_seeds + SEED_LENGTH_BYTES * i, SEED_LENGTH_BYTES);
-
-			/* expand seed[i] into seed_e and seed_u */
-			csprng_initialize(&csprng_state, csprng_input, CSPRNG_INPUT_LENGTH, domain_sep_csprng);
-			FZ_ELEM e_G_bar_prime[M];
-			csprng_fz_inf_w(e_G_bar_prime, &csprng_state);
-			fz_inf_w_by_fz_matrix(e_bar_prime, e_G_bar_prime, W_mat);
-			fz_dz_norm_n(e_bar_prime);
-			/* expand u_prime */
-			csprng_fp_vec(u_prime, &csprng_state);
-			/* PQClean-edit: CSPRNG release context */
-			csprng_release(&csprng_state);
-			fp_vec_by_restr_vec_scaled(y[i],
-			                           e_bar_prime,
-			                           chall_1[i],
-			                           u_prime);
-			fp_dz_norm(y[i]);
-		} else {
-			/* place y[i] in the buffer for later on hashing */
-			/* liboqs-edit: separate && operands to avoid "garbage value" in clang static analyzer (scan-build) and valgrind */
-			uint8_t is_packed_padd_y_ok = unpack_fp_vec(y[i], sig->resp_0[used_rsps].y);
-			is_packed_padd_ok = is_packed_padd_ok && is_packed_padd_y_ok;
-
-			FZ_ELEM v_bar[N];
-			/*v_G_bar is memcpy'ed directly into cmt_0 input buffer */
-			FZ_ELEM *v_G_bar_ptr = cmt_0_i_input + DENSELY_PACKED_FP_SYN_SIZE;
-			memcpy(v_G_bar_ptr,
-			       &sig->resp_0[used_rsps].v_G_bar,
-			       DENSELY_PACKED_FZ_RSDP_G_VEC_SIZE);
-			FZ_ELEM v_G_bar[M];
-			/* liboqs-edit: separate && operands to avoid "garbage value" in clang static analyzer (scan-build) and valgrind */
-			uint8_t is_packed_padd_v_G_bar_ok = unpack_fz_rsdp_g_vec(v_G_bar, sig->resp_0[used_rsps].v_G_bar);
-			is_packed_padd_ok = is_packed_padd_ok && is_packed_padd_v_G_bar_ok;
-			is_signature_ok = is_signature_ok &&
-			                  is_fz_vec_in_restr_group_m(v_G_bar);
-			fz_inf_w_by_fz_matrix(v_bar, v_G_bar, W_mat);
-
-			memcpy(&cmt_1[i * HASH_DIGEST_LENGTH], sig->resp_1[used_rsps], HASH_DIGEST_LENGTH);
-			used_rsps++;
-
-			FP_ELEM v[N];
-			convert_restr_vec_to_fp(v, v_bar);
-			fp_vec_by_fp_vec_pointwise(y_prime, v, y[i]);
-			fp_vec_by_fp_matrix(y_prime_H, y_prime, V_tr);
-			fp_dz_norm_synd(y_prime_H);
-			fp_synd_minus_fp_vec_scaled(s_prime,
-			                            y_prime_H,
-			                            chall_1[i],
-			                            s);
-			fp_dz_norm_synd(s_prime);
-			pack_fp_syn(cmt_0_i_input, s_prime);
-
-			hash(cmt_0[i], cmt_0_i_input, sizeof(cmt_0_i_input), domain_sep_hash);
-		}
-	} /* end for iterating on ZKID iterations */
-
-	uint8_t digest_cmt0_cmt1[2 * HASH_DIGEST_LENGTH];
-
-	uint8_t is_mtree_padding_ok = recompute_root(digest_cmt0_cmt1,
-	                              cmt_0,
-	                              sig->proof,
-	                              chall_2);
-	hash(digest_cmt0_cmt1 + HASH_DIGEST_LENGTH, cmt_1, sizeof(cmt_1), HASH_DOMAIN_SEP_CONST);
-
-	uint8_t digest_cmt_prime[HASH_DIGEST_LENGTH];
-	hash(digest_cmt_prime, digest_cmt0_cmt1, sizeof(digest_cmt0_cmt1), HASH_DOMAIN_SEP_CONST);
-
-	uint8_t y_digest_chall_1[T * DENSELY_PACKED_FP_VEC_SIZE + HASH_DIGEST_LENGTH];
-
-	for (int x = 0; x < T; x++) {
-		pack_fp_vec(y_digest_chall_1 + (x * DENSELY_PACKED_FP_VEC_SIZE), y[x]);
-	}
-	memcpy(y_digest_chall_1 + T * DENSELY_PACKED_FP_VEC_SIZE, digest_chall_1, HASH_DIGEST_LENGTH);
-
-	uint8_t digest_chall_2_prime[HASH_DIGEST_LENGTH];
-	hash(digest_chall_2_prime, y_digest_chall_1, sizeof(y_digest_chall_1), HASH_DOMAIN_SEP_CONST);
-
-	int does_digest_cmt_match = ( memcmp(digest_cmt_prime,
-	                                     sig->digest_cmt,
-	                                     HASH_DIGEST_LENGTH) == 0);
-
-	int does_digest_chall_2_match = ( memcmp(digest_chall_2_prime,
-	                                  sig->digest_chall_2,
-	                                  HASH_DIGEST_LENGTH) == 0);
-
-	is_signature_ok = is_signature_ok &&
-	                  does_digest_cmt_match &&
-	                  does_digest_chall_2_match &&
-	                  is_mtree_padding_ok &&
-	                  is_stree_padding_ok &&
-	                  is_padd_key_ok &&
-	                  is_packed_padd_ok;
-	return is_signature_ok;
+                 const CROSS_sig_t *const sig){
+    CROSS_PROBE_ENTRY(verify);
+    HASH_STATS_ENTER(HASH_STATS_VERIFY);
+    CROSS_verify_state_t state;
+    CROSS_verify_start(&state, PK, m, mlen, sig);
+    while(!CROSS_verify_step(&state, T)){
+    }
+    int is_signature_ok = CROSS_verify_finish(&state);
+    HASH_STATS_LEAVE(1);
+    CROSS_PROBE_RETURN_VALUE(verify, is_signature_ok);
+    return is_signature_ok;
+}
+
+int CROSS_verify_expanded(const pk_expanded_t *const EPK,
+                          const char *const m,
+                          const uint64_t mlen,
+                          const CROSS_sig_t *const sig){
+    CROSS_PROBE_ENTRY(verify);
+    HASH_STATS_ENTER(HASH_STATS_VERIFY);
+    CROSS_verify_state_t state;
+    CROSS_verify_start_expanded(&state, EPK, m, mlen, sig);
+    while(!CROSS_verify_step(&state, T)){
+    }
+    int is_signature_ok = CROSS_verify_finish(&state);
+    HASH_STATS_LEAVE(1);
+    CROSS_PROBE_RETURN_VALUE(verify, is_signature_ok);
+    return is_signature_ok;
 }
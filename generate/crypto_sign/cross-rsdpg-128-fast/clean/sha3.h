@@ -5,14 +5,14 @@
  * @version 2.0 (February 2025)
  *
  * Authors listed in alphabetical order:
- *
+ * 
  * @author: Alessandro Barenghi <alessandro.barenghi@polimi.it>
  * @author: Marco Gianvecchio <marco.gianvecchio@mail.polimi.it>
  * @author: Patrick Karl <patrick.karl@tum.de>
  * @author: Gerardo Pelosi <gerardo.pelosi@polimi.it>
  * @author: Jonas Schupp <jonas.schupp@tum.de>
- *
- *
+ * 
+ * 
  * This code is hereby placed in the public domain.
  *
  * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ''AS IS'' AND ANY EXPRESS
@@ -31,42 +31,47 @@
 
 #pragma once
 
+
 #include "fips202.h"
-/* standalone FIPS-202 implementation has
+/* standalone FIPS-202 implementation has 
  * different states for SHAKE depending on security level*/
 #define SHAKE_STATE_STRUCT shake128incctx
 // %%%%%%%%%%%%%%%%%% Self-contained SHAKE Wrappers %%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
 static inline
-void xof_shake_init(SHAKE_STATE_STRUCT *state, int val) {
-	shake128_inc_init(state);
-	/* avoid -Werror=unused-parameter */
-	(void)val;
+void xof_shake_init(SHAKE_STATE_STRUCT *state, int val)
+{
+   shake128_inc_init(state);
+   /* avoid -Werror=unused-parameter */
+   (void)val;
 }
 
 static inline
 void xof_shake_update(SHAKE_STATE_STRUCT *state,
                       const unsigned char *input,
-                      unsigned int inputByteLen) {
-	shake128_inc_absorb(state,
-	                    (const uint8_t *)input,
-	                    inputByteLen);
+                      unsigned int inputByteLen)
+{
+   shake128_inc_absorb(state,
+                       (const uint8_t *)input,
+                       inputByteLen);
 }
 
 static inline
-void xof_shake_final(SHAKE_STATE_STRUCT *state) {
-	shake128_inc_finalize(state);
+void xof_shake_final(SHAKE_STATE_STRUCT *state)
+{
+   shake128_inc_finalize(state);
 }
 
 static inline
 void xof_shake_extract(SHAKE_STATE_STRUCT *state,
                        unsigned char *output,
-                       unsigned int outputByteLen) {
-	shake128_inc_squeeze(output, outputByteLen, state);
+                       unsigned int outputByteLen){
+   shake128_inc_squeeze(output, outputByteLen, state);
 }
 
 /* PQClean-edit: SHAKE release context */
 static inline
-void xof_shake_release(SHAKE_STATE_STRUCT *state) {
-	shake128_inc_ctx_release(state);
+void xof_shake_release(SHAKE_STATE_STRUCT *state){
+   shake128_inc_ctx_release(state);
 }
+
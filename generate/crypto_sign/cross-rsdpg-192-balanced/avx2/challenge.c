@@ -0,0 +1,124 @@
+/**
+ *
+ * Reference ISO-C11 Implementation of CROSS.
+ *
+ * @version 2.0 (February 2025)
+ *
+ * Authors listed in alphabetical order:
+ * 
+ * @author: Alessandro Barenghi <alessandro.barenghi@polimi.it>
+ * @author: Marco Gianvecchio <marco.gianvecchio@mail.polimi.it>
+ * @author: Patrick Karl <patrick.karl@tum.de>
+ * @author: Gerardo Pelosi <gerardo.pelosi@polimi.it>
+ * @author: Jonas Schupp <jonas.schupp@tum.de>
+ * 
+ * 
+ * This code is hereby placed in the public domain.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ''AS IS'' AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **/
+
+
+#include <string.h> // memset(...)
+
+#include "challenge.h"
+#include "csprng_hash.h"
+
+/*****************************************************************************/
+void expand_digest_to_chall_2(chall_2_t *chall_2,
+                              const uint8_t digest[HASH_DIGEST_LENGTH]){
+    expand_digest_to_fixed_weight(chall_2->value, digest);
+
+    /* the challenge is public, branching on it leaks nothing */
+    memset(chall_2->bitmap, 0, sizeof(chall_2->bitmap));
+    int num_rounds_0 = 0;
+    int num_rounds_1 = 0;
+    for(int i = 0; i < T; i++){
+        if(chall_2->value[i] == 1){
+            chall_2->rounds_1[num_rounds_1] = i;
+            num_rounds_1++;
+            chall_2->bitmap[i/64] |= (uint64_t)1 << (i%64);
+        } else {
+            chall_2->rounds_0[num_rounds_0] = i;
+            num_rounds_0++;
+        }
+    }
+}
+
+/*****************************************************************************/
+/* the n <= 64 bits of bitmap starting at bit pos */
+static
+uint64_t bits_get(const uint64_t *bitmap, int pos, int n){
+    int shift = pos%64;
+    uint64_t w = bitmap[pos/64] >> shift;
+    if(shift != 0 && shift+n > 64){
+        w |= bitmap[pos/64+1] << (64-shift);
+    }
+    return w & bits_mask(n);
+}
+
+/* ORs the n <= 64 bits of w into bitmap starting at bit pos */
+static
+void bits_put(uint64_t *bitmap, int pos, uint64_t w, int n){
+    int shift = pos%64;
+    bitmap[pos/64] |= w << shift;
+    if(shift != 0 && shift+n > 64){
+        bitmap[pos/64+1] |= w >> (64-shift);
+    }
+}
+
+/*****************************************************************************/
+void tree_flags(tree_flags_t *flags,
+                const chall_2_t *chall_2,
+                uint8_t chall_value,
+                int both_children){
+    const uint16_t npl[LOG2(T)+1] = TREE_NODES_PER_LEVEL;
+    const uint16_t cons_leaves[TREE_SUBROOTS] = TREE_CONSECUTIVE_LEAVES;
+    const uint16_t leaves_start_indices[TREE_SUBROOTS] = TREE_LEAVES_START_INDICES;
+
+    memset(flags, 0, sizeof(*flags));
+
+    /* the leaves of each subroot are consecutive in a level, and so are
+     * their rounds in the bitmap of the challenge */
+    int round = 0;
+    for (int i = 0; i < TREE_SUBROOTS; i++) {
+        int level = 0;
+        int pos = leaves_start_indices[i];
+        while (pos >= npl[level]) {
+            pos -= npl[level];
+            level++;
+        }
+        for (int j = 0; j < cons_leaves[i]; j += 64) {
+            int n = (cons_leaves[i]-j < 64) ? cons_leaves[i]-j : 64;
+            uint64_t w = bits_get(chall_2->bitmap, round+j, n);
+            if (chall_value == 0) {
+                w = ~w & bits_mask(n);
+            }
+            bits_put(flags->level[level], pos+j, w, n);
+        }
+        round += cons_leaves[i];
+    }
+
+    /* the internal nodes of a level are the leftmost ones, the parents of
+     * the 64 nodes in a word are 32 contiguous ones; bits past the end of a
+     * level are clear and yield clear parents, thus the leaves of the level
+     * above are left untouched */
+    for (int level = LOG2(T); level > 0; level--) {
+        for (int c = 0; 64*c < npl[level]; c++) {
+            uint64_t w = flags->level[level][c];
+            w = both_children ? (w & (w >> 1)) : (w | (w >> 1));
+            flags->level[level-1][c/2] |= bits_compress(w) << (32*(c%2));
+        }
+    }
+}
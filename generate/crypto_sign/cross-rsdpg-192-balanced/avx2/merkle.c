@@ -5,14 +5,14 @@
  * @version 2.0 (February 2025)
  *
  * Authors listed in alphabetical order:
- *
+ * 
  * @author: Alessandro Barenghi <alessandro.barenghi@polimi.it>
  * @author: Marco Gianvecchio <marco.gianvecchio@mail.polimi.it>
  * @author: Patrick Karl <patrick.karl@tum.de>
  * @author: Gerardo Pelosi <gerardo.pelosi@polimi.it>
  * @author: Jonas Schupp <jonas.schupp@tum.de>
- *
- *
+ * 
+ * 
  * This code is hereby placed in the public domain.
  *
  * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ''AS IS'' AND ANY EXPRESS
@@ -33,10 +33,12 @@
 #include <string.h>
 
 #include "csprng_hash.h"
+#include "hash_stats.h"
 #include "merkle_tree.h"
 #include "parameters.h"
+#include "tree_tables.h"
+
 
-#define PARENT(i) ( ((i)%2) ? (((i)-1)/2) : (((i)-2)/2) )
 #define SIBLING(i) ( ((i)%2) ? (i)+1 : (i)-1 )
 
 #define CHALLENGE_PROOF_VALUE 0
@@ -46,218 +48,397 @@
 /*****************************************************************************/
 static
 void place_cmt_on_leaves(unsigned char merkle_tree[NUM_NODES_MERKLE_TREE *
-                         HASH_DIGEST_LENGTH],
-                         unsigned char commitments[T][HASH_DIGEST_LENGTH]) {
-	const uint16_t cons_leaves[TREE_SUBROOTS] = TREE_CONSECUTIVE_LEAVES;
-	const uint16_t leaves_start_indices[TREE_SUBROOTS] = TREE_LEAVES_START_INDICES;
-
-	unsigned int cnt = 0;
-	for (size_t i = 0; i < TREE_SUBROOTS; i++) {
-		for (size_t j = 0; j < cons_leaves[i]; j++) {
-			memcpy(merkle_tree + (leaves_start_indices[i] + j)*HASH_DIGEST_LENGTH,
-			       commitments + cnt,
-			       HASH_DIGEST_LENGTH);
-			cnt++;
-		}
-	}
+                                                 HASH_DIGEST_LENGTH],
+                       unsigned char commitments[T][HASH_DIGEST_LENGTH])
+{
+    for (size_t i=0; i<T; i++) {
+        memcpy(merkle_tree + TREE_LEAF_NODES[i]*HASH_DIGEST_LENGTH,
+               commitments + i,
+               HASH_DIGEST_LENGTH);
+    }
+}
+
+/*****************************************************************************/
+void tree_root(uint8_t root[HASH_DIGEST_LENGTH],
+               unsigned char tree[NUM_NODES_MERKLE_TREE *HASH_DIGEST_LENGTH],
+               unsigned char leaves[T][HASH_DIGEST_LENGTH])
+{
+    /* npl contains the number of nodes per level.
+     * leaves_start_indices contains the index of the leftmost leaf of each full binary subtree
+     */
+    const uint16_t npl[LOG2(T)+1] = TREE_NODES_PER_LEVEL;
+    const uint16_t leaves_start_indices[TREE_SUBROOTS] = TREE_LEAVES_START_INDICES;
+
+    /* Place the commitments on the (unbalanced-) Merkle tree using helper arrays for indexing */
+    place_cmt_on_leaves(tree, leaves);
+
+    /* Enqueue the calls to hash */
+    int to_hash = 0;
+    unsigned char* in_pos_queue[4] = {0};
+    int out_pos_queue[4] = {0};
+
+    /* Start hashing the nodes from right to left, starting always with
+     * the left-child node */
+    unsigned int start_node = leaves_start_indices[0];
+    for (int level=LOG2(T); level>0; level--) {
+        for (int i=npl[level]-2; i>=0; i-=2) {
+            to_hash++;
+            uint16_t current_node = start_node + i;
+            uint16_t parent_node = TREE_PARENT_NODES[current_node];
+            /* Save the position of the hash outputs and copy input nodes into array */
+            in_pos_queue[to_hash-1] = tree+current_node*HASH_DIGEST_LENGTH;
+            out_pos_queue[to_hash-1] = parent_node*HASH_DIGEST_LENGTH;            
+            /* Hash in batches of 4 (or less when changing tree level) */
+            if(to_hash == 4 || i == 0) {
+                HASH_STATS_PAR(HASH_STATS_SITE_TREE_ROOT, to_hash);
+                hash_par(
+                    to_hash,
+                    tree + out_pos_queue[0],
+                    tree + out_pos_queue[1],
+                    tree + out_pos_queue[2],
+                    tree + out_pos_queue[3],
+                    in_pos_queue[0],
+                    in_pos_queue[1],
+                    in_pos_queue[2],
+                    in_pos_queue[3],
+                    2*HASH_DIGEST_LENGTH,
+                    HASH_DOMAIN_SEP_CONST,
+                    HASH_DOMAIN_SEP_CONST,
+                    HASH_DOMAIN_SEP_CONST,
+                    HASH_DOMAIN_SEP_CONST);
+                to_hash = 0;
+            }
+        }
+        start_node -= npl[level-1];
+    }
+
+    /* Root is at first position of the tree */
+    memcpy(root, tree, HASH_DIGEST_LENGTH);
 }
 
 /*****************************************************************************/
+uint8_t *tree_leaf(uint8_t tree[NUM_NODES_MERKLE_TREE*HASH_DIGEST_LENGTH],
+                   int round)
+{
+    return tree + TREE_LEAF_NODES[round]*HASH_DIGEST_LENGTH;
+}
+
+/*****************************************************************************/
+void tree_builder_init(tree_builder_t *builder)
+{
+    builder->leaves = 0;
+    builder->to_hash = 0;
+    memset(builder->is_computed, NOT_COMPUTED, sizeof(builder->is_computed));
+}
+
+static
+void tree_builder_flush(tree_builder_t *builder,
+                        uint8_t tree[NUM_NODES_MERKLE_TREE*HASH_DIGEST_LENGTH]);
+
+/* marks node as computed, and enqueues its parent if its sibling is
+ * computed as well */
 static
-void label_leaves(unsigned char flag_tree[NUM_NODES_MERKLE_TREE],
-                  const unsigned char challenge[T]) {
-	const uint16_t cons_leaves[TREE_SUBROOTS] = TREE_CONSECUTIVE_LEAVES;
-	const uint16_t leaves_start_indices[TREE_SUBROOTS] = TREE_LEAVES_START_INDICES;
-
-	unsigned int cnt = 0;
-	for (size_t i = 0; i < TREE_SUBROOTS; i++) {
-		for (size_t j = 0; j < cons_leaves[i]; j++) {
-			if (challenge[cnt] == CHALLENGE_PROOF_VALUE) {
-				flag_tree[leaves_start_indices[i] + j] = COMPUTED;
-			}
-			cnt++;
-		}
-	}
+void tree_builder_computed(tree_builder_t *builder,
+                           uint8_t tree[NUM_NODES_MERKLE_TREE*HASH_DIGEST_LENGTH],
+                           uint16_t node)
+{
+    builder->is_computed[node] = COMPUTED;
+    if (node == 0 || builder->is_computed[SIBLING(node)] == NOT_COMPUTED) {
+        return;
+    }
+    /* the left child is the one with odd index */
+    builder->queue[builder->to_hash] = (node % 2) ? node : node-1;
+    builder->to_hash++;
+    if (builder->to_hash == TREE_BUILDER_QUEUE) {
+        tree_builder_flush(builder, tree);
+    }
+}
+
+/* hashes the enqueued nodes in parallel; their parents may in turn be
+ * enqueued and hashed */
+static
+void tree_builder_flush(tree_builder_t *builder,
+                        uint8_t tree[NUM_NODES_MERKLE_TREE*HASH_DIGEST_LENGTH])
+{
+
+    int to_hash = builder->to_hash;
+    uint16_t parent_node[4];
+    unsigned char *in_pos_queue[4];
+    unsigned char *out_pos_queue[4];
+    for (int l = 0; l < 4; l++) {
+        /* unused lanes alias the first one, they are ignored */
+        uint16_t left_node = builder->queue[(l < to_hash) ? l : 0];
+        parent_node[l] = TREE_PARENT_NODES[left_node];
+        in_pos_queue[l] = tree + left_node*HASH_DIGEST_LENGTH;
+        out_pos_queue[l] = tree + parent_node[l]*HASH_DIGEST_LENGTH;
+    }
+    builder->to_hash = 0;
+
+    HASH_STATS_PAR(HASH_STATS_SITE_TREE_BUILDER, to_hash);
+    hash_par(
+        to_hash,
+        out_pos_queue[0],
+        out_pos_queue[1],
+        out_pos_queue[2],
+        out_pos_queue[3],
+        in_pos_queue[0],
+        in_pos_queue[1],
+        in_pos_queue[2],
+        in_pos_queue[3],
+        2*HASH_DIGEST_LENGTH,
+        HASH_DOMAIN_SEP_CONST,
+        HASH_DOMAIN_SEP_CONST,
+        HASH_DOMAIN_SEP_CONST,
+        HASH_DOMAIN_SEP_CONST);
+
+    for (int l = 0; l < to_hash; l++) {
+        tree_builder_computed(builder, tree, parent_node[l]);
+    }
 }
 
 /*****************************************************************************/
-void tree_root(uint8_t root[HASH_DIGEST_LENGTH],
-               unsigned char tree[NUM_NODES_MERKLE_TREE * HASH_DIGEST_LENGTH],
-               unsigned char leaves[T][HASH_DIGEST_LENGTH]) {
-	/* off contains the offsets required to move between two layers in order
-	 * to compensate for the truncation.
-	 * npl contains the number of nodes per level.
-	 * leaves_start_indices contains the index of the leftmost leaf of each full binary subtree
-	 */
-	const uint16_t off[LOG2(T) + 1] = TREE_OFFSETS;
-	const uint16_t npl[LOG2(T) + 1] = TREE_NODES_PER_LEVEL;
-	const uint16_t leaves_start_indices[TREE_SUBROOTS] = TREE_LEAVES_START_INDICES;
-
-	/* Place the commitments on the (unbalanced-) Merkle tree using helper arrays for indexing */
-	place_cmt_on_leaves(tree, leaves);
-
-	/* Enqueue the calls to hash */
-	int to_hash = 0;
-	unsigned char *in_pos_queue[4] = {0};
-	int out_pos_queue[4] = {0};
-
-	/* Start hashing the nodes from right to left, starting always with
-	 * the left-child node */
-	unsigned int start_node = leaves_start_indices[0];
-	for (int level = LOG2(T); level > 0; level--) {
-		for (int i = npl[level] - 2; i >= 0; i -= 2) {
-			to_hash++;
-			uint16_t current_node = start_node + i;
-			uint16_t parent_node = PARENT(current_node) + (off[level - 1] >> 1);
-			/* Save the position of the hash outputs and copy input nodes into array */
-			in_pos_queue[to_hash - 1] = tree + current_node * HASH_DIGEST_LENGTH;
-			out_pos_queue[to_hash - 1] = parent_node * HASH_DIGEST_LENGTH;
-			/* Hash in batches of 4 (or less when changing tree level) */
-			if (to_hash == 4 || i == 0) {
-				hash_par(
-				    to_hash,
-				    tree + out_pos_queue[0],
-				    tree + out_pos_queue[1],
-				    tree + out_pos_queue[2],
-				    tree + out_pos_queue[3],
-				    in_pos_queue[0],
-				    in_pos_queue[1],
-				    in_pos_queue[2],
-				    in_pos_queue[3],
-				    2 * HASH_DIGEST_LENGTH,
-				    HASH_DOMAIN_SEP_CONST,
-				    HASH_DOMAIN_SEP_CONST,
-				    HASH_DOMAIN_SEP_CONST,
-				    HASH_DOMAIN_SEP_CONST);
-				to_hash = 0;
-			}
-		}
-		start_node -= npl[level - 1];
-	}
-
-	/* Root is at first position of the tree */
-	memcpy(root, tree, HASH_DIGEST_LENGTH);
+void tree_builder_add(tree_builder_t *builder,
+                      uint8_t tree[NUM_NODES_MERKLE_TREE*HASH_DIGEST_LENGTH],
+                      int count)
+{
+    for (int i = 0; i < count; i++) {
+        uint8_t *leaf = tree_leaf(tree, builder->leaves + i);
+        tree_builder_computed(builder, tree, (uint16_t)((leaf - tree)/HASH_DIGEST_LENGTH));
+    }
+    builder->leaves += count;
 }
 
 /*****************************************************************************/
-uint16_t tree_proof(uint8_t mtp[HASH_DIGEST_LENGTH * TREE_NODES_TO_STORE],
-                    const uint8_t tree[NUM_NODES_MERKLE_TREE * HASH_DIGEST_LENGTH],
-                    const uint8_t leaves_to_reveal[T]) {
-	/* Label the flag tree to identify computed/valid nodes */
-	unsigned char flag_tree[NUM_NODES_MERKLE_TREE] = {NOT_COMPUTED};
-	label_leaves(flag_tree, leaves_to_reveal);
-
-	const uint16_t off[LOG2(T) + 1] = TREE_OFFSETS;
-	const uint16_t npl[LOG2(T) + 1] = TREE_NODES_PER_LEVEL;
-	const uint16_t leaves_start_indices[TREE_SUBROOTS] = TREE_LEAVES_START_INDICES;
-
-	int published = 0;
-	unsigned int start_node = leaves_start_indices[0];
-	for (int level = LOG2(T); level > 0; level--) {
-		for (int i = npl[level] - 2; i >= 0; i -= 2) {
-			uint16_t current_node = start_node + i;
-			uint16_t parent_node = PARENT(current_node) + (off[level - 1] >> 1);
-
-			flag_tree[parent_node] = (flag_tree[current_node] == COMPUTED) || (flag_tree[SIBLING(current_node)] == COMPUTED);
-
-			/* Add left sibling only if right one was computed but left wasn't */
-			if ( (flag_tree[current_node] == NOT_COMPUTED) && (flag_tree[SIBLING(current_node)] == COMPUTED) ) {
-				memcpy(mtp + published * HASH_DIGEST_LENGTH, tree + current_node * HASH_DIGEST_LENGTH, HASH_DIGEST_LENGTH);
-				published++;
-			}
-
-			/* Add right sibling only if left was computed but right wasn't */
-			if ( (flag_tree[current_node] == COMPUTED) && (flag_tree[SIBLING(current_node)] == NOT_COMPUTED) ) {
-				memcpy(mtp + published * HASH_DIGEST_LENGTH, tree + SIBLING(current_node)*HASH_DIGEST_LENGTH, HASH_DIGEST_LENGTH);
-				published++;
-			}
-		}
-		start_node -= npl[level - 1];
-	}
-	return published;
+void tree_builder_root(tree_builder_t *builder,
+                       uint8_t root[HASH_DIGEST_LENGTH],
+                       uint8_t tree[NUM_NODES_MERKLE_TREE*HASH_DIGEST_LENGTH])
+{
+    /* the nodes close to the root are fewer than the hashes computed at once */
+    while (builder->to_hash > 0) {
+        tree_builder_flush(builder, tree);
+    }
+    /* Root is at first position of the tree */
+    memcpy(root, tree, HASH_DIGEST_LENGTH);
+}
+
+/*****************************************************************************/
+uint16_t tree_proof(uint8_t mtp[HASH_DIGEST_LENGTH*TREE_NODES_TO_STORE],
+                               const uint8_t tree[NUM_NODES_MERKLE_TREE*HASH_DIGEST_LENGTH],
+                               const chall_2_t *chall_2)
+{
+    /* flags of the nodes the verifier computes, i.e., having in their
+     * subtree the leaf of a round where the challenge is
+     * CHALLENGE_PROOF_VALUE */
+    tree_flags_t flags;
+    tree_flags(&flags, chall_2, CHALLENGE_PROOF_VALUE, 0);
+
+    const uint16_t npl[LOG2(T)+1] = TREE_NODES_PER_LEVEL;
+    const uint16_t leaves_start_indices[TREE_SUBROOTS] = TREE_LEAVES_START_INDICES;
+
+    int published = 0;
+    unsigned int start_node = leaves_start_indices[0];
+    for (int level=LOG2(T); level>0; level--) {
+        /* Add the nodes which were not computed while their sibling was,
+         * from right to left */
+        for (int c=(npl[level]-1)/64; c>=0; c--) {
+            uint64_t to_publish = tree_flags_siblings(&flags, level, c);
+            while (to_publish != 0) {
+                int pos = bits_highest(to_publish);
+                to_publish ^= (uint64_t)1 << pos;
+                memcpy(mtp + published*HASH_DIGEST_LENGTH, tree + (start_node+64*c+pos)*HASH_DIGEST_LENGTH, HASH_DIGEST_LENGTH);
+                published++;
+            }
+        }
+        start_node -= npl[level-1];
+    }
+    return published;
+}
+
+/*****************************************************************************/
+/* hashes the to_hash <= 4 sibling pairs at in_pos_queue into their parents
+ * at out_pos_queue */
+static
+void hash_queued_pairs(unsigned char tree[NUM_NODES_MERKLE_TREE * HASH_DIGEST_LENGTH],
+                       int to_hash,
+                       const int in_pos_queue[4],
+                       const int out_pos_queue[4])
+{
+    HASH_STATS_PAR(HASH_STATS_SITE_RECOMPUTE_ROOT, to_hash);
+    hash_par(
+        to_hash,
+        tree + out_pos_queue[0],
+        tree + out_pos_queue[1],
+        tree + out_pos_queue[2],
+        tree + out_pos_queue[3],
+        tree + in_pos_queue[0],
+        tree + in_pos_queue[1],
+        tree + in_pos_queue[2],
+        tree + in_pos_queue[3],
+        2*HASH_DIGEST_LENGTH,
+        HASH_DOMAIN_SEP_CONST,
+        HASH_DOMAIN_SEP_CONST,
+        HASH_DOMAIN_SEP_CONST,
+        HASH_DOMAIN_SEP_CONST);
+}
+
+void recompute_root_init(tree_recompute_t *recompute,
+                         uint8_t tree[NUM_NODES_MERKLE_TREE*HASH_DIGEST_LENGTH],
+                         uint8_t recomputed_leaves[T][HASH_DIGEST_LENGTH],
+                         const chall_2_t *chall_2)
+{
+    const uint16_t npl[LOG2(T)+1] = TREE_NODES_PER_LEVEL;
+    const uint16_t leaves_start_indices[TREE_SUBROOTS] = TREE_LEAVES_START_INDICES;
+
+    place_cmt_on_leaves(tree, recomputed_leaves);
+    /* flags of the nodes the verifier computes, i.e., having in their
+     * subtree the leaf of a round where the challenge is
+     * CHALLENGE_PROOF_VALUE */
+    tree_flags(&recompute->flags, chall_2, CHALLENGE_PROOF_VALUE, 0);
+
+    recompute->level = LOG2(T);
+    recompute->c = (npl[LOG2(T)]-1)/64;
+    recompute->start_node = leaves_start_indices[0];
+    recompute->word_level = LOG2(T);
+    recompute->word_node = leaves_start_indices[0];
+    recompute->computed = 0;
+    recompute->to_hash = 0;
+    recompute->published = 0;
+}
+
+/*****************************************************************************/
+int recompute_root_step(tree_recompute_t *recompute,
+                        uint8_t tree[NUM_NODES_MERKLE_TREE*HASH_DIGEST_LENGTH],
+                        const uint8_t mtp[HASH_DIGEST_LENGTH*TREE_NODES_TO_STORE],
+                        int max_nodes)
+{
+    const uint16_t npl[LOG2(T)+1] = TREE_NODES_PER_LEVEL;
+
+    /* Enqueue the calls to hash */
+    int to_hash = 0;
+    int in_pos_queue[4] = {0};
+    int out_pos_queue[4] = {0};
+
+    for (;;) {
+        /* hash the siblings of which at least one was computed, from right
+         * to left */
+        while (recompute->to_hash != 0 && max_nodes > 0) {
+            int pos = bits_highest(recompute->to_hash);
+            recompute->to_hash ^= (uint64_t)1 << pos;
+            max_nodes--;
+            uint64_t computed = recompute->computed;
+            uint16_t current_node = recompute->word_node + pos;
+            uint16_t parent_node = TREE_PARENT_NODES[current_node];
+
+            to_hash++;
+            in_pos_queue[to_hash-1] = current_node*HASH_DIGEST_LENGTH;
+            out_pos_queue[to_hash-1] = parent_node*HASH_DIGEST_LENGTH;
+
+            /* If the left sibling was not computed take it from the merkle proof */
+            if (!((computed >> pos) & 1)) {
+                memcpy(tree + current_node*HASH_DIGEST_LENGTH, mtp+recompute->published*HASH_DIGEST_LENGTH, HASH_DIGEST_LENGTH);
+                recompute->published++;
+            }
+
+            /* If the right sibling was not computed take it from the merkle proof */
+            if (!((computed >> (pos+1)) & 1)) {
+                memcpy(tree + current_node*HASH_DIGEST_LENGTH + HASH_DIGEST_LENGTH, mtp + recompute->published*HASH_DIGEST_LENGTH, HASH_DIGEST_LENGTH);
+                recompute->published++;
+            }
+
+            /* Hash in batches of 4 */
+            if (to_hash == 4) {
+                hash_queued_pairs(tree, to_hash, in_pos_queue, out_pos_queue);
+                to_hash = 0;
+            }
+        }
+        if (recompute->to_hash != 0 || max_nodes == 0 || recompute->level == 0) {
+            break;
+        }
+
+        /* the remaining ones, before moving to the parents level */
+        if (to_hash > 0 && recompute->level != recompute->word_level) {
+            hash_queued_pairs(tree, to_hash, in_pos_queue, out_pos_queue);
+            to_hash = 0;
+        }
+
+        /* the next word, the levels are taken from the leaves up */
+        int level = recompute->level;
+        int c = recompute->c;
+        recompute->computed = recompute->flags.level[level][c];
+        recompute->to_hash = tree_flags_pairs(&recompute->flags, level, c);
+        recompute->word_level = level;
+        recompute->word_node = recompute->start_node + 64*c;
+
+        recompute->c--;
+        if (recompute->c < 0) {
+            recompute->start_node -= npl[level-1];
+            recompute->level--;
+            recompute->c = (npl[recompute->level]-1)/64;
+        }
+    }
+
+    /* the ones left at the end of the step */
+    if (to_hash > 0) {
+        hash_queued_pairs(tree, to_hash, in_pos_queue, out_pos_queue);
+    }
+    return recompute->to_hash == 0 && recompute->level == 0;
+}
+
+/*****************************************************************************/
+uint8_t recompute_root_finish(const tree_recompute_t *recompute,
+                              uint8_t root[HASH_DIGEST_LENGTH],
+                              const uint8_t tree[NUM_NODES_MERKLE_TREE*HASH_DIGEST_LENGTH],
+                              const uint8_t mtp[HASH_DIGEST_LENGTH*TREE_NODES_TO_STORE])
+{
+    /* Root is at first position of the tree */
+    memcpy(root, tree, HASH_DIGEST_LENGTH);
+
+    // Check for correct zero padding in the remaining parth of the Merkle proof to 
+    // prevent trivial forgery
+    uint8_t error = 0;
+    for (int i=recompute->published*HASH_DIGEST_LENGTH; i<TREE_NODES_TO_STORE*HASH_DIGEST_LENGTH; i++) {
+        error |= mtp[i];
+    }
+    return (error == 0);
 }
 
 /*****************************************************************************/
 uint8_t recompute_root(uint8_t root[HASH_DIGEST_LENGTH],
                        uint8_t recomputed_leaves[T][HASH_DIGEST_LENGTH],
-                       const uint8_t mtp[HASH_DIGEST_LENGTH * TREE_NODES_TO_STORE],
-                       const uint8_t leaves_to_reveal[T]) {
-	unsigned char tree[NUM_NODES_MERKLE_TREE * HASH_DIGEST_LENGTH];
-	unsigned char flag_tree[NUM_NODES_MERKLE_TREE] = {NOT_COMPUTED};
-
-	place_cmt_on_leaves(tree, recomputed_leaves);
-	label_leaves(flag_tree, leaves_to_reveal);
-
-	const uint16_t off[LOG2(T) + 1] = TREE_OFFSETS;
-	const uint16_t npl[LOG2(T) + 1] = TREE_NODES_PER_LEVEL;
-	const uint16_t leaves_start_indices[TREE_SUBROOTS] = TREE_LEAVES_START_INDICES;
-
-	/* Enqueue the calls to hash */
-	int to_hash = 0;
-	int in_pos_queue[4] = {0};
-	int out_pos_queue[4] = {0};
-
-	unsigned int published = 0;
-	unsigned int start_node = leaves_start_indices[0];
-	for (int level = LOG2(T); level > 0; level--) {
-		for (int i = npl[level] - 2; i >= 0; i -= 2) {
-			uint16_t current_node = start_node + i;
-			uint16_t parent_node = PARENT(current_node) + (off[level - 1] >> 1);
-
-			uint8_t are_both_siblings_unused = flag_tree[current_node] == NOT_COMPUTED && flag_tree[SIBLING(current_node)] == NOT_COMPUTED;
-			if (!are_both_siblings_unused) {
-
-				/* At least one of the siblings is valid: there is a hash to compute */
-				to_hash++;
-				in_pos_queue[to_hash - 1] = current_node * HASH_DIGEST_LENGTH;
-				out_pos_queue[to_hash - 1] = parent_node * HASH_DIGEST_LENGTH;
-
-				/* If the left sibling was not computed take it from the merkle proof */
-				if (!(flag_tree[current_node] == COMPUTED)) {
-					memcpy(tree + current_node * HASH_DIGEST_LENGTH, mtp + published * HASH_DIGEST_LENGTH, HASH_DIGEST_LENGTH);
-					published++;
-				}
-
-				/* If the right sibling was not computed take it from the merkle proof */
-				if (!(flag_tree[SIBLING(current_node)] == COMPUTED)) {
-					memcpy(tree + current_node * HASH_DIGEST_LENGTH + HASH_DIGEST_LENGTH, mtp + published * HASH_DIGEST_LENGTH, HASH_DIGEST_LENGTH);
-					published++;
-				}
-
-				flag_tree[parent_node] = COMPUTED;
-			}
-
-			/* Hash in batches of 4 (or less when changing tree level) */
-			if (to_hash == 4 || i == 0) {
-				hash_par(
-				    to_hash,
-				    tree + out_pos_queue[0],
-				    tree + out_pos_queue[1],
-				    tree + out_pos_queue[2],
-				    tree + out_pos_queue[3],
-				    tree + in_pos_queue[0],
-				    tree + in_pos_queue[1],
-				    tree + in_pos_queue[2],
-				    tree + in_pos_queue[3],
-				    2 * HASH_DIGEST_LENGTH,
-				    HASH_DOMAIN_SEP_CONST,
-				    HASH_DOMAIN_SEP_CONST,
-				    HASH_DOMAIN_SEP_CONST,
-				    HASH_DOMAIN_SEP_CONST);
-				to_hash = 0;
-			}
-		}
-		start_node -= npl[level - 1];
-	}
-
-	/* Root is at first position of the tree */
-	memcpy(root, tree, HASH_DIGEST_LENGTH);
-
-	// Check for correct zero padding in the remaining parth of the Merkle proof to
-	// prevent trivial forgery
-	uint8_t error = 0;
-	for (int i = published * HASH_DIGEST_LENGTH; i < TREE_NODES_TO_STORE * HASH_DIGEST_LENGTH; i++) {
-		error |= mtp[i];
-	}
-	return (error == 0);
+                       const uint8_t mtp[HASH_DIGEST_LENGTH*TREE_NODES_TO_STORE],
+                       const chall_2_t *chall_2)
+{
+    unsigned char tree[NUM_NODES_MERKLE_TREE * HASH_DIGEST_LENGTH];
+    tree_recompute_t recompute;
+
+    recompute_root_init(&recompute, tree, recomputed_leaves, chall_2);
+    recompute_root_step(&recompute, tree, mtp, NUM_NODES_MERKLE_TREE);
+    return recompute_root_finish(&recompute, root, tree, mtp);
+}
+
+/*****************************************************************************/
+/* counts the digests recompute_root would take from the proof, without
+ * hashing, and checks the zero padding after them */
+uint8_t is_tree_proof_padding_ok(const uint8_t mtp[HASH_DIGEST_LENGTH*TREE_NODES_TO_STORE],
+                                 const chall_2_t *chall_2)
+{
+    tree_flags_t flags;
+    tree_flags(&flags, chall_2, CHALLENGE_PROOF_VALUE, 0);
+
+    const uint16_t npl[LOG2(T)+1] = TREE_NODES_PER_LEVEL;
+
+    /* exactly one of the siblings is taken from the proof, if the other one
+     * is computed */
+    unsigned int published = 0;
+    for (int level=LOG2(T); level>0; level--) {
+        for (int c=0; 64*c < npl[level]; c++) {
+            published += bits_count(tree_flags_siblings(&flags, level, c));
+        }
+    }
+
+    uint8_t error = 0;
+    for (int i=published*HASH_DIGEST_LENGTH; i<TREE_NODES_TO_STORE*HASH_DIGEST_LENGTH; i++) {
+        error |= mtp[i];
+    }
+    return (error == 0);
 }
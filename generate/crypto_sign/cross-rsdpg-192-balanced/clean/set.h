@@ -24,3 +24,17 @@
 /* Target */
 #undef SPEED
 #undef SIG_SIZE
+/* Extensions and their tunables, off unless requested on the command line,
+ * so that the generated implementations carry none of them (see also
+ * utility.py) */
+#undef HASH_STATS
+#undef PK_CACHE
+#undef PK_CACHE_BUDGET_BYTES
+#undef PK_CACHE_SHARDS
+#undef PK_EXPANDED_FILE
+#undef PRESIG_POOL
+#undef RNG_POOL
+#undef RNG_POOL_BYTES
+#undef RNG_POOL_RESEED_INTERVAL
+#undef USDT_PROBES
+#undef VERIFY_EARLY_REJECT
@@ -5,14 +5,14 @@
  * @version 2.0 (February 2025)
  *
  * Authors listed in alphabetical order:
- *
+ * 
  * @author: Alessandro Barenghi <alessandro.barenghi@polimi.it>
  * @author: Marco Gianvecchio <marco.gianvecchio@mail.polimi.it>
  * @author: Patrick Karl <patrick.karl@tum.de>
  * @author: Gerardo Pelosi <gerardo.pelosi@polimi.it>
  * @author: Jonas Schupp <jonas.schupp@tum.de>
- *
- *
+ * 
+ * 
  * This code is hereby placed in the public domain.
  *
  * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ''AS IS'' AND ANY EXPRESS
@@ -67,35 +67,37 @@
 /* log reduction, constant time unrolled S&M w/precomputed squares.
  * To be further optimized with muxed register-fitting tables */
 static inline
-FP_ELEM RESTR_TO_VAL(FP_ELEM x) {
-	uint32_t res1, res2, res3, res4;
-	res1 = ( FP_ELEM_CMOV(((x >> 0) & 1), RESTR_G_GEN_1, 1)) *
-	       ( FP_ELEM_CMOV(((x >> 1) & 1), RESTR_G_GEN_2, 1)) ;
-	res2 = ( FP_ELEM_CMOV(((x >> 2) & 1), RESTR_G_GEN_4, 1)) *
-	       ( FP_ELEM_CMOV(((x >> 3) & 1), RESTR_G_GEN_8, 1)) ;
-	res3 = ( FP_ELEM_CMOV(((x >> 4) & 1), RESTR_G_GEN_16, 1)) *
-	       ( FP_ELEM_CMOV(((x >> 5) & 1), RESTR_G_GEN_32, 1)) ;
-	res4 =   FP_ELEM_CMOV(((x >> 6) & 1), RESTR_G_GEN_64, 1);
-
-	/* Two intermediate reductions necessary:
-	 *     RESTR_G_GEN_1*RESTR_G_GEN_2*RESTR_G_GEN_4*RESTR_G_GEN_8    < 2^32
-	 *     RESTR_G_GEN_16*RESTR_G_GEN_32*RESTR_G_GEN_64               < 2^32 */
-	return FPRED_SINGLE( FPRED_SINGLE(res1 * res2) * FPRED_SINGLE(res3 * res4) );
+FP_ELEM RESTR_TO_VAL(FP_ELEM x){
+    uint32_t res1, res2, res3, res4;
+    res1 = ( FP_ELEM_CMOV(((x >> 0) &1),RESTR_G_GEN_1 ,1)) *
+           ( FP_ELEM_CMOV(((x >> 1) &1),RESTR_G_GEN_2 ,1)) ;
+    res2 = ( FP_ELEM_CMOV(((x >> 2) &1),RESTR_G_GEN_4 ,1)) *
+           ( FP_ELEM_CMOV(((x >> 3) &1),RESTR_G_GEN_8 ,1)) ;
+    res3 = ( FP_ELEM_CMOV(((x >> 4) &1),RESTR_G_GEN_16,1)) *
+           ( FP_ELEM_CMOV(((x >> 5) &1),RESTR_G_GEN_32,1)) ;
+    res4 =   FP_ELEM_CMOV(((x >> 6) &1),RESTR_G_GEN_64,1);
+
+    /* Two intermediate reductions necessary:
+     *     RESTR_G_GEN_1*RESTR_G_GEN_2*RESTR_G_GEN_4*RESTR_G_GEN_8    < 2^32
+     *     RESTR_G_GEN_16*RESTR_G_GEN_32*RESTR_G_GEN_64               < 2^32 */
+    return FPRED_SINGLE( FPRED_SINGLE(res1 * res2) * FPRED_SINGLE(res3 * res4) );
 }
 
+
+
 /* in-place normalization of redundant zero representation for syndromes*/
 static inline
-void fp_dz_norm_synd(FP_ELEM v[N - K]) {
-	for (int i = 0; i < N - K; i++) {
-		v[i] = FP_DOUBLE_ZERO_NORM(v[i]);
-	}
+void fp_dz_norm_synd(FP_ELEM v[N-K]){
+    for (int i = 0; i < N-K; i++){
+       v[i] = FP_DOUBLE_ZERO_NORM(v[i]);
+    }
 }
 
 static inline
-void fp_dz_norm(FP_ELEM v[N]) {
-	for (int i = 0; i < N; i++) {
-		v[i] = FP_DOUBLE_ZERO_NORM(v[i]);
-	}
+void fp_dz_norm(FP_ELEM v[N]){
+    for (int i = 0; i < N; i++){
+       v[i] = FP_DOUBLE_ZERO_NORM(v[i]);
+    }
 }
 /* Computes the product e*H of an n-element restricted vector by a (n-k)*n
  * FP H is in systematic form. Only the non systematic portion of H =[V I],
@@ -103,53 +105,53 @@ void fp_dz_norm(FP_ELEM v[N]) {
  * computation is vectorizable. */
 
 static
-void restr_vec_by_fp_matrix(FP_ELEM res[N - K],
+void restr_vec_by_fp_matrix(FP_ELEM res[N-K],
                             FZ_ELEM e[N],
-                            FP_ELEM V_tr[K][N - K]) {
-	for (int i = K ; i < N; i++) {
-		res[i - K] = RESTR_TO_VAL(e[i]);
-	}
-	for (int i = 0; i < K; i++) {
-		for (int j = 0; j < N - K; j++) {
-			res[j] = FPRED_DOUBLE( (FP_DOUBLEPREC) res[j] +
-			                       (FP_DOUBLEPREC) RESTR_TO_VAL(e[i]) *
-			                       (FP_DOUBLEPREC) V_tr[i][j]);
-		}
-	}
+                            FP_ELEM V_tr[K][N-K]){
+    for (int i = K ;i < N; i++){
+       res[i-K] = RESTR_TO_VAL(e[i]);
+    }
+    for(int i = 0; i < K; i++){
+       for(int j = 0; j < N-K; j++){
+           res[j] = FPRED_DOUBLE( (FP_DOUBLEPREC) res[j] +
+                                  (FP_DOUBLEPREC) RESTR_TO_VAL(e[i]) *
+                                  (FP_DOUBLEPREC) V_tr[i][j]);
+       }
+    }
 }
 
 static
-void fp_vec_by_fp_matrix(FP_ELEM res[N - K],
+void fp_vec_by_fp_matrix(FP_ELEM res[N-K],
                          FP_ELEM e[N],
-                         FP_ELEM V_tr[K][N - K]) {
-	memcpy(res, e + K, (N - K)*sizeof(FP_ELEM));
-	for (int i = 0; i < K; i++) {
-		for (int j = 0; j < N - K; j++) {
-			res[j] = FPRED_DOUBLE( (FP_DOUBLEPREC) res[j] +
-			                       (FP_DOUBLEPREC) e[i] *
-			                       (FP_DOUBLEPREC) V_tr[i][j]);
-		}
-	}
+                         FP_ELEM V_tr[K][N-K]){
+    memcpy(res,e+K,(N-K)*sizeof(FP_ELEM));
+    for(int i = 0; i < K; i++){
+       for(int j = 0; j < N-K; j++){
+           res[j] = FPRED_DOUBLE( (FP_DOUBLEPREC) res[j] +
+                                  (FP_DOUBLEPREC) e[i] *
+                                  (FP_DOUBLEPREC) V_tr[i][j]);
+       }
+    }
 }
 
 static inline
 void fp_vec_by_fp_vec_pointwise(FP_ELEM res[N],
                                 const FP_ELEM in1[N],
-                                const FP_ELEM in2[N]) {
-	for (int i = 0; i < N; i++) {
-		res[i] = FPRED_DOUBLE( (FP_DOUBLEPREC) in1[i] *
-		                       (FP_DOUBLEPREC) in2[i] );
-	}
+                                const FP_ELEM in2[N]){
+    for(int i = 0; i < N; i++){
+        res[i] = FPRED_DOUBLE( (FP_DOUBLEPREC) in1[i] *
+                               (FP_DOUBLEPREC) in2[i] );
+    }
 }
 
 static inline
 void restr_by_fp_vec_pointwise(FP_ELEM res[N],
-                               const FZ_ELEM in1[N],
-                               const FP_ELEM in2[N]) {
-	for (int i = 0; i < N; i++) {
-		res[i] = FPRED_DOUBLE( (FP_DOUBLEPREC) RESTR_TO_VAL(in1[i]) *
-		                       (FP_DOUBLEPREC) in2[i]);
-	}
+                                const FZ_ELEM in1[N],
+                                const FP_ELEM in2[N]){
+    for(int i = 0; i < N; i++){
+        res[i] = FPRED_DOUBLE( (FP_DOUBLEPREC) RESTR_TO_VAL(in1[i]) *
+                               (FP_DOUBLEPREC) in2[i]);
+    }
 }
 
 /* e*chall_1 + u_prime*/
@@ -157,29 +159,30 @@ static inline
 void fp_vec_by_restr_vec_scaled(FP_ELEM res[N],
                                 const FZ_ELEM e[N],
                                 const FP_ELEM chall_1,
-                                const FP_ELEM u_prime[N]) {
-	for (int i = 0; i < N; i++) {
-		res[i] = FPRED_DOUBLE( (FP_DOUBLEPREC) u_prime[i] +
-		                       (FP_DOUBLEPREC) RESTR_TO_VAL(e[i]) * (FP_DOUBLEPREC) chall_1) ;
-	}
+                                const FP_ELEM u_prime[N]){
+    for(int i = 0; i < N; i++){
+        res[i] = FPRED_DOUBLE( (FP_DOUBLEPREC) u_prime[i] +
+                               (FP_DOUBLEPREC) RESTR_TO_VAL(e[i]) * (FP_DOUBLEPREC) chall_1) ;
+    }
 }
 
+
 static inline
-void fp_synd_minus_fp_vec_scaled(FP_ELEM res[N - K],
-                                 const FP_ELEM synd[N - K],
+void fp_synd_minus_fp_vec_scaled(FP_ELEM res[N-K],
+                                 const FP_ELEM synd[N-K],
                                  const FP_ELEM chall_1,
-                                 const FP_ELEM s[N - K]) {
-	for (int j = 0; j < N - K; j++) {
-		FP_ELEM tmp = FPRED_DOUBLE( (FP_DOUBLEPREC) s[j] * (FP_DOUBLEPREC) chall_1);
-		tmp = FP_DOUBLE_ZERO_NORM(tmp);
-		res[j] = FPRED_SINGLE( (FP_DOUBLEPREC) synd[j] + FPRED_OPPOSITE(tmp) );
-	}
+                                 const FP_ELEM s[N-K]){
+    for(int j = 0; j < N-K; j++){
+        FP_ELEM tmp = FPRED_DOUBLE( (FP_DOUBLEPREC) s[j] * (FP_DOUBLEPREC) chall_1);
+        tmp = FP_DOUBLE_ZERO_NORM(tmp);
+        res[j] = FPRED_SINGLE( (FP_DOUBLEPREC) synd[j] + FPRED_OPPOSITE(tmp) );
+    }
 }
 
 static inline
 void convert_restr_vec_to_fp(FP_ELEM res[N],
-                             const FZ_ELEM in[N]) {
-	for (int j = 0; j < N; j++) {
-		res[j] = RESTR_TO_VAL(in[j]);
-	}
+                            const FZ_ELEM in[N]){
+    for(int j = 0; j < N; j++){
+        res[j] = RESTR_TO_VAL(in[j]);
+    }
 }
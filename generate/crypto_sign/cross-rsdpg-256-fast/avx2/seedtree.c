@@ -5,14 +5,14 @@
  * @version 2.0 (February 2025)
  *
  * Authors listed in alphabetical order:
- *
+ * 
  * @author: Alessandro Barenghi <alessandro.barenghi@polimi.it>
  * @author: Marco Gianvecchio <marco.gianvecchio@mail.polimi.it>
  * @author: Patrick Karl <patrick.karl@tum.de>
  * @author: Gerardo Pelosi <gerardo.pelosi@polimi.it>
  * @author: Jonas Schupp <jonas.schupp@tum.de>
- *
- *
+ * 
+ * 
  * This code is hereby placed in the public domain.
  *
  * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ''AS IS'' AND ANY EXPRESS
@@ -33,7 +33,9 @@
 #include <string.h> // memcpy(...), memset(...)
 
 #include "csprng_hash.h"
+#include "hash_stats.h"
 #include "seedtree.h"
+#include "tree_tables.h"
 
 #define LEFT_CHILD(i) (2*(i)+1)
 #define RIGHT_CHILD(i) (2*(i)+2)
@@ -45,116 +47,110 @@
  */
 
 #define TO_PUBLISH 1
-#define NOT_TO_PUBLISH 0
 
-int seed_leaves(unsigned char rounds_seeds[T * SEED_LENGTH_BYTES],
+int seed_leaves(unsigned char rounds_seeds[T*SEED_LENGTH_BYTES],
                 const unsigned char root_seed[SEED_LENGTH_BYTES],
-                const unsigned char salt[SALT_LENGTH_BYTES]) {
-
-	CSPRNG_STATE_T single_csprng_state;
-	PAR_CSPRNG_STATE_T par_csprng_state;
-
-	/* CSPRNG input: seed | salt | domain separation counter (0 to 4) */
-	unsigned char single_csprng_input[CSPRNG_INPUT_LENGTH];
-	unsigned char par_csprng_input[4][CSPRNG_INPUT_LENGTH];
-	unsigned char par_csprng_output[4][(T / 4 + 1)*SEED_LENGTH_BYTES];
-
-	/* copy the root seed and the salt */
-	memcpy(single_csprng_input, root_seed, SEED_LENGTH_BYTES);
-	memcpy(single_csprng_input + SEED_LENGTH_BYTES, salt, SALT_LENGTH_BYTES);
-
-	/* call the CSPRNG once to generate 4 intermediate seeds */
-	unsigned char quad_seed[4 * SEED_LENGTH_BYTES];
-	csprng_initialize(&single_csprng_state, single_csprng_input, CSPRNG_INPUT_LENGTH, 0);
-	csprng_randombytes(quad_seed, 4 * SEED_LENGTH_BYTES, &single_csprng_state);
-	/* PQClean-edit: CSPRNG release context */
-	csprng_release(&single_csprng_state);
-
-	memset(par_csprng_input, 0, 4 * CSPRNG_INPUT_LENGTH);
-
-	/* copy the salt */
-	for (int i = 0; i < 4; i++) {
-		memcpy(par_csprng_input[i] + SEED_LENGTH_BYTES, salt, SALT_LENGTH_BYTES);
-	}
-
-	int remainders[4] = {0};
-	if (T % 4 > 0) {
-		remainders[0] = 1;
-	}
-	if (T % 4 > 1) {
-		remainders[1] = 1;
-	}
-	if (T % 4 > 2) {
-		remainders[2] = 1;
-	}
-
-	/* copy the 4 intermediate seeds */
-	for (int i = 0; i < 4; i++) {
-		memcpy(par_csprng_input[i], &quad_seed[i * SEED_LENGTH_BYTES], SEED_LENGTH_BYTES);
-	}
-
-	/* make 4 (parallel) calls to the CSPRNG */
-	csprng_initialize_par(
-	    4,
-	    &par_csprng_state,
-	    par_csprng_input[0],
-	    par_csprng_input[1],
-	    par_csprng_input[2],
-	    par_csprng_input[3],
-	    CSPRNG_INPUT_LENGTH,
-	    CSPRNG_DOMAIN_SEP_CONST + 1,
-	    CSPRNG_DOMAIN_SEP_CONST + 2,
-	    CSPRNG_DOMAIN_SEP_CONST + 3,
-	    CSPRNG_DOMAIN_SEP_CONST + 4);
-	csprng_randombytes_par(
-	    4,
-	    &par_csprng_state,
-	    par_csprng_output[0],
-	    par_csprng_output[1],
-	    par_csprng_output[2],
-	    par_csprng_output[3],
-	    (T / 4 + 1)*SEED_LENGTH_BYTES);
-	/* PQClean-edit: CSPRNG release context */
-	csprng_release_par(4, &par_csprng_state);
-
-	/* store the CSPRNG outputs as round seeds */
-	int offset = 0;
-	for (int i = 0; i < 4; i++) {
-		memcpy(&rounds_seeds[((T / 4)*i + offset)*SEED_LENGTH_BYTES],
-		       par_csprng_output[i],
-		       (T / 4 + remainders[i])*SEED_LENGTH_BYTES);
-		offset += remainders[i];
-	}
-	return T;
+                const unsigned char salt[SALT_LENGTH_BYTES]){
+
+   CSPRNG_STATE_T single_csprng_state;
+   PAR_CSPRNG_STATE_T par_csprng_state;
+
+   /* CSPRNG input: seed | salt | domain separation counter (0 to 4) */
+   unsigned char single_csprng_input[CSPRNG_INPUT_LENGTH];
+   unsigned char par_csprng_input[4][CSPRNG_INPUT_LENGTH];
+   unsigned char par_csprng_output[4][(T/4+1)*SEED_LENGTH_BYTES];
+
+   /* copy the root seed and the salt */
+   memcpy(single_csprng_input,root_seed,SEED_LENGTH_BYTES);   
+   memcpy(single_csprng_input+SEED_LENGTH_BYTES,salt,SALT_LENGTH_BYTES);
+
+   /* call the CSPRNG once to generate 4 intermediate seeds */
+   unsigned char quad_seed[4*SEED_LENGTH_BYTES];
+   csprng_initialize(&single_csprng_state, single_csprng_input, CSPRNG_INPUT_LENGTH, 0);
+   csprng_randombytes(quad_seed,4*SEED_LENGTH_BYTES,&single_csprng_state);
+   /* PQClean-edit: CSPRNG release context */
+   csprng_release(&single_csprng_state);
+
+   memset(par_csprng_input,0,4*CSPRNG_INPUT_LENGTH);
+
+   /* copy the salt */
+   for(int i=0; i<4; i++){
+      memcpy(par_csprng_input[i]+SEED_LENGTH_BYTES,salt,SALT_LENGTH_BYTES);
+   }
+
+   int remainders[4] = {0};
+   if(T%4 > 0){ remainders[0] = 1; } 
+   if(T%4 > 1){ remainders[1] = 1; } 
+   if(T%4 > 2){ remainders[2] = 1; } 
+   
+   /* copy the 4 intermediate seeds */
+   for (int i = 0; i < 4; i++){
+      memcpy(par_csprng_input[i],&quad_seed[i*SEED_LENGTH_BYTES],SEED_LENGTH_BYTES);   
+   }
+
+   /* make 4 (parallel) calls to the CSPRNG */
+   HASH_STATS_PAR(HASH_STATS_SITE_SEED_LEAVES, 4);
+   csprng_initialize_par(
+        4,
+        &par_csprng_state, 
+        par_csprng_input[0],
+        par_csprng_input[1],
+        par_csprng_input[2],
+        par_csprng_input[3], 
+        CSPRNG_INPUT_LENGTH,
+        CSPRNG_DOMAIN_SEP_CONST + 1,
+        CSPRNG_DOMAIN_SEP_CONST + 2,
+        CSPRNG_DOMAIN_SEP_CONST + 3,
+        CSPRNG_DOMAIN_SEP_CONST + 4);
+   csprng_randombytes_par(
+        4,
+        &par_csprng_state,
+        par_csprng_output[0],
+        par_csprng_output[1],
+        par_csprng_output[2],
+        par_csprng_output[3], 
+        (T/4+1)*SEED_LENGTH_BYTES);
+   /* PQClean-edit: CSPRNG release context */
+   csprng_release_par(4, &par_csprng_state);
+
+   /* store the CSPRNG outputs as round seeds */
+   int offset = 0;
+   for(int i=0; i<4; i++){
+       memcpy(&rounds_seeds[((T/4)*i+offset)*SEED_LENGTH_BYTES],
+              par_csprng_output[i],
+              (T/4+remainders[i])*SEED_LENGTH_BYTES);
+       offset += remainders[i];
+   }
+   return T;
 }
 
 int seed_path(unsigned char *seed_storage,
-              const unsigned char rounds_seeds[T * SEED_LENGTH_BYTES],
-              const unsigned char indices_to_publish[T]) {
-	int published = 0;
-	for (int i = 0; i < T; i++) {
-		if (indices_to_publish[i] == TO_PUBLISH) {
-			memcpy(&seed_storage[SEED_LENGTH_BYTES * published],
-			       &rounds_seeds[i * SEED_LENGTH_BYTES],
-			       SEED_LENGTH_BYTES);
-			published++;
-		}
-	}
-	return published;
+              const unsigned char rounds_seeds[T*SEED_LENGTH_BYTES],
+              const chall_2_t *chall_2){
+    for(int i=0; i<W; i++){
+       memcpy(&seed_storage[SEED_LENGTH_BYTES*i],
+              &rounds_seeds[chall_2->rounds_1[i]*SEED_LENGTH_BYTES],
+              SEED_LENGTH_BYTES);
+    }
+    return W;
 }
 
 /* simply picks seeds out of the storage and places them in the in-memory array */
-uint8_t rebuild_leaves(unsigned char rounds_seeds[T * SEED_LENGTH_BYTES],
-                       const unsigned char indices_to_publish[T],
-                       const unsigned char *seed_storage) {
-	int published = 0;
-	for (int i = 0; i < T; i++) {
-		if (indices_to_publish[i] == TO_PUBLISH) {
-			memcpy(&rounds_seeds[i * SEED_LENGTH_BYTES],
-			       &seed_storage[SEED_LENGTH_BYTES * published],
-			       SEED_LENGTH_BYTES);
-			published++;
-		}
-	}
-	return 1;
+uint8_t rebuild_leaves(unsigned char rounds_seeds[T*SEED_LENGTH_BYTES],
+                       const chall_2_t *chall_2,
+                       const unsigned char *seed_storage){
+    for(int i=0; i<W; i++){
+       memcpy(&rounds_seeds[chall_2->rounds_1[i]*SEED_LENGTH_BYTES],
+              &seed_storage[SEED_LENGTH_BYTES*i],
+              SEED_LENGTH_BYTES);
+    }
+    return 1;
+}
+
+uint8_t is_seed_path_padding_ok(const chall_2_t *chall_2,
+                                const unsigned char *seed_storage){
+   /* the path holds exactly W seeds, there is no padding to check */
+   (void)chall_2;
+   (void)seed_storage;
+   return 1;
 }
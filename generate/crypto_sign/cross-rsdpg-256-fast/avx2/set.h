@@ -9,6 +9,7 @@
 #define IMPLEMENTATION_avx2
 #define HIGH_COMPATIBILITY_X86_64
 #define HIGH_PERFORMANCE_X86_64
+#define SHA_3_KECCAK_X86_64
 
 /* PQClean-edit: avoid VLA */
 #define CSPRNG_INPUT_LENGTH (SALT_LENGTH_BYTES+SEED_LENGTH_BYTES)
@@ -26,3 +27,17 @@
 /* Target */
 #undef BALANCED
 #undef SIG_SIZE
+/* Extensions and their tunables, off unless requested on the command line,
+ * so that the generated implementations carry none of them (see also
+ * utility.py) */
+#undef HASH_STATS
+#undef PK_CACHE
+#undef PK_CACHE_BUDGET_BYTES
+#undef PK_CACHE_SHARDS
+#undef PK_EXPANDED_FILE
+#undef PRESIG_POOL
+#undef RNG_POOL
+#undef RNG_POOL_BYTES
+#undef RNG_POOL_RESEED_INTERVAL
+#undef USDT_PROBES
+#undef VERIFY_EARLY_REJECT
@@ -5,14 +5,14 @@
  * @version 2.0 (February 2025)
  *
  * Authors listed in alphabetical order:
- *
+ * 
  * @author: Alessandro Barenghi <alessandro.barenghi@polimi.it>
  * @author: Marco Gianvecchio <marco.gianvecchio@mail.polimi.it>
  * @author: Patrick Karl <patrick.karl@tum.de>
  * @author: Gerardo Pelosi <gerardo.pelosi@polimi.it>
  * @author: Jonas Schupp <jonas.schupp@tum.de>
- *
- *
+ * 
+ * 
  * This code is hereby placed in the public domain.
  *
  * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ''AS IS'' AND ANY EXPRESS
@@ -31,6 +31,7 @@
 
 #pragma once
 
+#include <stddef.h>
 #include <stdint.h>
 
 #include "namespace.h"
@@ -40,45 +41,153 @@
 /* Public key: the parity check matrix is shrunk to a seed, syndrome
  * represented in full */
 typedef struct {
-	uint8_t seed_pk[KEYPAIR_SEED_LENGTH_BYTES];
-	uint8_t s[DENSELY_PACKED_FP_SYN_SIZE];
+   uint8_t seed_pk[KEYPAIR_SEED_LENGTH_BYTES];
+   uint8_t s[DENSELY_PACKED_FP_SYN_SIZE];
 } pk_t;
 
 /* Private key: just a single seed*/
 typedef struct {
-	uint8_t seed_sk[KEYPAIR_SEED_LENGTH_BYTES];
+   uint8_t seed_sk[KEYPAIR_SEED_LENGTH_BYTES];
 } sk_t;
 
 typedef struct {
-	uint8_t y[DENSELY_PACKED_FP_VEC_SIZE];
-	uint8_t v_G_bar[DENSELY_PACKED_FZ_RSDP_G_VEC_SIZE];
+  uint8_t y[DENSELY_PACKED_FP_VEC_SIZE];
+  uint8_t v_G_bar[DENSELY_PACKED_FZ_RSDP_G_VEC_SIZE];
 } resp_0_t;
 
 /* Signature: */
 typedef struct {
-	uint8_t salt[SALT_LENGTH_BYTES];
-	uint8_t digest_cmt[HASH_DIGEST_LENGTH];
-	uint8_t digest_chall_2[HASH_DIGEST_LENGTH];
-	/*Seed tree paths storage*/
-	uint8_t path[TREE_NODES_TO_STORE * SEED_LENGTH_BYTES];
-	/*Merkle tree proof field.*/
-	uint8_t proof[HASH_DIGEST_LENGTH * TREE_NODES_TO_STORE];
-	uint8_t resp_1[T - W][HASH_DIGEST_LENGTH];
-	resp_0_t resp_0[T - W];
+   uint8_t salt[SALT_LENGTH_BYTES];
+   uint8_t digest_cmt[HASH_DIGEST_LENGTH];
+   uint8_t digest_chall_2[HASH_DIGEST_LENGTH];
+   /*Seed tree paths storage*/
+   uint8_t path[TREE_NODES_TO_STORE*SEED_LENGTH_BYTES];
+   /*Merkle tree proof field.*/
+   uint8_t proof[HASH_DIGEST_LENGTH*TREE_NODES_TO_STORE];
+   uint8_t resp_1[T-W][HASH_DIGEST_LENGTH];
+   resp_0_t resp_0[T-W];
 } CROSS_sig_t;
 
+
 /* keygen cannot fail */
 void CROSS_keygen(sk_t *SK,
-                  pk_t *PK);
+                 pk_t *PK);
+
+/* generates n keypairs into SK[0..n-1], PK[0..n-1]; the keys are the same
+ * as the ones of n consecutive calls to CROSS_keygen */
+void CROSS_keygen_batch(sk_t *SK,
+                        pk_t *PK,
+                        size_t n);
 
 /* sign cannot fail */
-void CROSS_sign(const sk_t *SK,
-                const char *m,
+void CROSS_sign(const sk_t * SK,
+                const char * m,
                 uint64_t mlen,
-                CROSS_sig_t *sig);
+                CROSS_sig_t * sig);
+
+/* Signature in two parts, the state in between is found in presig.h:
+ * CROSS_presign does all the work which does not depend on the message,
+ * CROSS_sign_online completes it once the message is known */
+typedef struct CROSS_presig_s CROSS_presig_t;
+
+/* presign cannot fail */
+void CROSS_presign(const sk_t * SK,
+                   CROSS_presig_t * presig);
+
+/* signs m with presig, which must come from CROSS_presign and is wiped: a
+ * presignature is employed once at most. Returns 1 on success, 0 if presig
+ * was already employed */
+int CROSS_sign_online(CROSS_presig_t * presig,
+                      const char * m,
+                      uint64_t mlen,
+                      CROSS_sig_t * sig);
 
 /* verify returns 1 if signature is ok, 0 otherwise */
-int CROSS_verify(const pk_t *PK,
-                 const char *m,
+int CROSS_verify(const pk_t * PK,
+                 const char * m,
                  uint64_t mlen,
-                 const CROSS_sig_t *sig);
+                 const CROSS_sig_t * sig);
+
+/* The interfaces from here on, expanded public keys, their files and the
+ * step-wise verification, are internal to the implementation: they are not
+ * in api.h nor exported by the shared library, so only code built together
+ * with the implementation can call them. Their types are declared opaque
+ * here, the code allocating them includes pk_expanded.h or verify_state.h
+ * for their layout and size */
+
+/* Public key expanded for verification, its layout depends on the
+ * implementation and is found in pk_expanded.h */
+typedef struct pk_expanded_s pk_expanded_t;
+
+/* File of expanded public keys mapped in memory, see CROSS_pk_expanded_map */
+typedef struct pk_expanded_map_s pk_expanded_map_t;
+
+/* expands PK into EPK, returns 1 if PK is well formed, 0 otherwise */
+int CROSS_pk_expand(pk_expanded_t *EPK,
+                    const pk_t *PK);
+
+/* verify against an expanded public key obtained from a successful
+ * CROSS_pk_expand, returns 1 if signature is ok, 0 otherwise */
+int CROSS_verify_expanded(const pk_expanded_t *EPK,
+                          const char * m,
+                          uint64_t mlen,
+                          const CROSS_sig_t * sig);
+
+/* writes the n public keys in PK, expanded, to a file which
+ * CROSS_pk_expanded_map can map; returns 1 on success, 0 if a key is
+ * malformed or the file cannot be written. The files of expanded keys are
+ * only available when built with PK_EXPANDED_FILE: without it, storing
+ * returns 0 and mapping NULL */
+int CROSS_pk_expanded_store(const char *path,
+                            const pk_t *PK,
+                            size_t n);
+
+/* maps a file written by CROSS_pk_expanded_store, after checking that its
+ * version, layout, parameters, size and header checksum match; returns NULL
+ * otherwise. The entries are not read */
+pk_expanded_map_t *CROSS_pk_expanded_map(const char *path);
+
+/* returns the expanded form of PK stored in map, NULL if there is none or
+ * it is corrupted; its checksum is checked by its first lookup. It remains
+ * valid until map is unmapped */
+const pk_expanded_t *CROSS_pk_expanded_find(const pk_expanded_map_t *map,
+                                            const pk_t *PK);
+
+void CROSS_pk_expanded_unmap(pk_expanded_map_t *map);
+
+/* State of a verification carried out step by step, its layout depends on
+ * the implementation and is found in verify_state.h */
+typedef struct CROSS_verify_state_s CROSS_verify_state_t;
+
+/* Step-wise verification: start derives the challenges, the steps rebuild
+ * the seed tree, verify the T rounds and recompute the Merkle root, each
+ * doing at most budget_rounds units of work, a unit being a round or a few
+ * nodes of one of the trees, and finish returns 1 if the signature is ok, 0
+ * otherwise. The outcome is the one of CROSS_verify. finish does none of
+ * the work left by the steps: it returns 0 unless the last step returned 1.
+ * Every started verification must be either finished or aborted, which
+ * releases the hash states it holds. The state keeps a pointer to sig,
+ * which the steps and finish read: sig must remain available and unchanged
+ * until finish or abort returns, while m is only read by start. */
+void CROSS_verify_start(CROSS_verify_state_t *state,
+                        const pk_t * PK,
+                        const char * m,
+                        uint64_t mlen,
+                        const CROSS_sig_t * sig);
+
+/* as CROSS_verify_start, with an expanded public key which, as sig, must
+ * remain available and unchanged until finish or abort returns */
+void CROSS_verify_start_expanded(CROSS_verify_state_t *state,
+                                 const pk_expanded_t *EPK,
+                                 const char * m,
+                                 uint64_t mlen,
+                                 const CROSS_sig_t * sig);
+
+/* returns 1 once all the work is done, 0 otherwise */
+int CROSS_verify_step(CROSS_verify_state_t *state,
+                      unsigned int budget_rounds);
+
+int CROSS_verify_finish(CROSS_verify_state_t *state);
+
+/* ends a verification without its outcome */
+void CROSS_verify_abort(CROSS_verify_state_t *state);
@@ -5,14 +5,14 @@
  * @version 2.0 (February 2025)
  *
  * Authors listed in alphabetical order:
- *
+ * 
  * @author: Alessandro Barenghi <alessandro.barenghi@polimi.it>
  * @author: Marco Gianvecchio <marco.gianvecchio@mail.polimi.it>
  * @author: Patrick Karl <patrick.karl@tum.de>
  * @author: Gerardo Pelosi <gerardo.pelosi@polimi.it>
  * @author: Jonas Schupp <jonas.schupp@tum.de>
- *
- *
+ * 
+ * 
  * This code is hereby placed in the public domain.
  *
  * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ''AS IS'' AND ANY EXPRESS
@@ -69,166 +69,355 @@
 /* log reduction, constant time unrolled S&M w/precomputed squares.
  * To be further optimized with muxed register-fitting tables */
 static inline
-FP_ELEM RESTR_TO_VAL(FP_ELEM x) {
-	uint32_t res1, res2, res3, res4;
-	res1 = ( FP_ELEM_CMOV(((x >> 0) & 1), RESTR_G_GEN_1, 1)) *
-	       ( FP_ELEM_CMOV(((x >> 1) & 1), RESTR_G_GEN_2, 1)) ;
-	res2 = ( FP_ELEM_CMOV(((x >> 2) & 1), RESTR_G_GEN_4, 1)) *
-	       ( FP_ELEM_CMOV(((x >> 3) & 1), RESTR_G_GEN_8, 1)) ;
-	res3 = ( FP_ELEM_CMOV(((x >> 4) & 1), RESTR_G_GEN_16, 1)) *
-	       ( FP_ELEM_CMOV(((x >> 5) & 1), RESTR_G_GEN_32, 1)) ;
-	res4 =   FP_ELEM_CMOV(((x >> 6) & 1), RESTR_G_GEN_64, 1);
+FP_ELEM RESTR_TO_VAL(FP_ELEM x){
+    uint32_t res1, res2, res3, res4;
+    res1 = ( FP_ELEM_CMOV(((x >> 0) &1),RESTR_G_GEN_1 ,1)) *
+           ( FP_ELEM_CMOV(((x >> 1) &1),RESTR_G_GEN_2 ,1)) ;
+    res2 = ( FP_ELEM_CMOV(((x >> 2) &1),RESTR_G_GEN_4 ,1)) *
+           ( FP_ELEM_CMOV(((x >> 3) &1),RESTR_G_GEN_8 ,1)) ;
+    res3 = ( FP_ELEM_CMOV(((x >> 4) &1),RESTR_G_GEN_16,1)) *
+           ( FP_ELEM_CMOV(((x >> 5) &1),RESTR_G_GEN_32,1)) ;
+    res4 =   FP_ELEM_CMOV(((x >> 6) &1),RESTR_G_GEN_64,1);
 
-	/* Two intermediate reductions necessary:
-	 *     RESTR_G_GEN_1*RESTR_G_GEN_2*RESTR_G_GEN_4*RESTR_G_GEN_8    < 2^32
-	 *     RESTR_G_GEN_16*RESTR_G_GEN_32*RESTR_G_GEN_64               < 2^32 */
-	return FPRED_SINGLE( FPRED_SINGLE(res1 * res2) * FPRED_SINGLE(res3 * res4) );
+    /* Two intermediate reductions necessary:
+     *     RESTR_G_GEN_1*RESTR_G_GEN_2*RESTR_G_GEN_4*RESTR_G_GEN_8    < 2^32
+     *     RESTR_G_GEN_16*RESTR_G_GEN_32*RESTR_G_GEN_64               < 2^32 */
+    return FPRED_SINGLE( FPRED_SINGLE(res1 * res2) * FPRED_SINGLE(res3 * res4) );
 }
 
+
+
 /* in-place normalization of redundant zero representation for syndromes*/
 static inline
-void fp_dz_norm_synd(FP_ELEM v[N - K]) {
-	for (int i = 0; i < N - K; i++) {
-		v[i] = FP_DOUBLE_ZERO_NORM(v[i]);
-	}
+void fp_dz_norm_synd(FP_ELEM v[N-K]){
+    for (int i = 0; i < N-K; i++){
+       v[i] = FP_DOUBLE_ZERO_NORM(v[i]);
+    }
 }
 
 static inline
-void fp_dz_norm(FP_ELEM v[N]) {
-	for (int i = 0; i < N; i++) {
-		v[i] = FP_DOUBLE_ZERO_NORM(v[i]);
-	}
+void fp_dz_norm(FP_ELEM v[N]){
+    for (int i = 0; i < N; i++){
+       v[i] = FP_DOUBLE_ZERO_NORM(v[i]);
+    }
 }
 
-/* Computes the product e*H of an n-element restricted vector by a (n-k)*n
- * FP H is in systematic form. Only the non systematic portion of H =[V I],
- * V, is provided, transposed, hence linearized by columns so that syndrome
- * computation is vectorizable. */
-
-static
-void restr_vec_by_fp_matrix(FP_ELEM res[N - K],
-                            FZ_ELEM e[N],
-                            FP_ELEM V_tr[K][N - K]) {
-	FP_DOUBLEPREC res_dprec[N - K] = {0};
-	for (int i = 0; i < N - K; i++) {
-		res_dprec[i] = RESTR_TO_VAL(e[K + i]);
-	}
-	for (int i = 0; i < K; i++) {
-		for (int j = 0; j < N - K; j++) {
-			res_dprec[j] += FPRED_SINGLE(
-			                    (FP_DOUBLEPREC) RESTR_TO_VAL(e[i]) *
-			                    (FP_DOUBLEPREC) V_tr[i][j]);
-			if (i == P - 1) {
-				res_dprec[j] = FPRED_SINGLE(res_dprec[j]);
-			}
-		}
-	}
-	/* Save result trimming to regular precision */
-	for (int i = 0; i < N - K; i++) {
-		res[i] = FPRED_SINGLE(res_dprec[i]);
-	}
-}
+/* In both vector-matrix products below, the bounds of the column loop are
+ * constants of the set: the compiler unrolls it fully and keeps the column
+ * sums in registers across the rows, i.e., it emits the per-set register
+ * tiled kernel, so none is generated (see the fp_vec_by_fp_matrix and
+ * restr_vec_by_fp_matrix entries of bench/microbench.c) */
 
 /* reduce modulo 509 eigth 32-bit integers packed into a 256-bit vector, using Barrett's method
  * each 32-bit integer sould be in the range [0, 508*508] i.e. the result of a mul in FP
  * however, the function actually works for integers in the wider range [0, 8339743] */
+static inline 
+__m256i reduce_avx2_32(__m256i a){
+    int b_shift = 18; // ceil(log2(509))*2
+    int b_mul = (((uint64_t)1U << b_shift) / P);
+    /* r = a - ((B_MUL * a) >> B_SHIFT) * P) */
+    __m256i b_mul_32 = _mm256_set1_epi32(b_mul);
+    __m256i p_32 = _mm256_set1_epi32(P);
+    __m256i r = _mm256_mullo_epi32(a, b_mul_32);
+            r = _mm256_srli_epi32(r, b_shift);
+            r = _mm256_mullo_epi32(r, p_32);
+            r = _mm256_sub_epi32(a, r);
+    /* r = min(r, r - P) */
+    __m256i rs= _mm256_sub_epi32(r, p_32);
+            r = _mm256_min_epu32(r, rs);
+    return r;
+}
+
+/* lanes of x having the selected bit set to 1 are set to true_v, the others
+ * to 1, vector counterpart of FP_ELEM_CMOV */
+static inline
+__m256i fp_elem_cmov_epi32(__m256i x, int bit, int true_v){
+    __m256i one = _mm256_set1_epi32(1);
+    __m256i mask = _mm256_sub_epi32(_mm256_setzero_si256(),
+                                    _mm256_and_si256(_mm256_srli_epi32(x, bit), one));
+    return _mm256_blendv_epi8(one, _mm256_set1_epi32(true_v), mask);
+}
+
+/* RESTR_TO_VAL on eight exponents in [0,127] zero-extended to 32-bit lanes.
+ * The S&M products are reduced pairwise: each of them is below (P-1)^2, in
+ * the range of reduce_avx2_32 */
+static inline
+__m256i restr_to_val_epi32(__m256i x){
+    __m256i res1 = _mm256_mullo_epi32(fp_elem_cmov_epi32(x, 0, RESTR_G_GEN_1),
+                                      fp_elem_cmov_epi32(x, 1, RESTR_G_GEN_2));
+    __m256i res2 = _mm256_mullo_epi32(fp_elem_cmov_epi32(x, 2, RESTR_G_GEN_4),
+                                      fp_elem_cmov_epi32(x, 3, RESTR_G_GEN_8));
+    __m256i res3 = _mm256_mullo_epi32(fp_elem_cmov_epi32(x, 4, RESTR_G_GEN_16),
+                                      fp_elem_cmov_epi32(x, 5, RESTR_G_GEN_32));
+    __m256i res4 = fp_elem_cmov_epi32(x, 6, RESTR_G_GEN_64);
+    res1 = _mm256_mullo_epi32(reduce_avx2_32(res1), reduce_avx2_32(res2));
+    res3 = _mm256_mullo_epi32(reduce_avx2_32(res3), res4);
+    return reduce_avx2_32(_mm256_mullo_epi32(reduce_avx2_32(res1),
+                                             reduce_avx2_32(res3)));
+}
+
+/* zero-extending loads of eight FP resp. FZ elements into 32-bit lanes, and
+ * narrowing store of eight reduced 32-bit lanes as FP elements */
+static inline
+__m256i load_fp_epi32(const FP_ELEM *in){
+    return _mm256_cvtepu16_epi32(_mm_loadu_si128((__m128i const *) in));
+}
+
 static inline
-__m256i reduce_avx2_32(__m256i a) {
-	int b_shift = 18; // ceil(log2(509))*2
-	int b_mul = (((uint64_t)1U << b_shift) / P);
-	/* r = a - ((B_MUL * a) >> B_SHIFT) * P) */
-	__m256i b_mul_32 = _mm256_set1_epi32(b_mul);
-	__m256i p_32 = _mm256_set1_epi32(P);
-	__m256i r = _mm256_mullo_epi32(a, b_mul_32);
-	r = _mm256_srli_epi32(r, b_shift);
-	r = _mm256_mullo_epi32(r, p_32);
-	r = _mm256_sub_epi32(a, r);
-	/* r = min(r, r - P) */
-	__m256i rs = _mm256_sub_epi32(r, p_32);
-	r = _mm256_min_epu32(r, rs);
-	return r;
-}
-static inline
-void fp_vec_by_fp_matrix(FP_ELEM res[N - K], FP_ELEM e[N], FP_DOUBLEPREC V_tr[K][ROUND_UP(N - K, EPI32_PER_REG)]) {
-
-	alignas(EPI8_PER_REG) FP_DOUBLEPREC res_dprec[ROUND_UP(N - K, EPI32_PER_REG)] = {0};
-	for (int i = 0; i < N - K; i++) {
-		res_dprec[i] = e[K + i];
-	}
-
-	for (int i = 0; i < K; i++) {
-		__m256i e_coeff = _mm256_set1_epi32(e[i]);
-		for (int j = 0; j < ROUND_UP(N - K, EPI32_PER_REG) / EPI32_PER_REG; j++) {
-			__m256i res_w = _mm256_load_si256((__m256i const *) &res_dprec[j * EPI32_PER_REG] );
-			__m256i V_tr_slice = _mm256_lddqu_si256((__m256i const *) &V_tr[i][j * EPI32_PER_REG] );
-			__m256i a  = _mm256_mullo_epi32(e_coeff, V_tr_slice);
-			/* add to result */
-			res_w = _mm256_add_epi32(res_w, a);
-			/* - the previous sum is performed K times with K <= 69
-			 * - adding each time a value "a" in the range [0,(P-1)*(P-1)]
-			 * - the reduction function reduce_avx2_32(x) works for x < 8339743
-			 * therefore 3 reductions are enough */
-			if (i == K / 3 || i == (K / 3) * 2 || i == K - 1) {
-				res_w  = reduce_avx2_32(res_w);
-			}
-			/* store back */
-			_mm256_store_si256 ((__m256i *) &res_dprec[j * EPI32_PER_REG], res_w);
-		}
-	}
-	for (int i = 0; i < N - K; i++) {
-		res[i] = res_dprec[i];
-	}
+__m256i load_fz_epi32(const FZ_ELEM *in){
+    return _mm256_cvtepu8_epi32(_mm_loadl_epi64((__m128i const *) in));
+}
+
+static inline
+void store_fp_epi32(FP_ELEM *out, __m256i x){
+    /* packus interleaves the 128b lanes, pick back qwords 0 and 2 */
+    x = _mm256_packus_epi32(x, x);
+    x = _mm256_permute4x64_epi64(x, 0x08);
+    _mm_storeu_si128((__m128i *) out, _mm256_castsi256_si128(x));
+}
+/* no redundant zero in F_509: the result is already normalized */
+static inline 
+void fp_vec_by_fp_matrix(FP_ELEM res[N-K], FP_ELEM e[N], V_TR_ELEM V_tr[K][V_TR_COLS]){
+
+    alignas(EPI8_PER_REG) FP_DOUBLEPREC res_dprec[ROUND_UP(N-K,EPI32_PER_REG)] = {0};
+    for(int i=0; i< N-K;i++) {
+        res_dprec[i]=e[K+i];
+    }
+
+    for(int i = 0; i < K; i++){
+        __m256i e_coeff = _mm256_set1_epi32(e[i]);
+        for(int j = 0; j < ROUND_UP(N-K,EPI32_PER_REG)/EPI32_PER_REG; j++){
+            __m256i res_w = _mm256_load_si256((__m256i const *) &res_dprec[j*EPI32_PER_REG] );
+            __m256i V_tr_slice = _mm256_lddqu_si256((__m256i const *) &V_tr[i][j*EPI32_PER_REG] );
+            __m256i a  = _mm256_mullo_epi32(e_coeff, V_tr_slice);
+            /* add to result */
+            res_w = _mm256_add_epi32(res_w, a);
+            /* - the previous sum is performed K times with K <= 69
+             * - adding each time a value "a" in the range [0,(P-1)*(P-1)] 
+             * - the reduction function reduce_avx2_32(x) works for x < 8339743
+             * therefore 3 reductions are enough */
+            if(i == K/3 || i == (K/3)*2 || i == K-1){
+                res_w  = reduce_avx2_32(res_w);
+            }
+            /* store back */
+            _mm256_store_si256 ((__m256i *) &res_dprec[j*EPI32_PER_REG], res_w);
+        }
+    }
+    for(int i=0; i< N-K;i++) {
+        res[i] = res_dprec[i];
+    }
 }
 
 static inline
 void fp_vec_by_fp_vec_pointwise(FP_ELEM res[N],
                                 const FP_ELEM in1[N],
-                                const FP_ELEM in2[N]) {
-	for (int i = 0; i < N; i++) {
-		res[i] = FPRED_SINGLE( (FP_DOUBLEPREC) in1[i] *
-		                       (FP_DOUBLEPREC) in2[i] );
-	}
+                                const FP_ELEM in2[N]){
+    int i;
+    for(i = 0; i+EPI32_PER_REG <= N; i += EPI32_PER_REG){
+        __m256i a = load_fp_epi32(&in1[i]);
+        __m256i b = load_fp_epi32(&in2[i]);
+        store_fp_epi32(&res[i], reduce_avx2_32(_mm256_mullo_epi32(a, b)));
+    }
+    for(; i < N; i++){
+        res[i] = FPRED_SINGLE( (FP_DOUBLEPREC) in1[i] *
+                               (FP_DOUBLEPREC) in2[i] );
+    }
 }
 
 static inline
 void restr_by_fp_vec_pointwise(FP_ELEM res[N],
-                               const FZ_ELEM in1[N],
-                               const FP_ELEM in2[N]) {
-	for (int i = 0; i < N; i++) {
-		res[i] = FPRED_SINGLE( (FP_DOUBLEPREC) RESTR_TO_VAL(in1[i]) *
-		                       (FP_DOUBLEPREC) in2[i]);
-	}
+                                const FZ_ELEM in1[N],
+                                const FP_ELEM in2[N]){
+    int i;
+    for(i = 0; i+EPI32_PER_REG <= N; i += EPI32_PER_REG){
+        __m256i a = restr_to_val_epi32(load_fz_epi32(&in1[i]));
+        __m256i b = load_fp_epi32(&in2[i]);
+        store_fp_epi32(&res[i], reduce_avx2_32(_mm256_mullo_epi32(a, b)));
+    }
+    for(; i < N; i++){
+        res[i] = FPRED_SINGLE( (FP_DOUBLEPREC) RESTR_TO_VAL(in1[i]) *
+                               (FP_DOUBLEPREC) in2[i]);
+    }
+}
+
+/* Fused a - b, conversion to FP and product by u_prime: computes
+ * v_bar = a - b, normalized, and res = RESTR_TO_VAL(a - b) * u_prime in a
+ * single pass. The restricted vector is processed 16 bytes at a time, i.e.,
+ * two batches of 32-bit lanes for the conversion */
+static inline
+void restr_vec_sub_by_fp_vec_pointwise(FP_ELEM res[N],
+                                       FZ_ELEM v_bar[N],
+                                       const FZ_ELEM a[N],
+                                       const FZ_ELEM b[N],
+                                       const FP_ELEM u_prime[N]){
+    int i;
+    for(i = 0; i+2*EPI32_PER_REG <= N; i += 2*EPI32_PER_REG){
+        __m256i a_w = _mm256_broadcastsi128_si256(
+                                 _mm_loadu_si128((__m128i const *) &a[i]));
+        __m256i b_w = _mm256_broadcastsi128_si256(
+                                 _mm_loadu_si128((__m128i const *) &b[i]));
+        __m128i v_bar_w = _mm256_castsi256_si128(fz_sub_epi8(a_w, b_w));
+
+        __m256i lo = restr_to_val_epi32(_mm256_cvtepu8_epi32(v_bar_w));
+        __m256i hi = restr_to_val_epi32(_mm256_cvtepu8_epi32(_mm_srli_si128(v_bar_w, 8)));
+        lo = _mm256_mullo_epi32(lo, load_fp_epi32(&u_prime[i]));
+        hi = _mm256_mullo_epi32(hi, load_fp_epi32(&u_prime[i+EPI32_PER_REG]));
+        store_fp_epi32(&res[i], reduce_avx2_32(lo));
+        store_fp_epi32(&res[i+EPI32_PER_REG], reduce_avx2_32(hi));
+
+        v_bar_w = _mm256_castsi256_si128(
+                      mersenne_dz_norm_epi8(_mm256_broadcastsi128_si256(v_bar_w),
+                                            NUM_BITS_Z));
+        _mm_storeu_si128((__m128i *) &v_bar[i], v_bar_w);
+    }
+    for(; i < N; i++){
+        FZ_ELEM v_bar_i = FZRED_SINGLE( a[i] + FZRED_OPPOSITE(b[i]) );
+        res[i] = FPRED_SINGLE( (FP_DOUBLEPREC) RESTR_TO_VAL(v_bar_i) *
+                               (FP_DOUBLEPREC) u_prime[i]);
+        v_bar[i] = FZ_DOUBLE_ZERO_NORM(v_bar_i);
+    }
 }
 
-/* e*chall_1 + u_prime*/
+/* e*chall_1 + u_prime, with the redundant zero normalized, i.e., the
+ * response y as it is packed, without a further pass of fp_dz_norm */
 
+/* chall_1*RESTR_G_GEN^z for z in [0,127], i.e., the table of the values
+ * taken by y - u_prime in a round, built once per round and kept in
+ * registers. Row r holds the 16 entries having z >> 4 == r: its low bytes
+ * are broadcast to both 128b lanes of lut_lo[r], its high bytes to the ones
+ * of lut_hi[r], so that an in-lane shuffle on z & 0xf looks them up */
+static inline
+void restr_scaled_lut_epi8(__m256i lut_lo[8],
+                           __m256i lut_hi[8],
+                           const FP_ELEM chall_1){
+    uint32_t row[16];
+    row[0] = chall_1;
+    for(int j = 1; j < 16; j++){
+        row[j] = FPRED_SINGLE( (FP_DOUBLEPREC) row[j-1] * RESTR_G_GEN_1);
+    }
+    __m256i row_a = _mm256_loadu_si256((__m256i const *) &row[0]);
+    __m256i row_b = _mm256_loadu_si256((__m256i const *) &row[8]);
+    __m256i g_16 = _mm256_set1_epi32(RESTR_G_GEN_16);
+    /* gathers the low bytes of the 16-bit entries in the lower qword of each
+     * 128b lane, and the high bytes in the upper one */
+    __m256i split_bytes = _mm256_setr_epi8(0,2,4,6,8,10,12,14,1,3,5,7,9,11,13,15,
+                                           0,2,4,6,8,10,12,14,1,3,5,7,9,11,13,15);
+    for(int r = 0; r < 8; r++){
+        /* packus interleaves the 128b lanes, 0xD8 restores the qword order */
+        __m256i row_w = _mm256_packus_epi32(row_a, row_b);
+        row_w = _mm256_permute4x64_epi64(row_w, 0xD8);
+        row_w = _mm256_shuffle_epi8(row_w, split_bytes);
+        row_w = _mm256_permute4x64_epi64(row_w, 0xD8);
+        lut_lo[r] = _mm256_permute2x128_si256(row_w, row_w, 0x00);
+        lut_hi[r] = _mm256_permute2x128_si256(row_w, row_w, 0x11);
+        /* (P-1)*RESTR_G_GEN_16 is in range for reduce_avx2_32 */
+        row_a = reduce_avx2_32(_mm256_mullo_epi32(row_a, g_16));
+        row_b = reduce_avx2_32(_mm256_mullo_epi32(row_b, g_16));
+    }
+}
+
+/* u_prime + lut[e] over 32 elements: all the rows are looked up, the one
+ * matching e >> 4 is kept, so that no memory access depends on e */
+static inline
+void fp_restr_scaled_add_32(FP_ELEM res[EPI8_PER_REG],
+                            const __m256i lut_lo[8],
+                            const __m256i lut_hi[8],
+                            const FZ_ELEM e[EPI8_PER_REG],
+                            const FP_ELEM u_prime[EPI8_PER_REG]){
+    __m256i nibble_mask = _mm256_set1_epi8(0x0f);
+    __m256i p_16 = _mm256_set1_epi16(P);
+    __m256i e_w = _mm256_lddqu_si256((__m256i const *) e);
+    __m256i col = _mm256_and_si256(e_w, nibble_mask);
+    __m256i row = _mm256_and_si256(_mm256_srli_epi16(e_w, 4), nibble_mask);
+    __m256i val_lo = _mm256_setzero_si256();
+    __m256i val_hi = _mm256_setzero_si256();
+    for(int r = 0; r < 8; r++){
+        __m256i sel = _mm256_cmpeq_epi8(row, _mm256_set1_epi8((char) r));
+        val_lo = _mm256_or_si256(val_lo,
+                                 _mm256_and_si256(sel, _mm256_shuffle_epi8(lut_lo[r], col)));
+        val_hi = _mm256_or_si256(val_hi,
+                                 _mm256_and_si256(sel, _mm256_shuffle_epi8(lut_hi[r], col)));
+    }
+    /* back to 16-bit lanes, in element order */
+    __m256i val_a = _mm256_unpacklo_epi8(val_lo, val_hi);
+    __m256i val_b = _mm256_unpackhi_epi8(val_lo, val_hi);
+    __m256i res_0 = _mm256_permute2x128_si256(val_a, val_b, 0x20);
+    __m256i res_1 = _mm256_permute2x128_si256(val_a, val_b, 0x31);
+    /* both addends are reduced: a single conditional subtraction suffices */
+    res_0 = _mm256_add_epi16(res_0, _mm256_lddqu_si256((__m256i const *) &u_prime[0]));
+    res_1 = _mm256_add_epi16(res_1, _mm256_lddqu_si256((__m256i const *) &u_prime[EPI16_PER_REG]));
+    res_0 = _mm256_min_epu16(res_0, _mm256_sub_epi16(res_0, p_16));
+    res_1 = _mm256_min_epu16(res_1, _mm256_sub_epi16(res_1, p_16));
+    _mm256_storeu_si256((__m256i *) &res[0], res_0);
+    _mm256_storeu_si256((__m256i *) &res[EPI16_PER_REG], res_1);
+}
+
+/* res must not alias the inputs: the last, partial, block is computed on
+ * the final EPI8_PER_REG elements, overlapping the previous one */
 static inline
 void fp_vec_by_restr_vec_scaled(FP_ELEM res[N],
                                 const FZ_ELEM e[N],
                                 const FP_ELEM chall_1,
-                                const FP_ELEM u_prime[N]) {
-	for (int i = 0; i < N; i++) {
-		res[i] = FPRED_SINGLE( (FP_DOUBLEPREC) u_prime[i] +
-		                       (FP_DOUBLEPREC) RESTR_TO_VAL(e[i]) * (FP_DOUBLEPREC) chall_1) ;
-	}
+                                const FP_ELEM u_prime[N]){
+    __m256i lut_lo[8], lut_hi[8];
+    restr_scaled_lut_epi8(lut_lo, lut_hi, chall_1);
+    int i;
+    for(i = 0; i+EPI8_PER_REG <= N; i += EPI8_PER_REG){
+        fp_restr_scaled_add_32(&res[i], lut_lo, lut_hi, &e[i], &u_prime[i]);
+    }
+    if(i < N){
+        i = N-EPI8_PER_REG;
+        fp_restr_scaled_add_32(&res[i], lut_lo, lut_hi, &e[i], &u_prime[i]);
+    }
 }
 
 static inline
-void fp_synd_minus_fp_vec_scaled(FP_ELEM res[N - K],
-                                 const FP_ELEM synd[N - K],
+void fp_synd_minus_fp_vec_scaled(FP_ELEM res[N-K],
+                                 const FP_ELEM synd[N-K],
                                  const FP_ELEM chall_1,
-                                 const FP_ELEM s[N - K]) {
-	for (int j = 0; j < N - K; j++) {
-		FP_ELEM tmp = FPRED_SINGLE( (FP_DOUBLEPREC) s[j] * (FP_DOUBLEPREC) chall_1);
-		tmp = FP_DOUBLE_ZERO_NORM(tmp);
-		res[j] = FPRED_SINGLE( (FP_DOUBLEPREC) synd[j] + FPRED_OPPOSITE(tmp) );
-	}
+                                 const FP_ELEM s[N-K]){
+    __m256i chall_1_comb = _mm256_set1_epi32(chall_1);
+    __m256i p_32 = _mm256_set1_epi32(P);
+    int j;
+    for(j = 0; j+EPI32_PER_REG <= N-K; j += EPI32_PER_REG){
+        __m256i tmp = reduce_avx2_32(_mm256_mullo_epi32(load_fp_epi32(&s[j]),
+                                                        chall_1_comb));
+        /* synd + (P - tmp) is at most 2P-1, no need to reduce the opposite */
+        tmp = _mm256_add_epi32(load_fp_epi32(&synd[j]), _mm256_sub_epi32(p_32, tmp));
+        store_fp_epi32(&res[j], reduce_avx2_32(tmp));
+    }
+    for(; j < N-K; j++){
+        FP_ELEM tmp = FPRED_SINGLE( (FP_DOUBLEPREC) s[j] * (FP_DOUBLEPREC) chall_1);
+        tmp = FP_DOUBLE_ZERO_NORM(tmp);
+        tmp = FPRED_SINGLE( (FP_DOUBLEPREC) synd[j] + FPRED_OPPOSITE(tmp) );
+        res[j] = FP_DOUBLE_ZERO_NORM(tmp);
+    }
 }
 
 static inline
 void convert_restr_vec_to_fp(FP_ELEM res[N],
-                             const FZ_ELEM in[N]) {
-	for (int j = 0; j < N; j++) {
-		res[j] = RESTR_TO_VAL(in[j]);
-	}
+                            const FZ_ELEM in[N]){
+    int j;
+    for(j = 0; j+EPI32_PER_REG <= N; j += EPI32_PER_REG){
+        store_fp_epi32(&res[j], restr_to_val_epi32(load_fz_epi32(&in[j])));
+    }
+    for(; j < N; j++){
+        res[j] = RESTR_TO_VAL(in[j]);
+    }
+}
+
+/* Computes the product e*H of an n-element restricted vector by a (n-k)*n
+ * FP H is in systematic form. Only the non systematic portion of H =[V I],
+ * V, is provided, transposed, hence linearized by columns so that syndrome
+ * computation is vectorizable. The syndrome is returned with the redundant
+ * zero normalized. */
+/* The restricted vector is mapped to FP by the vectorized
+ * convert_restr_vec_to_fp, then the AVX2 fp_vec_by_fp_matrix is employed */
+static
+void restr_vec_by_fp_matrix(FP_ELEM res[N-K],
+                            FZ_ELEM e[N],
+                            V_TR_ELEM V_tr[K][V_TR_COLS]){
+    FP_ELEM e_fp[N];
+    convert_restr_vec_to_fp(e_fp, e);
+    fp_vec_by_fp_matrix(res, e_fp, V_tr);
 }
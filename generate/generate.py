@@ -1,14 +1,19 @@
-# for every parameter set create the corresponding directory
+# derive the tables of the trees of every set (tree_tables.h) from parameters.h
+# then for every parameter set create the corresponding directory
 # then copy the templates for the 'clean' and 'avx2' implementations inside that directory
 # then substitute the actual parameters (listed in parameter_sets.csv)
+# and keep a copy with the optional extensions, for the shared library and
+# the microbenchmarks
 # finally remove dead code (#if, #ifdef, #elif, etc.) and run astyle
 
 import os
+import re
 import csv
 import shutil
 import datetime
 
 import utility
+import tree_tables
 
 # move to the directory where the script is located
 base_directory = os.path.dirname(os.path.realpath(__file__))
@@ -16,6 +21,9 @@ os.chdir(base_directory)
 
 # output here
 TARGET_DIR = './crypto_sign'
+FULL_DIR = './crypto_sign_full'
+SHARED_DIR = './shared'
+BENCH_DIR = './bench'
 
 # check that the unifdef package is installed
 # unifded is used to remove dead code
@@ -24,9 +32,15 @@ if os.system('which unifdef > /dev/null 2>&1') != 0:
 
 astyle_config_file = './astyle/liboqs_astyle.ini'
 
+# the tables of the trees of every set, derived from parameters.h; unifdef
+# keeps the ones of the set at hand
+tree_tables.generate('../clean/parameters.h', '../clean/tree_tables.h')
+
 # delete output directory if it already exists
 if os.path.exists(TARGET_DIR):
     shutil.rmtree(TARGET_DIR)
+if os.path.exists(FULL_DIR):
+    shutil.rmtree(FULL_DIR)
 
 # csv file
 # the column '__dir__' constains the directory name for a given set of parameters
@@ -37,6 +51,8 @@ csv_filename = './parameter_sets.csv'
 meta_file = '/META.yml'
 clean_dir = '/clean'
 avx2_dir = '/avx2'
+shared_dir = '/shared'
+bench_dir = '/bench'
 
 with open(csv_filename, 'r') as csvfile:
 
@@ -71,9 +87,67 @@ with open(csv_filename, 'r') as csvfile:
             column_value = row[column_name]
             utility.replace_in_dir(dir, column_name, column_value)
 
+        # the extensions (see set.h) are removed from the implementations
+        # together with the dead code: the copy keeps them
+        shutil.copytree(dir, os.path.join(FULL_DIR, row['__dir__'], row['__implementation__']))
+
         utility.remove_dead_code(dir)
 
         utility.run_astyle(dir, astyle_config_file)
 
+# the shared library: for every parameter set, the header with its API and
+# the entry points which dispatch between its clean and avx2 implementations
+# at load time, the workload the profile-guided build is trained on, the
+# check of the presignature pool across fork() and the tests of the internal
+# interfaces of the implementations (see shared/Makefile)
+if os.path.exists(SHARED_DIR):
+    shutil.rmtree(SHARED_DIR)
+os.makedirs(SHARED_DIR)
+for file in ['cross.h', 'cross_dispatch.c', 'cross_dispatch.h', 'train.c',
+             'test_presig_pool.c', 'test_impl.c', 'test_impl.h',
+             'test_keygen_batch.c', 'test_pk_cache.c', 'test_pk_expanded.c',
+             'test_verify_step.c', 'test_early_reject.c', 'Makefile']:
+    shutil.copyfile('..' + shared_dir + '/' + file, SHARED_DIR + '/' + file)
+
+with open(csv_filename, 'r') as csvfile:
+
+    csv_reader = csv.DictReader(csvfile)
+    columns = csv_reader.fieldnames
+    rows = [row for row in csv_reader if row['__implementation__'] == 'clean']
+    sets = [row['__dir__'] for row in rows]
+
+    for row in rows:
+        dir = row['__dir__']
+        # the namespace of the set, without the one of the implementation
+        namespace = re.sub('CLEAN_$', '', row['__namespace__'])
+        header = SHARED_DIR + '/' + dir + '.h'
+        source = SHARED_DIR + '/' + dir + '.c'
+        shutil.copyfile('..' + clean_dir + '/api.h', header)
+        shutil.copyfile('..' + shared_dir + '/dispatch.c', source)
+        utility.replace_in_file(header, '__namespace__', namespace)
+        utility.replace_in_file(source, '__namespace_clean__', namespace + 'CLEAN_')
+        utility.replace_in_file(source, '__namespace_avx2__', namespace + 'AVX2_')
+        utility.replace_in_file(source, '__namespace__', namespace)
+        for column_name in columns:
+            utility.replace_in_file(header, column_name, row[column_name])
+            utility.replace_in_file(source, column_name, row[column_name])
+
+    includes = '\\n'.join('#include "' + dir + '.h"' for dir in sets)
+    utility.replace_in_file(SHARED_DIR + '/cross.h', '__includes__', includes)
+    train_sets = ',\\n'.join('   TRAIN_SET(' + re.sub('CLEAN_$', '', row['__namespace__']) + ', "' + row['__dir__'] + '")' for row in rows)
+    utility.replace_in_file(SHARED_DIR + '/train.c', '__train_sets__', train_sets)
+    test_sets = train_sets.replace('TRAIN_SET(', 'TEST_SET(')
+    utility.replace_in_file(SHARED_DIR + '/test_presig_pool.c', '__test_sets__', test_sets)
+    utility.replace_in_file(SHARED_DIR + '/Makefile', '__sets__', ' '.join(sets))
+
+# the microbenchmarks of the kernels of every parameter set and implementation
+# (see bench/Makefile)
+if os.path.exists(BENCH_DIR):
+    shutil.rmtree(BENCH_DIR)
+os.makedirs(BENCH_DIR)
+for file in ['microbench.c', 'Makefile']:
+    shutil.copyfile('..' + bench_dir + '/' + file, BENCH_DIR + '/' + file)
+utility.replace_in_file(BENCH_DIR + '/Makefile', '__sets__', ' '.join(sets))
+
 current_time = datetime.datetime.now().strftime("%H:%M")
-print("\nImplementations placed in", TARGET_DIR, "@", current_time)
\ No newline at end of file
+print("\nImplementations placed in", TARGET_DIR + ",", FULL_DIR + ",", SHARED_DIR, "and", BENCH_DIR, "@", current_time)
\ No newline at end of file
@@ -0,0 +1,124 @@
+# creates tree_tables.h from the tree parameters of every set in parameters.h
+# (TREE_OFFSETS, TREE_NODES_PER_LEVEL, etc.): for each set, the tables of the
+# parent of every node of the tree and of the leaf of every round, so that
+# merkle.c and seedtree.c look them up instead of walking the levels.
+# The sets are under the same conditions as in parameters.h, the ones of the
+# other sets are removed together with the rest of the dead code
+
+import re
+
+# values per line of the tables
+VALUES_PER_LINE = 16
+
+HEADER = '''/**
+ *
+ * Reference ISO-C11 Implementation of CROSS.
+ *
+ * @version 2.0 (February 2025)
+ *
+ * Authors listed in alphabetical order:
+ * 
+ * @author: Alessandro Barenghi <alessandro.barenghi@polimi.it>
+ * @author: Marco Gianvecchio <marco.gianvecchio@mail.polimi.it>
+ * @author: Patrick Karl <patrick.karl@tum.de>
+ * @author: Gerardo Pelosi <gerardo.pelosi@polimi.it>
+ * @author: Jonas Schupp <jonas.schupp@tum.de>
+ * 
+ * 
+ * This code is hereby placed in the public domain.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ''AS IS'' AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **/
+
+/* Generated by generate/tree_tables.py from parameters.h, do not edit.
+ * TREE_PARENT_NODES contains the parent of every node of the tree but the
+ * root, which has itself as parent.
+ * TREE_LEAF_NODES contains the leaf of every round. */
+
+#pragma once
+
+#include <stdint.h>
+
+#include "parameters.h"
+
+#if !defined(NO_TREES)
+'''
+
+FOOTER = '''#endif
+
+#endif
+'''
+
+def parse_list(text):
+    return [int(x) for x in text.strip(' {}').split(',')]
+
+# the conditions of the sets and their tree parameters, in order
+def parse_sets(params_path):
+    sets = []
+    with open(params_path, 'r') as f:
+        for line in f:
+            m = re.match(r'#(?:el)?if (\( defined\(CATEGORY_.*\) \))\s*$', line)
+            if m:
+                sets.append({'condition': m.group(1)})
+                continue
+            m = re.match(r'#define (TREE_\w+) (.*)$', line)
+            if m and sets:
+                sets[-1][m.group(1)] = m.group(2).strip()
+    return sets
+
+def compute_tables(params):
+    off = parse_list(params['TREE_OFFSETS'])
+    npl = parse_list(params['TREE_NODES_PER_LEVEL'])
+    start_indices = parse_list(params['TREE_LEAVES_START_INDICES'])
+    cons_leaves = parse_list(params['TREE_CONSECUTIVE_LEAVES'])
+    t = sum(cons_leaves)
+    num_nodes = sum(npl)
+    if num_nodes != 2*t-1:
+        raise Exception('inconsistent tree parameters for ' + params['condition'])
+
+    # the same indexing as the one of tree_root() in merkle.c
+    parents = [0]
+    start_node = 1
+    for level in range(1, len(npl)):
+        for node in range(start_node, start_node + npl[level]):
+            parent = ((node-1) if node % 2 else (node-2)) // 2
+            parents.append(parent + (off[level-1] >> 1))
+        start_node += npl[level]
+
+    leaves = [start + j for start, count in zip(start_indices, cons_leaves)
+                        for j in range(count)]
+    return parents, leaves
+
+def format_table(name, size, values):
+    lines = []
+    for i in range(0, len(values), VALUES_PER_LINE):
+        lines.append('    ' + ', '.join(str(v) for v in values[i:i+VALUES_PER_LINE]))
+    return ('static const uint16_t ' + name + '[' + size + '] = {\n'
+            + ',\n'.join(lines) + '\n};\n')
+
+def generate(params_path, out_path):
+    # the SPEED sets have no trees (NO_TREES is defined in set.h)
+    sets = [s for s in parse_sets(params_path)
+            if 'TREE_OFFSETS' in s and 'SPEED' not in s['condition']]
+    with open(out_path, 'w') as out:
+        out.write(HEADER)
+        for i, params in enumerate(sets):
+            parents, leaves = compute_tables(params)
+            out.write('\n' + ('#if ' if i == 0 else '#elif ') + params['condition'] + '\n')
+            out.write(format_table('TREE_PARENT_NODES', 'NUM_NODES_MERKLE_TREE', parents))
+            out.write(format_table('TREE_LEAF_NODES', 'T', leaves))
+        out.write('\n' + FOOTER)
+
+if __name__ == '__main__':
+    generate('../clean/parameters.h', '../clean/tree_tables.h')
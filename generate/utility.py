@@ -20,6 +20,12 @@ def run_astyle(dir, astyle_config_file):
             astyle_command = 'astyle --options='+astyle_config_file+' '+dir+'/'+file+' > /dev/null 2>&1'
             os.system(astyle_command)
 
+# symbols resolved on top of set.h and parameters.h: set.h cannot undefine
+# the ones the compiler or the platform define, yet the generated
+# implementations carry no code depending on them, e.g., the placement of
+# the tracepoints of probes.h
+platform_symbols = '-DNO_USDT_PROBES -U__GNUC__'
+
 # use the unifdef utility to remove #if, #ifdef, #elif, etc.
 # unifdef has a few quirks, some additional processing is needed
 # (e.g. it does not recognize multiline #define statements)
@@ -41,7 +47,7 @@ def remove_dead_code(dir):
     # use the definitions in set.h and parameters.h to remove dead code from the rest of the files
     for file in os.listdir(dir):
         if file.endswith('.c') or file.endswith('.h'):
-            unifdef_command = 'unifdef -m -f '+dir+'/set.h -f '+dir+'/tmp_parameters.h '+dir+'/'+file
+            unifdef_command = 'unifdef -m '+platform_symbols+' -f '+dir+'/set.h -f '+dir+'/tmp_parameters.h '+dir+'/'+file
             os.system(unifdef_command)
     # restore the preprocessor directives
     replace_in_dir(dir, "//#pragma once", "#pragma once")
@@ -0,0 +1,76 @@
+/**
+ *
+ * Reference ISO-C11 Implementation of CROSS.
+ *
+ * @version 2.0 (February 2025)
+ *
+ * Authors listed in alphabetical order:
+ * 
+ * @author: Alessandro Barenghi <alessandro.barenghi@polimi.it>
+ * @author: Marco Gianvecchio <marco.gianvecchio@mail.polimi.it>
+ * @author: Patrick Karl <patrick.karl@tum.de>
+ * @author: Gerardo Pelosi <gerardo.pelosi@polimi.it>
+ * @author: Jonas Schupp <jonas.schupp@tum.de>
+ * 
+ * 
+ * This code is hereby placed in the public domain.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ''AS IS'' AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **/
+
+#include <stdlib.h>
+
+#include "cross.h"
+#include "cross_dispatch.h"
+
+#define DISPATCH_UNKNOWN (-1)
+
+static int use_avx2 = DISPATCH_UNKNOWN;
+
+static
+int detect_avx2(void){
+#if defined(CROSS_DISPATCH_AVX2)
+    if(getenv("CROSS_DISABLE_AVX2") != NULL){
+        return 0;
+    }
+    /* also checks that the operating system saves the AVX registers */
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") ? 1 : 0;
+#else
+    return 0;
+#endif
+}
+
+int cross_dispatch_use_avx2(void){
+    int r = __atomic_load_n(&use_avx2, __ATOMIC_RELAXED);
+    if(r == DISPATCH_UNKNOWN){
+        /* concurrent first calls all come to the same answer */
+        r = detect_avx2();
+        __atomic_store_n(&use_avx2, r, __ATOMIC_RELAXED);
+    }
+    return r;
+}
+
+/* the choice is made when the library is loaded, the entry points only read
+ * it afterwards */
+__attribute__((constructor))
+static
+void cross_dispatch_init(void){
+    (void) cross_dispatch_use_avx2();
+}
+
+CROSS_EXPORT
+const char *CROSS_dispatch_implementation(void){
+    return cross_dispatch_use_avx2() ? "avx2" : "clean";
+}
@@ -0,0 +1,83 @@
+/**
+ *
+ * Reference ISO-C11 Implementation of CROSS.
+ *
+ * @version 2.0 (February 2025)
+ *
+ * Authors listed in alphabetical order:
+ * 
+ * @author: Alessandro Barenghi <alessandro.barenghi@polimi.it>
+ * @author: Marco Gianvecchio <marco.gianvecchio@mail.polimi.it>
+ * @author: Patrick Karl <patrick.karl@tum.de>
+ * @author: Gerardo Pelosi <gerardo.pelosi@polimi.it>
+ * @author: Jonas Schupp <jonas.schupp@tum.de>
+ * 
+ * 
+ * This code is hereby placed in the public domain.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ''AS IS'' AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **/
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Selection, at load time, of the implementation behind the entry points of
+ * the shared library. CROSS_DISPATCH_AVX2 is defined when the avx2
+ * implementations are linked in, which happens on x86-64 only */
+
+#if defined(__GNUC__)
+#define CROSS_EXPORT __attribute__((visibility("default")))
+#else
+#define CROSS_EXPORT
+#endif
+
+/* the entry points of one implementation of a parameter set, see its api.h */
+typedef struct {
+   int (*keypair)(unsigned char *pk, unsigned char *sk);
+   int (*keypair_batch)(unsigned char *pk, unsigned char *sk, size_t n);
+   int (*sign)(unsigned char *sm, size_t *smlen,
+               const unsigned char *m, size_t mlen,
+               const unsigned char *sk);
+   int (*open)(unsigned char *m, size_t *mlen,
+               const unsigned char *sm, size_t smlen,
+               const unsigned char *pk);
+   int (*signature)(unsigned char *sig, size_t *siglen,
+                    const unsigned char *m, size_t mlen,
+                    const unsigned char *sk);
+   int (*verify)(const unsigned char *sig, size_t siglen,
+                 const unsigned char *m, size_t mlen,
+                 const unsigned char *pk);
+   void (*rng_pool_release)(void);
+   void (*pk_cache_set_budget)(size_t budget_bytes);
+   void (*pk_cache_stats)(uint64_t *hits, uint64_t *misses, uint64_t *evictions);
+   void (*pk_cache_release)(void);
+   int (*presig_pool_start)(const unsigned char *sk, size_t capacity);
+   int (*signature_pooled)(unsigned char *sig, size_t *siglen,
+                           const unsigned char *m, size_t mlen);
+   void (*presig_pool_stop)(void);
+   const char *(*hash_stats_site)(size_t site);
+   void (*hash_stats_lanes)(size_t site, uint64_t calls[4]);
+   void (*hash_stats_sign)(uint64_t *signs, uint64_t *permutations,
+                           uint64_t *permutations_x4);
+   void (*hash_stats_verify)(uint64_t *verifies, uint64_t *permutations,
+                             uint64_t *permutations_x4);
+   void (*hash_stats_reset)(void);
+} cross_impl_t;
+
+/* returns 1 if the avx2 implementations are to be employed: they are linked
+ * in, CPU and operating system support AVX2, and the environment variable
+ * CROSS_DISABLE_AVX2 is not set; 0 otherwise. It is computed once */
+int cross_dispatch_use_avx2(void);
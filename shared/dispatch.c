@@ -0,0 +1,218 @@
+/**
+ *
+ * Reference ISO-C11 Implementation of CROSS.
+ *
+ * @version 2.0 (February 2025)
+ *
+ * Authors listed in alphabetical order:
+ * 
+ * @author: Alessandro Barenghi <alessandro.barenghi@polimi.it>
+ * @author: Marco Gianvecchio <marco.gianvecchio@mail.polimi.it>
+ * @author: Patrick Karl <patrick.karl@tum.de>
+ * @author: Gerardo Pelosi <gerardo.pelosi@polimi.it>
+ * @author: Jonas Schupp <jonas.schupp@tum.de>
+ * 
+ * 
+ * This code is hereby placed in the public domain.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ''AS IS'' AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **/
+
+/* Entry points of __dir__ in the shared library: each of them forwards to
+ * the avx2 implementation on hosts supporting it, to the clean one
+ * otherwise */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "cross_dispatch.h"
+#include "__dir__.h"
+#include "__dir__/clean/api.h"
+#if defined(CROSS_DISPATCH_AVX2)
+#include "__dir__/avx2/api.h"
+#endif
+
+static const cross_impl_t impl_clean = {
+   __namespace_clean__crypto_sign_keypair,
+   __namespace_clean__crypto_sign_keypair_batch,
+   __namespace_clean__crypto_sign,
+   __namespace_clean__crypto_sign_open,
+   __namespace_clean__crypto_sign_signature,
+   __namespace_clean__crypto_sign_verify,
+   __namespace_clean__crypto_sign_rng_pool_release,
+   __namespace_clean__crypto_sign_pk_cache_set_budget,
+   __namespace_clean__crypto_sign_pk_cache_stats,
+   __namespace_clean__crypto_sign_pk_cache_release,
+   __namespace_clean__crypto_sign_presig_pool_start,
+   __namespace_clean__crypto_sign_signature_pooled,
+   __namespace_clean__crypto_sign_presig_pool_stop,
+   __namespace_clean__crypto_sign_hash_stats_site,
+   __namespace_clean__crypto_sign_hash_stats_lanes,
+   __namespace_clean__crypto_sign_hash_stats_sign,
+   __namespace_clean__crypto_sign_hash_stats_verify,
+   __namespace_clean__crypto_sign_hash_stats_reset
+};
+
+#if defined(CROSS_DISPATCH_AVX2)
+static const cross_impl_t impl_avx2 = {
+   __namespace_avx2__crypto_sign_keypair,
+   __namespace_avx2__crypto_sign_keypair_batch,
+   __namespace_avx2__crypto_sign,
+   __namespace_avx2__crypto_sign_open,
+   __namespace_avx2__crypto_sign_signature,
+   __namespace_avx2__crypto_sign_verify,
+   __namespace_avx2__crypto_sign_rng_pool_release,
+   __namespace_avx2__crypto_sign_pk_cache_set_budget,
+   __namespace_avx2__crypto_sign_pk_cache_stats,
+   __namespace_avx2__crypto_sign_pk_cache_release,
+   __namespace_avx2__crypto_sign_presig_pool_start,
+   __namespace_avx2__crypto_sign_signature_pooled,
+   __namespace_avx2__crypto_sign_presig_pool_stop,
+   __namespace_avx2__crypto_sign_hash_stats_site,
+   __namespace_avx2__crypto_sign_hash_stats_lanes,
+   __namespace_avx2__crypto_sign_hash_stats_sign,
+   __namespace_avx2__crypto_sign_hash_stats_verify,
+   __namespace_avx2__crypto_sign_hash_stats_reset
+};
+#endif
+
+static
+const cross_impl_t *impl(void){
+#if defined(CROSS_DISPATCH_AVX2)
+    if(cross_dispatch_use_avx2()){
+        return &impl_avx2;
+    }
+#endif
+    return &impl_clean;
+}
+
+CROSS_EXPORT
+int __namespace__crypto_sign_keypair(unsigned char *pk,
+                        unsigned char *sk){
+    return impl()->keypair(pk, sk);
+}
+
+CROSS_EXPORT
+int __namespace__crypto_sign_keypair_batch(unsigned char *pk,
+                        unsigned char *sk,
+                        size_t n){
+    return impl()->keypair_batch(pk, sk, n);
+}
+
+CROSS_EXPORT
+int __namespace__crypto_sign(unsigned char *sm,
+                size_t *smlen,
+                const unsigned char *m,
+                size_t mlen,
+                const unsigned char *sk){
+    return impl()->sign(sm, smlen, m, mlen, sk);
+}
+
+CROSS_EXPORT
+int __namespace__crypto_sign_open(unsigned char *m,
+                     size_t *mlen,
+                     const unsigned char *sm,
+                     size_t smlen,
+                     const unsigned char *pk){
+    return impl()->open(m, mlen, sm, smlen, pk);
+}
+
+CROSS_EXPORT
+int __namespace__crypto_sign_signature(unsigned char *sig,
+                size_t *siglen,
+                const unsigned char *m,
+                size_t mlen,
+                const unsigned char *sk){
+    return impl()->signature(sig, siglen, m, mlen, sk);
+}
+
+CROSS_EXPORT
+int __namespace__crypto_sign_verify(const unsigned char *sig,
+                size_t siglen,
+                const unsigned char *m,
+                size_t mlen,
+                const unsigned char *pk){
+    return impl()->verify(sig, siglen, m, mlen, pk);
+}
+
+CROSS_EXPORT
+void __namespace__crypto_sign_rng_pool_release(void){
+    impl()->rng_pool_release();
+}
+
+CROSS_EXPORT
+void __namespace__crypto_sign_pk_cache_set_budget(size_t budget_bytes){
+    impl()->pk_cache_set_budget(budget_bytes);
+}
+
+CROSS_EXPORT
+void __namespace__crypto_sign_pk_cache_stats(uint64_t *hits,
+                                uint64_t *misses,
+                                uint64_t *evictions){
+    impl()->pk_cache_stats(hits, misses, evictions);
+}
+
+CROSS_EXPORT
+void __namespace__crypto_sign_pk_cache_release(void){
+    impl()->pk_cache_release();
+}
+
+CROSS_EXPORT
+int __namespace__crypto_sign_presig_pool_start(const unsigned char *sk,
+                                  size_t capacity){
+    return impl()->presig_pool_start(sk, capacity);
+}
+
+CROSS_EXPORT
+int __namespace__crypto_sign_signature_pooled(unsigned char *sig,
+                                 size_t *siglen,
+                                 const unsigned char *m,
+                                 size_t mlen){
+    return impl()->signature_pooled(sig, siglen, m, mlen);
+}
+
+CROSS_EXPORT
+void __namespace__crypto_sign_presig_pool_stop(void){
+    impl()->presig_pool_stop();
+}
+
+CROSS_EXPORT
+const char *__namespace__crypto_sign_hash_stats_site(size_t site){
+    return impl()->hash_stats_site(site);
+}
+
+CROSS_EXPORT
+void __namespace__crypto_sign_hash_stats_lanes(size_t site,
+                                  uint64_t calls[4]){
+    impl()->hash_stats_lanes(site, calls);
+}
+
+CROSS_EXPORT
+void __namespace__crypto_sign_hash_stats_sign(uint64_t *signs,
+                                 uint64_t *permutations,
+                                 uint64_t *permutations_x4){
+    impl()->hash_stats_sign(signs, permutations, permutations_x4);
+}
+
+CROSS_EXPORT
+void __namespace__crypto_sign_hash_stats_verify(uint64_t *verifies,
+                                   uint64_t *permutations,
+                                   uint64_t *permutations_x4){
+    impl()->hash_stats_verify(verifies, permutations, permutations_x4);
+}
+
+CROSS_EXPORT
+void __namespace__crypto_sign_hash_stats_reset(void){
+    impl()->hash_stats_reset();
+}
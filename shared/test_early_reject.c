@@ -0,0 +1,162 @@
+/**
+ *
+ * Reference ISO-C11 Implementation of CROSS.
+ *
+ * @version 2.0 (February 2025)
+ *
+ * Authors listed in alphabetical order:
+ * 
+ * @author: Alessandro Barenghi <alessandro.barenghi@polimi.it>
+ * @author: Marco Gianvecchio <marco.gianvecchio@mail.polimi.it>
+ * @author: Patrick Karl <patrick.karl@tum.de>
+ * @author: Gerardo Pelosi <gerardo.pelosi@polimi.it>
+ * @author: Jonas Schupp <jonas.schupp@tum.de>
+ * 
+ * 
+ * This code is hereby placed in the public domain.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ''AS IS'' AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **/
+
+
+
+/* Checks the reject paths of VERIFY_EARLY_REJECT: signatures with a packed
+ * response out of range, or with nonzero padding in the seed path or in the
+ * Merkle proof, and public keys with a packed syndrome out of range, must be
+ * rejected by CROSS_verify and, built with VERIFY_EARLY_REJECT, by the
+ * start of the step-wise verification, before any step does work. A
+ * well-formed signature which does not verify must still be left to the
+ * steps. Built without VERIFY_EARLY_REJECT, the same signatures and keys
+ * must be rejected, by the steps.
+ * Usage: test_early_reject */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "CROSS.h"
+#include "pk_expanded.h"
+#include "test_impl.h"
+#include "verify_state.h"
+
+#define MESSAGE_BYTES 32
+
+static sk_t sk;
+static pk_t pk, pk_malformed;
+static pk_expanded_t epk;
+static CROSS_sig_t sig, malformed;
+static CROSS_verify_state_t state;
+static char m[MESSAGE_BYTES];
+static int ok = 1;
+
+/* fails the test, saying why, unless condition holds */
+static
+void expect(int condition, const char *what){
+    if(!condition){
+        fprintf(stderr, "%s %s: %s\n", TEST_SET, TEST_IMPL, what);
+        ok = 0;
+    }
+}
+
+/* returns 1 if the verification just started was ended by its start, i.e.,
+ * a step of no budget has no work left, after finishing it, which must
+ * reject */
+static
+int started_rejected(const char *what){
+    int ended = CROSS_verify_step(&state, 0);
+    expect(!CROSS_verify_finish(&state), what);
+    return ended;
+}
+
+/* checks that signature is rejected under PK, early if and only if early */
+static
+void check_rejected(const pk_t *PK, const CROSS_sig_t *signature,
+                    int early, const char *what){
+    expect(!CROSS_verify(PK, m, sizeof(m), signature), what);
+    CROSS_verify_start(&state, PK, m, sizeof(m), signature);
+    expect(started_rejected(what) == early, what);
+}
+
+/* as check_rejected, with the signature also checked through the
+ * expansion of the valid public key */
+static
+void check_sig_rejected(const CROSS_sig_t *signature, int early,
+                        const char *what){
+    check_rejected(&pk, signature, early, what);
+    CROSS_verify_start_expanded(&state, &epk, m, sizeof(m), signature);
+    expect(started_rejected(what) == early, what);
+}
+
+/* returns 1 if the last seed_bytes of storage are all zero, i.e., padding */
+static
+int is_padded(const uint8_t *storage, size_t bytes, size_t seed_bytes){
+    for(size_t i = bytes - seed_bytes; i < bytes; i++){
+        if(storage[i] != 0){
+            return 0;
+        }
+    }
+    return 1;
+}
+
+int main(void){
+    if(test_skipped("test_early_reject", TEST_SET, TEST_IMPL)){
+        return 0;
+    }
+#if defined(VERIFY_EARLY_REJECT)
+    const int early = 1;
+#else
+    const int early = 0;
+#endif
+    test_randombytes_reset(1);
+    memset(m, 0x5a, sizeof(m));
+    CROSS_keygen(&sk, &pk);
+    CROSS_sign(&sk, m, sizeof(m), &sig);
+    CROSS_pk_expand(&epk, &pk);
+
+    /* all the bits set pack an element as large as its field allows, which
+     * is out of range for every parameter set */
+    malformed = sig;
+    memset(malformed.resp_0[T-W-1].y, 0xff, sizeof(malformed.resp_0[0].y));
+    check_sig_rejected(&malformed, early, "y out of range");
+    malformed = sig;
+#if defined(RSDP)
+    memset(malformed.resp_0[0].v_bar, 0xff, sizeof(malformed.resp_0[0].v_bar));
+#elif defined(RSDPG)
+    memset(malformed.resp_0[0].v_G_bar, 0xff, sizeof(malformed.resp_0[0].v_G_bar));
+#endif
+    check_sig_rejected(&malformed, early, "restricted response out of range");
+    pk_malformed = pk;
+    memset(pk_malformed.s, 0xff, sizeof(pk_malformed.s));
+    check_rejected(&pk_malformed, &sig, early, "syndrome out of range");
+
+    /* the seed path and the Merkle proof end in padding unless the
+     * challenge fills them */
+    if(is_padded(sig.path, sizeof(sig.path), SEED_LENGTH_BYTES)){
+        malformed = sig;
+        malformed.path[sizeof(malformed.path)-1] = 1;
+        check_sig_rejected(&malformed, early, "nonzero padding of the seed path");
+    }
+    if(is_padded(sig.proof, sizeof(sig.proof), HASH_DIGEST_LENGTH)){
+        malformed = sig;
+        malformed.proof[sizeof(malformed.proof)-1] = 1;
+        check_sig_rejected(&malformed, early, "nonzero padding of the Merkle proof");
+    }
+
+    /* well formed, but not verifying: left to the steps */
+    malformed = sig;
+    malformed.resp_1[0][0] ^= 1;
+    check_sig_rejected(&malformed, 0, "well-formed signature rejected early");
+
+    return test_report("test_early_reject", TEST_SET, TEST_IMPL, ok);
+}
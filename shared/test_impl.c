@@ -0,0 +1,76 @@
+/**
+ *
+ * Reference ISO-C11 Implementation of CROSS.
+ *
+ * @version 2.0 (February 2025)
+ *
+ * Authors listed in alphabetical order:
+ * 
+ * @author: Alessandro Barenghi <alessandro.barenghi@polimi.it>
+ * @author: Marco Gianvecchio <marco.gianvecchio@mail.polimi.it>
+ * @author: Patrick Karl <patrick.karl@tum.de>
+ * @author: Gerardo Pelosi <gerardo.pelosi@polimi.it>
+ * @author: Jonas Schupp <jonas.schupp@tum.de>
+ * 
+ * 
+ * This code is hereby placed in the public domain.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ''AS IS'' AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **/
+
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "randombytes.h"
+#include "test_impl.h"
+
+/* xorshift64*: the tests need repeatable draws, not unpredictable ones */
+static uint64_t state = 1;
+
+void test_randombytes_reset(uint64_t seed){
+    state = seed | 1;
+}
+
+int randombytes(uint8_t *output, size_t n){
+    for(size_t i = 0; i < n; i++){
+        state ^= state >> 12;
+        state ^= state << 25;
+        state ^= state >> 27;
+        output[i] = (uint8_t)((state * 0x2545F4914F6CDD1DULL) >> 56);
+    }
+    return 0;
+}
+
+int test_skipped(const char *test, const char *set, const char *impl){
+#if defined(__GNUC__) && defined(__x86_64__)
+    /* also checks that the operating system saves the AVX registers */
+    __builtin_cpu_init();
+    int has_avx2 = __builtin_cpu_supports("avx2");
+#else
+    int has_avx2 = 0;
+#endif
+    if(strcmp(impl, "avx2") == 0 && !has_avx2){
+        printf("%s %s %s skipped, no AVX2\n", test, set, impl);
+        return 1;
+    }
+    return 0;
+}
+
+int test_report(const char *test, const char *set, const char *impl, int ok){
+    printf("%s %s %s %s\n", test, set, impl, ok ? "ok" : "failed");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,86 @@
+/**
+ *
+ * Reference ISO-C11 Implementation of CROSS.
+ *
+ * @version 2.0 (February 2025)
+ *
+ * Authors listed in alphabetical order:
+ * 
+ * @author: Alessandro Barenghi <alessandro.barenghi@polimi.it>
+ * @author: Marco Gianvecchio <marco.gianvecchio@mail.polimi.it>
+ * @author: Patrick Karl <patrick.karl@tum.de>
+ * @author: Gerardo Pelosi <gerardo.pelosi@polimi.it>
+ * @author: Jonas Schupp <jonas.schupp@tum.de>
+ * 
+ * 
+ * This code is hereby placed in the public domain.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ''AS IS'' AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **/
+
+
+
+/* Checks that CROSS_keygen_batch generates the same keypairs as as many
+ * consecutive calls to CROSS_keygen drawing the same randomness, for batches
+ * which fill the lanes of the avx2 implementation and which do not.
+ * Usage: test_keygen_batch */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "CROSS.h"
+#include "rng_pool.h"
+#include "test_impl.h"
+
+#define MAX_KEYPAIRS 7
+
+static const size_t batch_sizes[] = {1, 3, 4, 5, MAX_KEYPAIRS};
+
+/* returns 1 if the batch of n keypairs matches the consecutive ones */
+static
+int test_batch(size_t n){
+    sk_t sk[MAX_KEYPAIRS], sk_batch[MAX_KEYPAIRS];
+    pk_t pk[MAX_KEYPAIRS], pk_batch[MAX_KEYPAIRS];
+
+    /* the pool of RNG_POOL is wiped, so that both reseed from the same
+     * randombytes */
+    rng_pool_release();
+    test_randombytes_reset(n);
+    for(size_t i = 0; i < n; i++){
+        CROSS_keygen(&sk[i], &pk[i]);
+    }
+    rng_pool_release();
+    test_randombytes_reset(n);
+    CROSS_keygen_batch(sk_batch, pk_batch, n);
+    rng_pool_release();
+
+    if(memcmp(sk, sk_batch, n*sizeof(sk_t)) != 0 ||
+       memcmp(pk, pk_batch, n*sizeof(pk_t)) != 0){
+        fprintf(stderr, "%s %s: a batch of %zu keypairs differs\n",
+                TEST_SET, TEST_IMPL, n);
+        return 0;
+    }
+    return 1;
+}
+
+int main(void){
+    if(test_skipped("test_keygen_batch", TEST_SET, TEST_IMPL)){
+        return 0;
+    }
+    int ok = 1;
+    for(size_t b = 0; b < sizeof(batch_sizes)/sizeof(batch_sizes[0]); b++){
+        ok &= test_batch(batch_sizes[b]);
+    }
+    return test_report("test_keygen_batch", TEST_SET, TEST_IMPL, ok);
+}
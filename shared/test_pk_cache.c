@@ -0,0 +1,132 @@
+/**
+ *
+ * Reference ISO-C11 Implementation of CROSS.
+ *
+ * @version 2.0 (February 2025)
+ *
+ * Authors listed in alphabetical order:
+ * 
+ * @author: Alessandro Barenghi <alessandro.barenghi@polimi.it>
+ * @author: Marco Gianvecchio <marco.gianvecchio@mail.polimi.it>
+ * @author: Patrick Karl <patrick.karl@tum.de>
+ * @author: Gerardo Pelosi <gerardo.pelosi@polimi.it>
+ * @author: Jonas Schupp <jonas.schupp@tum.de>
+ * 
+ * 
+ * This code is hereby placed in the public domain.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ''AS IS'' AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **/
+
+
+
+/* Checks that CROSS_verify has the same outcome whether the matrices of the
+ * public key are expanded or copied out of the cache of PK_CACHE: on a valid
+ * signature, on a tampered one, under another public key, and under a
+ * public key sharing seed_pk with the signer's but with another syndrome,
+ * which the cache must not mistake for the signer's. Also checks that the
+ * second verification against a seed_pk is a hit, and that no entry is kept
+ * with a zero budget. Built without PK_CACHE, every lookup must miss.
+ * Usage: test_pk_cache */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "CROSS.h"
+#include "pk_cache.h"
+#include "test_impl.h"
+
+#define MESSAGE_BYTES 32
+#define BUDGET_BYTES (64*1024*1024)
+
+static sk_t sk, sk_other;
+static pk_t pk, pk_other, pk_forged;
+static CROSS_sig_t sig, sig_tampered;
+static char m[MESSAGE_BYTES];
+
+static
+uint64_t hits(void){
+    uint64_t h;
+    pk_cache_stats(&h, NULL, NULL);
+    return h;
+}
+
+/* returns 1 if verifying sig under PK gives expected both on a miss and on
+ * the hit which follows, 0 otherwise */
+static
+int check_miss_hit(const char *what, const pk_t *PK,
+                   const CROSS_sig_t *signature, int expected){
+    pk_cache_release();
+    uint64_t before = hits();
+    int miss = CROSS_verify(PK, m, sizeof(m), signature);
+    int hit = CROSS_verify(PK, m, sizeof(m), signature);
+#if defined(PK_CACHE)
+    uint64_t expected_hits = before + 1;
+#else
+    uint64_t expected_hits = 0;
+#endif
+    if(miss != expected || hit != expected || hits() != expected_hits){
+        fprintf(stderr, "%s %s: %s, miss %d, hit %d, expected %d, hits %llu\n",
+                TEST_SET, TEST_IMPL, what, miss, hit, expected,
+                (unsigned long long)(hits() - before));
+        return 0;
+    }
+    return 1;
+}
+
+int main(void){
+    if(test_skipped("test_pk_cache", TEST_SET, TEST_IMPL)){
+        return 0;
+    }
+    test_randombytes_reset(1);
+    pk_cache_set_budget(BUDGET_BYTES);
+    memset(m, 0x5a, sizeof(m));
+    CROSS_keygen(&sk, &pk);
+    CROSS_keygen(&sk_other, &pk_other);
+    CROSS_sign(&sk, m, sizeof(m), &sig);
+
+    sig_tampered = sig;
+    sig_tampered.resp_1[0][0] ^= 1;
+    pk_forged = pk;
+    memcpy(pk_forged.s, pk_other.s, sizeof(pk.s));
+
+    int ok = check_miss_hit("valid", &pk, &sig, 1);
+    ok &= check_miss_hit("tampered", &pk, &sig_tampered, 0);
+    ok &= check_miss_hit("other key", &pk_other, &sig, 0);
+    ok &= check_miss_hit("other syndrome", &pk_forged, &sig, 0);
+
+    /* with the cache warm with the signer's seed_pk, the forged key must be
+     * rejected on a hit as well */
+    pk_cache_release();
+    uint64_t before = hits();
+    ok &= CROSS_verify(&pk, m, sizeof(m), &sig) == 1;
+    ok &= CROSS_verify(&pk_forged, m, sizeof(m), &sig) == 0;
+    ok &= CROSS_verify(&pk, m, sizeof(m), &sig) == 1;
+#if defined(PK_CACHE)
+    ok &= hits() == before + 2;
+#else
+    ok &= hits() == before;
+#endif
+
+    /* nothing fits a zero budget */
+    pk_cache_set_budget(0);
+    before = hits();
+    ok &= CROSS_verify(&pk, m, sizeof(m), &sig) == 1;
+    ok &= CROSS_verify(&pk, m, sizeof(m), &sig) == 1;
+    ok &= hits() == before;
+    pk_cache_release();
+
+    return test_report("test_pk_cache", TEST_SET, TEST_IMPL, ok);
+}
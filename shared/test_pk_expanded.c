@@ -0,0 +1,186 @@
+/**
+ *
+ * Reference ISO-C11 Implementation of CROSS.
+ *
+ * @version 2.0 (February 2025)
+ *
+ * Authors listed in alphabetical order:
+ * 
+ * @author: Alessandro Barenghi <alessandro.barenghi@polimi.it>
+ * @author: Marco Gianvecchio <marco.gianvecchio@mail.polimi.it>
+ * @author: Patrick Karl <patrick.karl@tum.de>
+ * @author: Gerardo Pelosi <gerardo.pelosi@polimi.it>
+ * @author: Jonas Schupp <jonas.schupp@tum.de>
+ * 
+ * 
+ * This code is hereby placed in the public domain.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ''AS IS'' AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **/
+
+
+
+/* Checks the files of expanded public keys of PK_EXPANDED_FILE: every key
+ * stored is found in the mapped file, expanded as CROSS_pk_expand does, and
+ * verifies its signature, while a key not stored is not found; an entry
+ * which is corrupted in the file is not returned, the others still are, and
+ * a file with a corrupted header or truncated is not mapped. Built without
+ * PK_EXPANDED_FILE, storing must fail and mapping return NULL.
+ * Usage: test_pk_expanded [directory for the file, default /tmp] */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "CROSS.h"
+#include "pk_expanded.h"
+#include "test_impl.h"
+
+#define NUM_KEYS 5
+#define MESSAGE_BYTES 32
+#define PATH_BYTES 256
+
+static sk_t sk[NUM_KEYS+1];
+static pk_t pk[NUM_KEYS+1];
+static char m[MESSAGE_BYTES];
+static int ok = 1;
+
+/* fails the test, saying why, unless condition holds */
+static
+void expect(int condition, const char *what){
+    if(!condition){
+        fprintf(stderr, "%s %s: %s\n", TEST_SET, TEST_IMPL, what);
+        ok = 0;
+    }
+}
+
+#if defined(PK_EXPANDED_FILE)
+static CROSS_sig_t sig;
+static pk_expanded_t epk;
+
+/* returns the number of the first NUM_KEYS keys which are found in the file
+ * at path, checking those against their expansion and signature; -1 if the
+ * file is not mapped */
+static
+int found_keys(const char *path){
+    pk_expanded_map_t *map = CROSS_pk_expanded_map(path);
+    if(map == NULL){
+        return -1;
+    }
+    int found = 0;
+    for(int i = 0; i < NUM_KEYS; i++){
+        const pk_expanded_t *stored = CROSS_pk_expanded_find(map, &pk[i]);
+        if(stored == NULL){
+            continue;
+        }
+        found++;
+        /* the file zeroes the padding of the entries */
+        memset(&epk, 0, sizeof(epk));
+        CROSS_pk_expand(&epk, &pk[i]);
+        CROSS_sign(&sk[i], m, sizeof(m), &sig);
+        expect(memcmp(stored, &epk, sizeof(epk)) == 0 &&
+               CROSS_verify_expanded(stored, m, sizeof(m), &sig),
+               "a key differs once stored");
+    }
+    expect(CROSS_pk_expanded_find(map, &pk[NUM_KEYS]) == NULL,
+           "a key not stored is found");
+    CROSS_pk_expanded_unmap(map);
+    return found;
+}
+
+/* copies the file at from to to, flipping the bits of flip in the byte at
+ * offset (counted from the end if negative) and dropping the last truncate
+ * bytes; returns 1 on success, 0 otherwise */
+static
+int corrupt(const char *from, const char *to, long offset, uint8_t flip,
+            long truncate){
+    FILE *f = fopen(from, "rb");
+    if(f == NULL || fseek(f, 0, SEEK_END) != 0){
+        if(f != NULL){
+            fclose(f);
+        }
+        return 0;
+    }
+    long size = ftell(f);
+    uint8_t *data = malloc(size > 0 ? size : 1);
+    int copied = (size > truncate && data != NULL && fseek(f, 0, SEEK_SET) == 0 &&
+                  fread(data, size, 1, f) == 1);
+    fclose(f);
+    if(copied){
+        data[offset < 0 ? offset + size : offset] ^= flip;
+        f = fopen(to, "wb");
+        copied = (f != NULL && fwrite(data, size - truncate, 1, f) == 1);
+        if(f != NULL){
+            copied &= (fclose(f) == 0);
+        }
+    }
+    free(data);
+    return copied;
+}
+#endif
+
+int main(int argc, char **argv){
+    if(test_skipped("test_pk_expanded", TEST_SET, TEST_IMPL)){
+        return 0;
+    }
+    char path[PATH_BYTES], corrupted[PATH_BYTES];
+    const char *dir = (argc > 1) ? argv[1] : "/tmp";
+    long pid = (long)getpid();
+    if(snprintf(path, sizeof(path), "%s/test_pk_expanded_%ld.epk", dir, pid) >= PATH_BYTES ||
+       snprintf(corrupted, sizeof(corrupted), "%s/test_pk_expanded_%ld.corrupted.epk", dir, pid) >= PATH_BYTES){
+        fprintf(stderr, "usage: %s [directory for the file, default /tmp]\n", argv[0]);
+        return 1;
+    }
+
+    test_randombytes_reset(1);
+    memset(m, 0x5a, sizeof(m));
+    for(int i = 0; i <= NUM_KEYS; i++){
+        CROSS_keygen(&sk[i], &pk[i]);
+    }
+
+#if defined(PK_EXPANDED_FILE)
+    expect(CROSS_pk_expanded_store(path, pk, NUM_KEYS), "the keys are not stored");
+    expect(found_keys(path) == NUM_KEYS, "a key stored is not found");
+
+    /* a byte of the syndrome of the last entry, then of the CRC32C of the
+     * first one, which follow the entries */
+    long entry_s = -(long)(4*NUM_KEYS + sizeof(pk_expanded_t) - offsetof(pk_expanded_t, s));
+    expect(corrupt(path, corrupted, entry_s, 0x10, 0) &&
+           found_keys(corrupted) == NUM_KEYS-1,
+           "a corrupted entry is returned");
+    expect(corrupt(path, corrupted, -4*NUM_KEYS, 0x10, 0) &&
+           found_keys(corrupted) == NUM_KEYS-1,
+           "an entry with a corrupted CRC32C is returned");
+
+    /* the magic of the header, then the size of the file */
+    expect(corrupt(path, corrupted, 0, 0x10, 0) &&
+           found_keys(corrupted) == -1,
+           "a file with a corrupted header is mapped");
+    expect(corrupt(path, corrupted, 0, 0, 1) &&
+           found_keys(corrupted) == -1,
+           "a truncated file is mapped");
+    remove(corrupted);
+#else
+    expect(!CROSS_pk_expanded_store(path, pk, NUM_KEYS), "keys are stored");
+    expect(CROSS_pk_expanded_map(path) == NULL, "a file is mapped");
+#endif
+    remove(path);
+
+    return test_report("test_pk_expanded", TEST_SET, TEST_IMPL, ok);
+}
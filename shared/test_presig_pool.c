@@ -0,0 +1,170 @@
+/**
+ *
+ * Reference ISO-C11 Implementation of CROSS.
+ *
+ * @version 2.0 (February 2025)
+ *
+ * Authors listed in alphabetical order:
+ * 
+ * @author: Alessandro Barenghi <alessandro.barenghi@polimi.it>
+ * @author: Marco Gianvecchio <marco.gianvecchio@mail.polimi.it>
+ * @author: Patrick Karl <patrick.karl@tum.de>
+ * @author: Gerardo Pelosi <gerardo.pelosi@polimi.it>
+ * @author: Jonas Schupp <jonas.schupp@tum.de>
+ * 
+ * 
+ * This code is hereby placed in the public domain.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ''AS IS'' AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **/
+
+
+/* Checks that a child process forked while the presignature pool of a set
+ * runs cannot sign with the presignatures of its parent: in the child,
+ * crypto_sign_signature_pooled must fail until the pool is started again,
+ * stopping the inherited pool must return, and a pool started afresh must
+ * sign. The parent must keep signing with its own pool meanwhile.
+ * The library must be built with EXTRAFLAGS="-DPRESIG_POOL", otherwise the
+ * check is skipped.
+ * Usage: test_presig_pool [set ...] */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "cross.h"
+
+#define CAPACITY 4
+#define MESSAGE_BYTES 32
+
+typedef struct {
+   const char *name;
+   size_t pk_bytes;
+   size_t sk_bytes;
+   size_t sig_bytes;
+   int (*keypair)(unsigned char *pk, unsigned char *sk);
+   int (*verify)(const unsigned char *sig, size_t siglen,
+                 const unsigned char *m, size_t mlen,
+                 const unsigned char *pk);
+   int (*pool_start)(const unsigned char *sk, size_t capacity);
+   int (*signature_pooled)(unsigned char *sig, size_t *siglen,
+                           const unsigned char *m, size_t mlen);
+   void (*pool_stop)(void);
+} test_set_t;
+
+#define TEST_SET(namespace, dir) { dir, \
+   namespace##CRYPTO_PUBLICKEYBYTES, \
+   namespace##CRYPTO_SECRETKEYBYTES, \
+   namespace##CRYPTO_BYTES, \
+   namespace##crypto_sign_keypair, \
+   namespace##crypto_sign_verify, \
+   namespace##crypto_sign_presig_pool_start, \
+   namespace##crypto_sign_signature_pooled, \
+   namespace##crypto_sign_presig_pool_stop }
+
+static const test_set_t sets[] = {
+__test_sets__
+};
+
+/* returns 1 if a pooled signature of m verifies under pk, 0 otherwise */
+static
+int sign_pooled(const test_set_t *set, const unsigned char *pk,
+                unsigned char *sig){
+    unsigned char m[MESSAGE_BYTES];
+    size_t siglen;
+    memset(m, 0x5a, sizeof(m));
+    return set->signature_pooled(sig, &siglen, m, sizeof(m)) == 0 &&
+           set->verify(sig, siglen, m, sizeof(m), pk) == 0;
+}
+
+/* the checks of the child, its exit status is 0 if all of them pass */
+static
+int child(const test_set_t *set, unsigned char *pk, unsigned char *sk,
+          unsigned char *sig){
+    size_t siglen;
+    unsigned char m[MESSAGE_BYTES];
+    memset(m, 0xa5, sizeof(m));
+    if(set->signature_pooled(sig, &siglen, m, sizeof(m)) != -1){
+        fprintf(stderr, "%s: the child signed with the pool of its parent\n", set->name);
+        return 1;
+    }
+    set->pool_stop();
+    set->keypair(pk, sk);
+    if(set->pool_start(sk, CAPACITY) != 0 || !sign_pooled(set, pk, sig)){
+        fprintf(stderr, "%s: the child cannot start a pool of its own\n", set->name);
+        return 1;
+    }
+    set->pool_stop();
+    return 0;
+}
+
+/* returns 1 if the checks pass or are skipped, 0 otherwise */
+static
+int test(const test_set_t *set){
+    unsigned char *pk = malloc(set->pk_bytes);
+    unsigned char *sk = malloc(set->sk_bytes);
+    unsigned char *sig = malloc(set->sig_bytes);
+    int ok = (pk != NULL && sk != NULL && sig != NULL);
+
+    if(ok){
+        set->keypair(pk, sk);
+        if(set->pool_start(sk, CAPACITY) != 0){
+            printf("%s skipped, built without PRESIG_POOL\n", set->name);
+            goto end;
+        }
+        /* the refill thread is given the time to fill the pool, so that the
+         * child inherits ready presignatures */
+        struct timespec delay = {0, 200000000};
+        nanosleep(&delay, NULL);
+
+        pid_t pid = fork();
+        if(pid == 0){
+            _exit(child(set, pk, sk, sig));
+        }
+        int status = 0;
+        ok = (pid > 0 && waitpid(pid, &status, 0) == pid &&
+              WIFEXITED(status) && WEXITSTATUS(status) == 0);
+        if(ok && !sign_pooled(set, pk, sig)){
+            fprintf(stderr, "%s: the parent cannot sign after the fork\n", set->name);
+            ok = 0;
+        }
+        set->pool_stop();
+        printf("%s %s\n", set->name, ok ? "ok" : "failed");
+    }
+end:
+    free(pk);
+    free(sk);
+    free(sig);
+    return ok;
+}
+
+int main(int argc, char **argv){
+    int failed = 0;
+    for(size_t s = 0; s < sizeof(sets)/sizeof(sets[0]); s++){
+        int selected = (argc == 1);
+        for(int a = 1; a < argc; a++){
+            selected |= (strcmp(argv[a], sets[s].name) == 0);
+        }
+        if(selected && !test(&sets[s])){
+            failed = 1;
+        }
+    }
+    return failed;
+}
@@ -0,0 +1,158 @@
+/**
+ *
+ * Reference ISO-C11 Implementation of CROSS.
+ *
+ * @version 2.0 (February 2025)
+ *
+ * Authors listed in alphabetical order:
+ * 
+ * @author: Alessandro Barenghi <alessandro.barenghi@polimi.it>
+ * @author: Marco Gianvecchio <marco.gianvecchio@mail.polimi.it>
+ * @author: Patrick Karl <patrick.karl@tum.de>
+ * @author: Gerardo Pelosi <gerardo.pelosi@polimi.it>
+ * @author: Jonas Schupp <jonas.schupp@tum.de>
+ * 
+ * 
+ * This code is hereby placed in the public domain.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ''AS IS'' AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **/
+
+
+
+/* Checks the step-wise verification against CROSS_verify: with step budgets
+ * of a few units up to more than the whole work, on a valid signature and on
+ * signatures tampered in each of their fields and at random offsets, with
+ * the public key and with its expansion, it must come to the same outcome,
+ * in a number of steps bounded by the work. finish must reject when the
+ * steps have work left, and after an abort, which may be repeated.
+ * Usage: test_verify_step */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "CROSS.h"
+#include "pk_expanded.h"
+#include "test_impl.h"
+#include "verify_state.h"
+
+#define MESSAGE_BYTES 32
+#define RANDOM_TAMPERINGS 25
+
+static const unsigned int budgets[] = {1, 2, 3, 5, 7, 1000};
+
+static sk_t sk;
+static pk_t pk;
+static pk_expanded_t epk;
+static CROSS_sig_t sig, tampered;
+static CROSS_verify_state_t state;
+static char m[MESSAGE_BYTES];
+static int ok = 1;
+
+/* fails the test, saying why, unless condition holds */
+static
+void expect(int condition, const char *what){
+    if(!condition){
+        fprintf(stderr, "%s %s: %s\n", TEST_SET, TEST_IMPL, what);
+        ok = 0;
+    }
+}
+
+/* steps with budget until the work is done, then finishes; returns the
+ * outcome, or -1 if it takes more steps than the units of work, i.e., T
+ * rounds and the nodes of the trees, could need */
+static
+int verify_stepped(const CROSS_sig_t *signature, int expanded,
+                   unsigned int budget){
+    if(expanded){
+        CROSS_verify_start_expanded(&state, &epk, m, sizeof(m), signature);
+    } else {
+        CROSS_verify_start(&state, &pk, m, sizeof(m), signature);
+    }
+    int steps = 0;
+    while(!CROSS_verify_step(&state, budget)){
+        if(++steps > 4*T){
+            CROSS_verify_abort(&state);
+            return -1;
+        }
+    }
+    return CROSS_verify_finish(&state);
+}
+
+/* checks every budget against CROSS_verify on signature */
+static
+void check_budgets(const CROSS_sig_t *signature, const char *what){
+    int expected = CROSS_verify(&pk, m, sizeof(m), signature);
+    for(size_t b = 0; b < sizeof(budgets)/sizeof(budgets[0]); b++){
+        expect(verify_stepped(signature, 0, budgets[b]) == expected &&
+               verify_stepped(signature, 1, budgets[b]) == expected, what);
+    }
+}
+
+/* a tampering which CROSS_verify rejects must be rejected step by step */
+static
+void check_tampered(size_t offset, uint8_t flip, const char *what){
+    tampered = sig;
+    ((uint8_t *)&tampered)[offset] ^= flip;
+    expect(!CROSS_verify(&pk, m, sizeof(m), &tampered), what);
+    check_budgets(&tampered, what);
+}
+
+int main(void){
+    if(test_skipped("test_verify_step", TEST_SET, TEST_IMPL)){
+        return 0;
+    }
+    test_randombytes_reset(1);
+    memset(m, 0x5a, sizeof(m));
+    CROSS_keygen(&sk, &pk);
+    CROSS_sign(&sk, m, sizeof(m), &sig);
+    expect(CROSS_pk_expand(&epk, &pk), "the public key does not expand");
+
+    expect(CROSS_verify(&pk, m, sizeof(m), &sig), "a valid signature is rejected");
+    check_budgets(&sig, "a valid signature differs step by step");
+
+    check_tampered(offsetof(CROSS_sig_t, salt), 1, "tampered salt");
+    check_tampered(offsetof(CROSS_sig_t, digest_cmt), 1, "tampered digest_cmt");
+    check_tampered(offsetof(CROSS_sig_t, digest_chall_2), 1, "tampered digest_chall_2");
+    check_tampered(offsetof(CROSS_sig_t, path), 1, "tampered path");
+    check_tampered(offsetof(CROSS_sig_t, proof), 1, "tampered proof");
+    check_tampered(offsetof(CROSS_sig_t, resp_1), 1, "tampered resp_1");
+    check_tampered(offsetof(CROSS_sig_t, resp_0), 1, "tampered resp_0");
+    check_tampered(sizeof(CROSS_sig_t)-1, 0x80, "tampered last byte");
+    srand(1);
+    for(int t = 0; t < RANDOM_TAMPERINGS; t++){
+        check_tampered((size_t)rand() % sizeof(CROSS_sig_t),
+                       (uint8_t)(1 + rand() % 255), "random tampering");
+    }
+
+    /* finish does not do the work left by the steps */
+    CROSS_verify_start(&state, &pk, m, sizeof(m), &sig);
+    expect(!CROSS_verify_step(&state, 0), "no work is left after a step of 0");
+    expect(!CROSS_verify_finish(&state), "finish accepts with all the work left");
+    CROSS_verify_start(&state, &pk, m, sizeof(m), &sig);
+    CROSS_verify_step(&state, T);
+    expect(!CROSS_verify_finish(&state), "finish accepts with the trees left");
+
+    /* an aborted verification is rejected */
+    CROSS_verify_start(&state, &pk, m, sizeof(m), &sig);
+    CROSS_verify_step(&state, budgets[2]);
+    CROSS_verify_abort(&state);
+    CROSS_verify_abort(&state);
+    expect(!CROSS_verify_finish(&state), "finish accepts after an abort");
+
+    return test_report("test_verify_step", TEST_SET, TEST_IMPL, ok);
+}
@@ -0,0 +1,160 @@
+/**
+ *
+ * Reference ISO-C11 Implementation of CROSS.
+ *
+ * @version 2.0 (February 2025)
+ *
+ * Authors listed in alphabetical order:
+ * 
+ * @author: Alessandro Barenghi <alessandro.barenghi@polimi.it>
+ * @author: Marco Gianvecchio <marco.gianvecchio@mail.polimi.it>
+ * @author: Patrick Karl <patrick.karl@tum.de>
+ * @author: Gerardo Pelosi <gerardo.pelosi@polimi.it>
+ * @author: Jonas Schupp <jonas.schupp@tum.de>
+ * 
+ * 
+ * This code is hereby placed in the public domain.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ''AS IS'' AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **/
+
+
+/* The sign and verify workload the profile-guided build of the shared
+ * library is trained on (see Makefile), which also times it. For every
+ * parameter set, or for the ones named on the command line, it runs
+ * ITERATIONS keypairs, signatures and verifications, and prints one line per
+ * operation: set, operation, median time in nanoseconds.
+ * Usage: train [-n iterations] [set ...] */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "cross.h"
+
+#define ITERATIONS 16
+#define MESSAGE_BYTES 32
+
+typedef struct {
+   const char *name;
+   size_t pk_bytes;
+   size_t sk_bytes;
+   size_t sig_bytes;
+   int (*keypair)(unsigned char *pk, unsigned char *sk);
+   int (*signature)(unsigned char *sig, size_t *siglen,
+                    const unsigned char *m, size_t mlen,
+                    const unsigned char *sk);
+   int (*verify)(const unsigned char *sig, size_t siglen,
+                 const unsigned char *m, size_t mlen,
+                 const unsigned char *pk);
+} train_set_t;
+
+#define TRAIN_SET(namespace, dir) { dir, \
+   namespace##CRYPTO_PUBLICKEYBYTES, \
+   namespace##CRYPTO_SECRETKEYBYTES, \
+   namespace##CRYPTO_BYTES, \
+   namespace##crypto_sign_keypair, \
+   namespace##crypto_sign_signature, \
+   namespace##crypto_sign_verify }
+
+static const train_set_t sets[] = {
+__train_sets__
+};
+
+static
+uint64_t now_ns(void){
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec*1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+static
+int compare_u64(const void *a, const void *b){
+    uint64_t x = *(const uint64_t *)a;
+    uint64_t y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+static
+uint64_t median(uint64_t *t, int n){
+    qsort(t, n, sizeof(uint64_t), compare_u64);
+    return t[n/2];
+}
+
+/* returns 1 if every signature verifies, 0 otherwise */
+static
+int train(const train_set_t *set, int iterations){
+    unsigned char *pk = malloc(set->pk_bytes);
+    unsigned char *sk = malloc(set->sk_bytes);
+    unsigned char *sig = malloc(set->sig_bytes);
+    uint64_t *t = malloc(3*iterations*sizeof(uint64_t));
+    uint64_t *t_keypair = t, *t_sign = t + iterations, *t_verify = t + 2*iterations;
+    unsigned char m[MESSAGE_BYTES];
+    int ok = (pk != NULL && sk != NULL && sig != NULL && t != NULL);
+
+    for(int i = 0; ok && i < iterations; i++){
+        size_t siglen;
+        memset(m, i, sizeof(m));
+        uint64_t start = now_ns();
+        set->keypair(pk, sk);
+        t_keypair[i] = now_ns() - start;
+        start = now_ns();
+        set->signature(sig, &siglen, m, sizeof(m), sk);
+        t_sign[i] = now_ns() - start;
+        start = now_ns();
+        ok = (set->verify(sig, siglen, m, sizeof(m), pk) == 0);
+        t_verify[i] = now_ns() - start;
+    }
+    if(ok){
+        printf("%s keypair %llu\n", set->name, (unsigned long long)median(t_keypair, iterations));
+        printf("%s sign %llu\n", set->name, (unsigned long long)median(t_sign, iterations));
+        printf("%s verify %llu\n", set->name, (unsigned long long)median(t_verify, iterations));
+    } else {
+        fprintf(stderr, "%s: verification failed\n", set->name);
+    }
+    free(pk);
+    free(sk);
+    free(sig);
+    free(t);
+    return ok;
+}
+
+int main(int argc, char **argv){
+    int iterations = ITERATIONS;
+    int first = 1;
+    if(argc > 2 && strcmp(argv[1], "-n") == 0){
+        iterations = atoi(argv[2]);
+        first = 3;
+    }
+    if(iterations < 1){
+        fprintf(stderr, "usage: %s [-n iterations] [set ...]\n", argv[0]);
+        return 1;
+    }
+
+    int failed = 0;
+    for(size_t s = 0; s < sizeof(sets)/sizeof(sets[0]); s++){
+        int selected = (first == argc);
+        for(int a = first; a < argc; a++){
+            selected |= (strcmp(argv[a], sets[s].name) == 0);
+        }
+        if(selected && !train(&sets[s], iterations)){
+            failed = 1;
+        }
+    }
+    return failed;
+}